@@ -1,5 +1,8 @@
 // CG scalar computation
-// Dispatch: 1 workgroup of 1 thread
+// Dispatch: 1 workgroup of 1 thread (always direct — it writes the indirect args)
+//
+// With the block-Jacobi preconditioner every "rr" below is r dot z (z = D^-1 r);
+// the formulas are unchanged.
 //
 // Scalar buffer layout (8 f32):
 //   [0] rr       — current r dot r
@@ -7,10 +10,23 @@
 //   [2] rr_new   — new r dot r (after x,r update)
 //   [3] alpha    — output: rr / pAp
 //   [4] beta     — output: rr_new / rr
+//   [5] rr0      — initial r dot r (convergence reference)
 //
 // Mode uniform (u32):
 //   0: compute alpha = rr / pAp
 //   1: compute beta = rr_new / rr, then advance rr = rr_new
+//   2: record rr0 = rr (after the initial dot product)
+//
+// Convergence (modes 1 and 2): once rr <= tol^2 * rr0, every indirect
+// dispatch argument is zeroed so the remaining CG passes become no-ops.
+//
+// Indirect args layout (12 u32, see CGSolver):
+//   [0..2]  node-sized dispatch   (workgroup_count, 1, 1)
+//   [3..5]  single-workgroup dispatch (1, 1, 1)
+//   [6..8]  dot dispatch          (dot workgroup count, 1, 1)
+//   [9..11] SpMV dispatch         (SpMV workgroup count, 1, 1)
+
+#import "core_simulate/header/solver_params.wgsl"
 
 struct ModeParams {
     mode: u32,
@@ -21,10 +37,19 @@ struct ModeParams {
 
 @group(0) @binding(0) var<storage, read_write> scalars: array<f32>;
 @group(0) @binding(1) var<uniform> mode_params: ModeParams;
+@group(0) @binding(2) var<uniform> solver: SolverParams;
+@group(0) @binding(3) var<storage, read_write> dispatch_args: array<u32>;
+
+fn mark_converged() {
+    for (var i = 0u; i < arrayLength(&dispatch_args); i = i + 1u) {
+        dispatch_args[i] = 0u;
+    }
+}
 
 @compute @workgroup_size(1)
 fn cs_main() {
     let mode = mode_params.mode;
+    let tol_sq = solver.cg_tolerance * solver.cg_tolerance;
 
     if (mode == 0u) {
         let rr = scalars[0];
@@ -34,7 +59,7 @@ fn cs_main() {
         } else {
             scalars[3] = 0.0;
         }
-    } else {
+    } else if (mode == 1u) {
         let rr_old = scalars[0];
         let rr_new = scalars[2];
         if (rr_old > 1e-30) {
@@ -43,5 +68,17 @@ fn cs_main() {
             scalars[4] = 0.0;
         }
         scalars[0] = rr_new;
+
+        if (rr_new <= tol_sq * scalars[5]) {
+            mark_converged();
+        }
+    } else {
+        let rr0 = scalars[0];
+        scalars[5] = rr0;
+
+        // Zero RHS: x = 0 is already the solution
+        if (rr0 <= 1e-30) {
+            mark_converged();
+        }
     }
 }
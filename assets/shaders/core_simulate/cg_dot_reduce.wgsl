@@ -0,0 +1,17 @@
+// CG dot product in one dispatch (shared-memory workgroup reduction)
+// See core_simulate/header/dot_reduce.wgsl.
+// Dispatch: ceil(node_count / workgroup_size) workgroups
+
+#import "core_simulate/header/reduce_shared.wgsl"
+#import "core_simulate/header/dot_reduce.wgsl"
+#import "header/workgroup_size.wgsl"
+
+@compute @workgroup_size(workgroup_size)
+fn cs_main(
+    @builtin(global_invocation_id) gid: vec3u,
+    @builtin(local_invocation_id) lid: vec3u,
+    @builtin(workgroup_id) wid: vec3u,
+    @builtin(num_workgroups) nwg: vec3u,
+) {
+    dot_reduce(gid.x, lid.x, wid.x, nwg.x, 0u);
+}
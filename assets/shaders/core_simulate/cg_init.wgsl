@@ -1,14 +1,16 @@
 // CG initialization: x = 0, p = r (r already contains b from RHS assembly)
-// Dispatch: ceil(node_count / 64) workgroups
+// With the block-Jacobi preconditioner cg_r is bound to z = D^-1 r instead.
+// Dispatch: ceil(node_count / workgroup_size) workgroups
 
 #import "core_simulate/header/solver_params.wgsl"
+#import "header/workgroup_size.wgsl"
 
 @group(0) @binding(0) var<uniform> solver: SolverParams;
 @group(0) @binding(1) var<storage, read_write> cg_x: array<vec4f>;
 @group(0) @binding(2) var<storage, read> cg_r: array<vec4f>;
 @group(0) @binding(3) var<storage, read_write> cg_p: array<vec4f>;
 
-@compute @workgroup_size(64)
+@compute @workgroup_size(workgroup_size)
 fn cs_main(@builtin(global_invocation_id) gid: vec3u) {
     let id = gid.x;
     if (id >= solver.node_count) {
@@ -0,0 +1,31 @@
+// Pipelined CG initialization: x = 0, p = 0, s = 0, u = M^-1 r
+// (r already contains b from RHS assembly)
+// Dispatch: ceil(node_count / workgroup_size) workgroups
+//
+// M^-1 is block_inv from cg_precond_invert: D^-1 blocks for block-Jacobi,
+// identity otherwise, zero for pinned nodes (MPCG filter).
+
+#import "core_simulate/header/solver_params.wgsl"
+#import "header/workgroup_size.wgsl"
+
+@group(0) @binding(0) var<uniform> solver: SolverParams;
+@group(0) @binding(1) var<storage, read_write> cg_x: array<vec4f>;
+@group(0) @binding(2) var<storage, read> cg_r: array<vec4f>;
+@group(0) @binding(3) var<storage, read_write> cg_p: array<vec4f>;
+@group(0) @binding(4) var<storage, read_write> cg_s: array<vec4f>;
+@group(0) @binding(5) var<storage, read_write> cg_u: array<vec4f>;
+@group(0) @binding(6) var<storage, read> block_inv: array<mat3x3f>;
+
+@compute @workgroup_size(workgroup_size)
+fn cs_main(@builtin(global_invocation_id) gid: vec3u) {
+    let id = gid.x;
+    if (id >= solver.node_count) {
+        return;
+    }
+
+    let zero = vec4f(0.0, 0.0, 0.0, 0.0);
+    cg_x[id] = zero;
+    cg_p[id] = zero;
+    cg_s[id] = zero;
+    cg_u[id] = vec4f(block_inv[id] * cg_r[id].xyz, 0.0);
+}
@@ -0,0 +1,107 @@
+// Pipelined CG final reduction + scalar update (one workgroup)
+// Sums the (r.u, w.u) partials written by the fused SpMV and, on thread 0,
+// computes the step scalars in the same dispatch.
+// Dispatch: 1 workgroup (always direct — it writes the indirect args)
+//
+// Chronopoulos-Gear recurrences (gamma = r.u, delta = w.u):
+//   init:    alpha = gamma / delta, beta = 0
+//   iterate: beta = gamma_new / gamma
+//            alpha = gamma_new / (delta - beta * gamma_new / alpha)
+//
+// Scalar buffer layout (shared with cg_compute_scalars):
+//   [0] gamma    — current r dot u
+//   [1] delta    — w dot u
+//   [3] alpha
+//   [4] beta
+//   [5] gamma0   — initial r dot u (convergence reference)
+//
+// Convergence: once gamma <= tol^2 * gamma0 every indirect dispatch argument
+// is zeroed (same layout as cg_compute_scalars).
+
+#import "core_simulate/header/solver_params.wgsl"
+#import "header/workgroup_size.wgsl"
+
+struct ReduceConfig {
+    mode: u32,            // 0 = init, 1 = iterate
+    partial_count: u32,
+    pad0: u32,
+    pad1: u32,
+};
+
+@group(0) @binding(0) var<storage, read> partials: array<vec2f>;
+@group(0) @binding(1) var<storage, read_write> scalars: array<f32>;
+@group(0) @binding(2) var<uniform> config: ReduceConfig;
+@group(0) @binding(3) var<uniform> solver: SolverParams;
+@group(0) @binding(4) var<storage, read_write> dispatch_args: array<u32>;
+
+var<workgroup> shared_data: array<vec2f, workgroup_size>;
+
+fn mark_converged() {
+    for (var i = 0u; i < arrayLength(&dispatch_args); i = i + 1u) {
+        dispatch_args[i] = 0u;
+    }
+}
+
+@compute @workgroup_size(workgroup_size)
+fn cs_main(@builtin(local_invocation_id) lid: vec3u) {
+    let local_id = lid.x;
+    let count = config.partial_count;
+
+    var sum = vec2f(0.0, 0.0);
+    var i = local_id;
+    loop {
+        if (i >= count) {
+            break;
+        }
+        sum = sum + partials[i];
+        i = i + workgroup_size;
+    }
+
+    shared_data[local_id] = sum;
+    workgroupBarrier();
+
+    for (var stride = workgroup_size / 2u; stride > 0u; stride = stride >> 1u) {
+        if (local_id < stride) {
+            shared_data[local_id] = shared_data[local_id] + shared_data[local_id + stride];
+        }
+        workgroupBarrier();
+    }
+
+    if (local_id != 0u) {
+        return;
+    }
+
+    let gamma = shared_data[0].x;
+    let delta = shared_data[0].y;
+    let tol_sq = solver.cg_tolerance * solver.cg_tolerance;
+
+    if (config.mode == 0u) {
+        scalars[0] = gamma;
+        scalars[1] = delta;
+        scalars[3] = select(0.0, gamma / delta, delta > 1e-30);
+        scalars[4] = 0.0;
+        scalars[5] = gamma;
+
+        // Zero RHS: x = 0 is already the solution
+        if (gamma <= 1e-30) {
+            mark_converged();
+        }
+    } else {
+        let gamma_old = scalars[0];
+        let alpha_old = scalars[3];
+        let beta = select(0.0, gamma / gamma_old, gamma_old > 1e-30);
+        var denom = delta;
+        if (alpha_old > 1e-30) {
+            denom = delta - beta * gamma / alpha_old;
+        }
+
+        scalars[0] = gamma;
+        scalars[1] = delta;
+        scalars[3] = select(0.0, gamma / denom, denom > 1e-30);
+        scalars[4] = beta;
+
+        if (gamma <= tol_sq * scalars[5]) {
+            mark_converged();
+        }
+    }
+}
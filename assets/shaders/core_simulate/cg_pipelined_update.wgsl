@@ -0,0 +1,43 @@
+// Pipelined CG vector update (Chronopoulos-Gear), one pass per iteration:
+//   p = u + beta * p
+//   s = w + beta * s          (s tracks A*p without a second SpMV)
+//   x += alpha * p
+//   r -= alpha * s
+//   u = M^-1 r
+// Dispatch: ceil(node_count / workgroup_size) workgroups (indirect with the convergence check)
+//
+// Pinned nodes have a zero block_inv, so u, and with it p and x, stay zero there.
+
+#import "core_simulate/header/solver_params.wgsl"
+#import "header/workgroup_size.wgsl"
+
+@group(0) @binding(0) var<uniform> solver: SolverParams;
+@group(0) @binding(1) var<storage, read_write> cg_x: array<vec4f>;
+@group(0) @binding(2) var<storage, read_write> cg_r: array<vec4f>;
+@group(0) @binding(3) var<storage, read_write> cg_p: array<vec4f>;
+@group(0) @binding(4) var<storage, read_write> cg_s: array<vec4f>;
+@group(0) @binding(5) var<storage, read_write> cg_u: array<vec4f>;
+@group(0) @binding(6) var<storage, read> cg_w: array<vec4f>;
+@group(0) @binding(7) var<storage, read> scalars: array<f32>;
+@group(0) @binding(8) var<storage, read> block_inv: array<mat3x3f>;
+
+@compute @workgroup_size(workgroup_size)
+fn cs_main(@builtin(global_invocation_id) gid: vec3u) {
+    let id = gid.x;
+    if (id >= solver.node_count) {
+        return;
+    }
+
+    let alpha = scalars[3];
+    let beta = scalars[4];
+
+    let p = cg_u[id].xyz + beta * cg_p[id].xyz;
+    let s = cg_w[id].xyz + beta * cg_s[id].xyz;
+    let r = cg_r[id].xyz - alpha * s;
+
+    cg_p[id] = vec4f(p, 0.0);
+    cg_s[id] = vec4f(s, 0.0);
+    cg_x[id] = vec4f(cg_x[id].xyz + alpha * p, 0.0);
+    cg_r[id] = vec4f(r, 0.0);
+    cg_u[id] = vec4f(block_inv[id] * r, 0.0);
+}
@@ -0,0 +1,29 @@
+// Block-Jacobi preconditioner apply: z = D^-1 * r
+// Dispatch: ceil(node_count / workgroup_size) workgroups
+
+#import "core_simulate/header/solver_params.wgsl"
+#import "core_simulate/header/sim_mass.wgsl"
+#import "header/workgroup_size.wgsl"
+
+@group(0) @binding(0) var<uniform> solver: SolverParams;
+@group(0) @binding(1) var<storage, read> cg_r: array<vec4f>;
+@group(0) @binding(2) var<storage, read> block_inv: array<mat3x3f>;
+@group(0) @binding(3) var<storage, read_write> cg_z: array<vec4f>;
+@group(0) @binding(4) var<storage, read> mass: array<SimMass>;
+
+@compute @workgroup_size(workgroup_size)
+fn cs_main(@builtin(global_invocation_id) gid: vec3u) {
+    let id = gid.x;
+    if (id >= solver.node_count) {
+        return;
+    }
+
+    // MPCG filter: pinned (infinite mass) nodes get no preconditioned residual
+    let inv_mass = mass[id].inv_mass;
+    if (inv_mass <= 0.0) {
+        cg_z[id] = vec4f(0.0, 0.0, 0.0, 0.0);
+        return;
+    }
+
+    cg_z[id] = vec4f(block_inv[id] * cg_r[id].xyz, 0.0);
+}
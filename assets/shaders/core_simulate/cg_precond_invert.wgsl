@@ -0,0 +1,57 @@
+// Block-Jacobi preconditioner setup: inv[i] = D_i^-1 for each 3x3 diagonal block
+// Dispatch: ceil(node_count / workgroup_size) workgroups, once per CG solve (the diagonal
+// is re-assembled every Newton iteration).
+//
+// The diagonal buffer stores 3x3 blocks (9 f32 per node, row-major).
+// With rows r0, r1, r2, the inverse's columns are
+//   cross(r1, r2) / det, cross(r2, r0) / det, cross(r0, r1) / det.
+// Singular blocks fall back to the identity (unpreconditioned) for that node.
+//
+// Pinned nodes (inv_mass == 0) get a zero block, so z = inv * r is already
+// MPCG-filtered. With invert_blocks = false every free node gets the identity;
+// pipelined CG uses that as its filter-only "preconditioner" and diag is unread.
+
+#import "core_simulate/header/solver_params.wgsl"
+#import "core_simulate/header/sim_mass.wgsl"
+#import "header/workgroup_size.wgsl"
+
+override invert_blocks: bool = true;
+
+@group(0) @binding(0) var<uniform> solver: SolverParams;
+@group(0) @binding(1) var<storage, read> diag_values: array<f32>;
+@group(0) @binding(2) var<storage, read_write> block_inv: array<mat3x3f>;
+@group(0) @binding(3) var<storage, read> mass: array<SimMass>;
+
+const kIdentity = mat3x3f(1.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 1.0);
+
+@compute @workgroup_size(workgroup_size)
+fn cs_main(@builtin(global_invocation_id) gid: vec3u) {
+    let id = gid.x;
+    if (id >= solver.node_count) {
+        return;
+    }
+
+    if (mass[id].inv_mass <= 0.0) {
+        block_inv[id] = mat3x3f();
+        return;
+    }
+    if (!invert_blocks) {
+        block_inv[id] = kIdentity;
+        return;
+    }
+
+    let base = id * 9u;
+    let r0 = vec3f(diag_values[base + 0u], diag_values[base + 1u], diag_values[base + 2u]);
+    let r1 = vec3f(diag_values[base + 3u], diag_values[base + 4u], diag_values[base + 5u]);
+    let r2 = vec3f(diag_values[base + 6u], diag_values[base + 7u], diag_values[base + 8u]);
+
+    let c0 = cross(r1, r2);
+    let det = dot(r0, c0);
+    if (abs(det) <= 1e-30) {
+        block_inv[id] = kIdentity;
+        return;
+    }
+
+    let inv_det = 1.0 / det;
+    block_inv[id] = mat3x3f(c0 * inv_det, cross(r2, r0) * inv_det, cross(r0, r1) * inv_det);
+}
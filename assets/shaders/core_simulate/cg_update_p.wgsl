@@ -1,8 +1,10 @@
 // CG direction update: p = r + beta * p
-// Dispatch: ceil(node_count / 64) workgroups
+// With the block-Jacobi preconditioner cg_r is bound to z = D^-1 r instead.
+// Dispatch: ceil(node_count / workgroup_size) workgroups
 
 #import "core_simulate/header/solver_params.wgsl"
 #import "core_simulate/header/sim_mass.wgsl"
+#import "header/workgroup_size.wgsl"
 
 @group(0) @binding(0) var<uniform> solver: SolverParams;
 @group(0) @binding(1) var<storage, read> cg_r: array<vec4f>;
@@ -10,7 +12,7 @@
 @group(0) @binding(3) var<storage, read> scalars: array<f32>;
 @group(0) @binding(4) var<storage, read> mass: array<SimMass>;
 
-@compute @workgroup_size(64)
+@compute @workgroup_size(workgroup_size)
 fn cs_main(@builtin(global_invocation_id) gid: vec3u) {
     let id = gid.x;
     if (id >= solver.node_count) {
@@ -1,8 +1,9 @@
 // CG update: x += alpha * p, r -= alpha * Ap
-// Dispatch: ceil(node_count / 64) workgroups
+// Dispatch: ceil(node_count / workgroup_size) workgroups
 
 #import "core_simulate/header/solver_params.wgsl"
 #import "core_simulate/header/sim_mass.wgsl"
+#import "header/workgroup_size.wgsl"
 
 @group(0) @binding(0) var<uniform> solver: SolverParams;
 @group(0) @binding(1) var<storage, read_write> cg_x: array<vec4f>;
@@ -12,7 +13,7 @@
 @group(0) @binding(5) var<storage, read> scalars: array<f32>;
 @group(0) @binding(6) var<storage, read> mass: array<SimMass>;
 
-@compute @workgroup_size(64)
+@compute @workgroup_size(workgroup_size)
 fn cs_main(@builtin(global_invocation_id) gid: vec3u) {
     let id = gid.x;
     if (id >= solver.node_count) {
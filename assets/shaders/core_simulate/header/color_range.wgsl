@@ -0,0 +1,10 @@
+// One color batch of a conflict-free element dispatch (see ElementColoring).
+// Elements [offset, offset + count) share no nodes, so they may accumulate into
+// per-node and per-CSR-block storage with plain read-modify-write.
+
+struct ColorRange {
+    offset: u32,
+    count: u32,
+    _pad0: u32,
+    _pad1: u32,
+};
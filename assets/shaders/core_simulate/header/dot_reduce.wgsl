@@ -0,0 +1,61 @@
+// Single-dispatch global dot product: scalars[target_slot] = sum_i dot(a[i].xyz, b[i].xyz)
+//
+// Each workgroup reduces its workgroup_size nodes with workgroup_sum() (imported first,
+// shared-memory or subgroup variant) and publishes the partial. The last
+// workgroup to finish, detected with an atomic ticket counter, sums all
+// partials and writes the scalar, then re-arms the counter for the next dot.
+//
+// Adapter assumption: WGSL atomics are relaxed and the memory model gives no
+// release/acquire ordering between workgroups, so nothing in the language
+// guarantees the last workgroup sees the other partials. This relies on the
+// adapter making storage atomics of finished workgroups visible (true on the
+// D3D12, Metal and Vulkan drivers we run on). Where it does not hold, turn off
+// GPUConfig::single_pass_reductions: CGSolver then uses the two-dispatch
+// cg_dot + cg_dot_final pair, ordered by the dispatch boundary.
+
+#import "core_simulate/header/solver_params.wgsl"
+#import "header/workgroup_size.wgsl"
+
+struct DotConfig {
+    target_slot: u32,
+    partial_count: u32,  // unused here (num_workgroups is authoritative)
+    pad0: u32,
+    pad1: u32,
+};
+
+@group(0) @binding(0) var<uniform> solver: SolverParams;
+@group(0) @binding(1) var<storage, read> vec_a: array<vec4f>;
+@group(0) @binding(2) var<storage, read> vec_b: array<vec4f>;
+@group(0) @binding(3) var<storage, read_write> partials: array<atomic<u32>>;
+@group(0) @binding(4) var<storage, read_write> scalars: array<f32>;
+@group(0) @binding(5) var<uniform> config: DotConfig;
+@group(0) @binding(6) var<storage, read_write> ticket: atomic<u32>;
+
+var<workgroup> is_last: u32;
+
+fn dot_reduce(gid: u32, lid: u32, wid: u32, wg_count: u32, lane: u32) {
+    var val = 0.0;
+    if (gid < solver.node_count) {
+        val = dot(vec_a[gid].xyz, vec_b[gid].xyz);
+    }
+
+    let partial = workgroup_sum(val, lid, lane);
+    if (lid == 0u) {
+        atomicStore(&partials[wid], bitcast<u32>(partial));
+        is_last = select(0u, 1u, atomicAdd(&ticket, 1u) == wg_count - 1u);
+    }
+    if (workgroupUniformLoad(&is_last) == 0u) {
+        return;
+    }
+
+    // Last workgroup: every partial has been published
+    var sum = 0.0;
+    for (var i = lid; i < wg_count; i = i + workgroup_size) {
+        sum = sum + bitcast<f32>(atomicLoad(&partials[i]));
+    }
+    let total = workgroup_sum(sum, lid, lane);
+    if (lid == 0u) {
+        scalars[config.target_slot] = total;
+        atomicStore(&ticket, 0u);
+    }
+}
@@ -0,0 +1,22 @@
+// Workgroup sum (workgroup_size invocations, a power of two) via a shared-memory
+// tree, one barrier per level.
+// Fallback for adapters without the subgroups feature; same interface as
+// reduce_subgroup.wgsl. Must be called from uniform control flow.
+// The result is only valid on local invocation 0.
+
+#import "header/workgroup_size.wgsl"
+
+var<workgroup> reduce_scratch: array<f32, workgroup_size>;
+
+fn workgroup_sum(v: f32, lid: u32, lane: u32) -> f32 {
+    reduce_scratch[lid] = v;
+    workgroupBarrier();
+
+    for (var stride = workgroup_size / 2u; stride > 0u; stride = stride >> 1u) {
+        if (lid < stride) {
+            reduce_scratch[lid] = reduce_scratch[lid] + reduce_scratch[lid + stride];
+        }
+        workgroupBarrier();
+    }
+    return reduce_scratch[0];
+}
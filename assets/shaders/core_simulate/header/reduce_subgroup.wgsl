@@ -0,0 +1,35 @@
+// Workgroup sum (workgroup_size invocations) via subgroupAdd: one subgroup-wide add, then
+// invocation 0 adds the per-subgroup results (workgroup_size / subgroup_size of them).
+// Two barriers regardless of subgroup size. Requires `enable subgroups;` in
+// the including shader. Must be called from uniform control flow.
+// The result is only valid on local invocation 0.
+//
+// WGSL does not fix how invocations map to subgroups, so subgroup leaders
+// claim compact slots with a workgroup atomic instead of indexing by lid.
+
+#import "header/workgroup_size.wgsl"
+
+var<workgroup> reduce_scratch: array<f32, workgroup_size>;
+var<workgroup> reduce_count: atomic<u32>;
+
+fn workgroup_sum(v: f32, lid: u32, lane: u32) -> f32 {
+    if (lid == 0u) {
+        atomicStore(&reduce_count, 0u);
+    }
+    workgroupBarrier();
+
+    let s = subgroupAdd(v);
+    if (lane == 0u) {
+        reduce_scratch[atomicAdd(&reduce_count, 1u)] = s;
+    }
+    workgroupBarrier();
+
+    var total = 0.0;
+    if (lid == 0u) {
+        let n = atomicLoad(&reduce_count);
+        for (var i = 0u; i < n; i = i + 1u) {
+            total = total + reduce_scratch[i];
+        }
+    }
+    return total;
+}
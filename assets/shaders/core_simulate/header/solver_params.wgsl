@@ -3,7 +3,9 @@
 //
 // Layout (32 bytes = 2 x vec4):
 //   [0..3]   node_count, edge_count, face_count, cg_max_iter   (u32 x4)
-//   [4..7]   cg_tolerance, _pad0, _pad1, _pad2                 (f32 x4)
+//   [4..7]   cg_tolerance, cg_precond, _pad1, _pad2             (f32, u32, f32 x2)
+//
+// cg_precond: 0 = none, 1 = block-Jacobi (3x3 diagonal blocks)
 
 struct SolverParams {
     node_count: u32,
@@ -11,7 +13,7 @@ struct SolverParams {
     face_count: u32,
     cg_max_iter: u32,
     cg_tolerance: f32,
-    _pad0: f32,
+    cg_precond: u32,
     _pad1: f32,
     _pad2: f32,
 };
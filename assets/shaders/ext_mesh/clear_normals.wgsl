@@ -1,11 +1,12 @@
 // Clear normal accumulation buffer (fixed-point i32 atomics)
-// Dispatch: ceil(node_count / 64) workgroups
+// Dispatch: ceil(node_count / workgroup_size) workgroups
 
 #import "ext_mesh/header/normal_params.wgsl"
+#import "header/workgroup_size.wgsl"
 
 @group(0) @binding(1) var<storage, read_write> normals: array<atomic<i32>>;
 
-@compute @workgroup_size(64)
+@compute @workgroup_size(workgroup_size)
 fn cs_main(@builtin(global_invocation_id) gid: vec3u) {
     let id = gid.x;
     if (id >= params.node_count) {
@@ -1,14 +1,15 @@
 // Normalize per-vertex normals from fixed-point i32 to unit vec4f
-// Dispatch: ceil(node_count / 64) workgroups
+// Dispatch: ceil(node_count / workgroup_size) workgroups
 
 #import "ext_mesh/header/normal_params.wgsl"
+#import "header/workgroup_size.wgsl"
 
 const FP_SCALE: f32 = 1048576.0; // 2^20
 
 @group(0) @binding(1) var<storage, read> normals_i32: array<i32>;
 @group(0) @binding(2) var<storage, read_write> normals_out: array<vec4f>;
 
-@compute @workgroup_size(64)
+@compute @workgroup_size(workgroup_size)
 fn cs_main(@builtin(global_invocation_id) gid: vec3u) {
     let id = gid.x;
     if (id >= params.node_count) {
@@ -1,7 +1,8 @@
 // Compute per-face normals and scatter (atomic add) to vertex normals
-// Dispatch: ceil(face_count / 64) workgroups
+// Dispatch: ceil(face_count / workgroup_size) workgroups
 
 #import "ext_mesh/header/normal_params.wgsl"
+#import "header/workgroup_size.wgsl"
 
 const FP_SCALE: f32 = 1048576.0; // 2^20
 
@@ -16,7 +17,7 @@ struct Face {
 @group(0) @binding(2) var<storage, read> faces: array<Face>;
 @group(0) @binding(3) var<storage, read_write> normals: array<atomic<i32>>;
 
-@compute @workgroup_size(64)
+@compute @workgroup_size(workgroup_size)
 fn cs_main(@builtin(global_invocation_id) gid: vec3u) {
     let fid = gid.x;
     if (fid >= params.face_count) {
@@ -0,0 +1,112 @@
+// FEM/SVD Area Preservation Constraint (gather assembly)
+// Dispatch: ceil(node_count / workgroup_size) workgroups, one thread per node / CSR row.
+//
+// Each thread walks the faces incident to its node (node_incidence) and sums
+// the force, diagonal block and its two CSR row blocks of every face, so all
+// writes are owned by the thread. Each face is evaluated once per vertex.
+//
+// With zero_csr_rows set, the thread zeroes its CSR row first; the first
+// term in assembly order does this in place of clearing csr_values.
+//
+// incidence[k] = vec2u(face index, vertex slot 0..2)
+// Energy, forces and Hessian blocks: see ext_newton/header/area_energy.wgsl
+
+#import "core_simulate/header/solver_params.wgsl"
+#import "core_simulate/header/physics_params.wgsl"
+#import "ext_newton/header/area_energy.wgsl"
+#import "header/workgroup_size.wgsl"
+
+override zero_csr_rows: bool = false;
+
+@group(0) @binding(0) var<uniform> physics: PhysicsParams;
+@group(0) @binding(1) var<uniform> solver: SolverParams;
+@group(0) @binding(2) var<storage, read> positions: array<vec4f>;
+@group(0) @binding(3) var<storage, read_write> forces: array<f32>;
+@group(0) @binding(4) var<storage, read> triangles: array<AreaTriangle>;
+@group(0) @binding(5) var<storage, read_write> diag_values: array<f32>;
+@group(0) @binding(6) var<uniform> area_params: AreaParams;
+@group(0) @binding(7) var<storage, read_write> csr_values: array<f32>;
+@group(0) @binding(8) var<storage, read> face_csr_map: array<FaceCSRMapping>;
+@group(0) @binding(9) var<storage, read> incidence_offsets: array<u32>;
+@group(0) @binding(10) var<storage, read> incidence: array<vec2u>;
+@group(0) @binding(11) var<storage, read> csr_row_ptr: array<u32>;
+
+// Accumulate a 3x3 block (given as rows) into off-diagonal CSR
+fn addCSRBlock(csr_idx: u32, h: array<vec3f, 3>) {
+    let base = csr_idx * 9u;
+    for (var m = 0u; m < 3u; m = m + 1u) {
+        csr_values[base + m * 3u + 0u] += h[m].x;
+        csr_values[base + m * 3u + 1u] += h[m].y;
+        csr_values[base + m * 3u + 2u] += h[m].z;
+    }
+}
+
+@compute @workgroup_size(workgroup_size)
+fn cs_main(@builtin(global_invocation_id) gid: vec3u) {
+    let id = gid.x;
+    if (id >= solver.node_count) {
+        return;
+    }
+
+    if (zero_csr_rows) {
+        for (var k = csr_row_ptr[id] * 9u; k < csr_row_ptr[id + 1u] * 9u; k = k + 1u) {
+            csr_values[k] = 0.0;
+        }
+    }
+
+    var f = vec3f(0.0);
+    var d = array<vec3f, 3>(vec3f(0.0), vec3f(0.0), vec3f(0.0));
+
+    for (var k = incidence_offsets[id]; k < incidence_offsets[id + 1u]; k = k + 1u) {
+        let entry = incidence[k];
+        let tri = triangles[entry.x];
+
+        var ev = evalArea(tri, positions[tri.n0].xyz, positions[tri.n1].xyz, positions[tri.n2].xyz,
+                          area_params.stiffness, area_params.shear_stiffness, physics.dt_sq);
+        if (!ev.valid) {
+            continue;  // degenerate triangle
+        }
+
+        // Own slot s and the other two vertex slots (s+1, s+2 mod 3)
+        let s = entry.y;
+        let s1 = (s + 1u) % 3u;
+        let s2 = (s + 2u) % 3u;
+        let ws = ev.w[s];
+
+        f += ev.force[s];
+
+        let hd = areaBlock(ev, ws, ws);
+        d[0] += hd[0];
+        d[1] += hd[1];
+        d[2] += hd[2];
+
+        // Row blocks (s, s1) and (s, s2)
+        let mapping = face_csr_map[entry.x];
+        var csr_a: u32;
+        var csr_b: u32;
+        if (s == 0u) {
+            csr_a = mapping.csr_01;
+            csr_b = mapping.csr_02;
+        } else if (s == 1u) {
+            csr_a = mapping.csr_12;
+            csr_b = mapping.csr_10;
+        } else {
+            csr_a = mapping.csr_20;
+            csr_b = mapping.csr_21;
+        }
+        addCSRBlock(csr_a, areaBlock(ev, ws, ev.w[s1]));
+        addCSRBlock(csr_b, areaBlock(ev, ws, ev.w[s2]));
+    }
+
+    let fb = id * 4u;
+    forces[fb + 0u] += f.x;
+    forces[fb + 1u] += f.y;
+    forces[fb + 2u] += f.z;
+
+    let db = id * 9u;
+    for (var m = 0u; m < 3u; m = m + 1u) {
+        diag_values[db + m * 3u + 0u] += d[m].x;
+        diag_values[db + m * 3u + 1u] += d[m].y;
+        diag_values[db + m * 3u + 2u] += d[m].z;
+    }
+}
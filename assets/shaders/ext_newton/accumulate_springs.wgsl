@@ -1,5 +1,6 @@
 // Accumulate spring forces and assemble Hessian blocks
-// Dispatch: ceil(edge_count / 64) workgroups
+// Dispatch: once per edge color, ceil(color.count / workgroup_size) workgroups.
+// Edges within a color share no nodes, so accumulation uses plain stores.
 //
 // Per edge (a, b) with stiffness k and rest length L:
 //   dx = pos[a] - pos[b], dist = |dx|, dir = dx / dist
@@ -16,7 +17,8 @@
 
 #import "core_simulate/header/solver_params.wgsl"
 #import "core_simulate/header/physics_params.wgsl"
-#import "core_simulate/header/atomic_float.wgsl"
+#import "core_simulate/header/color_range.wgsl"
+#import "header/workgroup_size.wgsl"
 
 @group(0) @binding(0) var<uniform> physics: PhysicsParams;
 @group(0) @binding(1) var<uniform> solver: SolverParams;
@@ -35,19 +37,20 @@ struct SpringParams {
 };
 
 @group(0) @binding(2) var<storage, read> positions: array<vec4f>;
-@group(0) @binding(3) var<storage, read_write> forces: array<atomic<u32>>;
+@group(0) @binding(3) var<storage, read_write> forces: array<f32>;
 @group(0) @binding(4) var<storage, read> edges: array<SpringEdge>;
-@group(0) @binding(5) var<storage, read_write> csr_values: array<atomic<u32>>;
-@group(0) @binding(6) var<storage, read_write> diag_values: array<atomic<u32>>;
+@group(0) @binding(5) var<storage, read_write> csr_values: array<f32>;
+@group(0) @binding(6) var<storage, read_write> diag_values: array<f32>;
 @group(0) @binding(7) var<storage, read> edge_csr_map: array<vec4u>;
 @group(0) @binding(8) var<uniform> spring_params: SpringParams;
+@group(0) @binding(9) var<uniform> color: ColorRange;
 
-@compute @workgroup_size(64)
+@compute @workgroup_size(workgroup_size)
 fn cs_main(@builtin(global_invocation_id) gid: vec3u) {
-    let eid = gid.x;
-    if (eid >= solver.edge_count) {
+    if (gid.x >= color.count) {
         return;
     }
+    let eid = color.offset + gid.x;
 
     let edge = edges[eid];
     let a = edge.n0;
@@ -71,17 +74,17 @@ fn cs_main(@builtin(global_invocation_id) gid: vec3u) {
     // f = -k * (dist - rest_len) * dir
     let f_spring = -k * (dist - rest_len) * dir;
 
-    // Atomic add force to node a: force[a] += f_spring
+    // Add force to node a: force[a] += f_spring
     let base_a = a * 4u;
-    atomicAddFloat(&forces[base_a + 0u], f_spring.x);
-    atomicAddFloat(&forces[base_a + 1u], f_spring.y);
-    atomicAddFloat(&forces[base_a + 2u], f_spring.z);
+    forces[base_a + 0u] += f_spring.x;
+    forces[base_a + 1u] += f_spring.y;
+    forces[base_a + 2u] += f_spring.z;
 
-    // Atomic add force to node b: force[b] -= f_spring
+    // Add force to node b: force[b] -= f_spring
     let base_b = b * 4u;
-    atomicAddFloat(&forces[base_b + 0u], -f_spring.x);
-    atomicAddFloat(&forces[base_b + 1u], -f_spring.y);
-    atomicAddFloat(&forces[base_b + 2u], -f_spring.z);
+    forces[base_b + 0u] -= f_spring.x;
+    forces[base_b + 1u] -= f_spring.y;
+    forces[base_b + 2u] -= f_spring.z;
 
     // --- Hessian assembly ---
     // Clamp ratio to [0, 1] so that coeff_i >= 0, ensuring the Jacobian block
@@ -111,14 +114,14 @@ fn cs_main(@builtin(global_invocation_id) gid: vec3u) {
     let dt2 = physics.dt_sq;
 
     // Write off-diagonal CSR blocks (symmetric: H_ab = H_ba)
-    // Uses atomicAddFloat to accumulate with other terms (e.g. area) sharing CSR entries.
+    // Accumulates with other terms (e.g. area) sharing CSR entries; terms run as separate dispatches.
     let mapping = edge_csr_map[eid];
     let csr_ab = mapping.x * 9u;
     let csr_ba = mapping.y * 9u;
 
     for (var i = 0u; i < 9u; i = i + 1u) {
-        atomicAddFloat(&csr_values[csr_ab + i], -dt2 * h[i]);
-        atomicAddFloat(&csr_values[csr_ba + i], -dt2 * h[i]);
+        csr_values[csr_ab + i] -= dt2 * h[i];
+        csr_values[csr_ba + i] -= dt2 * h[i];
     }
 
     // Accumulate diagonal blocks: diag += dt²*H_ab per neighbor
@@ -126,7 +129,7 @@ fn cs_main(@builtin(global_invocation_id) gid: vec3u) {
     let diag_b = b * 9u;
 
     for (var i = 0u; i < 9u; i = i + 1u) {
-        atomicAddFloat(&diag_values[diag_a + i], dt2 * h[i]);
-        atomicAddFloat(&diag_values[diag_b + i], dt2 * h[i]);
+        diag_values[diag_a + i] += dt2 * h[i];
+        diag_values[diag_b + i] += dt2 * h[i];
     }
 }
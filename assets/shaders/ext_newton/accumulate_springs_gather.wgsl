@@ -0,0 +1,132 @@
+// Accumulate spring forces and assemble Hessian blocks (gather assembly)
+// Dispatch: ceil(node_count / workgroup_size) workgroups, one thread per node / CSR row.
+//
+// Each thread walks the springs incident to its node (node_incidence) and
+// sums their contributions into its own force entry, diagonal block and CSR
+// row, so every location has a single writer and no coloring is needed.
+// Spring physics matches accumulate_springs.wgsl; the per-edge work is
+// evaluated once from each endpoint.
+//
+// With zero_csr_rows set, the thread zeroes its CSR row first; the first
+// term in assembly order does this in place of clearing csr_values.
+//
+// incidence[k] = vec2u(edge index, endpoint slot: 0 = n0, 1 = n1)
+
+#import "core_simulate/header/solver_params.wgsl"
+#import "core_simulate/header/physics_params.wgsl"
+#import "header/workgroup_size.wgsl"
+
+override zero_csr_rows: bool = false;
+
+@group(0) @binding(0) var<uniform> physics: PhysicsParams;
+@group(0) @binding(1) var<uniform> solver: SolverParams;
+
+struct SpringEdge {
+    n0: u32,
+    n1: u32,
+    rest_length: f32,
+};
+
+struct SpringParams {
+    stiffness: f32,
+    _pad0: f32,
+    _pad1: f32,
+    _pad2: f32,
+};
+
+@group(0) @binding(2) var<storage, read> positions: array<vec4f>;
+@group(0) @binding(3) var<storage, read_write> forces: array<f32>;
+@group(0) @binding(4) var<storage, read> edges: array<SpringEdge>;
+@group(0) @binding(5) var<storage, read_write> csr_values: array<f32>;
+@group(0) @binding(6) var<storage, read_write> diag_values: array<f32>;
+@group(0) @binding(7) var<storage, read> edge_csr_map: array<vec4u>;
+@group(0) @binding(8) var<uniform> spring_params: SpringParams;
+@group(0) @binding(9) var<storage, read> incidence_offsets: array<u32>;
+@group(0) @binding(10) var<storage, read> incidence: array<vec2u>;
+@group(0) @binding(11) var<storage, read> csr_row_ptr: array<u32>;
+
+@compute @workgroup_size(workgroup_size)
+fn cs_main(@builtin(global_invocation_id) gid: vec3u) {
+    let id = gid.x;
+    if (id >= solver.node_count) {
+        return;
+    }
+
+    if (zero_csr_rows) {
+        for (var k = csr_row_ptr[id] * 9u; k < csr_row_ptr[id + 1u] * 9u; k = k + 1u) {
+            csr_values[k] = 0.0;
+        }
+    }
+
+    let k_s = spring_params.stiffness;
+    let dt2 = physics.dt_sq;
+    var f = vec3f(0.0);
+    var d0 = vec3f(0.0);
+    var d1 = vec3f(0.0);
+    var d2 = vec3f(0.0);
+
+    for (var k = incidence_offsets[id]; k < incidence_offsets[id + 1u]; k = k + 1u) {
+        let entry = incidence[k];
+        let edge = edges[entry.x];
+        let rest_len = edge.rest_length;
+
+        let dx = positions[edge.n0].xyz - positions[edge.n1].xyz;
+        let dist = length(dx);
+        if (dist < 1e-8) {
+            continue;
+        }
+        let dir = dx / dist;
+
+        // Force on n0 is f_spring, on n1 is -f_spring
+        let f_spring = -k_s * (dist - rest_len) * dir;
+
+        // Same clamped PSD block as the scatter kernel
+        let ratio = min(rest_len / dist, 1.0);
+        let coeff_i = k_s * (1.0 - ratio);
+        let coeff_d = k_s * ratio;
+        let h0 = dt2 * (coeff_d * dir.x * dir + vec3f(coeff_i, 0.0, 0.0));
+        let h1 = dt2 * (coeff_d * dir.y * dir + vec3f(0.0, coeff_i, 0.0));
+        let h2 = dt2 * (coeff_d * dir.z * dir + vec3f(0.0, 0.0, coeff_i));
+
+        // Own row: off-diagonal block (id, other) = -dt²*h, diagonal += dt²*h
+        let mapping = edge_csr_map[entry.x];
+        var csr = mapping.x;
+        if (entry.y == 0u) {
+            f += f_spring;
+        } else {
+            f -= f_spring;
+            csr = mapping.y;
+        }
+
+        let base = csr * 9u;
+        csr_values[base + 0u] -= h0.x;
+        csr_values[base + 1u] -= h0.y;
+        csr_values[base + 2u] -= h0.z;
+        csr_values[base + 3u] -= h1.x;
+        csr_values[base + 4u] -= h1.y;
+        csr_values[base + 5u] -= h1.z;
+        csr_values[base + 6u] -= h2.x;
+        csr_values[base + 7u] -= h2.y;
+        csr_values[base + 8u] -= h2.z;
+
+        d0 += h0;
+        d1 += h1;
+        d2 += h2;
+    }
+
+    let fb = id * 4u;
+    forces[fb + 0u] += f.x;
+    forces[fb + 1u] += f.y;
+    forces[fb + 2u] += f.z;
+
+    let db = id * 9u;
+    diag_values[db + 0u] += d0.x;
+    diag_values[db + 1u] += d0.y;
+    diag_values[db + 2u] += d0.z;
+    diag_values[db + 3u] += d1.x;
+    diag_values[db + 4u] += d1.y;
+    diag_values[db + 5u] += d1.z;
+    diag_values[db + 6u] += d2.x;
+    diag_values[db + 7u] += d2.y;
+    diag_values[db + 8u] += d2.z;
+}
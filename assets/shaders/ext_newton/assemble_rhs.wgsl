@@ -1,13 +1,14 @@
 // Assemble RHS vector: b = dt * F - M * dv_total
-// Dispatch: ceil(node_count / 64) workgroups
+// Dispatch: ceil(node_count / workgroup_size) workgroups
 //
 // Newton outer loop: the RHS uses accumulated velocity delta (dv_total)
 // instead of CSR matrix-vector product against velocity.
-// Forces are f32 (accumulated via CAS-based atomic float add).
+// Forces are f32 (accumulated color by color with plain stores).
 
 #import "core_simulate/header/solver_params.wgsl"
 #import "core_simulate/header/physics_params.wgsl"
 #import "core_simulate/header/sim_mass.wgsl"
+#import "header/workgroup_size.wgsl"
 
 @group(0) @binding(0) var<uniform> physics: PhysicsParams;
 @group(0) @binding(1) var<uniform> solver: SolverParams;
@@ -17,7 +18,7 @@
 @group(0) @binding(4) var<storage, read> mass: array<SimMass>;
 @group(0) @binding(5) var<storage, read_write> rhs: array<vec4f>;
 
-@compute @workgroup_size(64)
+@compute @workgroup_size(workgroup_size)
 fn cs_main(@builtin(global_invocation_id) gid: vec3u) {
     let id = gid.x;
     if (id >= solver.node_count) {
@@ -6,9 +6,10 @@
 //   SpringTerm:   diag += dt^2 * H_diag,  offdiag += -dt^2 * H_offdiag
 //
 // No physics-specific knowledge — pure linear algebra.
-// Dispatch: ceil(node_count / 64) workgroups
+// Dispatch: ceil(node_count / workgroup_size) workgroups
 
 #import "core_simulate/header/solver_params.wgsl"
+#import "header/workgroup_size.wgsl"
 
 @group(0) @binding(0) var<uniform> solver: SolverParams;
 @group(0) @binding(1) var<storage, read> cg_p: array<vec4f>;
@@ -43,7 +44,7 @@ fn mat3_mul_vec3(m: mat3x3f, v: vec3f) -> vec3f {
     );
 }
 
-@compute @workgroup_size(64)
+@compute @workgroup_size(workgroup_size)
 fn cs_main(@builtin(global_invocation_id) gid: vec3u) {
     let id = gid.x;
     if (id >= solver.node_count) {
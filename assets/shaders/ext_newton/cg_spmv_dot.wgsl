@@ -0,0 +1,90 @@
+// Fused SpMV + dot products for pipelined CG:
+//   w = A * u
+//   partials[wg] = (sum r.u, sum w.u) over the workgroup's nodes
+// Same block-CSR product as cg_spmv.wgsl; the reductions ride along so the
+// CG iteration needs no separate dot passes.
+// Dispatch: ceil(node_count / workgroup_size) workgroups
+
+#import "core_simulate/header/solver_params.wgsl"
+#import "header/workgroup_size.wgsl"
+
+@group(0) @binding(0) var<uniform> solver: SolverParams;
+@group(0) @binding(1) var<storage, read> cg_u: array<vec4f>;
+@group(0) @binding(2) var<storage, read_write> cg_w: array<vec4f>;
+@group(0) @binding(3) var<storage, read> csr_row_ptr: array<u32>;
+@group(0) @binding(4) var<storage, read> csr_col_idx: array<u32>;
+@group(0) @binding(5) var<storage, read> csr_values: array<f32>;
+@group(0) @binding(6) var<storage, read> diag: array<f32>;
+@group(0) @binding(7) var<storage, read> cg_r: array<vec4f>;
+@group(0) @binding(8) var<storage, read_write> partials: array<vec2f>;
+
+var<workgroup> shared_data: array<vec2f, workgroup_size>;
+
+fn read_csr_block(offset: u32) -> mat3x3f {
+    return mat3x3f(
+        vec3f(csr_values[offset + 0u], csr_values[offset + 1u], csr_values[offset + 2u]),
+        vec3f(csr_values[offset + 3u], csr_values[offset + 4u], csr_values[offset + 5u]),
+        vec3f(csr_values[offset + 6u], csr_values[offset + 7u], csr_values[offset + 8u]),
+    );
+}
+
+fn read_diag_block(node: u32) -> mat3x3f {
+    let base = node * 9u;
+    return mat3x3f(
+        vec3f(diag[base + 0u], diag[base + 1u], diag[base + 2u]),
+        vec3f(diag[base + 3u], diag[base + 4u], diag[base + 5u]),
+        vec3f(diag[base + 6u], diag[base + 7u], diag[base + 8u]),
+    );
+}
+
+fn mat3_mul_vec3(m: mat3x3f, v: vec3f) -> vec3f {
+    return vec3f(
+        dot(m[0], v),
+        dot(m[1], v),
+        dot(m[2], v),
+    );
+}
+
+@compute @workgroup_size(workgroup_size)
+fn cs_main(
+    @builtin(global_invocation_id) gid: vec3u,
+    @builtin(local_invocation_id) lid: vec3u,
+    @builtin(workgroup_id) wid: vec3u,
+) {
+    let id = gid.x;
+    let local_id = lid.x;
+
+    // No early return: every invocation takes part in the reduction below
+    var val = vec2f(0.0, 0.0);
+    if (id < solver.node_count) {
+        let ui = cg_u[id].xyz;
+
+        // Diagonal: A_ii * u_i
+        var result = mat3_mul_vec3(read_diag_block(id), ui);
+
+        // Off-diagonal: sum_j A_ij * u_j
+        let row_start = csr_row_ptr[id];
+        let row_end = csr_row_ptr[id + 1u];
+        for (var idx = row_start; idx < row_end; idx = idx + 1u) {
+            let col = csr_col_idx[idx];
+            result = result + mat3_mul_vec3(read_csr_block(idx * 9u), cg_u[col].xyz);
+        }
+
+        cg_w[id] = vec4f(result, 0.0);
+        val = vec2f(dot(cg_r[id].xyz, ui), dot(result, ui));
+    }
+
+    shared_data[local_id] = val;
+    workgroupBarrier();
+
+    for (var stride = workgroup_size / 2u; stride > 0u; stride = stride >> 1u) {
+        if (local_id < stride) {
+            shared_data[local_id] = shared_data[local_id] + shared_data[local_id + stride];
+        }
+        workgroupBarrier();
+    }
+
+    if (local_id == 0u) {
+        partials[wid.x] = shared_data[0];
+    }
+}
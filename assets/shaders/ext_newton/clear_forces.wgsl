@@ -1,12 +1,13 @@
-// Clear force accumulation buffer (atomic u32 for CAS-based float atomics)
-// Dispatch: ceil(node_count / 64) workgroups
+// Clear force accumulation buffer
+// Dispatch: ceil(node_count / workgroup_size) workgroups
 
 #import "core_simulate/header/solver_params.wgsl"
+#import "header/workgroup_size.wgsl"
 
 @group(0) @binding(0) var<uniform> solver: SolverParams;
-@group(0) @binding(1) var<storage, read_write> forces: array<atomic<u32>>;
+@group(0) @binding(1) var<storage, read_write> forces: array<f32>;
 
-@compute @workgroup_size(64)
+@compute @workgroup_size(workgroup_size)
 fn cs_main(@builtin(global_invocation_id) gid: vec3u) {
     let id = gid.x;
     if (id >= solver.node_count) {
@@ -14,8 +15,8 @@ fn cs_main(@builtin(global_invocation_id) gid: vec3u) {
     }
 
     let base = id * 4u;
-    atomicStore(&forces[base + 0u], 0u);
-    atomicStore(&forces[base + 1u], 0u);
-    atomicStore(&forces[base + 2u], 0u);
-    atomicStore(&forces[base + 3u], 0u);
+    forces[base + 0u] = 0.0;
+    forces[base + 1u] = 0.0;
+    forces[base + 2u] = 0.0;
+    forces[base + 3u] = 0.0;
 }
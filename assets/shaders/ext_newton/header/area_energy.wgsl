@@ -0,0 +1,213 @@
+// FEM/SVD area preservation energy, shared by the scatter (per-face) and
+// gather (per-node) assembly kernels.
+//
+// Energy: psi = 0.5*k*(J-1)^2 + mu/2*((sigma1-1)^2 + (sigma2-1)^2)
+// where J = sigma1 * sigma2 is the area ratio from the SVD of the
+// deformation gradient F = Ds * Dm_inv.
+//
+// Forces: PK1 stress via singular value decomposition
+// Hessian: SVD-projected PSD (Teran 2005 / Smith 2019)
+
+struct AreaTriangle {
+    n0: u32,
+    n1: u32,
+    n2: u32,
+    rest_area: f32,
+    dm_inv_00: f32,
+    dm_inv_01: f32,
+    dm_inv_10: f32,
+    dm_inv_11: f32,
+};
+
+struct AreaParams {
+    stiffness: f32,        // area preservation (bulk modulus k)
+    shear_stiffness: f32,  // trace energy / shear modulus (μ)
+    _pad1: f32,
+    _pad2: f32,
+};
+
+struct FaceCSRMapping {
+    csr_01: u32,
+    csr_10: u32,
+    csr_02: u32,
+    csr_20: u32,
+    csr_12: u32,
+    csr_21: u32,
+};
+
+// Per-face forces and Hessian factors; vertex slots 0..2 map to n0..n2
+struct AreaEval {
+    valid: bool,
+    force: array<vec3f, 3>,
+    w: array<vec2f, 3>,    // wi = (dot(ci,v1), dot(ci,v2))
+    u1: vec3f,
+    u2: vec3f,
+    u3: vec3f,
+    Q00: f32,
+    Q01: f32,
+    Q11: f32,
+    a_coeff: f32,          // (lam_twist + lam_flip) / 2
+    b_coeff: f32,          // (lam_flip - lam_twist) / 2
+    lam_n1: f32,           // null-space coefficients
+    lam_n2: f32,
+    scale: f32,            // dt² * A0
+};
+
+fn evalArea(tri: AreaTriangle, x0: vec3f, x1: vec3f, x2: vec3f,
+            k: f32, mu: f32, dt2: f32) -> AreaEval {
+    var ev: AreaEval;
+    ev.valid = false;
+
+    let A0 = tri.rest_area;
+
+    // Deformed edges (3D)
+    let ds0 = x1 - x0;
+    let ds1 = x2 - x0;
+
+    // Deformation gradient F = Ds * Dm_inv (3x2, stored as two column vec3s)
+    let dm00 = tri.dm_inv_00;
+    let dm01 = tri.dm_inv_01;
+    let dm10 = tri.dm_inv_10;
+    let dm11 = tri.dm_inv_11;
+    let f0 = ds0 * dm00 + ds1 * dm10;  // F column 0
+    let f1 = ds0 * dm01 + ds1 * dm11;  // F column 1
+
+    // Cauchy-Green C = F^T * F (2x2 symmetric)
+    let c00 = dot(f0, f0);
+    let c01 = dot(f0, f1);
+    let c11 = dot(f1, f1);
+    let det_C = c00 * c11 - c01 * c01;
+
+    if (det_C < 1e-20) {
+        return ev;  // degenerate triangle
+    }
+
+    // ===== SVD via eigendecomposition of C =====
+    let half_sum = 0.5 * (c00 + c11);
+    let half_diff = 0.5 * (c00 - c11);
+    let disc = sqrt(half_diff * half_diff + c01 * c01);
+    let lam1 = max(half_sum + disc, 1e-12);  // larger eigenvalue
+    let lam2 = max(half_sum - disc, 1e-12);  // smaller eigenvalue
+
+    let sig1 = sqrt(lam1);
+    let sig2 = sqrt(lam2);
+    let J = sig1 * sig2;  // area ratio
+
+    // Eigenvectors of C -> V rotation matrix
+    // Guard atan2(0,0): when C is diagonal (c01≈0, c00≈c11), any rotation is valid.
+    // Some GPU drivers return NaN for atan2(0,0), which propagates via 0*NaN=NaN.
+    let atan_y = 2.0 * c01;
+    let atan_x = c00 - c11;
+    var theta = 0.0;
+    if (abs(atan_y) > 1e-20 || abs(atan_x) > 1e-20) {
+        theta = 0.5 * atan2(atan_y, atan_x);
+    }
+    let cos_t = cos(theta);
+    let sin_t = sin(theta);
+    let v1 = vec2f(cos_t, sin_t);
+    let v2 = vec2f(-sin_t, cos_t);
+
+    // Left singular vectors: U = F * V * Sigma^{-1}
+    let u1 = (f0 * v1.x + f1 * v1.y) / sig1;
+    let u2 = (f0 * v2.x + f1 * v2.y) / sig2;
+    let u3 = cross(u1, u2);  // triangle normal direction
+
+    // ===== Forces via PK1 stress =====
+    // Combined area + ARAP shear energy; ARAP forces are zero at rest
+    // (sigma=1), unlike trace energy.
+    let Jm1 = J - 1.0;
+    let p1 = k * Jm1 * sig2 + mu * (sig1 - 1.0);
+    let p2 = k * Jm1 * sig1 + mu * (sig2 - 1.0);
+
+    // P = U * diag(p1,p2) * V^T  (3x2 PK1 stress)
+    let P0 = u1 * (p1 * v1.x) + u2 * (p2 * v2.x);  // column 0
+    let P1 = u1 * (p1 * v1.y) + u2 * (p2 * v2.y);  // column 1
+
+    // Vertex forces = -A0 * P * Dm_inv^T
+    // ci vectors (rows of Dm_inv for each vertex)
+    let ci1 = vec2f(dm00, dm01);  // row 0 -> vertex 1 (n1)
+    let ci2 = vec2f(dm10, dm11);  // row 1 -> vertex 2 (n2)
+    let ci0 = -(ci1 + ci2);      // vertex 0 (n0)
+
+    ev.force[0] = -A0 * (P0 * ci0.x + P1 * ci0.y);
+    ev.force[1] = -A0 * (P0 * ci1.x + P1 * ci1.y);
+    ev.force[2] = -A0 * (P0 * ci2.x + P1 * ci2.y);
+
+    // ===== SVD-Projected PSD Hessian =====
+    // Stretch Hessian in singular value space (2x2)
+    // Combined area + trace: d²ψ/dσᵢdσⱼ includes +μ on diagonal
+    let h11 = k * sig2 * sig2 + mu;
+    let h22 = k * sig1 * sig1 + mu;
+    let h12 = k * (2.0 * J - 1.0);
+
+    // PSD clamp: eigendecompose the 2x2 stretch Hessian
+    let s_half_sum = 0.5 * (h11 + h22);
+    let s_half_diff = 0.5 * (h11 - h22);
+    let s_disc = sqrt(s_half_diff * s_half_diff + h12 * h12);
+    let s_lam1 = max(s_half_sum + s_disc, 0.0);
+    let s_lam2 = max(s_half_sum - s_disc, 0.0);
+
+    // Reconstruct clamped Q = R * diag(s_lam) * R^T
+    // Guard atan2(0,0) — same GPU driver issue as SVD theta above.
+    let s_atan_y = 2.0 * h12;
+    let s_atan_x = h11 - h22;
+    var s_theta = 0.0;
+    if (abs(s_atan_y) > 1e-20 || abs(s_atan_x) > 1e-20) {
+        s_theta = 0.5 * atan2(s_atan_y, s_atan_x);
+    }
+    let sc = cos(s_theta);
+    let ss = sin(s_theta);
+    ev.Q00 = sc * sc * s_lam1 + ss * ss * s_lam2;
+    ev.Q01 = sc * ss * (s_lam1 - s_lam2);
+    ev.Q11 = ss * ss * s_lam1 + sc * sc * s_lam2;
+
+    // Twist: (p1-p2)/(sig1-sig2) = -k*(J-1) + μ
+    // Flip:  (p1+p2)/(sig1+sig2) = k*(J-1) + μ  (trace energy approximation)
+    let lam_twist = max(-k * Jm1 + mu, 0.0);
+    let lam_flip = max(k * Jm1 + mu, 0.0);
+
+    // Null-space (u3 direction): p_i/sigma_i → 0 at rest.
+    // No artificial floor — area energy has no bending stiffness.
+    ev.lam_n1 = select(0.0, max(p1 / sig1, 0.0), sig1 > 1e-8);
+    ev.lam_n2 = select(0.0, max(p2 / sig2, 0.0), sig2 > 1e-8);
+
+    ev.a_coeff = 0.5 * (lam_twist + lam_flip);
+    ev.b_coeff = 0.5 * (lam_flip - lam_twist);
+
+    ev.w[0] = vec2f(dot(ci0, v1), dot(ci0, v2));
+    ev.w[1] = vec2f(dot(ci1, v1), dot(ci1, v2));
+    ev.w[2] = vec2f(dot(ci2, v1), dot(ci2, v2));
+
+    ev.u1 = u1;
+    ev.u2 = u2;
+    ev.u3 = u3;
+    ev.scale = dt2 * A0;
+    ev.valid = true;
+    return ev;
+}
+
+// 3x3 Hessian block for vertex pair (i,j), returned as its three rows.
+fn areaBlock(ev: AreaEval, wi: vec2f, wj: vec2f) -> array<vec3f, 3> {
+    let A1 = wi.x * wj.x;
+    let A2 = wi.x * wj.y;
+    let A3 = wi.y * wj.x;
+    let A4 = wi.y * wj.y;
+
+    // Combined coefficients for each rank-1 basis
+    let c11 = ev.Q00 * A1 + ev.a_coeff * A4;
+    let c12 = ev.Q01 * A2 + ev.b_coeff * A3;
+    let c21 = ev.Q01 * A3 + ev.b_coeff * A2;
+    let c22 = ev.Q11 * A4 + ev.a_coeff * A1;
+    let c33 = ev.lam_n1 * A1 + ev.lam_n2 * A4;
+
+    // H = scale * (c11*u1*u1^T + c12*u1*u2^T + c21*u2*u1^T + c22*u2*u2^T + c33*u3*u3^T)
+    let row1 = c11 * ev.u1 + c12 * ev.u2;
+    let row2 = c21 * ev.u1 + c22 * ev.u2;
+    let row3 = c33 * ev.u3;
+
+    // For each spatial row m: H[m,:] = scale * (u1[m]*row1 + u2[m]*row2 + u3[m]*row3)
+    return array<vec3f, 3>(
+        ev.scale * (ev.u1.x * row1 + ev.u2.x * row2 + ev.u3.x * row3),
+        ev.scale * (ev.u1.y * row1 + ev.u2.y * row2 + ev.u3.y * row3),
+        ev.scale * (ev.u1.z * row1 + ev.u2.z * row2 + ev.u3.z * row3));
+}
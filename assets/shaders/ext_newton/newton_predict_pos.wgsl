@@ -1,9 +1,10 @@
 // Newton predict positions: x_temp = x_old + dt * (v + dv_total)
-// Dispatch: ceil(node_count / 64) workgroups
+// Dispatch: ceil(node_count / workgroup_size) workgroups
 
 #import "core_simulate/header/solver_params.wgsl"
 #import "core_simulate/header/physics_params.wgsl"
 #import "core_simulate/header/sim_mass.wgsl"
+#import "header/workgroup_size.wgsl"
 
 @group(0) @binding(0) var<uniform> physics: PhysicsParams;
 @group(0) @binding(1) var<uniform> solver: SolverParams;
@@ -14,7 +15,7 @@
 @group(0) @binding(5) var<storage, read> dv_total: array<vec4f>;
 @group(0) @binding(6) var<storage, read> mass: array<SimMass>;
 
-@compute @workgroup_size(64)
+@compute @workgroup_size(workgroup_size)
 fn cs_main(@builtin(global_invocation_id) gid: vec3u) {
     let id = gid.x;
     if (id >= solver.node_count) {
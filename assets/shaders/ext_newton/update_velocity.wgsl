@@ -1,5 +1,5 @@
 // Update velocity: v = (v + dv_total) * damping (for free nodes)
-// Dispatch: ceil(node_count / 64) workgroups
+// Dispatch: ceil(node_count / workgroup_size) workgroups
 //
 // dv_total contains the accumulated Newton velocity delta.
 // Pinned nodes (inv_mass == 0) have velocity set to zero.
@@ -7,6 +7,7 @@
 #import "core_simulate/header/solver_params.wgsl"
 #import "core_simulate/header/physics_params.wgsl"
 #import "core_simulate/header/sim_mass.wgsl"
+#import "header/workgroup_size.wgsl"
 
 @group(0) @binding(0) var<uniform> physics: PhysicsParams;
 @group(0) @binding(1) var<uniform> solver: SolverParams;
@@ -15,7 +16,7 @@
 @group(0) @binding(3) var<storage, read> dv_total: array<vec4f>;
 @group(0) @binding(4) var<storage, read> mass: array<SimMass>;
 
-@compute @workgroup_size(64)
+@compute @workgroup_size(workgroup_size)
 fn cs_main(@builtin(global_invocation_id) gid: vec3u) {
     let id = gid.x;
     if (id >= solver.node_count) {
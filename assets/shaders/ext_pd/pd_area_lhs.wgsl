@@ -1,5 +1,5 @@
 // PD Area LHS: Constant system matrix assembly (w * S^T * S for triangles)
-// Dispatch: ceil(face_count / 64) workgroups
+// Dispatch: ceil(face_count / workgroup_size) workgroups
 //
 // For each triangle (n0,n1,n2) with weight w = stiffness * rest_area:
 //   The selection matrix S maps vertex positions to deformation gradient
@@ -18,6 +18,7 @@
 
 #import "core_simulate/header/solver_params.wgsl"
 #import "core_simulate/header/atomic_float.wgsl"
+#import "header/workgroup_size.wgsl"
 
 struct AreaTriangle {
     n0: u32,
@@ -69,7 +70,7 @@ fn atomicAddCSRScalar(csr_idx: u32, val: f32) {
     atomicAddFloat(&csr_values[base + 8u], val);
 }
 
-@compute @workgroup_size(64)
+@compute @workgroup_size(workgroup_size)
 fn cs_main(@builtin(global_invocation_id) gid: vec3u) {
     let fid = gid.x;
     if (fid >= solver.face_count) {
@@ -1,5 +1,6 @@
 // PD Area Fused: ARAP Local Projection + RHS Assembly
-// Dispatch: ceil(face_count / 64) workgroups
+// Dispatch: once per face color, ceil(color.count / workgroup_size) workgroups.
+// Faces within a color share no nodes, so the RHS scatter uses plain stores.
 //
 // For each triangle (n0,n1,n2) with weight w = stiffness * rest_area:
 //   1. Compute deformation gradient F = Ds * Dm_inv (3x2)
@@ -8,7 +9,8 @@
 // Eliminates the intermediate projection buffer.
 
 #import "core_simulate/header/solver_params.wgsl"
-#import "core_simulate/header/atomic_float.wgsl"
+#import "core_simulate/header/color_range.wgsl"
+#import "header/workgroup_size.wgsl"
 
 struct AreaTriangle {
     n0: u32,
@@ -31,15 +33,16 @@ struct AreaParams {
 @group(0) @binding(0) var<uniform> solver: SolverParams;
 @group(0) @binding(1) var<storage, read> triangles: array<AreaTriangle>;
 @group(0) @binding(2) var<storage, read> q: array<vec4f>;
-@group(0) @binding(3) var<storage, read_write> rhs: array<atomic<u32>>;
+@group(0) @binding(3) var<storage, read_write> rhs: array<f32>;
 @group(0) @binding(4) var<uniform> area_params: AreaParams;
+@group(0) @binding(5) var<uniform> color: ColorRange;
 
-@compute @workgroup_size(64)
+@compute @workgroup_size(workgroup_size)
 fn cs_main(@builtin(global_invocation_id) gid: vec3u) {
-    let fid = gid.x;
-    if (fid >= solver.face_count) {
+    if (gid.x >= color.count) {
         return;
     }
+    let fid = color.offset + gid.x;
 
     let tri = triangles[fid];
     let na = tri.n0;
@@ -119,17 +122,17 @@ fn cs_main(@builtin(global_invocation_id) gid: vec3u) {
 
     // Scatter to RHS
     let base_a = na * 4u;
-    atomicAddFloat(&rhs[base_a + 0u], contrib0.x);
-    atomicAddFloat(&rhs[base_a + 1u], contrib0.y);
-    atomicAddFloat(&rhs[base_a + 2u], contrib0.z);
+    rhs[base_a + 0u] += contrib0.x;
+    rhs[base_a + 1u] += contrib0.y;
+    rhs[base_a + 2u] += contrib0.z;
 
     let base_b = nb * 4u;
-    atomicAddFloat(&rhs[base_b + 0u], contrib1.x);
-    atomicAddFloat(&rhs[base_b + 1u], contrib1.y);
-    atomicAddFloat(&rhs[base_b + 2u], contrib1.z);
+    rhs[base_b + 0u] += contrib1.x;
+    rhs[base_b + 1u] += contrib1.y;
+    rhs[base_b + 2u] += contrib1.z;
 
     let base_c = nc * 4u;
-    atomicAddFloat(&rhs[base_c + 0u], contrib2.x);
-    atomicAddFloat(&rhs[base_c + 1u], contrib2.y);
-    atomicAddFloat(&rhs[base_c + 2u], contrib2.z);
+    rhs[base_c + 0u] += contrib2.x;
+    rhs[base_c + 1u] += contrib2.y;
+    rhs[base_c + 2u] += contrib2.z;
 }
@@ -1,15 +1,16 @@
 // Compute D_inv: inverse of each 3x3 diagonal block
 // Uses adjugate/determinant method for 3x3 matrix inverse.
 // If determinant is near zero (< 1e-20), writes identity matrix.
-// Dispatch: ceil(node_count / 64) workgroups
+// Dispatch: ceil(node_count / workgroup_size) workgroups
 
 #import "core_simulate/header/solver_params.wgsl"
+#import "header/workgroup_size.wgsl"
 
 @group(0) @binding(0) var<uniform> solver: SolverParams;
 @group(0) @binding(1) var<storage, read> diag: array<f32>;
 @group(0) @binding(2) var<storage, read_write> d_inv: array<f32>;
 
-@compute @workgroup_size(64)
+@compute @workgroup_size(workgroup_size)
 fn cs_main(@builtin(global_invocation_id) gid: vec3u) {
     let id = gid.x;
     if (id >= solver.node_count) {
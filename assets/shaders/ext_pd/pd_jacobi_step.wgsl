@@ -1,7 +1,7 @@
 // Fused off-diagonal SpMV + Jacobi + Chebyshev step for Projective Dynamics.
 // Combines: offdiag = (A-D)*q_curr, z = D⁻¹*(b-offdiag), q_new = ω*(z-q_prev)+q_prev
 // Eliminates the intermediate temp buffer.
-// Dispatch: ceil(node_count / 64) workgroups
+// Dispatch: ceil(node_count / workgroup_size) workgroups
 
 struct JacobiParams {
     omega: f32,
@@ -12,6 +12,7 @@ struct JacobiParams {
 
 #import "core_simulate/header/solver_params.wgsl"
 #import "core_simulate/header/sim_mass.wgsl"
+#import "header/workgroup_size.wgsl"
 
 @group(0) @binding(0) var<uniform> solver: SolverParams;
 @group(0) @binding(1) var<storage, read> q_curr: array<vec4f>;
@@ -50,7 +51,7 @@ fn mat3_mul_vec3(m: mat3x3f, v: vec3f) -> vec3f {
     );
 }
 
-@compute @workgroup_size(64)
+@compute @workgroup_size(workgroup_size)
 fn cs_main(@builtin(global_invocation_id) gid: vec3u) {
     let id = gid.x;
     if (id >= solver.node_count) {
@@ -59,9 +60,10 @@ fn cs_main(@builtin(global_invocation_id) gid: vec3u) {
 
     let inv_mass = mass[id].inv_mass;
 
-    // Pinned nodes: keep predicted position
+    // Pinned nodes: keep predicted position (every iterate holds s for them, and
+    // q_prev is not yet written on the first step)
     if (inv_mass <= 0.0) {
-        q_new[id] = q_prev[id];
+        q_new[id] = q_curr[id];
         return;
     }
 
@@ -1,5 +1,5 @@
 // PD Spring LHS: Constant system matrix assembly (w * S^T * S)
-// Dispatch: ceil(edge_count / 64) workgroups
+// Dispatch: ceil(edge_count / workgroup_size) workgroups
 //
 // For each spring edge (a,b) with weight w = stiffness:
 //   S = [I, -I] maps 2-node positions to relative displacement
@@ -14,6 +14,7 @@
 
 #import "core_simulate/header/solver_params.wgsl"
 #import "core_simulate/header/atomic_float.wgsl"
+#import "header/workgroup_size.wgsl"
 
 struct SpringEdge {
     n0: u32,
@@ -35,7 +36,7 @@ struct SpringParams {
 @group(0) @binding(4) var<storage, read> edge_csr_map: array<vec4u>;
 @group(0) @binding(5) var<uniform> spring_params: SpringParams;
 
-@compute @workgroup_size(64)
+@compute @workgroup_size(workgroup_size)
 fn cs_main(@builtin(global_invocation_id) gid: vec3u) {
     let eid = gid.x;
     if (eid >= solver.edge_count) {
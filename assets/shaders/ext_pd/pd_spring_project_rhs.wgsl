@@ -1,5 +1,6 @@
 // PD Spring Fused: Local Projection + RHS Assembly
-// Dispatch: ceil(edge_count / 64) workgroups
+// Dispatch: once per edge color, ceil(color.count / workgroup_size) workgroups.
+// Edges within a color share no nodes, so the RHS scatter uses plain stores.
 //
 // For each edge (a,b) with weight w = stiffness:
 //   1. Compute projection: p = rest_length * normalize(q[a] - q[b])
@@ -7,7 +8,8 @@
 // Eliminates the intermediate projection buffer.
 
 #import "core_simulate/header/solver_params.wgsl"
-#import "core_simulate/header/atomic_float.wgsl"
+#import "core_simulate/header/color_range.wgsl"
+#import "header/workgroup_size.wgsl"
 
 struct SpringEdge {
     n0: u32,
@@ -25,15 +27,16 @@ struct SpringParams {
 @group(0) @binding(0) var<uniform> solver: SolverParams;
 @group(0) @binding(1) var<storage, read> edges: array<SpringEdge>;
 @group(0) @binding(2) var<storage, read> q: array<vec4f>;
-@group(0) @binding(3) var<storage, read_write> rhs: array<atomic<u32>>;
+@group(0) @binding(3) var<storage, read_write> rhs: array<f32>;
 @group(0) @binding(4) var<uniform> spring_params: SpringParams;
+@group(0) @binding(5) var<uniform> color: ColorRange;
 
-@compute @workgroup_size(64)
+@compute @workgroup_size(workgroup_size)
 fn cs_main(@builtin(global_invocation_id) gid: vec3u) {
-    let eid = gid.x;
-    if (eid >= solver.edge_count) {
+    if (gid.x >= color.count) {
         return;
     }
+    let eid = color.offset + gid.x;
 
     let edge = edges[eid];
     let a = edge.n0;
@@ -56,12 +59,12 @@ fn cs_main(@builtin(global_invocation_id) gid: vec3u) {
 
     // Scatter to RHS: rhs[a] += w*p, rhs[b] -= w*p
     let base_a = a * 4u;
-    atomicAddFloat(&rhs[base_a + 0u], wp.x);
-    atomicAddFloat(&rhs[base_a + 1u], wp.y);
-    atomicAddFloat(&rhs[base_a + 2u], wp.z);
+    rhs[base_a + 0u] += wp.x;
+    rhs[base_a + 1u] += wp.y;
+    rhs[base_a + 2u] += wp.z;
 
     let base_b = b * 4u;
-    atomicAddFloat(&rhs[base_b + 0u], -wp.x);
-    atomicAddFloat(&rhs[base_b + 1u], -wp.y);
-    atomicAddFloat(&rhs[base_b + 2u], -wp.z);
+    rhs[base_b + 0u] -= wp.x;
+    rhs[base_b + 1u] -= wp.y;
+    rhs[base_b + 2u] -= wp.z;
 }
@@ -1,5 +1,5 @@
 // Update position: pos = x_old + vel * dt (for free nodes)
-// Dispatch: ceil(node_count / 64) workgroups
+// Dispatch: ceil(node_count / workgroup_size) workgroups
 //
 // Uses x_old (saved at PD init) as base position.
 // Velocity already includes damping from pd_update_velocity.
@@ -8,6 +8,7 @@
 #import "core_simulate/header/solver_params.wgsl"
 #import "core_simulate/header/physics_params.wgsl"
 #import "core_simulate/header/sim_mass.wgsl"
+#import "header/workgroup_size.wgsl"
 
 @group(0) @binding(0) var<uniform> physics: PhysicsParams;
 @group(0) @binding(1) var<uniform> solver: SolverParams;
@@ -17,7 +18,7 @@
 @group(0) @binding(4) var<storage, read> velocities: array<vec4f>;
 @group(0) @binding(5) var<storage, read> mass: array<SimMass>;
 
-@compute @workgroup_size(64)
+@compute @workgroup_size(workgroup_size)
 fn cs_main(@builtin(global_invocation_id) gid: vec3u) {
     let id = gid.x;
     if (id >= solver.node_count) {
@@ -0,0 +1,4 @@
+// Workgroup size of the including compute shader. Pipelines specialize it with
+// the "workgroup_size" constant (ComputePipelineDesc::SetWorkgroupSize); kernels
+// that reduce across the workgroup require a power of two.
+override workgroup_size: u32 = 64u;
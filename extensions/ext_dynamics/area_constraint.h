@@ -11,6 +11,7 @@ using namespace mps;
 // Triangle topology is stored as ArrayStorage<AreaTriangle> on the same entity.
 struct AreaConstraintData {
     float32 stiffness = 1.0f;
+    uint32 assembly_mode = 0;   // Newton: 0 = scatter (colored), 1 = gather (per-node)
 };
 
 }  // namespace ext_dynamics
@@ -18,8 +18,8 @@ using namespace mps::database;
 namespace ext_dynamics {
 
 uint32 BuildSpringConstraints(Database& db, Entity mesh_entity, float32 stiffness) {
-    const auto* positions = db.GetArray<SimPosition>(mesh_entity);
-    const auto* faces = db.GetArray<ext_mesh::MeshFace>(mesh_entity);
+    auto positions = db.GetArray<SimPosition>(mesh_entity);
+    auto faces = db.GetArray<ext_mesh::MeshFace>(mesh_entity);
     if (!positions || !faces) return 0;
 
     // Extract unique edges from face topology
@@ -66,8 +66,8 @@ uint32 BuildSpringConstraints(Database& db, Entity mesh_entity, float32 stiffnes
 }
 
 uint32 BuildAreaConstraints(Database& db, Entity mesh_entity, float32 stiffness) {
-    const auto* positions = db.GetArray<SimPosition>(mesh_entity);
-    const auto* faces = db.GetArray<ext_mesh::MeshFace>(mesh_entity);
+    auto positions = db.GetArray<SimPosition>(mesh_entity);
+    auto faces = db.GetArray<ext_mesh::MeshFace>(mesh_entity);
     if (!positions || !faces) return 0;
 
     std::vector<AreaTriangle> triangles;
@@ -38,6 +38,11 @@ void DynamicsExtension::Register(System& system) {
     system.RegisterArray<SimMass>(
         gpu::BufferUsage::None, "sim_mass");
 
+    // Node-aligned regions let scoped solvers bind their mesh in place (no copies)
+    system.SetArrayRegionAlignment<SimPosition>(kNodeRegionAlignment);
+    system.SetArrayRegionAlignment<SimVelocity>(kNodeRegionAlignment);
+    system.SetArrayRegionAlignment<SimMass>(kNodeRegionAlignment, SimMass{0.0f, 0.0f});
+
     // Register indexed arrays (topology with auto-offset relative to SimPosition)
     system.RegisterIndexedArray<SpringEdge, SimPosition>(
         gpu::BufferUsage::None, "spring_edges",
@@ -0,0 +1,154 @@
+#include "ext_dynamics/host_node_state.h"
+#include "core_simulate/sim_components.h"
+#include "core_system/system.h"
+#include "core_database/database.h"
+#include "core_gpu/gpu_core.h"
+#include "core_gpu/staging_belt.h"
+#include "core_util/logger.h"
+
+using namespace mps;
+using namespace mps::util;
+using namespace mps::simulate;
+using namespace mps::database;
+
+namespace ext_dynamics {
+
+// Copy one entity's arrays into state starting at node index base
+static void GatherEntity(const Database& db, Entity entity, uint32 base, HostNodeState& state) {
+    auto positions = db.GetArray<SimPosition>(entity);
+    auto velocities = db.GetArray<SimVelocity>(entity);
+    auto masses = db.GetArray<SimMass>(entity);
+    if (!positions) return;
+
+    uint32 count = static_cast<uint32>(positions->size());
+    for (uint32 i = 0; i < count && base + i < state.GetNodeCount(); ++i) {
+        uint32 n = base + i;
+        const SimPosition& p = (*positions)[i];
+        state.positions.x[n] = p.x;
+        state.positions.y[n] = p.y;
+        state.positions.z[n] = p.z;
+        state.position_w[n] = p.w;
+
+        if (velocities && i < velocities->size()) {
+            const SimVelocity& v = (*velocities)[i];
+            state.velocities.x[n] = v.vx;
+            state.velocities.y[n] = v.vy;
+            state.velocities.z[n] = v.vz;
+        }
+
+        SimMass m = (masses && i < masses->size()) ? (*masses)[i] : SimMass{};
+        state.mass[n] = m.mass;
+        state.inv_mass[n] = m.inv_mass;
+    }
+}
+
+// Write node indices [base, base + count) of state back to one entity's arrays.
+// Velocities are only written where the entity already has a matching array, so the
+// array layout never changes.
+static void StoreEntity(Database& db, Entity entity, uint32 base, const HostNodeState& state) {
+    auto existing = db.GetArray<SimPosition>(entity);
+    if (!existing) return;
+    uint32 count = static_cast<uint32>(existing->size());
+    if (base > state.GetNodeCount() || count > state.GetNodeCount() - base) return;
+
+    std::vector<SimPosition> positions(count);
+    for (uint32 i = 0; i < count; ++i) {
+        uint32 n = base + i;
+        positions[i] = {state.positions.x[n], state.positions.y[n], state.positions.z[n],
+                        state.position_w[n]};
+    }
+    db.DirectSetArray<SimPosition>(entity, positions);
+
+    auto old_velocities = db.GetArray<SimVelocity>(entity);
+    if (!old_velocities || old_velocities->size() != count) return;
+    std::vector<SimVelocity> velocities(old_velocities->begin(), old_velocities->end());
+    for (uint32 i = 0; i < count; ++i) {
+        uint32 n = base + i;
+        velocities[i].vx = state.velocities.x[n];
+        velocities[i].vy = state.velocities.y[n];
+        velocities[i].vz = state.velocities.z[n];
+    }
+    db.DirectSetArray<SimVelocity>(entity, velocities);
+}
+
+bool GatherHostNodes(const system::System& system, Entity mesh_entity, HostNodeState& state) {
+    const auto& db = system.GetDatabase();
+    const auto* storage = db.GetArrayStorageById(GetComponentTypeId<SimPosition>());
+    if (!storage) return false;
+
+    uint32 node_count = 0;
+    if (mesh_entity != kInvalidEntity) {
+        node_count = storage->GetArrayCount(mesh_entity);
+    } else {
+        node_count = system.GetArrayTotalCount<SimPosition>();
+    }
+    if (node_count == 0) return false;
+
+    // Gap nodes between regions match the DeviceDB padding: zero and pinned
+    state.positions.Assign(node_count);
+    state.velocities.Assign(node_count);
+    state.position_w.assign(node_count, 0.0f);
+    state.mass.assign(node_count, 0.0f);
+    state.inv_mass.assign(node_count, 0.0f);
+
+    if (mesh_entity != kInvalidEntity) {
+        GatherEntity(db, mesh_entity, 0, state);
+        return true;
+    }
+
+    auto* entry = system.GetArrayEntryById(GetComponentTypeId<SimPosition>());
+    if (!entry) return false;
+    for (Entity entity : storage->GetEntities()) {
+        uint32 offset = entry->GetEntityOffset(entity);
+        if (offset == UINT32_MAX) continue;
+        GatherEntity(db, entity, offset, state);
+    }
+    return true;
+}
+
+// Host-only System: the Database is the only copy of the node state
+static void StoreHostNodes(system::System& system, Entity mesh_entity, const HostNodeState& state) {
+    auto& db = system.GetDatabase();
+    if (mesh_entity != kInvalidEntity) {
+        StoreEntity(db, mesh_entity, 0, state);
+        return;
+    }
+
+    const auto* storage = db.GetArrayStorageById(GetComponentTypeId<SimPosition>());
+    auto* entry = system.GetArrayEntryById(GetComponentTypeId<SimPosition>());
+    if (!storage || !entry) return;
+    std::vector<Entity> entities = storage->GetEntities();   // storage is rewritten below
+    for (Entity entity : entities) {
+        uint32 offset = entry->GetEntityOffset(entity);
+        if (offset == UINT32_MAX) continue;
+        StoreEntity(db, entity, offset, state);
+    }
+}
+
+void PublishHostNodes(system::System& system, Entity mesh_entity, uint32 node_offset,
+                      const HostNodeState& state) {
+    uint32 n = state.GetNodeCount();
+    if (n == 0) return;
+    if (system.IsHostOnly()) {
+        StoreHostNodes(system, mesh_entity, state);
+        return;
+    }
+    if (!gpu::GPUCore::GetInstance().IsInitialized()) return;
+
+    // Interleave straight into staging memory
+    auto& belt = gpu::StagingBelt::GetInstance();
+    auto* positions = reinterpret_cast<SimPosition*>(
+        belt.Allocate(system.GetDeviceBuffer<SimPosition>(), uint64(node_offset) * sizeof(SimPosition),
+                      uint64(n) * sizeof(SimPosition)).data());
+    auto* velocities = reinterpret_cast<SimVelocity*>(
+        belt.Allocate(system.GetDeviceBuffer<SimVelocity>(), uint64(node_offset) * sizeof(SimVelocity),
+                      uint64(n) * sizeof(SimVelocity)).data());
+    for (uint32 i = 0; i < n; ++i) {
+        positions[i] = {state.positions.x[i], state.positions.y[i], state.positions.z[i],
+                        state.position_w[i]};
+        velocities[i] = {state.velocities.x[i], state.velocities.y[i], state.velocities.z[i], 0.0f};
+    }
+    belt.Flush();
+}
+
+}  // namespace ext_dynamics
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "core_simulate/host_cg_solver.h"
+#include "core_database/entity.h"
+#include "core_util/types.h"
+#include <vector>
+
+namespace mps { namespace system { class System; } }
+
+namespace ext_dynamics {
+
+// Node state of a CPU-backend system in structure-of-arrays layout.
+// Node i corresponds to node (node_offset + i) of the DeviceDB node buffers.
+struct HostNodeState {
+    mps::simulate::HostVec3Array positions;
+    mps::simulate::HostVec3Array velocities;
+    std::vector<mps::float32> position_w;   // carried through unchanged when publishing
+    std::vector<mps::float32> mass;
+    std::vector<mps::float32> inv_mass;     // 0 = pinned
+
+    [[nodiscard]] mps::uint32 GetNodeCount() const { return positions.GetCount(); }
+};
+
+// Read the initial node state from the host Database.
+// mesh_entity == kInvalidEntity gathers every SimPosition entity at its DeviceDB
+// offset (global mode; gap nodes stay zero-mass and pinned), otherwise only that
+// entity's nodes (scoped mode). Returns false if there are no nodes.
+bool GatherHostNodes(const mps::system::System& system, mps::database::Entity mesh_entity,
+                     HostNodeState& state);
+
+// Publish the CPU result. With a GPU device, positions and velocities are written
+// into the DeviceDB node buffers starting at node_offset (so rendering sees them).
+// On a host-only System they are written back into the host Database's SimPosition /
+// SimVelocity arrays instead (mesh_entity as for GatherHostNodes), without recording
+// a transaction.
+void PublishHostNodes(mps::system::System& system, mps::database::Entity mesh_entity,
+                      mps::uint32 node_offset, const HostNodeState& state);
+
+}  // namespace ext_dynamics
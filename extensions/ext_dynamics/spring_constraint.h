@@ -11,6 +11,7 @@ using namespace mps;
 // Edge topology is stored as ArrayStorage<SpringEdge> on the same entity.
 struct SpringConstraintData {
     float32 stiffness = 500.0f;
+    uint32 assembly_mode = 0;   // Newton: 0 = scatter (colored), 1 = gather (per-node)
 };
 
 }  // namespace ext_dynamics
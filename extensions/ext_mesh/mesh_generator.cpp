@@ -1,12 +1,14 @@
 #include "ext_mesh/mesh_generator.h"
 #include "ext_mesh/mesh_types.h"
 #include "ext_mesh/mesh_component.h"
+#include "ext_mesh/obj_parser.h"
 #include "core_gpu/asset_path.h"
 #include "core_database/database.h"
 #include "core_simulate/sim_components.h"
+#include "core_util/logger.h"
+#include "core_util/mapped_file.h"
+#include "core_util/thread_pool.h"
 #include <cmath>
-#include <fstream>
-#include <sstream>
 #include <string>
 #include <vector>
 #include <algorithm>
@@ -96,65 +98,26 @@ MeshResult CreateGrid(Database& db,
     return result;
 }
 
-// Parse a vertex index from an OBJ face token ("v", "v/vt", "v/vt/vn", "v//vn")
-static uint32 ParseVertexIndex(const std::string& token, uint32 vertex_count) {
-    auto slash_pos = token.find('/');
-    std::string v_str = (slash_pos != std::string::npos) ? token.substr(0, slash_pos) : token;
-    int idx = std::stoi(v_str);
-    if (idx < 0) {
-        return static_cast<uint32>(static_cast<int>(vertex_count) + idx);
-    }
-    return static_cast<uint32>(idx - 1);
-}
+// Faces per ThreadPool chunk in the import mass pass
+static constexpr uint32 kImportFaceGrain = 4096;
 
 MeshResult ImportOBJ(Database& db, const std::string& filepath, float32 scale,
                      util::vec3 offset, float32 density) {
     MeshResult result;
 
     auto full_path = gpu::ResolveAssetPath("objs/" + filepath);
-    std::ifstream file(full_path);
-    if (!file.is_open()) {
+    util::MappedFile file(full_path);
+    if (!file.IsOpen()) {
         return result;
     }
 
-    std::vector<SimPosition> positions;
-    std::vector<MeshFace> faces;
-
-    std::string line;
-    while (std::getline(file, line)) {
-        if (line.empty() || line[0] == '#') continue;
-
-        std::istringstream iss(line);
-        std::string prefix;
-        iss >> prefix;
-
-        if (prefix == "v") {
-            float32 x = 0.0f, y = 0.0f, z = 0.0f;
-            iss >> x >> y >> z;
-            SimPosition pos;
-            pos.x = x * scale + offset.x;
-            pos.y = y * scale + offset.y;
-            pos.z = z * scale + offset.z;
-            pos.w = 0.0f;
-            positions.push_back(pos);
-        } else if (prefix == "f") {
-            std::vector<uint32> indices;
-            std::string token;
-            while (iss >> token) {
-                indices.push_back(ParseVertexIndex(token, static_cast<uint32>(positions.size())));
-            }
-
-            // Triangulate: first triangle + fan for quads/polygons
-            for (uint32 i = 1; i + 1 < static_cast<uint32>(indices.size()); ++i) {
-                MeshFace face;
-                face.n0 = indices[0];
-                face.n1 = indices[i];
-                face.n2 = indices[i + 1];
-                faces.push_back(face);
-            }
-        }
-        // Skip vn, vt, mtllib, usemtl, g, o, s, and other lines
+    OBJMesh mesh;
+    if (!ParseOBJ(file.GetView(), scale, offset, mesh)) {
+        util::LogError("ImportOBJ: failed to parse ", full_path);
+        return result;
     }
+    auto& positions = mesh.positions;
+    auto& faces = mesh.faces;
 
     if (positions.empty() || faces.empty()) {
         return result;
@@ -162,36 +125,45 @@ MeshResult ImportOBJ(Database& db, const std::string& filepath, float32 scale,
 
     uint32 node_count = static_cast<uint32>(positions.size());
     uint32 face_count = static_cast<uint32>(faces.size());
+    auto& pool = util::ThreadPool::GetInstance();
+
+    // Compute area-weighted mass per vertex. Triangle areas are computed in parallel;
+    // the scatter stays sequential in face order so vertex sums are reproducible.
+    std::vector<float32> face_share(face_count);
+    pool.ParallelFor(face_count, kImportFaceGrain, [&](uint32 begin, uint32 end) {
+        for (uint32 f = begin; f < end; ++f) {
+            const auto& face = faces[f];
+            const auto& p0 = positions[face.n0];
+            const auto& p1 = positions[face.n1];
+            const auto& p2 = positions[face.n2];
+
+            float32 e1x = p1.x - p0.x, e1y = p1.y - p0.y, e1z = p1.z - p0.z;
+            float32 e2x = p2.x - p0.x, e2y = p2.y - p0.y, e2z = p2.z - p0.z;
+
+            float32 cx = e1y * e2z - e1z * e2y;
+            float32 cy = e1z * e2x - e1x * e2z;
+            float32 cz = e1x * e2y - e1y * e2x;
+            float32 tri_area = 0.5f * std::sqrt(cx * cx + cy * cy + cz * cz);
+            face_share[f] = tri_area / 3.0f;
+        }
+    });
 
-    // Compute area-weighted mass per vertex
-    std::vector<SimMass> masses(node_count);
     std::vector<float32> vertex_area(node_count, 0.0f);
-
-    for (const auto& face : faces) {
-        const auto& p0 = positions[face.n0];
-        const auto& p1 = positions[face.n1];
-        const auto& p2 = positions[face.n2];
-
-        float32 e1x = p1.x - p0.x, e1y = p1.y - p0.y, e1z = p1.z - p0.z;
-        float32 e2x = p2.x - p0.x, e2y = p2.y - p0.y, e2z = p2.z - p0.z;
-
-        float32 cx = e1y * e2z - e1z * e2y;
-        float32 cy = e1z * e2x - e1x * e2z;
-        float32 cz = e1x * e2y - e1y * e2x;
-        float32 tri_area = 0.5f * std::sqrt(cx * cx + cy * cy + cz * cz);
-
-        float32 share = tri_area / 3.0f;
-        vertex_area[face.n0] += share;
-        vertex_area[face.n1] += share;
-        vertex_area[face.n2] += share;
+    for (uint32 f = 0; f < face_count; ++f) {
+        vertex_area[faces[f].n0] += face_share[f];
+        vertex_area[faces[f].n1] += face_share[f];
+        vertex_area[faces[f].n2] += face_share[f];
     }
 
-    for (uint32 i = 0; i < node_count; ++i) {
-        float32 m = density * vertex_area[i];
-        if (m < 1e-12f) m = 1e-6f;  // prevent zero mass
-        masses[i].mass = m;
-        masses[i].inv_mass = 1.0f / m;
-    }
+    std::vector<SimMass> masses(node_count);
+    pool.ParallelFor(node_count, kImportFaceGrain, [&](uint32 begin, uint32 end) {
+        for (uint32 i = begin; i < end; ++i) {
+            float32 m = density * vertex_area[i];
+            if (m < 1e-12f) m = 1e-6f;  // prevent zero mass
+            masses[i].mass = m;
+            masses[i].inv_mass = 1.0f / m;
+        }
+    });
 
     // Zero velocities
     std::vector<SimVelocity> velocities(node_count);
@@ -220,16 +192,16 @@ void PinVertices(Database& db, Entity mesh_entity,
                  const std::vector<uint32>& vertex_indices) {
     if (vertex_indices.empty()) return;
 
-    const auto* masses_ptr = db.GetArray<SimMass>(mesh_entity);
-    if (!masses_ptr) return;
+    auto masses_view = db.GetArray<SimMass>(mesh_entity);
+    if (!masses_view) return;
 
-    uint32 node_count = static_cast<uint32>(masses_ptr->size());
-    auto masses = *masses_ptr;
+    uint32 node_count = static_cast<uint32>(masses_view->size());
+    std::vector<SimMass> masses(masses_view->begin(), masses_view->end());
 
     // Load existing fixed vertices (may already have some pinned)
     std::vector<FixedVertex> fixed;
-    const auto* existing = db.GetArray<FixedVertex>(mesh_entity);
-    if (existing) fixed = *existing;
+    auto existing = db.GetArray<FixedVertex>(mesh_entity);
+    if (existing) fixed.assign(existing->begin(), existing->end());
 
     for (uint32 idx : vertex_indices) {
         if (idx >= node_count) continue;
@@ -256,12 +228,12 @@ void UnpinVertices(Database& db, Entity mesh_entity,
                    const std::vector<uint32>& vertex_indices) {
     if (vertex_indices.empty()) return;
 
-    const auto* masses_ptr = db.GetArray<SimMass>(mesh_entity);
-    const auto* fixed_ptr = db.GetArray<FixedVertex>(mesh_entity);
-    if (!masses_ptr || !fixed_ptr) return;
+    auto masses_view = db.GetArray<SimMass>(mesh_entity);
+    auto fixed_view = db.GetArray<FixedVertex>(mesh_entity);
+    if (!masses_view || !fixed_view) return;
 
-    auto masses = *masses_ptr;
-    auto fixed = *fixed_ptr;
+    std::vector<SimMass> masses(masses_view->begin(), masses_view->end());
+    std::vector<FixedVertex> fixed(fixed_view->begin(), fixed_view->end());
 
     for (uint32 idx : vertex_indices) {
         auto it = std::find_if(fixed.begin(), fixed.end(),
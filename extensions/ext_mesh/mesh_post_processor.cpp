@@ -51,21 +51,10 @@ void MeshPostProcessor::Initialize() {
         return;
     }
 
-    auto face_entities = face_storage->GetEntities();
-    std::sort(face_entities.begin(), face_entities.end());
+    const auto& face_entities = face_storage->GetEntities();
 
     // Build position offset map
-    auto* pos_storage = db.GetArrayStorageById(GetComponentTypeId<SimPosition>());
-    std::unordered_map<Entity, uint32> pos_offset_map;
-    if (pos_storage) {
-        auto pos_entities = pos_storage->GetEntities();
-        std::sort(pos_entities.begin(), pos_entities.end());
-        uint32 offset = 0;
-        for (Entity e : pos_entities) {
-            pos_offset_map[e] = offset;
-            offset += pos_storage->GetArrayCount(e);
-        }
-    }
+    auto pos_offset_map = NodeRegionOffsets(db.GetArrayStorageById(GetComponentTypeId<SimPosition>()));
 
     // Build globally-indexed face index buffer
     std::vector<uint32> face_idx;
@@ -138,7 +127,7 @@ uint32 MeshPostProcessor::ComputeTotalFaceCount() const {
     const auto& db = system_.GetDatabase();
     auto* storage = db.GetArrayStorageById(GetComponentTypeId<MeshFace>());
     if (!storage) return 0;
-    auto entities = storage->GetEntities();
+    const auto& entities = storage->GetEntities();
     uint32 total = 0;
     for (Entity e : entities) {
         total += storage->GetArrayCount(e);
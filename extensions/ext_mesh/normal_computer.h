@@ -3,6 +3,7 @@
 #include "core_util/types.h"
 #include "core_gpu/gpu_handle.h"
 #include "core_gpu/gpu_buffer.h"
+#include "core_gpu/gpu_buffer_pool.h"
 #include <memory>
 
 struct WGPUCommandEncoderImpl;  typedef WGPUCommandEncoderImpl* WGPUCommandEncoder;
@@ -46,7 +47,7 @@ private:
     mps::uint32 face_wg_count_ = 0;
 
     // Params uniform (owned internally)
-    std::unique_ptr<mps::gpu::GPUBuffer<NormalParams>> params_buffer_;
+    mps::gpu::GPUBufferSlice params_buffer_;
 
     std::unique_ptr<mps::gpu::GPUBuffer<mps::int32>> normal_atomic_;
     std::unique_ptr<mps::gpu::GPUBuffer<mps::float32>> normal_out_;
@@ -0,0 +1,197 @@
+#include "ext_mesh/obj_parser.h"
+#include "core_util/thread_pool.h"
+#include "core_util/logger.h"
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+
+using namespace mps;
+using namespace mps::util;
+using namespace mps::simulate;
+
+namespace ext_mesh {
+
+// Text per parse chunk; chunks end on a line boundary
+static constexpr uint64 kOBJChunkBytes = 1ull << 20;
+
+namespace {
+
+struct OBJChunk {
+    const char* begin = nullptr;
+    const char* end = nullptr;
+
+    std::vector<SimPosition> vertices;
+    std::vector<int32> corners;            // face corner vertex indices, file order
+    std::vector<uint32> face_sizes;        // corners per polygon
+    std::vector<uint32> relative_corners;  // corners holding chunk-relative indices (negative OBJ indices)
+    uint32 triangle_count = 0;
+    bool malformed = false;
+
+    // Set by the merge
+    uint32 vertex_base = 0;
+    uint32 triangle_base = 0;
+};
+
+}  // namespace
+
+static bool IsSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+static const char* SkipSpace(const char* p, const char* end) {
+    while (p < end && IsSpace(*p)) ++p;
+    return p;
+}
+
+// Leaves value unchanged if no number is found (matches istream >> float)
+static const char* ParseFloat(const char* p, const char* end, float32& value) {
+    p = SkipSpace(p, end);
+    if (p < end && *p == '+') ++p;
+    auto [next, ec] = std::from_chars(p, end, value);
+    return ec == std::errc() ? next : p;
+}
+
+static void ParseLine(OBJChunk& chunk, const char* p, const char* end,
+                      float32 scale, const vec3& offset) {
+    p = SkipSpace(p, end);
+    if (end - p < 2 || !IsSpace(p[1])) return;  // only "v " and "f " records
+
+    if (p[0] == 'v') {
+        float32 x = 0.0f, y = 0.0f, z = 0.0f;
+        p = ParseFloat(p + 2, end, x);
+        p = ParseFloat(p, end, y);
+        ParseFloat(p, end, z);
+        SimPosition pos;
+        pos.x = x * scale + offset.x;
+        pos.y = y * scale + offset.y;
+        pos.z = z * scale + offset.z;
+        pos.w = 0.0f;
+        chunk.vertices.push_back(pos);
+    } else if (p[0] == 'f') {
+        uint32 count = 0;
+        p += 2;
+        while ((p = SkipSpace(p, end)) < end) {
+            int64 index = 0;
+            auto [next, ec] = std::from_chars(p, end, index);
+            if (ec != std::errc() || index == 0) {
+                chunk.malformed = true;
+                return;
+            }
+            if (index > 0) {
+                chunk.corners.push_back(static_cast<int32>(index - 1));
+            } else {
+                chunk.relative_corners.push_back(static_cast<uint32>(chunk.corners.size()));
+                chunk.corners.push_back(static_cast<int32>(static_cast<int64>(chunk.vertices.size()) + index));
+            }
+            ++count;
+            // Skip "/vt/vn"
+            p = next;
+            while (p < end && !IsSpace(*p)) ++p;
+        }
+        chunk.face_sizes.push_back(count);
+        if (count >= 3) chunk.triangle_count += count - 2;
+    }
+}
+
+static void ParseChunk(OBJChunk& chunk, float32 scale, const vec3& offset) {
+    const char* p = chunk.begin;
+    while (p < chunk.end) {
+        const auto* newline = static_cast<const char*>(std::memchr(p, '\n', chunk.end - p));
+        const char* line_end = newline ? newline : chunk.end;
+        ParseLine(chunk, p, line_end, scale, offset);
+        p = newline ? newline + 1 : chunk.end;
+    }
+}
+
+// Copy the chunk's vertices and fan-triangulate its polygons into the merged mesh.
+// Returns false if a corner references a vertex outside [0, vertex_count).
+static bool MergeChunk(OBJChunk& chunk, uint32 vertex_count, OBJMesh& out) {
+    std::copy(chunk.vertices.begin(), chunk.vertices.end(), out.positions.begin() + chunk.vertex_base);
+
+    for (uint32 c : chunk.relative_corners) {
+        chunk.corners[c] += static_cast<int32>(chunk.vertex_base);
+    }
+
+    bool valid = true;
+    const int32* corner = chunk.corners.data();
+    MeshFace* face = out.faces.data() + chunk.triangle_base;
+    for (uint32 size : chunk.face_sizes) {
+        for (uint32 i = 0; i < size; ++i) {
+            valid &= corner[i] >= 0 && static_cast<uint32>(corner[i]) < vertex_count;
+        }
+        for (uint32 i = 1; i + 1 < size; ++i) {
+            face->n0 = static_cast<uint32>(corner[0]);
+            face->n1 = static_cast<uint32>(corner[i]);
+            face->n2 = static_cast<uint32>(corner[i + 1]);
+            ++face;
+        }
+        corner += size;
+    }
+    return valid;
+}
+
+bool ParseOBJ(std::string_view text, float32 scale, vec3 offset, OBJMesh& out) {
+    out.positions.clear();
+    out.faces.clear();
+
+    // Split into chunks ending after a newline
+    std::vector<OBJChunk> chunks;
+    const char* p = text.data();
+    const char* end = text.data() + text.size();
+    while (p < end) {
+        const char* stop = end;
+        if (static_cast<uint64>(end - p) > kOBJChunkBytes) {
+            const auto* newline = static_cast<const char*>(
+                std::memchr(p + kOBJChunkBytes, '\n', end - (p + kOBJChunkBytes)));
+            stop = newline ? newline + 1 : end;
+        }
+        OBJChunk chunk;
+        chunk.begin = p;
+        chunk.end = stop;
+        chunks.push_back(std::move(chunk));
+        p = stop;
+    }
+
+    auto& pool = ThreadPool::GetInstance();
+    uint32 chunk_count = static_cast<uint32>(chunks.size());
+    pool.ParallelFor(chunk_count, 1, [&](uint32 begin, uint32 end_chunk) {
+        for (uint32 c = begin; c < end_chunk; ++c) {
+            ParseChunk(chunks[c], scale, offset);
+        }
+    });
+
+    // File-order offsets of each chunk's vertices and triangles
+    uint32 vertex_count = 0;
+    uint32 triangle_count = 0;
+    for (auto& chunk : chunks) {
+        if (chunk.malformed) {
+            LogError("ParseOBJ: malformed face record");
+            return false;
+        }
+        chunk.vertex_base = vertex_count;
+        chunk.triangle_base = triangle_count;
+        vertex_count += static_cast<uint32>(chunk.vertices.size());
+        triangle_count += chunk.triangle_count;
+    }
+
+    out.positions.resize(vertex_count);
+    out.faces.resize(triangle_count);
+    std::vector<uint8> chunk_valid(chunk_count, 1);
+    pool.ParallelFor(chunk_count, 1, [&](uint32 begin, uint32 end_chunk) {
+        for (uint32 c = begin; c < end_chunk; ++c) {
+            chunk_valid[c] = MergeChunk(chunks[c], vertex_count, out) ? 1 : 0;
+        }
+    });
+
+    for (uint8 valid : chunk_valid) {
+        if (!valid) {
+            LogError("ParseOBJ: face references a vertex out of range (", vertex_count, " vertices)");
+            out.positions.clear();
+            out.faces.clear();
+            return false;
+        }
+    }
+    return true;
+}
+
+}  // namespace ext_mesh
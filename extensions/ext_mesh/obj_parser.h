@@ -0,0 +1,26 @@
+#pragma once
+
+#include "ext_mesh/mesh_types.h"
+#include "core_simulate/sim_components.h"
+#include "core_util/math.h"
+#include <string_view>
+#include <vector>
+
+namespace ext_mesh {
+
+// Vertices and fan-triangulated faces of an OBJ file
+struct OBJMesh {
+    std::vector<mps::simulate::SimPosition> positions;   // scaled and offset
+    std::vector<MeshFace> faces;
+};
+
+// Parse the "v" and "f" records of OBJ text; every other record is skipped.
+// Face corners may be "v", "v/vt", "v/vt/vn" or "v//vn"; negative indices are
+// relative to the vertices read so far. Polygons are fan-triangulated.
+//
+// The text is split into chunks at line boundaries that are parsed on the
+// ThreadPool, then merged in file order, so the result matches a sequential parse.
+// Returns false (logging the reason) if a face references a missing vertex.
+bool ParseOBJ(std::string_view text, mps::float32 scale, mps::util::vec3 offset, OBJMesh& out);
+
+}  // namespace ext_mesh
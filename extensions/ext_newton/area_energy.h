@@ -0,0 +1,159 @@
+#pragma once
+
+#include "ext_dynamics/area_types.h"
+#include "core_util/math.h"
+#include <algorithm>
+#include <cmath>
+
+namespace ext_newton {
+
+// Host port of ext_newton/header/area_energy.wgsl for the CPU backend; keep the
+// two in sync. Energy, forces and the SVD-projected PSD Hessian are described there.
+
+// Per-face forces and Hessian factors; vertex slots 0..2 map to n0..n2
+struct AreaEval {
+    bool valid = false;
+    mps::util::vec3 force[3];
+    mps::util::vec2 w[3];    // wi = (dot(ci,v1), dot(ci,v2))
+    mps::util::vec3 u1;
+    mps::util::vec3 u2;
+    mps::util::vec3 u3;
+    mps::float32 Q00 = 0.0f;
+    mps::float32 Q01 = 0.0f;
+    mps::float32 Q11 = 0.0f;
+    mps::float32 a_coeff = 0.0f;   // (lam_twist + lam_flip) / 2
+    mps::float32 b_coeff = 0.0f;   // (lam_flip - lam_twist) / 2
+    mps::float32 lam_n1 = 0.0f;    // null-space coefficients
+    mps::float32 lam_n2 = 0.0f;
+    mps::float32 scale = 0.0f;     // dt² * A0
+};
+
+inline AreaEval EvalArea(const ext_dynamics::AreaTriangle& tri, const mps::util::vec3& x0,
+                         const mps::util::vec3& x1, const mps::util::vec3& x2,
+                         mps::float32 k, mps::float32 mu, mps::float32 dt2) {
+    using mps::float32;
+    using mps::util::vec2;
+    using mps::util::vec3;
+
+    AreaEval ev;
+    const float32 A0 = tri.rest_area;
+
+    // Deformation gradient F = Ds * Dm_inv (3x2, two column vectors)
+    vec3 ds0 = x1 - x0;
+    vec3 ds1 = x2 - x0;
+    vec3 f0 = ds0 * tri.dm_inv_00 + ds1 * tri.dm_inv_10;
+    vec3 f1 = ds0 * tri.dm_inv_01 + ds1 * tri.dm_inv_11;
+
+    // Cauchy-Green C = F^T * F
+    float32 c00 = glm::dot(f0, f0);
+    float32 c01 = glm::dot(f0, f1);
+    float32 c11 = glm::dot(f1, f1);
+    if (c00 * c11 - c01 * c01 < 1e-20f) {
+        return ev;  // degenerate triangle
+    }
+
+    // SVD via eigendecomposition of C
+    float32 half_sum = 0.5f * (c00 + c11);
+    float32 half_diff = 0.5f * (c00 - c11);
+    float32 disc = std::sqrt(half_diff * half_diff + c01 * c01);
+    float32 sig1 = std::sqrt(std::max(half_sum + disc, 1e-12f));
+    float32 sig2 = std::sqrt(std::max(half_sum - disc, 1e-12f));
+    float32 J = sig1 * sig2;
+
+    float32 atan_y = 2.0f * c01;
+    float32 atan_x = c00 - c11;
+    float32 theta = 0.0f;
+    if (std::abs(atan_y) > 1e-20f || std::abs(atan_x) > 1e-20f) {
+        theta = 0.5f * std::atan2(atan_y, atan_x);
+    }
+    vec2 v1(std::cos(theta), std::sin(theta));
+    vec2 v2(-v1.y, v1.x);
+
+    vec3 u1 = (f0 * v1.x + f1 * v1.y) / sig1;
+    vec3 u2 = (f0 * v2.x + f1 * v2.y) / sig2;
+    vec3 u3 = glm::cross(u1, u2);
+
+    // Forces via PK1 stress P = U * diag(p1, p2) * V^T
+    float32 Jm1 = J - 1.0f;
+    float32 p1 = k * Jm1 * sig2 + mu * (sig1 - 1.0f);
+    float32 p2 = k * Jm1 * sig1 + mu * (sig2 - 1.0f);
+    vec3 P0 = u1 * (p1 * v1.x) + u2 * (p2 * v2.x);
+    vec3 P1 = u1 * (p1 * v1.y) + u2 * (p2 * v2.y);
+
+    vec2 ci1(tri.dm_inv_00, tri.dm_inv_01);
+    vec2 ci2(tri.dm_inv_10, tri.dm_inv_11);
+    vec2 ci0 = -(ci1 + ci2);
+    ev.force[0] = (P0 * ci0.x + P1 * ci0.y) * -A0;
+    ev.force[1] = (P0 * ci1.x + P1 * ci1.y) * -A0;
+    ev.force[2] = (P0 * ci2.x + P1 * ci2.y) * -A0;
+
+    // PSD clamp of the 2x2 stretch Hessian
+    float32 h11 = k * sig2 * sig2 + mu;
+    float32 h22 = k * sig1 * sig1 + mu;
+    float32 h12 = k * (2.0f * J - 1.0f);
+    float32 s_half_sum = 0.5f * (h11 + h22);
+    float32 s_half_diff = 0.5f * (h11 - h22);
+    float32 s_disc = std::sqrt(s_half_diff * s_half_diff + h12 * h12);
+    float32 s_lam1 = std::max(s_half_sum + s_disc, 0.0f);
+    float32 s_lam2 = std::max(s_half_sum - s_disc, 0.0f);
+
+    float32 s_atan_y = 2.0f * h12;
+    float32 s_atan_x = h11 - h22;
+    float32 s_theta = 0.0f;
+    if (std::abs(s_atan_y) > 1e-20f || std::abs(s_atan_x) > 1e-20f) {
+        s_theta = 0.5f * std::atan2(s_atan_y, s_atan_x);
+    }
+    float32 sc = std::cos(s_theta);
+    float32 ss = std::sin(s_theta);
+    ev.Q00 = sc * sc * s_lam1 + ss * ss * s_lam2;
+    ev.Q01 = sc * ss * (s_lam1 - s_lam2);
+    ev.Q11 = ss * ss * s_lam1 + sc * sc * s_lam2;
+
+    float32 lam_twist = std::max(-k * Jm1 + mu, 0.0f);
+    float32 lam_flip = std::max(k * Jm1 + mu, 0.0f);
+    ev.lam_n1 = sig1 > 1e-8f ? std::max(p1 / sig1, 0.0f) : 0.0f;
+    ev.lam_n2 = sig2 > 1e-8f ? std::max(p2 / sig2, 0.0f) : 0.0f;
+    ev.a_coeff = 0.5f * (lam_twist + lam_flip);
+    ev.b_coeff = 0.5f * (lam_flip - lam_twist);
+
+    ev.w[0] = vec2(glm::dot(ci0, v1), glm::dot(ci0, v2));
+    ev.w[1] = vec2(glm::dot(ci1, v1), glm::dot(ci1, v2));
+    ev.w[2] = vec2(glm::dot(ci2, v1), glm::dot(ci2, v2));
+
+    ev.u1 = u1;
+    ev.u2 = u2;
+    ev.u3 = u3;
+    ev.scale = dt2 * A0;
+    ev.valid = true;
+    return ev;
+}
+
+// 3x3 Hessian block for vertex pair (i,j), row-major into h[9]
+inline void AreaBlock(const AreaEval& ev, const mps::util::vec2& wi, const mps::util::vec2& wj,
+                      mps::float32 h[9]) {
+    using mps::float32;
+    using mps::util::vec3;
+
+    float32 A1 = wi.x * wj.x;
+    float32 A2 = wi.x * wj.y;
+    float32 A3 = wi.y * wj.x;
+    float32 A4 = wi.y * wj.y;
+
+    float32 c11 = ev.Q00 * A1 + ev.a_coeff * A4;
+    float32 c12 = ev.Q01 * A2 + ev.b_coeff * A3;
+    float32 c21 = ev.Q01 * A3 + ev.b_coeff * A2;
+    float32 c22 = ev.Q11 * A4 + ev.a_coeff * A1;
+    float32 c33 = ev.lam_n1 * A1 + ev.lam_n2 * A4;
+
+    vec3 row1 = ev.u1 * c11 + ev.u2 * c12;
+    vec3 row2 = ev.u1 * c21 + ev.u2 * c22;
+    vec3 row3 = ev.u3 * c33;
+    for (int m = 0; m < 3; ++m) {
+        vec3 row = (row1 * ev.u1[m] + row2 * ev.u2[m] + row3 * ev.u3[m]) * ev.scale;
+        h[m * 3 + 0] = row.x;
+        h[m * 3 + 1] = row.y;
+        h[m * 3 + 2] = row.z;
+    }
+}
+
+}  // namespace ext_newton
@@ -1,10 +1,13 @@
 #include "ext_newton/area_term.h"
+#include "ext_newton/area_energy.h"
 #include "core_gpu/gpu_core.h"
-#include "core_gpu/shader_loader.h"
+#include "core_gpu/pipeline_registry.h"
 #include "core_gpu/bind_group_builder.h"
-#include "core_gpu/compute_encoder.h"
+#include "core_gpu/compute_pass_recorder.h"
 #include "core_util/logger.h"
+#include "core_util/thread_pool.h"
 #include <webgpu/webgpu.h>
+#include <algorithm>
 #include <span>
 
 using namespace mps;
@@ -18,11 +21,37 @@ namespace ext_newton {
 
 const std::string AreaTerm::kName = "AreaTerm";
 
+// Auto-layout pipeline; the gather kernel's zero_csr_rows override is set when
+// this term is the first to assemble and owns the CSR row clear.
+static GPUComputePipeline MakePipeline(const std::string& name, bool zero_csr_rows, uint32 workgroup_size) {
+    ComputePipelineDesc desc{"ext_newton/" + name + ".wgsl", name};
+    desc.SetWorkgroupSize(workgroup_size);
+    if (zero_csr_rows) {
+        desc.constants.emplace_back("zero_csr_rows", 1.0);
+    }
+    return PipelineRegistry::GetInstance().Get(desc);
+}
+
+static std::vector<uint32> FaceNodes(const std::vector<AreaTriangle>& triangles) {
+    std::vector<uint32> face_nodes;
+    face_nodes.reserve(uint64(triangles.size()) * 3);
+    for (const auto& tri : triangles) {
+        face_nodes.push_back(tri.n0);
+        face_nodes.push_back(tri.n1);
+        face_nodes.push_back(tri.n2);
+    }
+    return face_nodes;
+}
+
 AreaTerm::AreaTerm(const std::vector<AreaTriangle>& triangles, float32 stiffness)
     : triangles_(triangles), stiffness_(stiffness) {}
 
 const std::string& AreaTerm::GetName() const { return kName; }
 
+void AreaTerm::SetAssemblyMode(simulate::AssemblyMode mode) { mode_ = mode; }
+
+simulate::AssemblyMode AreaTerm::GetAssemblyMode() const { return mode_; }
+
 void AreaTerm::DeclareSparsity(simulate::SparsityBuilder& builder) {
     for (const auto& tri : triangles_) {
         builder.AddEdge(tri.n0, tri.n1);
@@ -31,11 +60,8 @@ void AreaTerm::DeclareSparsity(simulate::SparsityBuilder& builder) {
     }
 }
 
-void AreaTerm::Initialize(const simulate::SparsityBuilder& sparsity, const simulate::AssemblyContext& ctx) {
+void AreaTerm::BuildCSRMappings(const simulate::SparsityBuilder& sparsity) {
     uint32 F = static_cast<uint32>(triangles_.size());
-    nnz_ = sparsity.GetNNZ();
-
-    // Build face-to-CSR mapping
     face_csr_mappings_.resize(F);
     for (uint32 f = 0; f < F; ++f) {
         uint32 a = triangles_[f].n0;
@@ -48,77 +74,194 @@ void AreaTerm::Initialize(const simulate::SparsityBuilder& sparsity, const simul
         face_csr_mappings_[f].csr_12 = sparsity.GetCSRIndex(b, c);
         face_csr_mappings_[f].csr_21 = sparsity.GetCSRIndex(c, b);
     }
+}
+
+void AreaTerm::Initialize(const simulate::SparsityBuilder& sparsity, const simulate::AssemblyContext& ctx) {
+    uint32 F = static_cast<uint32>(triangles_.size());
+    nnz_ = sparsity.GetNNZ();
+
+    bool gather = mode_ == simulate::AssemblyMode::Gather;
+
+    std::vector<uint32> face_nodes = FaceNodes(triangles_);
+
+    // Scatter: color faces so that no two faces of one color share a node (and
+    // therefore no diagonal or CSR block), grouping each color contiguously.
+    // Gather: each node walks its incident faces and writes only its own row.
+    simulate::ElementColoring coloring;
+    simulate::NodeIncidence incidence;
+    if (gather) {
+        incidence.Build(face_nodes, 3, ctx.node_count);
+    } else {
+        coloring.Build(face_nodes, 3, ctx.node_count);
+        triangles_ = coloring.Reorder(triangles_);
+    }
+
+    BuildCSRMappings(sparsity);
 
     // Upload triangle buffer
     triangle_buffer_ = std::make_unique<GPUBuffer<AreaTriangle>>(
-        BufferUsage::Storage, std::span<const AreaTriangle>(triangles_), "area_triangles");
+        BufferUsage::Storage, simulate::NonEmptyUpload(triangles_), "area_triangles");
 
     // Upload face CSR mapping buffer
     face_csr_buffer_ = std::make_unique<GPUBuffer<FaceCSRMapping>>(
-        BufferUsage::Storage, std::span<const FaceCSRMapping>(face_csr_mappings_), "area_face_csr");
+        BufferUsage::Storage, simulate::NonEmptyUpload(face_csr_mappings_), "area_face_csr");
 
     // Upload area params uniform
     AreaParams params;
     params.stiffness = stiffness_;
     params.shear_stiffness = stiffness_ * 0.5f;  // 50% of area stiffness for shear resistance
-    area_params_buffer_ = std::make_unique<GPUBuffer<AreaParams>>(
-        BufferUsage::Uniform, std::span<const AreaParams>(&params, 1), "area_params");
+    area_params_buffer_ = GPUBufferPool::GetInstance().Allocate(
+        BufferUsage::Uniform, std::span<const AreaParams>(&params, 1));
 
     // Create pipeline
-    auto shader = ShaderLoader::CreateModule("ext_newton/accumulate_area.wgsl", "accumulate_area");
-    WGPUComputePipelineDescriptor desc = WGPU_COMPUTE_PIPELINE_DESCRIPTOR_INIT;
-    std::string label = "accumulate_area";
-    desc.label = {label.data(), label.size()};
-    desc.layout = nullptr;
-    desc.compute.module = shader.GetHandle();
-    std::string entry = "cs_main";
-    desc.compute.entryPoint = {entry.data(), entry.size()};
-    pipeline_ = GPUComputePipeline(wgpuDeviceCreateComputePipeline(GPUCore::GetInstance().GetDevice(), &desc));
-
-    // Cache bind group
+    pipeline_ = gather
+        ? MakePipeline("accumulate_area_gather", ctx.zero_csr_rows, ctx.workgroup_size)
+        : MakePipeline("accumulate_area", false, ctx.workgroup_size);
+
+    // Cache bind groups
     uint64 pos_sz = uint64(ctx.node_count) * 4 * sizeof(float32);
-    uint64 force_sz = uint64(ctx.node_count) * 4 * sizeof(uint32);
-    uint64 tri_sz = uint64(F) * sizeof(AreaTriangle);
+    uint64 force_sz = uint64(ctx.node_count) * 4 * sizeof(float32);
+    uint64 tri_sz = triangle_buffer_->GetByteLength();
     uint64 diag_sz = uint64(ctx.node_count) * 9 * sizeof(float32);
-    uint64 csr_val_sz = uint64(nnz_) * 9 * sizeof(float32);
-    uint64 csr_map_sz = uint64(F) * sizeof(FaceCSRMapping);
+    uint64 csr_val_sz = std::max(uint64(nnz_) * 9 * sizeof(float32), uint64(4));
+    uint64 csr_map_sz = face_csr_buffer_->GetByteLength();
 
     auto bgl = wgpuComputePipelineGetBindGroupLayout(pipeline_.GetHandle(), 0);
-    bg_area_ = BindGroupBuilder("bg_area")
-        .AddBuffer(0, ctx.physics_buffer, ctx.physics_size)
-        .AddBuffer(1, ctx.params_buffer, ctx.params_size)
-        .AddBuffer(2, ctx.position_buffer, pos_sz)
-        .AddBuffer(3, ctx.force_buffer, force_sz)
-        .AddBuffer(4, triangle_buffer_->GetHandle(), tri_sz)
-        .AddBuffer(5, ctx.diag_buffer, diag_sz)
-        .AddBuffer(6, area_params_buffer_->GetHandle(), sizeof(AreaParams))
-        .AddBuffer(7, ctx.csr_values_buffer, csr_val_sz)
-        .AddBuffer(8, face_csr_buffer_->GetHandle(), csr_map_sz)
-        .Build(bgl);
+    auto common = [&](const std::string& label) {
+        return BindGroupBuilder(label)
+            .AddBuffer(0, ctx.physics_buffer, ctx.physics_size)
+            .AddBuffer(1, ctx.params_buffer, ctx.params_size)
+            .AddBuffer(2, ctx.position_buffer, pos_sz, ctx.position_offset)
+            .AddBuffer(3, ctx.force_buffer, force_sz)
+            .AddBuffer(4, triangle_buffer_->GetHandle(), tri_sz)
+            .AddBuffer(5, ctx.diag_buffer, diag_sz)
+            .AddSlice(6, area_params_buffer_)
+            .AddBuffer(7, ctx.csr_values_buffer, csr_val_sz)
+            .AddBuffer(8, face_csr_buffer_->GetHandle(), csr_map_sz);
+    };
+    bg_area_.clear();
+    wg_counts_.clear();
+
+    if (gather) {
+        const auto& offsets = incidence.GetOffsets();
+        const auto& entries = incidence.GetEntries();
+        incidence_offsets_buffer_ = std::make_unique<GPUBuffer<uint32>>(
+            BufferUsage::Storage, std::span<const uint32>(offsets), "area_incidence_offsets");
+        incidence_buffer_ = std::make_unique<GPUBuffer<simulate::IncidenceEntry>>(
+            BufferUsage::Storage, simulate::NonEmptyUpload(entries), "area_incidence");
+
+        bg_area_.push_back(common("bg_area_gather")
+            .AddBuffer(9, incidence_offsets_buffer_->GetHandle(), offsets.size() * sizeof(uint32))
+            .AddBuffer(10, incidence_buffer_->GetHandle(), incidence_buffer_->GetByteLength())
+            .AddBuffer(11, ctx.csr_row_ptr_buffer, uint64(ctx.node_count + 1) * sizeof(uint32))
+            .Build(bgl));
+        wg_counts_.push_back((ctx.node_count + ctx.workgroup_size - 1) / ctx.workgroup_size);
+    } else {
+        // Per-color ranges, one 256-byte uniform slot each
+        const auto& ranges = coloring.GetRanges();
+        if (!ranges.empty()) {
+            color_range_buffer_ = GPUBufferPool::GetInstance().Allocate(
+                BufferUsage::Uniform, std::span<const simulate::ColorRange>(ranges));
+        }
+        for (uint32 c = 0; c < coloring.GetColorCount(); ++c) {
+            bg_area_.push_back(common("bg_area_c" + std::to_string(c))
+                .AddSlice(9, color_range_buffer_, simulate::kColorRangeBindingSize,
+                          uint64(c) * sizeof(simulate::ColorRange))
+                .Build(bgl));
+            wg_counts_.push_back((ranges[c].count + ctx.workgroup_size - 1) / ctx.workgroup_size);
+        }
+    }
     wgpuBindGroupLayoutRelease(bgl);
 
-    wg_count_ = (F + ctx.workgroup_size - 1) / ctx.workgroup_size;
+    if (gather) {
+        LogInfo("AreaTerm: initialized (", F, " triangles, nnz=", nnz_, ", stiffness=", stiffness_,
+                ", gather, max valence ", incidence.GetMaxValence(), ")");
+    } else {
+        LogInfo("AreaTerm: initialized (", F, " triangles, nnz=", nnz_, ", stiffness=", stiffness_,
+                ", ", coloring.GetColorCount(), " colors)");
+    }
+}
 
-    LogInfo("AreaTerm: initialized (", F, " triangles, nnz=", nnz_, ", stiffness=", stiffness_, ")");
+void AreaTerm::Assemble(ComputePassRecorder& recorder) {
+    // Scatter: colors run as ordered dispatches; faces within one never write the same entry.
+    // Gather: a single node-parallel dispatch.
+    for (size_t i = 0; i < bg_area_.size(); ++i) {
+        recorder.Dispatch(pipeline_.GetHandle(), bg_area_[i].GetHandle(), wg_counts_[i]);
+    }
 }
 
-void AreaTerm::Assemble(WGPUCommandEncoder encoder) {
-    WGPUComputePassDescriptor pd = WGPU_COMPUTE_PASS_DESCRIPTOR_INIT;
-    WGPUComputePassEncoder pass = wgpuCommandEncoderBeginComputePass(encoder, &pd);
-    ComputeEncoder enc(pass);
-    enc.SetPipeline(pipeline_.GetHandle());
-    enc.SetBindGroup(0, bg_area_.GetHandle());
-    enc.Dispatch(wg_count_);
-    wgpuComputePassEncoderEnd(pass);
-    wgpuComputePassEncoderRelease(pass);
+bool AreaTerm::InitializeHost(const simulate::SparsityBuilder& sparsity, uint32 node_count) {
+    nnz_ = sparsity.GetNNZ();
+
+    // Host assembly always scatters: colors run in order, faces of one color in parallel
+    simulate::ElementColoring coloring;
+    coloring.Build(FaceNodes(triangles_), 3, node_count);
+    triangles_ = coloring.Reorder(triangles_);
+    host_colors_ = coloring.GetRanges();
+    BuildCSRMappings(sparsity);
+
+    LogInfo("AreaTerm: host initialized (", triangles_.size(), " triangles, nnz=", nnz_,
+            ", stiffness=", stiffness_, ", ", coloring.GetColorCount(), " colors)");
+    return true;
+}
+
+// Host port of accumulate_area.wgsl
+void AreaTerm::AssembleHost(const simulate::HostAssemblyContext& ctx) {
+    const float32 k = stiffness_;
+    const float32 mu = stiffness_ * 0.5f;  // same shear ratio as the GPU params
+    auto load = [&](uint32 n) {
+        return vec3(ctx.position[0][n], ctx.position[1][n], ctx.position[2][n]);
+    };
+    auto add_block = [](float32* dst, const float32 h[9]) {
+        for (uint32 i = 0; i < 9; ++i) dst[i] += h[i];
+    };
+
+    for (const auto& color : host_colors_) {
+        ThreadPool::GetInstance().ParallelFor(color.count, simulate::kHostElementGrain,
+            [&](uint32 begin, uint32 end) {
+            for (uint32 f = color.offset + begin; f < color.offset + end; ++f) {
+                const AreaTriangle& tri = triangles_[f];
+                AreaEval ev = EvalArea(tri, load(tri.n0), load(tri.n1), load(tri.n2), k, mu, ctx.dt_sq);
+                if (!ev.valid) continue;
+
+                const uint32 nodes[3] = {tri.n0, tri.n1, tri.n2};
+                for (uint32 i = 0; i < 3; ++i) {
+                    ctx.force[0][nodes[i]] += ev.force[i].x;
+                    ctx.force[1][nodes[i]] += ev.force[i].y;
+                    ctx.force[2][nodes[i]] += ev.force[i].z;
+                }
+
+                float32 h[9];
+                for (uint32 i = 0; i < 3; ++i) {
+                    AreaBlock(ev, ev.w[i], ev.w[i], h);
+                    add_block(ctx.diag + uint64(nodes[i]) * 9, h);
+                }
+
+                const FaceCSRMapping& mapping = face_csr_mappings_[f];
+                const uint32 pairs[6][3] = {
+                    {0, 1, mapping.csr_01}, {1, 0, mapping.csr_10},
+                    {0, 2, mapping.csr_02}, {2, 0, mapping.csr_20},
+                    {1, 2, mapping.csr_12}, {2, 1, mapping.csr_21}};
+                for (const auto& [i, j, csr] : pairs) {
+                    AreaBlock(ev, ev.w[i], ev.w[j], h);
+                    add_block(ctx.csr_values + uint64(csr) * 9, h);
+                }
+            }
+        });
+    }
 }
 
 void AreaTerm::Shutdown() {
-    bg_area_ = {};
+    bg_area_.clear();
+    wg_counts_.clear();
     pipeline_ = {};
     triangle_buffer_.reset();
     face_csr_buffer_.reset();
-    area_params_buffer_.reset();
+    area_params_buffer_ = {};
+    color_range_buffer_ = {};
+    incidence_offsets_buffer_.reset();
+    incidence_buffer_.reset();
+    host_colors_.clear();
     LogInfo("AreaTerm: shutdown");
 }
 
@@ -52,20 +52,9 @@ std::unique_ptr<IDynamicsTerm> AreaTermProvider::CreateTerm(
         all_triangles.assign(data, data + count);
     } else {
         // Global: merge ALL entities' triangles with position offsets
-        auto entities = storage->GetEntities();
-        std::sort(entities.begin(), entities.end());
-
-        auto* pos_storage = db.GetArrayStorageById(GetComponentTypeId<SimPosition>());
-        std::unordered_map<Entity, uint32> pos_offset_map;
-        if (pos_storage) {
-            auto pos_entities = pos_storage->GetEntities();
-            std::sort(pos_entities.begin(), pos_entities.end());
-            uint32 offset = 0;
-            for (Entity e : pos_entities) {
-                pos_offset_map[e] = offset;
-                offset += pos_storage->GetArrayCount(e);
-            }
-        }
+        const auto& entities = storage->GetEntities();
+
+        auto pos_offset_map = NodeRegionOffsets(db.GetArrayStorageById(GetComponentTypeId<SimPosition>()));
 
         for (Entity mesh_e : entities) {
             uint32 count = storage->GetArrayCount(mesh_e);
@@ -91,7 +80,9 @@ std::unique_ptr<IDynamicsTerm> AreaTermProvider::CreateTerm(
     if (all_triangles.empty()) return nullptr;
 
     face_count_ = static_cast<uint32>(all_triangles.size());
-    return std::make_unique<AreaTerm>(all_triangles, config->stiffness);
+    auto term = std::make_unique<AreaTerm>(all_triangles, config->stiffness);
+    term->SetAssemblyMode(static_cast<AssemblyMode>(config->assembly_mode));
+    return term;
 }
 
 void AreaTermProvider::DeclareTopology(uint32& out_edge_count, uint32& out_face_count) {
@@ -113,7 +104,7 @@ void AreaTermProvider::QueryTopology(const Database& db, Entity entity,
         out_face_count = storage->GetArrayCount(entity);
     } else {
         // Global: sum across ALL entities
-        auto entities = storage->GetEntities();
+        const auto& entities = storage->GetEntities();
         uint32 total = 0;
         for (Entity e : entities) {
             total += storage->GetArrayCount(e);
@@ -0,0 +1,196 @@
+#include "ext_newton/host_newton_dynamics.h"
+#include "core_util/thread_pool.h"
+#include "core_util/logger.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace mps::util;
+using ext_dynamics::HostNodeState;
+
+namespace mps {
+namespace simulate {
+
+HostNewtonDynamics::HostNewtonDynamics() = default;
+HostNewtonDynamics::~HostNewtonDynamics() = default;
+
+void HostNewtonDynamics::AddTerm(std::unique_ptr<IDynamicsTerm> term) {
+    terms_.push_back(std::move(term));
+}
+
+void HostNewtonDynamics::Initialize(uint32 node_count) {
+    node_count_ = node_count;
+
+    sparsity_ = std::make_unique<SparsityBuilder>(node_count);
+    for (auto& term : terms_) {
+        term->DeclareSparsity(*sparsity_);
+    }
+    sparsity_->Build();
+
+    std::erase_if(terms_, [&](const std::unique_ptr<IDynamicsTerm>& term) {
+        if (term->InitializeHost(*sparsity_, node_count)) return false;
+        LogError("HostNewtonDynamics: term '", term->GetName(), "' has no host path, skipped");
+        return true;
+    });
+
+    diag_values_.assign(uint64(node_count) * 9, 0.0f);
+    csr_values_.assign(uint64(sparsity_->GetNNZ()) * 9, 0.0f);
+    x_old_.Assign(node_count);
+    dv_total_.Assign(node_count);
+    predicted_.Assign(node_count);
+    force_.Assign(node_count);
+    rhs_.Assign(node_count);
+    cg_solver_.Initialize(node_count);
+
+    LogInfo("HostNewtonDynamics: initialized (", node_count, " nodes, nnz=", sparsity_->GetNNZ(),
+            ", ", terms_.size(), " terms, ", ThreadPool::GetInstance().GetThreadCount(), " threads)");
+}
+
+// Clear forces and blocks, set diag = M, add gravity, then let the terms accumulate
+void HostNewtonDynamics::Assemble(const HostNodeState& state, const PhysicsParamsGPU& physics) {
+    auto& pool = ThreadPool::GetInstance();
+    const float32* mass = state.mass.data();
+    const float32* inv_mass = state.inv_mass.data();
+
+    pool.ParallelFor(node_count_, kHostNodeGrain, [&](uint32 begin, uint32 end) {
+        for (uint32 i = begin; i < end; ++i) {
+            bool free = inv_mass[i] > 0.0f;
+            force_.x[i] = free ? physics.gravity_x * mass[i] : 0.0f;
+            force_.y[i] = free ? physics.gravity_y * mass[i] : 0.0f;
+            force_.z[i] = free ? physics.gravity_z * mass[i] : 0.0f;
+
+            float32* d = diag_values_.data() + uint64(i) * 9;
+            std::fill(d, d + 9, 0.0f);
+            d[0] = mass[i];
+            d[4] = mass[i];
+            d[8] = mass[i];
+        }
+    });
+    std::fill(csr_values_.begin(), csr_values_.end(), 0.0f);
+
+    HostAssemblyContext ctx{};
+    ctx.position[0] = predicted_.x.data();
+    ctx.position[1] = predicted_.y.data();
+    ctx.position[2] = predicted_.z.data();
+    ctx.force[0] = force_.x.data();
+    ctx.force[1] = force_.y.data();
+    ctx.force[2] = force_.z.data();
+    ctx.diag = diag_values_.data();
+    ctx.csr_values = csr_values_.data();
+    ctx.dt_sq = physics.dt_sq;
+    ctx.node_count = node_count_;
+    for (auto& term : terms_) {
+        term->AssembleHost(ctx);
+    }
+}
+
+void HostNewtonDynamics::Step(HostNodeState& state, const PhysicsParamsGPU& physics) {
+    if (node_count_ == 0 || state.GetNodeCount() != node_count_) return;
+
+    auto& pool = ThreadPool::GetInstance();
+    const float32 dt = physics.dt;
+    const float32* mass = state.mass.data();
+    const float32* inv_mass = state.inv_mass.data();
+    HostVec3Array& pos = state.positions;
+    HostVec3Array& vel = state.velocities;
+
+    // x_old = x, dv_total = 0
+    pool.ParallelFor(node_count_, kHostNodeGrain, [&](uint32 begin, uint32 end) {
+        for (uint32 i = begin; i < end; ++i) {
+            x_old_.x[i] = pos.x[i];
+            x_old_.y[i] = pos.y[i];
+            x_old_.z[i] = pos.z[i];
+            dv_total_.x[i] = 0.0f;
+            dv_total_.y[i] = 0.0f;
+            dv_total_.z[i] = 0.0f;
+        }
+    });
+
+    HostBlockMatrix matrix;
+    matrix.row_ptr = sparsity_->GetRowPtr().data();
+    matrix.col_idx = sparsity_->GetColIdx().data();
+    matrix.csr_values = csr_values_.data();
+    matrix.diag = diag_values_.data();
+    matrix.node_count = node_count_;
+
+    for (uint32 iter = 0; iter < newton_iterations_; ++iter) {
+        // Predict x = x_old + dt * (v + dv_total); pinned nodes stay at x_old
+        pool.ParallelFor(node_count_, kHostNodeGrain, [&](uint32 begin, uint32 end) {
+            for (uint32 i = begin; i < end; ++i) {
+                float32 h = inv_mass[i] > 0.0f ? dt : 0.0f;
+                predicted_.x[i] = x_old_.x[i] + h * (vel.x[i] + dv_total_.x[i]);
+                predicted_.y[i] = x_old_.y[i] + h * (vel.y[i] + dv_total_.y[i]);
+                predicted_.z[i] = x_old_.z[i] + h * (vel.z[i] + dv_total_.z[i]);
+            }
+        });
+
+        Assemble(state, physics);
+
+        // b = dt * f - M * dv_total (MPCG: zero on pinned nodes)
+        pool.ParallelFor(node_count_, kHostNodeGrain, [&](uint32 begin, uint32 end) {
+            for (uint32 i = begin; i < end; ++i) {
+                bool free = inv_mass[i] > 0.0f;
+                rhs_.x[i] = free ? dt * force_.x[i] - mass[i] * dv_total_.x[i] : 0.0f;
+                rhs_.y[i] = free ? dt * force_.y[i] - mass[i] * dv_total_.y[i] : 0.0f;
+                rhs_.z[i] = free ? dt * force_.z[i] - mass[i] * dv_total_.z[i] : 0.0f;
+            }
+        });
+
+        last_cg_iterations_ = cg_solver_.Solve(matrix, rhs_, state.inv_mass,
+                                               cg_max_iterations_, cg_tolerance_);
+
+        // dv_total += dx
+        const HostVec3Array& dx = cg_solver_.GetSolution();
+        pool.ParallelFor(node_count_, kHostNodeGrain, [&](uint32 begin, uint32 end) {
+            for (uint32 i = begin; i < end; ++i) {
+                dv_total_.x[i] += dx.x[i];
+                dv_total_.y[i] += dx.y[i];
+                dv_total_.z[i] += dx.z[i];
+            }
+        });
+    }
+
+    // v = (v + dv_total) * damping, clamped to 50 m/s; x = x_old + v * dt.
+    // Pinned nodes get zero velocity and keep their position.
+    constexpr float32 kMaxSpeed = 50.0f;
+    pool.ParallelFor(node_count_, kHostNodeGrain, [&](uint32 begin, uint32 end) {
+        for (uint32 i = begin; i < end; ++i) {
+            if (inv_mass[i] <= 0.0f) {
+                vel.x[i] = 0.0f;
+                vel.y[i] = 0.0f;
+                vel.z[i] = 0.0f;
+                continue;
+            }
+            float32 vx = (vel.x[i] + dv_total_.x[i]) * physics.damping;
+            float32 vy = (vel.y[i] + dv_total_.y[i]) * physics.damping;
+            float32 vz = (vel.z[i] + dv_total_.z[i]) * physics.damping;
+            float32 speed = std::sqrt(vx * vx + vy * vy + vz * vz);
+            if (speed > kMaxSpeed) {
+                float32 s = kMaxSpeed / speed;
+                vx *= s;
+                vy *= s;
+                vz *= s;
+            }
+            vel.x[i] = vx;
+            vel.y[i] = vy;
+            vel.z[i] = vz;
+            pos.x[i] = x_old_.x[i] + vx * dt;
+            pos.y[i] = x_old_.y[i] + vy * dt;
+            pos.z[i] = x_old_.z[i] + vz * dt;
+        }
+    });
+}
+
+void HostNewtonDynamics::Shutdown() {
+    for (auto& term : terms_) {
+        term->Shutdown();
+    }
+    terms_.clear();
+    sparsity_.reset();
+    diag_values_.clear();
+    csr_values_.clear();
+    node_count_ = 0;
+    LogInfo("HostNewtonDynamics: shutdown");
+}
+
+}  // namespace simulate
+}  // namespace mps
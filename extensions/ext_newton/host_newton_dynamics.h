@@ -0,0 +1,71 @@
+#pragma once
+
+#include "core_simulate/dynamics_term.h"
+#include "core_simulate/host_cg_solver.h"
+#include "core_simulate/solver_params.h"
+#include "ext_dynamics/global_physics_params.h"
+#include "ext_dynamics/host_node_state.h"
+#include <memory>
+#include <vector>
+
+namespace mps {
+namespace simulate {
+
+// CPU reference backend for NewtonDynamics.
+// Runs the same Newton-Raphson loop (predict, assemble, MPCG solve, accumulate dv)
+// plus the velocity/position update on host SoA arrays, using the terms' host
+// assembly paths and the ThreadPool. Needs no GPU device, so it doubles as a
+// fallback and as an oracle for validating the GPU solver.
+class HostNewtonDynamics {
+public:
+    HostNewtonDynamics();
+    ~HostNewtonDynamics();
+
+    // Add a dynamics term (call before Initialize)
+    void AddTerm(std::unique_ptr<IDynamicsTerm> term);
+
+    void SetNewtonIterations(uint32 iterations) { newton_iterations_ = iterations; }
+    void SetCGMaxIterations(uint32 iterations) { cg_max_iterations_ = iterations; }
+    void SetCGTolerance(float32 tolerance) { cg_tolerance_ = tolerance; }
+    void SetCGConvergenceCheck(bool enabled) { cg_solver_.SetConvergenceCheck(enabled); }
+    void SetCGPreconditioner(CGPreconditioner preconditioner) { cg_solver_.SetPreconditioner(preconditioner); }
+
+    // Initialize after all terms are added. Terms without a host path are dropped.
+    void Initialize(uint32 node_count);
+
+    // Advance state by one timestep (velocities and positions are updated in place)
+    void Step(ext_dynamics::HostNodeState& state, const PhysicsParamsGPU& physics);
+
+    // CG iterations run by the last Newton iteration of the last Step
+    [[nodiscard]] uint32 GetLastCGIterations() const { return last_cg_iterations_; }
+
+    void Shutdown();
+
+private:
+    void Assemble(const ext_dynamics::HostNodeState& state, const PhysicsParamsGPU& physics);
+
+    std::vector<std::unique_ptr<IDynamicsTerm>> terms_;
+    std::unique_ptr<SparsityBuilder> sparsity_;
+
+    uint32 node_count_ = 0;
+    uint32 newton_iterations_ = 1;
+    uint32 cg_max_iterations_ = 30;
+    float32 cg_tolerance_ = 1e-6f;
+    uint32 last_cg_iterations_ = 0;
+
+    // System matrix storage (GPU block layout)
+    std::vector<float32> diag_values_;
+    std::vector<float32> csr_values_;
+
+    // Newton state
+    HostVec3Array x_old_;
+    HostVec3Array dv_total_;
+    HostVec3Array predicted_;
+    HostVec3Array force_;
+    HostVec3Array rhs_;
+
+    HostCGSolver cg_solver_;
+};
+
+}  // namespace simulate
+}  // namespace mps
@@ -1,9 +1,10 @@
 #include "ext_newton/newton_dynamics.h"
 #include "core_simulate/sim_components.h"
 #include "core_gpu/gpu_core.h"
-#include "core_gpu/shader_loader.h"
+#include "core_gpu/pipeline_registry.h"
 #include "core_gpu/bind_group_builder.h"
-#include "core_gpu/compute_encoder.h"
+#include "core_gpu/compute_pass_recorder.h"
+#include "core_gpu/workgroup_tuner.h"
 #include "core_util/logger.h"
 #include <webgpu/webgpu.h>
 #include <algorithm>
@@ -24,41 +25,22 @@ namespace simulate {
 
 static GPUBindGroup MakeBG(const GPUComputePipeline& pipeline,
                            const std::string& label,
-                           std::initializer_list<std::pair<uint32, std::pair<WGPUBuffer, uint64>>> entries) {
+                           std::initializer_list<std::pair<uint32, BufferBinding>> entries) {
     auto bgl = wgpuComputePipelineGetBindGroupLayout(pipeline.GetHandle(), 0);
     auto builder = BindGroupBuilder(label);
-    for (auto& [binding, buf_size] : entries) {
-        builder = std::move(builder).AddBuffer(binding, buf_size.first, buf_size.second);
+    for (auto& [binding, buf] : entries) {
+        builder = std::move(builder).AddBuffer(binding, buf.buffer, buf.size, buf.offset);
     }
     auto bg = std::move(builder).Build(bgl);
     wgpuBindGroupLayoutRelease(bgl);
     return bg;
 }
 
-static void Dispatch(WGPUCommandEncoder encoder,
-                     const GPUComputePipeline& pipeline,
-                     const GPUBindGroup& bg,
-                     uint32 workgroup_count) {
-    WGPUComputePassDescriptor pd = WGPU_COMPUTE_PASS_DESCRIPTOR_INIT;
-    WGPUComputePassEncoder pass = wgpuCommandEncoderBeginComputePass(encoder, &pd);
-    ComputeEncoder enc(pass);
-    enc.SetPipeline(pipeline.GetHandle());
-    enc.SetBindGroup(0, bg.GetHandle());
-    enc.Dispatch(workgroup_count);
-    wgpuComputePassEncoderEnd(pass);
-    wgpuComputePassEncoderRelease(pass);
-}
-
-static GPUComputePipeline MakePipeline(const std::string& shader_path,
-                                        const std::string& label) {
-    auto shader = ShaderLoader::CreateModule("ext_newton/" + shader_path, label);
-    WGPUComputePipelineDescriptor desc = WGPU_COMPUTE_PIPELINE_DESCRIPTOR_INIT;
-    desc.label = {label.data(), label.size()};
-    desc.layout = nullptr;
-    desc.compute.module = shader.GetHandle();
-    std::string entry = "cs_main";
-    desc.compute.entryPoint = {entry.data(), entry.size()};
-    return GPUComputePipeline(wgpuDeviceCreateComputePipeline(GPUCore::GetInstance().GetDevice(), &desc));
+static ComputePipelineDesc PipelineDesc(const std::string& shader_path, const std::string& label,
+                                        uint32 workgroup_size) {
+    ComputePipelineDesc desc{"ext_newton/" + shader_path, label};
+    desc.SetWorkgroupSize(workgroup_size);
+    return desc;
 }
 
 // ============================================================================
@@ -86,8 +68,49 @@ void NewtonDynamics::SpMVOperator::PrepareSolve(
          {6, {owner_.diag_values_buffer_->GetHandle(), diag_sz}}});
 }
 
-void NewtonDynamics::SpMVOperator::Apply(WGPUCommandEncoder encoder, uint32 workgroup_count) {
-    Dispatch(encoder, owner_.spmv_pipeline_, bind_group_, workgroup_count);
+void NewtonDynamics::SpMVOperator::Apply(ComputePassRecorder& recorder, uint32 workgroup_count) {
+    recorder.Dispatch(owner_.spmv_pipeline_, bind_group_, workgroup_count);
+}
+
+void NewtonDynamics::SpMVOperator::ApplyIndirect(ComputePassRecorder& recorder,
+                                                 WGPUBuffer indirect_buffer, uint64 indirect_offset) {
+    recorder.DispatchIndirect(owner_.spmv_pipeline_, bind_group_, indirect_buffer, indirect_offset);
+}
+
+bool NewtonDynamics::SpMVOperator::PrepareFusedSolve(
+    WGPUBuffer u_buffer, WGPUBuffer w_buffer,
+    WGPUBuffer r_buffer, uint64 vec_size,
+    WGPUBuffer partial_buffer, uint64 partial_size) {
+    if (!owner_.spmv_dot_pipeline_) {
+        owner_.spmv_dot_pipeline_ = PipelineRegistry::GetInstance().Get(
+            PipelineDesc("cg_spmv_dot.wgsl", "cg_spmv_dot", owner_.spmv_workgroup_size_));
+    }
+
+    uint64 row_ptr_sz = owner_.csr_row_ptr_buffer_->GetByteLength();
+    uint64 col_idx_sz = owner_.csr_col_idx_buffer_->GetByteLength();
+    uint64 csr_val_sz = owner_.csr_values_buffer_->GetByteLength();
+    uint64 diag_sz = uint64(owner_.node_count_) * 9 * sizeof(float32);
+
+    fused_bind_group_ = MakeBG(owner_.spmv_dot_pipeline_, "bg_spmv_dot",
+        {{0, {owner_.params_buffer_->GetHandle(), sizeof(SolverParams)}},
+         {1, {u_buffer, vec_size}},
+         {2, {w_buffer, vec_size}},
+         {3, {owner_.csr_row_ptr_buffer_->GetHandle(), row_ptr_sz}},
+         {4, {owner_.csr_col_idx_buffer_->GetHandle(), col_idx_sz}},
+         {5, {owner_.csr_values_buffer_->GetHandle(), csr_val_sz}},
+         {6, {owner_.diag_values_buffer_->GetHandle(), diag_sz}},
+         {7, {r_buffer, vec_size}},
+         {8, {partial_buffer, partial_size}}});
+    return true;
+}
+
+void NewtonDynamics::SpMVOperator::ApplyFused(ComputePassRecorder& recorder, uint32 workgroup_count) {
+    recorder.Dispatch(owner_.spmv_dot_pipeline_, fused_bind_group_, workgroup_count);
+}
+
+void NewtonDynamics::SpMVOperator::ApplyFusedIndirect(ComputePassRecorder& recorder,
+                                                      WGPUBuffer indirect_buffer, uint64 indirect_offset) {
+    recorder.DispatchIndirect(owner_.spmv_dot_pipeline_, fused_bind_group_, indirect_buffer, indirect_offset);
 }
 
 // ============================================================================
@@ -98,6 +121,43 @@ NewtonDynamics::NewtonDynamics() = default;
 
 NewtonDynamics::~NewtonDynamics() = default;
 
+void NewtonDynamics::SetCGMaxIterations(uint32 iterations) {
+    cg_max_iterations_ = iterations;
+    solve_program_.Clear();
+    WriteSolverParams();
+}
+
+void NewtonDynamics::SetCGTolerance(float32 tolerance) {
+    cg_tolerance_ = tolerance;
+    WriteSolverParams();   // read by the convergence check on the GPU; the program is unchanged
+}
+
+void NewtonDynamics::SetCGConvergenceCheck(bool enabled) {
+    cg_convergence_check_ = enabled;
+    solve_program_.Clear();
+    if (cg_solver_) cg_solver_->SetConvergenceCheck(enabled);
+}
+
+void NewtonDynamics::SetCGPreconditioner(CGPreconditioner preconditioner) {
+    if (preconditioner == cg_preconditioner_) return;
+    cg_preconditioner_ = preconditioner;
+    WriteSolverParams();
+    CacheCGBindGroups();
+}
+
+void NewtonDynamics::SetCGPipelined(bool enabled) {
+    if (enabled == cg_pipelined_) return;
+    cg_pipelined_ = enabled;
+    CacheCGBindGroups();
+}
+
+void NewtonDynamics::WriteSolverParams() {
+    params_.cg_max_iter = cg_max_iterations_;
+    params_.cg_tolerance = cg_tolerance_;
+    params_.cg_precond = static_cast<uint32>(cg_preconditioner_);
+    if (params_buffer_) params_buffer_->WriteData(std::span<const SolverParams>(&params_, 1));
+}
+
 void NewtonDynamics::AddTerm(std::unique_ptr<IDynamicsTerm> term) {
     terms_.push_back(std::move(term));
 }
@@ -110,9 +170,11 @@ void NewtonDynamics::Initialize(uint32 node_count, uint32 edge_count, uint32 fac
     edge_count_ = edge_count;
     face_count_ = face_count;
     workgroup_size_ = workgroup_size;
+    spmv_workgroup_size_ = WorkgroupTuner::GetInstance().GetSize(CGSolver::kSpMVKernel, workgroup_size);
     node_wg_count_ = (node_count + workgroup_size - 1) / workgroup_size;
     physics_buffer_ = physics_buffer;
     physics_size_ = physics_size;
+    mass_buffer_ = mass_buffer;
 
     BuildSparsity();
     CreateBuffers();
@@ -120,7 +182,8 @@ void NewtonDynamics::Initialize(uint32 node_count, uint32 edge_count, uint32 fac
 
     // Initialize CG solver
     cg_solver_ = std::make_unique<CGSolver>();
-    cg_solver_->Initialize(node_count, workgroup_size);
+    cg_solver_->Initialize(node_count, workgroup_size, spmv_workgroup_size_);
+    cg_solver_->SetConvergenceCheck(cg_convergence_check_);
 
     // Initialize SpMV operator
     spmv_ = std::make_unique<SpMVOperator>(*this);
@@ -132,19 +195,29 @@ void NewtonDynamics::Initialize(uint32 node_count, uint32 edge_count, uint32 fac
     ctx.position_buffer = position_buffer;
     ctx.velocity_buffer = velocity_buffer;
     ctx.mass_buffer = mass_buffer;
+    ctx.position_offset = uint64(node_offset_) * sizeof(SimPosition);
+    ctx.velocity_offset = uint64(node_offset_) * sizeof(SimVelocity);
+    ctx.mass_offset = uint64(node_offset_) * sizeof(SimMass);
     ctx.force_buffer = force_buffer_->GetHandle();
     ctx.diag_buffer = diag_values_buffer_->GetHandle();
     ctx.csr_values_buffer = csr_values_buffer_->GetHandle();
     ctx.params_buffer = params_buffer_->GetHandle();
     ctx.dv_total_buffer = dv_total_buffer_->GetHandle();
+    ctx.csr_row_ptr_buffer = csr_row_ptr_buffer_->GetHandle();
     ctx.node_count = node_count;
     ctx.edge_count = edge_count;
     ctx.workgroup_size = workgroup_size;
     ctx.params_size = sizeof(SolverParams);
 
+    // A gather-mode first term owns every CSR row and zeroes it in-kernel,
+    // which lets the per-iteration csr_values clear be dropped.
+    csr_zeroed_by_term_ = !terms_.empty()
+        && terms_.front()->GetAssemblyMode() == AssemblyMode::Gather;
+
     // Initialize terms with context for bind group caching
-    for (auto& term : terms_) {
-        term->Initialize(*sparsity_, ctx);
+    for (size_t i = 0; i < terms_.size(); ++i) {
+        ctx.zero_csr_rows = csr_zeroed_by_term_ && i == 0;
+        terms_[i]->Initialize(*sparsity_, ctx);
     }
 
     // Cache Newton and CG bind groups
@@ -173,6 +246,9 @@ void NewtonDynamics::CreateBuffers() {
     params_.node_count = node_count_;
     params_.edge_count = edge_count_;
     params_.face_count = face_count_;
+    params_.cg_max_iter = cg_max_iterations_;
+    params_.cg_tolerance = cg_tolerance_;
+    params_.cg_precond = static_cast<uint32>(cg_preconditioner_);
     params_buffer_ = std::make_unique<GPUBuffer<SolverParams>>(
         BufferUsage::Uniform, std::span<const SolverParams>(&params_, 1), "solver_params");
 
@@ -193,9 +269,9 @@ void NewtonDynamics::CreateBuffers() {
     diag_values_buffer_ = std::make_unique<GPUBuffer<float32>>(
         BufferConfig{.usage = srw, .size = uint64(node_count_) * 9 * sizeof(float32), .label = "diag_values"});
 
-    // Force buffer (atomic u32, N*4)
+    // Force buffer (f32, N*4)
     force_buffer_ = std::make_unique<GPUBuffer<float32>>(
-        BufferConfig{.usage = srw, .size = uint64(node_count_) * 4 * sizeof(int32), .label = "forces"});
+        BufferConfig{.usage = srw, .size = uint64(node_count_) * 4 * sizeof(float32), .label = "forces"});
 
     // Newton solver buffers
     x_old_buffer_ = std::make_unique<GPUBuffer<float32>>(
@@ -205,14 +281,17 @@ void NewtonDynamics::CreateBuffers() {
 }
 
 void NewtonDynamics::CreatePipelines() {
-    newton_init_pipeline_ = MakePipeline("newton_init.wgsl", "newton_init");
-    newton_predict_pos_pipeline_ = MakePipeline("newton_predict_pos.wgsl", "newton_predict_pos");
-    newton_accumulate_dv_pipeline_ = MakePipeline("newton_accumulate_dv.wgsl", "newton_accumulate_dv");
-    clear_forces_pipeline_ = MakePipeline("clear_forces.wgsl", "clear_forces");
-    assemble_rhs_pipeline_ = MakePipeline("assemble_rhs.wgsl", "assemble_rhs");
-    spmv_pipeline_ = MakePipeline("cg_spmv.wgsl", "cg_spmv");
-    inertia_pipeline_ = MakePipeline("inertia_assemble.wgsl", "inertia_assemble");
-    gravity_pipeline_ = MakePipeline("accumulate_gravity.wgsl", "accumulate_gravity");
+    PipelineBatch batch;
+    uint32 wg = workgroup_size_;
+    batch.Add(PipelineDesc("newton_init.wgsl", "newton_init", wg), newton_init_pipeline_);
+    batch.Add(PipelineDesc("newton_predict_pos.wgsl", "newton_predict_pos", wg), newton_predict_pos_pipeline_);
+    batch.Add(PipelineDesc("newton_accumulate_dv.wgsl", "newton_accumulate_dv", wg), newton_accumulate_dv_pipeline_);
+    batch.Add(PipelineDesc("clear_forces.wgsl", "clear_forces", wg), clear_forces_pipeline_);
+    batch.Add(PipelineDesc("assemble_rhs.wgsl", "assemble_rhs", wg), assemble_rhs_pipeline_);
+    batch.Add(PipelineDesc("cg_spmv.wgsl", "cg_spmv", spmv_workgroup_size_), spmv_pipeline_);
+    batch.Add(PipelineDesc("inertia_assemble.wgsl", "inertia_assemble", wg), inertia_pipeline_);
+    batch.Add(PipelineDesc("accumulate_gravity.wgsl", "accumulate_gravity", wg), gravity_pipeline_);
+    batch.Resolve();
 }
 
 void NewtonDynamics::CacheBindGroups(WGPUBuffer position_buffer,
@@ -223,6 +302,11 @@ void NewtonDynamics::CacheBindGroups(WGPUBuffer position_buffer,
     uint64 mass_sz = uint64(node_count_) * sizeof(simulate::SimMass);
     uint64 force_sz = uint64(node_count_) * 4 * sizeof(int32);
 
+    // Node region of the external buffers (non-zero for scoped systems)
+    uint64 pos_off = uint64(node_offset_) * sizeof(SimPosition);
+    uint64 vel_off = uint64(node_offset_) * sizeof(SimVelocity);
+    uint64 mass_off = uint64(node_offset_) * sizeof(SimMass);
+
     WGPUBuffer phys_h = physics_buffer_;
     uint64 phys_sz = physics_size_;
     WGPUBuffer params_h = params_buffer_->GetHandle();
@@ -235,15 +319,15 @@ void NewtonDynamics::CacheBindGroups(WGPUBuffer position_buffer,
     // Newton init bind group
     bg_newton_init_ = MakeBG(newton_init_pipeline_, "bg_newton_init",
         {{0, {params_h, params_sz}},
-         {1, {position_buffer, vec_sz}},
+         {1, {position_buffer, vec_sz, pos_off}},
          {2, {x_old_h, vec_sz}}, {3, {dv_total_h, vec_sz}}});
 
     // Predict positions bind group
     bg_predict_ = MakeBG(newton_predict_pos_pipeline_, "bg_predict",
         {{0, {phys_h, phys_sz}}, {1, {params_h, params_sz}},
-         {2, {position_buffer, vec_sz}},
-         {3, {x_old_h, vec_sz}}, {4, {velocity_buffer, vec_sz}},
-         {5, {dv_total_h, vec_sz}}, {6, {mass_buffer, mass_sz}}});
+         {2, {position_buffer, vec_sz, pos_off}},
+         {3, {x_old_h, vec_sz}}, {4, {velocity_buffer, vec_sz, vel_off}},
+         {5, {dv_total_h, vec_sz}}, {6, {mass_buffer, mass_sz, mass_off}}});
 
     // Clear forces bind group
     bg_clear_forces_ = MakeBG(clear_forces_pipeline_, "bg_clear_f",
@@ -254,7 +338,7 @@ void NewtonDynamics::CacheBindGroups(WGPUBuffer position_buffer,
     bg_rhs_ = MakeBG(assemble_rhs_pipeline_, "bg_rhs",
         {{0, {phys_h, phys_sz}}, {1, {params_h, params_sz}},
          {2, {force_h, force_sz}},
-         {3, {dv_total_h, vec_sz}}, {4, {mass_buffer, mass_sz}},
+         {3, {dv_total_h, vec_sz}}, {4, {mass_buffer, mass_sz, mass_off}},
          {5, {rhs_h, vec_sz}}});
 
     // Accumulate dv bind group
@@ -268,61 +352,83 @@ void NewtonDynamics::CacheBindGroups(WGPUBuffer position_buffer,
     bg_inertia_ = MakeBG(inertia_pipeline_, "bg_inertia",
         {{0, {params_h, params_sz}},
          {1, {diag_values_buffer_->GetHandle(), diag_sz}},
-         {2, {mass_buffer, mass_sz}}});
+         {2, {mass_buffer, mass_sz, mass_off}}});
 
     // Gravity: force += M * g
     bg_gravity_ = MakeBG(gravity_pipeline_, "bg_gravity",
         {{0, {phys_h, phys_sz}}, {1, {params_h, params_sz}},
          {2, {force_h, force_sz}},
-         {3, {mass_buffer, mass_sz}}});
+         {3, {mass_buffer, mass_sz, mass_off}}});
 
-    // Cache CG solver bind groups
-    cg_solver_->CacheBindGroups(phys_h, phys_sz, params_h, params_sz, mass_buffer, mass_sz, *spmv_);
+    CacheCGBindGroups();
 }
 
-void NewtonDynamics::Solve(WGPUCommandEncoder encoder) {
+// Also called when the preconditioner or the pipelined iteration changes after Initialize
+void NewtonDynamics::CacheCGBindGroups() {
+    if (!cg_solver_ || !spmv_) return;
+    uint64 mass_sz = uint64(node_count_) * sizeof(simulate::SimMass);
+    uint64 mass_off = uint64(node_offset_) * sizeof(SimMass);
     uint64 diag_sz = uint64(node_count_) * 9 * sizeof(float32);
+
+    // Block-Jacobi reads the assembled diagonal blocks
+    cg_solver_->SetPreconditioner(cg_preconditioner_);
+    cg_solver_->SetPipelined(cg_pipelined_);
+    cg_solver_->CacheBindGroups(physics_buffer_, physics_size_, params_buffer_->GetHandle(),
+                                sizeof(SolverParams), mass_buffer_, mass_sz, *spmv_,
+                                diag_values_buffer_->GetHandle(), diag_sz, mass_off);
+    solve_program_.Clear();
+}
+
+void NewtonDynamics::Solve(ComputePassRecorder& recorder) {
+    // Every command below only references cached pipelines, bind groups and buffers,
+    // so the sequence is identical each frame: capture once, replay thereafter.
+    if (solve_program_.IsEmpty()) {
+        ComputePassRecorder capture(solve_program_);
+        RecordSolve(capture);
+        LogInfo("NewtonDynamics: recorded solve program (", solve_program_.GetCommandCount(),
+                " commands, ", capture.GetDispatchCount(), " dispatches)");
+    }
+    solve_program_.Replay(recorder);
+}
+
+void NewtonDynamics::RecordSolve(ComputePassRecorder& recorder) {
     uint64 csr_val_sz = uint64(nnz_) * 9 * sizeof(float32);
-    WGPUBuffer diag_h = diag_values_buffer_->GetHandle();
 
     // ---- Newton Init: save x_old, zero dv_total ----
-    Dispatch(encoder, newton_init_pipeline_, bg_newton_init_, node_wg_count_);
+    recorder.Dispatch(newton_init_pipeline_, bg_newton_init_, node_wg_count_);
 
     // ---- Newton Outer Loop ----
     for (uint32 nit = 0; nit < newton_iterations_; ++nit) {
         // Predict positions: x_temp = x_old + dt*(v + dv_total)
-        Dispatch(encoder, newton_predict_pos_pipeline_, bg_predict_, node_wg_count_);
+        recorder.Dispatch(newton_predict_pos_pipeline_, bg_predict_, node_wg_count_);
 
         // Clear forces
-        Dispatch(encoder, clear_forces_pipeline_, bg_clear_forces_, node_wg_count_);
+        recorder.Dispatch(clear_forces_pipeline_, bg_clear_forces_, node_wg_count_);
 
-        // Clear diagonal Hessian buffer
-        wgpuCommandEncoderClearBuffer(encoder, diag_h, 0, diag_sz);
-
-        // Clear off-diagonal CSR values (if any edges)
-        if (csr_val_sz > 0) {
-            wgpuCommandEncoderClearBuffer(encoder, csr_values_buffer_->GetHandle(), 0, csr_val_sz);
+        // Clear off-diagonal CSR values (if any edges), unless a gather term zeroes its rows
+        if (csr_val_sz > 0 && !csr_zeroed_by_term_) {
+            recorder.ClearBuffer(csr_values_buffer_->GetHandle(), 0, csr_val_sz);
         }
 
-        // Inertial contribution: diag += M * I3x3 (hardcoded, always required)
-        Dispatch(encoder, inertia_pipeline_, bg_inertia_, node_wg_count_);
+        // Inertial contribution: diag = M * I3x3 (writes full blocks, so no diag clear)
+        recorder.Dispatch(inertia_pipeline_, bg_inertia_, node_wg_count_);
 
         // Gravity: force += M * g (hardcoded, always required)
-        Dispatch(encoder, gravity_pipeline_, bg_gravity_, node_wg_count_);
+        recorder.Dispatch(gravity_pipeline_, bg_gravity_, node_wg_count_);
 
         // Assemble contributions from all terms (using cached bind groups)
         for (auto& term : terms_) {
-            term->Assemble(encoder);
+            term->Assemble(recorder);
         }
 
         // Assemble RHS: b = dt*F - M*dv_total → writes to CG r buffer
-        Dispatch(encoder, assemble_rhs_pipeline_, bg_rhs_, node_wg_count_);
+        recorder.Dispatch(assemble_rhs_pipeline_, bg_rhs_, node_wg_count_);
 
         // CG Solve (uses cached bind groups)
-        cg_solver_->Solve(encoder, cg_max_iterations_);
+        cg_solver_->Solve(recorder, cg_max_iterations_);
 
         // Accumulate CG solution: dv_total += cg_x
-        Dispatch(encoder, newton_accumulate_dv_pipeline_, bg_accumulate_, node_wg_count_);
+        recorder.Dispatch(newton_accumulate_dv_pipeline_, bg_accumulate_, node_wg_count_);
     }
 }
 
@@ -347,6 +453,8 @@ uint64 NewtonDynamics::GetVec4BufferSize() const {
 }
 
 void NewtonDynamics::Shutdown() {
+    solve_program_.Clear();
+
     for (auto& term : terms_) {
         term->Shutdown();
     }
@@ -371,10 +479,12 @@ void NewtonDynamics::Shutdown() {
     clear_forces_pipeline_ = {};
     assemble_rhs_pipeline_ = {};
     spmv_pipeline_ = {};
+    spmv_dot_pipeline_ = {};
     inertia_pipeline_ = {};
     gravity_pipeline_ = {};
 
     params_buffer_.reset();
+    mass_buffer_ = nullptr;
     csr_row_ptr_buffer_.reset();
     csr_col_idx_buffer_.reset();
     csr_values_buffer_.reset();
@@ -5,6 +5,7 @@
 #include "core_simulate/solver_params.h"
 #include "core_gpu/gpu_handle.h"
 #include "core_gpu/gpu_buffer.h"
+#include "core_gpu/compute_program.h"
 #include <memory>
 #include <string>
 #include <vector>
@@ -27,9 +28,19 @@ public:
     // Add a dynamics term (call before Initialize)
     void AddTerm(std::unique_ptr<IDynamicsTerm> term);
 
-    // Configure solver iterations (call before Initialize or anytime)
-    void SetNewtonIterations(uint32 iterations) { newton_iterations_ = iterations; }
-    void SetCGMaxIterations(uint32 iterations) { cg_max_iterations_ = iterations; }
+    // Configure solver iterations (call before Initialize or anytime).
+    // After Initialize, changes are written to the solver params uniform; those that
+    // alter the dispatch sequence or the CG bind groups invalidate the recorded solve program.
+    void SetNewtonIterations(uint32 iterations) { newton_iterations_ = iterations; solve_program_.Clear(); }
+    void SetCGMaxIterations(uint32 iterations);
+    void SetCGTolerance(float32 tolerance);
+    void SetCGConvergenceCheck(bool enabled);
+    void SetCGPreconditioner(CGPreconditioner preconditioner);
+    void SetCGPipelined(bool enabled);
+
+    // First node of this system in the position/velocity/mass buffers (call before
+    // Initialize). Scoped systems bind their region of the shared DeviceDB buffers.
+    void SetNodeOffset(uint32 node_offset) { node_offset_ = node_offset; }
 
     // Initialize after all terms are added.
     // physics_buffer: DeviceDB singleton uniform (binding 0).
@@ -40,9 +51,11 @@ public:
                     WGPUBuffer mass_buffer, uint32 workgroup_size = 64);
 
     // Run the Newton-Raphson solver for one timestep.
-    // Records all compute passes into encoder using cached bind groups.
+    // The dispatch sequence is captured into a ComputeProgram on the first call and
+    // replayed into the recorder afterwards; passes are only split at the per-iteration
+    // Hessian clears and inside the CG solver.
     // Caller must submit the encoder and handle readback.
-    void Solve(WGPUCommandEncoder encoder);
+    void Solve(gpu::ComputePassRecorder& recorder);
 
     // Result buffers (valid after Initialize)
     [[nodiscard]] WGPUBuffer GetDVTotalBuffer() const;
@@ -59,6 +72,9 @@ private:
     void CreatePipelines();
     void CacheBindGroups(WGPUBuffer position_buffer, WGPUBuffer velocity_buffer,
                          WGPUBuffer mass_buffer);
+    void CacheCGBindGroups();
+    void WriteSolverParams();
+    void RecordSolve(gpu::ComputePassRecorder& recorder);
 
     // Terms
     std::vector<std::unique_ptr<IDynamicsTerm>> terms_;
@@ -72,16 +88,26 @@ private:
     uint32 edge_count_ = 0;
     uint32 face_count_ = 0;
     uint32 workgroup_size_ = 64;
+    uint32 spmv_workgroup_size_ = 64;   // tuned per adapter (CGSolver::kSpMVKernel)
     uint32 node_wg_count_ = 0;
+    uint32 node_offset_ = 0;
 
     // Newton config
     uint32 newton_iterations_ = 1;
     uint32 cg_max_iterations_ = 30;
+    float32 cg_tolerance_ = 1e-6f;
+    bool cg_convergence_check_ = true;
+    CGPreconditioner cg_preconditioner_ = CGPreconditioner::None;
+    bool cg_pipelined_ = false;
+    bool csr_zeroed_by_term_ = false;  // first term gathers and zeroes CSR rows itself
 
     // Physics uniform (non-owning, from DeviceDB)
     WGPUBuffer physics_buffer_ = nullptr;
     uint64 physics_size_ = 0;
 
+    // Mass buffer (non-owning), kept to rebuild the CG bind groups on a config change
+    WGPUBuffer mass_buffer_ = nullptr;
+
     // Solver params uniform
     std::unique_ptr<gpu::GPUBuffer<SolverParams>> params_buffer_;
     SolverParams params_{};
@@ -92,7 +118,7 @@ private:
     std::unique_ptr<gpu::GPUBuffer<float32>> csr_values_buffer_;
     std::unique_ptr<gpu::GPUBuffer<float32>> diag_values_buffer_;
 
-    // Force buffer (atomic u32 for CAS-based float accumulation)
+    // Force buffer (f32, accumulated by colored term dispatches)
     std::unique_ptr<gpu::GPUBuffer<float32>> force_buffer_;
 
     // Newton solver buffers
@@ -108,11 +134,20 @@ private:
         explicit SpMVOperator(NewtonDynamics& owner);
         void PrepareSolve(WGPUBuffer p_buffer, uint64 p_size,
                           WGPUBuffer ap_buffer, uint64 ap_size) override;
-        void Apply(WGPUCommandEncoder encoder, uint32 workgroup_count) override;
+        void Apply(gpu::ComputePassRecorder& recorder, uint32 workgroup_count) override;
+        void ApplyIndirect(gpu::ComputePassRecorder& recorder,
+                           WGPUBuffer indirect_buffer, uint64 indirect_offset) override;
+        bool PrepareFusedSolve(WGPUBuffer u_buffer, WGPUBuffer w_buffer,
+                               WGPUBuffer r_buffer, uint64 vec_size,
+                               WGPUBuffer partial_buffer, uint64 partial_size) override;
+        void ApplyFused(gpu::ComputePassRecorder& recorder, uint32 workgroup_count) override;
+        void ApplyFusedIndirect(gpu::ComputePassRecorder& recorder,
+                                WGPUBuffer indirect_buffer, uint64 indirect_offset) override;
 
     private:
         NewtonDynamics& owner_;
         gpu::GPUBindGroup bind_group_;
+        gpu::GPUBindGroup fused_bind_group_;
     };
     std::unique_ptr<SpMVOperator> spmv_;
 
@@ -123,6 +158,7 @@ private:
     gpu::GPUComputePipeline clear_forces_pipeline_;
     gpu::GPUComputePipeline assemble_rhs_pipeline_;
     gpu::GPUComputePipeline spmv_pipeline_;
+    gpu::GPUComputePipeline spmv_dot_pipeline_;   // pipelined CG only
     gpu::GPUComputePipeline inertia_pipeline_;
     gpu::GPUComputePipeline gravity_pipeline_;
 
@@ -135,6 +171,9 @@ private:
     gpu::GPUBindGroup bg_inertia_;
     gpu::GPUBindGroup bg_gravity_;
 
+    // Captured Solve() dispatch sequence (rebuilt lazily when cleared)
+    gpu::ComputeProgram solve_program_{"newton_step"};
+
     static constexpr uint32 kWorkgroupSize = 64;
 };
 
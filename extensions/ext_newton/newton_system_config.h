@@ -20,8 +20,11 @@ struct NewtonSystemConfig {
     uint32 constraint_entities[MAX_CONSTRAINTS] = {};
 
     uint32 mesh_entity        = database::kInvalidEntity;  // kInvalidEntity = global mode, valid entity = scoped
-    uint32 padding[3]         = {};
-    // Total: 64 bytes
+    uint32 cg_convergence_check = 1;  // 1 = stop CG once rr <= tol^2 * rr0
+    uint32 cg_preconditioner  = 0;    // 0 = none, 1 = block-Jacobi (3x3 diagonal blocks)
+    uint32 cg_pipelined       = 0;    // 1 = pipelined CG (3 dispatches per iteration)
+    uint32 backend            = 0;    // SolverBackend: 0 = GPU, 1 = CPU reference backend
+    // Total: 68 bytes
 };
 
 }  // namespace ext_newton
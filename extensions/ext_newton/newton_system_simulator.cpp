@@ -1,6 +1,8 @@
 #include "ext_newton/newton_system_simulator.h"
 #include "ext_newton/newton_system_config.h"
 #include "ext_newton/newton_dynamics.h"
+#include "ext_newton/host_newton_dynamics.h"
+#include "ext_dynamics/host_node_state.h"
 #include "core_simulate/simulate_config.h"
 #include "core_simulate/dynamics_term_provider.h"
 #include "ext_dynamics/global_physics_params.h"
@@ -8,9 +10,10 @@
 #include "core_system/system.h"
 #include "core_database/component_storage.h"
 #include "core_gpu/gpu_core.h"
-#include "core_gpu/shader_loader.h"
+#include "core_gpu/pipeline_registry.h"
 #include "core_gpu/bind_group_builder.h"
-#include "core_gpu/compute_encoder.h"
+#include "core_gpu/compute_pass_recorder.h"
+#include "core_gpu/gpu_readback.h"
 #include "core_util/logger.h"
 #include <webgpu/webgpu.h>
 
@@ -30,11 +33,11 @@ const std::string NewtonSystemSimulator::kName = "NewtonSystemSimulator";
 
 static GPUBindGroup MakeBindGroup(const GPUComputePipeline& pipeline,
                                    const std::string& label,
-                                   std::initializer_list<std::pair<uint32, std::pair<WGPUBuffer, uint64>>> entries) {
+                                   std::initializer_list<std::pair<uint32, BufferBinding>> entries) {
     auto bgl = wgpuComputePipelineGetBindGroupLayout(pipeline.GetHandle(), 0);
     auto builder = BindGroupBuilder(label);
-    for (auto& [binding, buf_size] : entries) {
-        builder = std::move(builder).AddBuffer(binding, buf_size.first, buf_size.second);
+    for (auto& [binding, buf] : entries) {
+        builder = std::move(builder).AddBuffer(binding, buf.buffer, buf.size, buf.offset);
     }
     auto bg = std::move(builder).Build(bgl);
     wgpuBindGroupLayoutRelease(bgl);
@@ -78,6 +81,11 @@ void NewtonSystemSimulator::Initialize() {
     const auto* config = db.GetComponent<NewtonSystemConfig>(config_entity);
     if (!config) return;
 
+    if (static_cast<SolverBackend>(config->backend) == SolverBackend::CPU) {
+        InitializeHost(*config);
+        return;
+    }
+
     // Determine node count and buffer handles (scoped vs global mode)
     WGPUBuffer pos_h, vel_h, mass_h;
 
@@ -104,42 +112,21 @@ void NewtonSystemSimulator::Initialize() {
             return;
         }
 
-        // Create local GPU buffers
-        auto& gpu_local = GPUCore::GetInstance();
-        auto create_buf = [&](uint64 size) -> WGPUBuffer {
-            WGPUBufferDescriptor bd = WGPU_BUFFER_DESCRIPTOR_INIT;
-            bd.usage = WGPUBufferUsage_Storage | WGPUBufferUsage_CopySrc | WGPUBufferUsage_CopyDst;
-            bd.size = size;
-            return wgpuDeviceCreateBuffer(gpu_local.GetDevice(), &bd);
-        };
-
-        uint64 pos_bytes = uint64(node_count_) * sizeof(SimPosition);
-        uint64 vel_bytes = uint64(node_count_) * sizeof(SimVelocity);
-        uint64 mass_bytes = uint64(node_count_) * sizeof(SimMass);
-
-        local_pos_ = create_buf(pos_bytes);
-        local_vel_ = create_buf(vel_bytes);
-        local_mass_ = create_buf(mass_bytes);
-
-        // Cache global handles for copy-in/copy-out
-        global_pos_ = system_.GetDeviceBuffer<SimPosition>();
-        global_vel_ = system_.GetDeviceBuffer<SimVelocity>();
-        WGPUBuffer global_mass = system_.GetDeviceBuffer<SimMass>();
-
-        // Copy mass once (immediate) — mass doesn't change at runtime
-        uint64 mass_offset = uint64(node_offset_) * sizeof(SimMass);
-        WGPUCommandEncoderDescriptor me_desc = WGPU_COMMAND_ENCODER_DESCRIPTOR_INIT;
-        WGPUCommandEncoder me = wgpuDeviceCreateCommandEncoder(gpu_local.GetDevice(), &me_desc);
-        wgpuCommandEncoderCopyBufferToBuffer(me, global_mass, mass_offset, local_mass_, 0, mass_bytes);
-        WGPUCommandBuffer mc = wgpuCommandEncoderFinish(me, nullptr);
-        wgpuQueueSubmit(gpu_local.GetQueue(), 1, &mc);
-        wgpuCommandBufferRelease(mc);
-        wgpuCommandEncoderRelease(me);
+        // Bind the mesh's region of the global buffers in place (no per-frame copies).
+        // DeviceDB starts node regions on kNodeRegionAlignment, which satisfies the
+        // storage offset alignment for every node array.
+        uint32 alignment = GPUCore::GetInstance().GetMinStorageBufferOffsetAlignment();
+        if ((uint64(node_offset_) * sizeof(SimPosition)) % alignment != 0 ||
+            (uint64(node_offset_) * sizeof(SimMass)) % alignment != 0) {
+            LogError("NewtonSystemSimulator: node region offset ", node_offset_,
+                     " is not storage-offset aligned");
+            return;
+        }
 
         scoped_ = true;
-        pos_h = local_pos_;
-        vel_h = local_vel_;
-        mass_h = local_mass_;
+        pos_h = system_.GetDeviceBuffer<SimPosition>();
+        vel_h = system_.GetDeviceBuffer<SimVelocity>();
+        mass_h = system_.GetDeviceBuffer<SimMass>();
     } else {
         // Global mode (all nodes)
         node_count_ = system_.GetArrayTotalCount<SimPosition>();
@@ -187,25 +174,23 @@ void NewtonSystemSimulator::Initialize() {
     // Store Newton config iterations
     dynamics_->SetNewtonIterations(config->newton_iterations);
     dynamics_->SetCGMaxIterations(config->cg_max_iterations);
+    dynamics_->SetCGTolerance(config->cg_tolerance);
+    dynamics_->SetCGConvergenceCheck(config->cg_convergence_check != 0);
+    dynamics_->SetCGPreconditioner(static_cast<CGPreconditioner>(config->cg_preconditioner));
+    dynamics_->SetCGPipelined(config->cg_pipelined != 0);
+    dynamics_->SetNodeOffset(node_offset_);
 
     // Initialize dynamics solver with physics + external buffer handles
     dynamics_->Initialize(node_count_, total_edge_count, total_face_count,
-                          physics_h, physics_sz, pos_h, vel_h, mass_h);
+                          physics_h, physics_sz, pos_h, vel_h, mass_h, kWorkgroupSize);
 
     // Create velocity/position update pipelines
-    auto make_pipeline = [](const std::string& shader_path, const std::string& label) -> GPUComputePipeline {
-        auto shader = ShaderLoader::CreateModule("ext_newton/" + shader_path, label);
-        WGPUComputePipelineDescriptor desc = WGPU_COMPUTE_PIPELINE_DESCRIPTOR_INIT;
-        desc.label = {label.data(), label.size()};
-        desc.layout = nullptr;
-        desc.compute.module = shader.GetHandle();
-        std::string entry = "cs_main";
-        desc.compute.entryPoint = {entry.data(), entry.size()};
-        return GPUComputePipeline(wgpuDeviceCreateComputePipeline(GPUCore::GetInstance().GetDevice(), &desc));
-    };
-
-    update_velocity_pipeline_ = make_pipeline("update_velocity.wgsl", "newton_update_velocity");
-    update_position_pipeline_ = make_pipeline("update_position.wgsl", "newton_update_position");
+    PipelineBatch batch;
+    batch.Add(ComputePipelineDesc{"ext_newton/update_velocity.wgsl", "newton_update_velocity"}
+                  .SetWorkgroupSize(kWorkgroupSize), update_velocity_pipeline_);
+    batch.Add(ComputePipelineDesc{"ext_newton/update_position.wgsl", "newton_update_position"}
+                  .SetWorkgroupSize(kWorkgroupSize), update_position_pipeline_);
+    batch.Resolve();
 
     // Cache velocity/position update bind groups
     uint64 params_sz = dynamics_->GetParamsSize();
@@ -213,17 +198,21 @@ void NewtonSystemSimulator::Initialize() {
     uint64 mass_sz_bg = uint64(node_count_) * sizeof(SimMass);
     uint64 vel_sz = uint64(node_count_) * sizeof(SimVelocity);
     uint64 pos_sz = uint64(node_count_) * sizeof(SimPosition);
+    uint64 mass_off = uint64(node_offset_) * sizeof(SimMass);
+    uint64 vel_off = uint64(node_offset_) * sizeof(SimVelocity);
+    uint64 pos_off = uint64(node_offset_) * sizeof(SimPosition);
     WGPUBuffer params_h_bg = dynamics_->GetParamsBuffer();
     WGPUBuffer dv_total_h = dynamics_->GetDVTotalBuffer();
     WGPUBuffer x_old_h = dynamics_->GetXOldBuffer();
 
     bg_vel_ = MakeBindGroup(update_velocity_pipeline_, "bg_vel",
         {{0, {physics_h, physics_sz}}, {1, {params_h_bg, params_sz}},
-         {2, {vel_h, vel_sz}}, {3, {dv_total_h, vec_sz}}, {4, {mass_h, mass_sz_bg}}});
+         {2, {vel_h, vel_sz, vel_off}}, {3, {dv_total_h, vec_sz}},
+         {4, {mass_h, mass_sz_bg, mass_off}}});
     bg_pos_ = MakeBindGroup(update_position_pipeline_, "bg_pos",
         {{0, {physics_h, physics_sz}}, {1, {params_h_bg, params_sz}},
-         {2, {pos_h, pos_sz}}, {3, {x_old_h, vec_sz}},
-         {4, {vel_h, vel_sz}}, {5, {mass_h, mass_sz_bg}}});
+         {2, {pos_h, pos_sz, pos_off}}, {3, {x_old_h, vec_sz}},
+         {4, {vel_h, vel_sz, vel_off}}, {5, {mass_h, mass_sz_bg, mass_off}}});
 
     topology_sig_ = ComputeTopologySignature();
     initialized_ = true;
@@ -231,18 +220,90 @@ void NewtonSystemSimulator::Initialize() {
             total_edge_count, " edges, ", dynamics_ ? "solver ready" : "no solver", ")");
 }
 
+// ============================================================================
+// CPU backend
+// ============================================================================
+
+void NewtonSystemSimulator::InitializeHost(const NewtonSystemConfig& config) {
+    const auto& db = system_.GetDatabase();
+
+    if (config.mesh_entity != database::kInvalidEntity) {
+        mesh_entity_ = config.mesh_entity;
+        auto* pos_entry = system_.GetArrayEntryById(GetComponentTypeId<SimPosition>());
+        node_offset_ = pos_entry ? pos_entry->GetEntityOffset(mesh_entity_) : UINT32_MAX;
+        if (node_offset_ == UINT32_MAX) {
+            LogError("NewtonSystemSimulator: mesh entity ", mesh_entity_, " not in SimPosition");
+            return;
+        }
+        scoped_ = true;
+    }
+
+    host_state_ = std::make_unique<ext_dynamics::HostNodeState>();
+    if (!ext_dynamics::GatherHostNodes(system_, config.mesh_entity, *host_state_)) {
+        LogError("NewtonSystemSimulator: no SimPosition nodes for the CPU backend");
+        host_state_.reset();
+        return;
+    }
+    node_count_ = host_state_->GetNodeCount();
+    host_initial_ = std::make_unique<ext_dynamics::HostNodeState>(*host_state_);
+
+    host_dynamics_ = std::make_unique<HostNewtonDynamics>();
+    for (uint32 i = 0; i < config.constraint_count; ++i) {
+        Entity constraint_entity = config.constraint_entities[i];
+        for (auto* provider : system_.FindAllTermProviders(constraint_entity)) {
+            auto term = provider->CreateTerm(db, constraint_entity, node_count_);
+            if (term) {
+                LogInfo("NewtonSystemSimulator: added host term '", term->GetName(), "'");
+                host_dynamics_->AddTerm(std::move(term));
+            }
+        }
+    }
+
+    host_dynamics_->SetNewtonIterations(config.newton_iterations);
+    host_dynamics_->SetCGMaxIterations(config.cg_max_iterations);
+    host_dynamics_->SetCGTolerance(config.cg_tolerance);
+    host_dynamics_->SetCGConvergenceCheck(config.cg_convergence_check != 0);
+    host_dynamics_->SetCGPreconditioner(static_cast<CGPreconditioner>(config.cg_preconditioner));
+    host_dynamics_->Initialize(node_count_);
+
+    topology_sig_ = ComputeTopologySignature();
+    initialized_ = true;
+    LogInfo("NewtonSystemSimulator: initialized on CPU backend (", node_count_, " nodes)");
+}
+
+void NewtonSystemSimulator::UpdateHost() {
+    const auto& physics = system_.GetDatabase().GetSingleton<GlobalPhysicsParams>();
+    host_dynamics_->Step(*host_state_, ToGPU(physics));
+    ext_dynamics::PublishHostNodes(system_, scoped_ ? mesh_entity_ : database::kInvalidEntity,
+                                   node_offset_, *host_state_);
+}
+
+void NewtonSystemSimulator::OnReset() {
+    if (!host_state_ || !host_initial_) return;
+    *host_state_ = *host_initial_;
+    ext_dynamics::PublishHostNodes(system_, scoped_ ? mesh_entity_ : database::kInvalidEntity,
+                                   node_offset_, *host_state_);
+}
+
+bool NewtonSystemSimulator::RequiresGPU() const {
+    const auto* storage = system_.GetDatabase().GetStorageById(GetComponentTypeId<NewtonSystemConfig>());
+    if (!storage || storage->GetDenseCount() == 0) return false;   // nothing to run
+    const auto& entities =
+        static_cast<const ComponentStorage<NewtonSystemConfig>*>(storage)->GetEntities();
+    const auto* config = system_.GetDatabase().GetComponent<NewtonSystemConfig>(entities[0]);
+    return !config || static_cast<SolverBackend>(config->backend) != SolverBackend::CPU;
+}
+
 // ============================================================================
 // Update (per frame)
 // ============================================================================
 
 void NewtonSystemSimulator::Update() {
-    if (!initialized_ || !dynamics_) return;
-
-    Timer profile_timer;
-    if constexpr (kEnableSimulationProfiling) {
-        WaitForGPU();
-        profile_timer.Start();
+    if (initialized_ && host_dynamics_) {
+        UpdateHost();
+        return;
     }
+    if (!initialized_ || !dynamics_) return;
 
     auto& gpu = GPUCore::GetInstance();
     uint32 node_wg = (node_count_ + kWorkgroupSize - 1) / kWorkgroupSize;
@@ -252,47 +313,19 @@ void NewtonSystemSimulator::Update() {
     enc_desc.label = {"newton_compute", 14};
     WGPUCommandEncoder encoder = wgpuDeviceCreateCommandEncoder(gpu.GetDevice(), &enc_desc);
 
-    // Copy-in: global → local (scoped mode)
-    if (scoped_) {
-        uint64 pos_off = uint64(node_offset_) * sizeof(SimPosition);
-        uint64 vel_off = uint64(node_offset_) * sizeof(SimVelocity);
-        uint64 pos_sz = uint64(node_count_) * sizeof(SimPosition);
-        uint64 vel_sz_copy = uint64(node_count_) * sizeof(SimVelocity);
-        wgpuCommandEncoderCopyBufferToBuffer(encoder, global_pos_, pos_off, local_pos_, 0, pos_sz);
-        wgpuCommandEncoderCopyBufferToBuffer(encoder, global_vel_, vel_off, local_vel_, 0, vel_sz_copy);
-    }
+    ComputePassRecorder recorder(encoder, "newton_step");
 
     // Solve dynamics (computes dv_total, uses cached bind groups)
-    dynamics_->Solve(encoder);
-
-    auto dispatch = [&](const GPUComputePipeline& pipeline, const GPUBindGroup& bg, uint32 wg_count) {
-        WGPUComputePassDescriptor pd = WGPU_COMPUTE_PASS_DESCRIPTOR_INIT;
-        WGPUComputePassEncoder pass = wgpuCommandEncoderBeginComputePass(encoder, &pd);
-        ComputeEncoder enc(pass);
-        enc.SetPipeline(pipeline.GetHandle());
-        enc.SetBindGroup(0, bg.GetHandle());
-        enc.Dispatch(wg_count);
-        wgpuComputePassEncoderEnd(pass);
-        wgpuComputePassEncoderRelease(pass);
-    };
+    dynamics_->Solve(recorder);
 
     // Update velocity: v = (v + dv_total) * damping
-    dispatch(update_velocity_pipeline_, bg_vel_, node_wg);
+    recorder.Dispatch(update_velocity_pipeline_, bg_vel_, node_wg);
 
     // Update position: pos = x_old + vel * dt
-    dispatch(update_position_pipeline_, bg_pos_, node_wg);
-
-    // Copy-out: local → global (scoped mode)
-    if (scoped_) {
-        uint64 pos_off = uint64(node_offset_) * sizeof(SimPosition);
-        uint64 vel_off = uint64(node_offset_) * sizeof(SimVelocity);
-        uint64 pos_sz = uint64(node_count_) * sizeof(SimPosition);
-        uint64 vel_sz_copy = uint64(node_count_) * sizeof(SimVelocity);
-        wgpuCommandEncoderCopyBufferToBuffer(encoder, local_pos_, 0, global_pos_, pos_off, pos_sz);
-        wgpuCommandEncoderCopyBufferToBuffer(encoder, local_vel_, 0, global_vel_, vel_off, vel_sz_copy);
-    }
+    recorder.Dispatch(update_position_pipeline_, bg_pos_, node_wg);
 
     // Submit
+    recorder.Flush();
     WGPUCommandBuffer cmd = wgpuCommandEncoderFinish(encoder, nullptr);
     wgpuQueueSubmit(gpu.GetQueue(), 1, &cmd);
     wgpuCommandBufferRelease(cmd);
@@ -300,55 +333,21 @@ void NewtonSystemSimulator::Update() {
 
     // Debug: log sample node positions for first 20 frames
     if (debug_frame_ < 20) {
-        WaitForGPU();
-        WGPUBuffer pos_buf = scoped_ ? local_pos_ : system_.GetDeviceBuffer<SimPosition>();
+        WGPUBuffer pos_buf = system_.GetDeviceBuffer<SimPosition>();
         uint32 sample_node = std::min(uint32(2048), node_count_ - 1);
-        uint64 read_offset = uint64(sample_node) * sizeof(SimPosition);
+        uint64 read_offset = uint64(node_offset_ + sample_node) * sizeof(SimPosition);
         uint64 read_size = sizeof(SimPosition);
 
-        auto& gpu_rb = GPUCore::GetInstance();
-        WGPUBufferDescriptor bd = WGPU_BUFFER_DESCRIPTOR_INIT;
-        bd.usage = WGPUBufferUsage_MapRead | WGPUBufferUsage_CopyDst;
-        bd.size = read_size;
-        WGPUBuffer staging = wgpuDeviceCreateBuffer(gpu_rb.GetDevice(), &bd);
-
-        WGPUCommandEncoderDescriptor ed = WGPU_COMMAND_ENCODER_DESCRIPTOR_INIT;
-        WGPUCommandEncoder enc_rb = wgpuDeviceCreateCommandEncoder(gpu_rb.GetDevice(), &ed);
-        wgpuCommandEncoderCopyBufferToBuffer(enc_rb, pos_buf, read_offset, staging, 0, read_size);
-        WGPUCommandBuffer cb = wgpuCommandEncoderFinish(enc_rb, nullptr);
-        wgpuQueueSubmit(gpu_rb.GetQueue(), 1, &cb);
-        wgpuCommandBufferRelease(cb);
-        wgpuCommandEncoderRelease(enc_rb);
-
-        WaitForGPU();
-        struct Ctx { bool done = false; };
-        Ctx map_ctx;
-        WGPUBufferMapCallbackInfo mi = WGPU_BUFFER_MAP_CALLBACK_INFO_INIT;
-        mi.mode = WGPUCallbackMode_WaitAnyOnly;
-        mi.callback = [](WGPUMapAsyncStatus, WGPUStringView, void* ud, void*) {
-            static_cast<Ctx*>(ud)->done = true;
-        };
-        mi.userdata1 = &map_ctx;
-        WGPUFuture future = wgpuBufferMapAsync(staging, WGPUMapMode_Read, 0, read_size, mi);
-        WGPUFutureWaitInfo wi = WGPU_FUTURE_WAIT_INFO_INIT;
-        wi.future = future;
-        wgpuInstanceWaitAny(gpu_rb.GetWGPUInstance(), 1, &wi, UINT64_MAX);
-
-        const float32* p = static_cast<const float32*>(
-            wgpuBufferGetConstMappedRange(staging, 0, read_size));
-        LogInfo("[Newton] frame=", debug_frame_, " node=", sample_node,
-                " pos=(", p[0], ", ", p[1], ", ", p[2], ")");
-        wgpuBufferUnmap(staging);
-        wgpuBufferRelease(staging);
+        // Delivered a frame or two later; the log line carries the frame it was taken on
+        GPUReadback::GetInstance().Request(pos_buf, read_offset, read_size,
+            [frame = debug_frame_, sample_node](std::span<const uint8> data) {
+                if (data.size() < 3 * sizeof(float32)) return;
+                const float32* p = reinterpret_cast<const float32*>(data.data());
+                LogInfo("[Newton] frame=", frame, " node=", sample_node,
+                        " pos=(", p[0], ", ", p[1], ", ", p[2], ")");
+            });
         debug_frame_++;
     }
-
-    if constexpr (kEnableSimulationProfiling) {
-        WaitForGPU();
-        profile_timer.Stop();
-        LogInfo("[Profile] ", kName, "::Update: ",
-                profile_timer.GetElapsedMilliseconds(), " ms");
-    }
 }
 
 // ============================================================================
@@ -414,18 +413,16 @@ void NewtonSystemSimulator::OnDatabaseChanged() {
 void NewtonSystemSimulator::Shutdown() {
     if (dynamics_) dynamics_->Shutdown();
     dynamics_.reset();
+    if (host_dynamics_) host_dynamics_->Shutdown();
+    host_dynamics_.reset();
+    host_state_.reset();
+    host_initial_.reset();
 
     bg_vel_ = {};
     bg_pos_ = {};
     update_velocity_pipeline_ = {};
     update_position_pipeline_ = {};
 
-    // Release scoped local buffers
-    if (local_pos_) { wgpuBufferRelease(local_pos_); local_pos_ = nullptr; }
-    if (local_vel_) { wgpuBufferRelease(local_vel_); local_vel_ = nullptr; }
-    if (local_mass_) { wgpuBufferRelease(local_mass_); local_mass_ = nullptr; }
-    global_pos_ = nullptr;
-    global_vel_ = nullptr;
     scoped_ = false;
     mesh_entity_ = database::kInvalidEntity;
     node_offset_ = 0;
@@ -10,11 +10,14 @@ struct WGPUBufferImpl;  typedef WGPUBufferImpl* WGPUBuffer;
 
 namespace mps {
 namespace system { class System; }
-namespace simulate { class NewtonDynamics; }
+namespace simulate { class NewtonDynamics; class HostNewtonDynamics; }
 }
+namespace ext_dynamics { struct HostNodeState; }
 
 namespace ext_newton {
 
+struct NewtonSystemConfig;
+
 // Generic Newton-Raphson dynamics simulator.
 // Discovers constraint terms from entity references in NewtonSystemConfig,
 // then runs the Newton solver and integrates velocity/position.
@@ -28,13 +31,25 @@ public:
     void Update() override;
     void Shutdown() override;
     void OnDatabaseChanged() override;
+    void OnReset() override;
+    [[nodiscard]] bool RequiresGPU() const override;
 
 private:
+    // CPU backend (NewtonSystemConfig::backend == SolverBackend::CPU)
+    void InitializeHost(const NewtonSystemConfig& config);
+    void UpdateHost();
+
     mps::system::System& system_;
 
     // Dynamics solver (Newton-Raphson + CG + pluggable terms)
     std::unique_ptr<mps::simulate::NewtonDynamics> dynamics_;
 
+    // CPU backend: host solver and node state (published per frame), plus the gathered
+    // initial state for OnReset (a host-only System overwrites the Database copy)
+    std::unique_ptr<mps::simulate::HostNewtonDynamics> host_dynamics_;
+    std::unique_ptr<ext_dynamics::HostNodeState> host_state_;
+    std::unique_ptr<ext_dynamics::HostNodeState> host_initial_;
+
     // Velocity/position update pipelines
     mps::gpu::GPUComputePipeline update_velocity_pipeline_;
     mps::gpu::GPUComputePipeline update_position_pipeline_;
@@ -49,12 +64,8 @@ private:
     bool initialized_ = false;
     mps::uint32 debug_frame_ = 0;
 
-    // Scoped mode (mesh_entity != kInvalidEntity): local buffer copy
-    WGPUBuffer local_pos_ = nullptr;
-    WGPUBuffer local_vel_ = nullptr;
-    WGPUBuffer local_mass_ = nullptr;
-    WGPUBuffer global_pos_ = nullptr;
-    WGPUBuffer global_vel_ = nullptr;
+    // Scoped mode (mesh_entity != kInvalidEntity): the solver binds this node region
+    // of the global DeviceDB buffers
     mps::uint32 mesh_entity_ = mps::database::kInvalidEntity;
     mps::uint32 node_offset_ = 0;
     bool scoped_ = false;
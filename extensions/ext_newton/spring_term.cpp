@@ -1,10 +1,14 @@
 #include "ext_newton/spring_term.h"
 #include "core_gpu/gpu_core.h"
-#include "core_gpu/shader_loader.h"
+#include "core_gpu/pipeline_registry.h"
 #include "core_gpu/bind_group_builder.h"
-#include "core_gpu/compute_encoder.h"
+#include "core_gpu/compute_pass_recorder.h"
+#include "core_gpu/workgroup_tuner.h"
 #include "core_util/logger.h"
+#include "core_util/thread_pool.h"
 #include <webgpu/webgpu.h>
+#include <algorithm>
+#include <cmath>
 #include <span>
 
 using namespace mps;
@@ -18,22 +22,44 @@ namespace ext_newton {
 
 const std::string SpringTerm::kName = "SpringTerm";
 
+// Auto-layout pipeline; the gather kernel's zero_csr_rows override is set when
+// this term is the first to assemble and owns the CSR row clear.
+static GPUComputePipeline MakePipeline(const std::string& name, bool zero_csr_rows, uint32 workgroup_size) {
+    ComputePipelineDesc desc{"ext_newton/" + name + ".wgsl", name};
+    desc.SetWorkgroupSize(workgroup_size);
+    if (zero_csr_rows) {
+        desc.constants.emplace_back("zero_csr_rows", 1.0);
+    }
+    return PipelineRegistry::GetInstance().Get(desc);
+}
+
+static std::vector<uint32> EdgeNodes(const std::vector<SpringEdge>& edges) {
+    std::vector<uint32> edge_nodes;
+    edge_nodes.reserve(uint64(edges.size()) * 2);
+    for (const auto& edge : edges) {
+        edge_nodes.push_back(edge.n0);
+        edge_nodes.push_back(edge.n1);
+    }
+    return edge_nodes;
+}
+
 SpringTerm::SpringTerm(const std::vector<SpringEdge>& edges, float32 stiffness)
     : edges_(edges), stiffness_(stiffness) {}
 
 const std::string& SpringTerm::GetName() const { return kName; }
 
+void SpringTerm::SetAssemblyMode(simulate::AssemblyMode mode) { mode_ = mode; }
+
+simulate::AssemblyMode SpringTerm::GetAssemblyMode() const { return mode_; }
+
 void SpringTerm::DeclareSparsity(simulate::SparsityBuilder& builder) {
     for (const auto& edge : edges_) {
         builder.AddEdge(edge.n0, edge.n1);
     }
 }
 
-void SpringTerm::Initialize(const simulate::SparsityBuilder& sparsity, const simulate::AssemblyContext& ctx) {
+void SpringTerm::BuildCSRMappings(const simulate::SparsityBuilder& sparsity) {
     uint32 E = static_cast<uint32>(edges_.size());
-    nnz_ = sparsity.GetNNZ();
-
-    // Build edge-to-CSR mapping
     edge_csr_mappings_.resize(E);
     for (uint32 e = 0; e < E; ++e) {
         uint32 a = edges_[e].n0;
@@ -43,74 +69,195 @@ void SpringTerm::Initialize(const simulate::SparsityBuilder& sparsity, const sim
         edge_csr_mappings_[e].block_aa = a;
         edge_csr_mappings_[e].block_bb = b;
     }
+}
+
+void SpringTerm::Initialize(const simulate::SparsityBuilder& sparsity, const simulate::AssemblyContext& ctx) {
+    uint32 E = static_cast<uint32>(edges_.size());
+    nnz_ = sparsity.GetNNZ();
+    bool gather = mode_ == simulate::AssemblyMode::Gather;
+
+    std::vector<uint32> edge_nodes = EdgeNodes(edges_);
+
+    // Scatter: color edges so that no two edges of one color share a node, and group
+    // each color contiguously; every color batch then scatters with plain stores.
+    // Gather: each node walks its incident edges and writes only its own row.
+    simulate::ElementColoring coloring;
+    simulate::NodeIncidence incidence;
+    if (gather) {
+        incidence.Build(edge_nodes, 2, ctx.node_count);
+    } else {
+        coloring.Build(edge_nodes, 2, ctx.node_count);
+        edges_ = coloring.Reorder(edges_);
+    }
+
+    BuildCSRMappings(sparsity);
 
     // Upload GPU buffers
     edge_buffer_ = std::make_unique<GPUBuffer<SpringEdge>>(
-        BufferUsage::Storage, std::span<const SpringEdge>(edges_), "spring_edges");
+        BufferUsage::Storage, simulate::NonEmptyUpload(edges_), "spring_edges");
     edge_csr_buffer_ = std::make_unique<GPUBuffer<EdgeCSRMapping>>(
-        BufferUsage::Storage, std::span<const EdgeCSRMapping>(edge_csr_mappings_), "spring_edge_csr");
+        BufferUsage::Storage, simulate::NonEmptyUpload(edge_csr_mappings_), "spring_edge_csr");
 
     // Upload spring params uniform
     SpringParams params;
     params.stiffness = stiffness_;
-    spring_params_buffer_ = std::make_unique<GPUBuffer<SpringParams>>(
-        BufferUsage::Uniform, std::span<const SpringParams>(&params, 1), "spring_params");
-
-    // Create pipeline
-    auto shader = ShaderLoader::CreateModule("ext_newton/accumulate_springs.wgsl", "accumulate_springs");
-    WGPUComputePipelineDescriptor desc = WGPU_COMPUTE_PIPELINE_DESCRIPTOR_INIT;
-    std::string label = "accumulate_springs";
-    desc.label = {label.data(), label.size()};
-    desc.layout = nullptr;
-    desc.compute.module = shader.GetHandle();
-    std::string entry = "cs_main";
-    desc.compute.entryPoint = {entry.data(), entry.size()};
-    pipeline_ = GPUComputePipeline(wgpuDeviceCreateComputePipeline(GPUCore::GetInstance().GetDevice(), &desc));
-
-    // Cache bind group
+    spring_params_buffer_ = GPUBufferPool::GetInstance().Allocate(
+        BufferUsage::Uniform, std::span<const SpringParams>(&params, 1));
+
+    // Create pipeline (workgroup size tuned per adapter, else the solver's)
+    uint32 wg = WorkgroupTuner::GetInstance().GetSize(kAccumulateKernel, ctx.workgroup_size);
+    pipeline_ = gather
+        ? MakePipeline("accumulate_springs_gather", ctx.zero_csr_rows, wg)
+        : MakePipeline("accumulate_springs", false, wg);
+
+    // Cache bind groups
     uint64 pos_sz = uint64(ctx.node_count) * 4 * sizeof(float32);
-    uint64 force_sz = uint64(ctx.node_count) * 4 * sizeof(uint32);
-    uint64 edge_sz = uint64(E) * sizeof(SpringEdge);
-    uint64 csr_val_sz = uint64(nnz_) * 9 * sizeof(float32);
+    uint64 force_sz = uint64(ctx.node_count) * 4 * sizeof(float32);
+    uint64 edge_sz = edge_buffer_->GetByteLength();
+    uint64 csr_val_sz = std::max(uint64(nnz_) * 9 * sizeof(float32), uint64(4));
     uint64 diag_sz = uint64(ctx.node_count) * 9 * sizeof(float32);
-    uint64 csr_map_sz = uint64(E) * sizeof(EdgeCSRMapping);
+    uint64 csr_map_sz = edge_csr_buffer_->GetByteLength();
 
     auto bgl = wgpuComputePipelineGetBindGroupLayout(pipeline_.GetHandle(), 0);
-    bg_springs_ = BindGroupBuilder("bg_springs")
-        .AddBuffer(0, ctx.physics_buffer, ctx.physics_size)
-        .AddBuffer(1, ctx.params_buffer, ctx.params_size)
-        .AddBuffer(2, ctx.position_buffer, pos_sz)
-        .AddBuffer(3, ctx.force_buffer, force_sz)
-        .AddBuffer(4, edge_buffer_->GetHandle(), edge_sz)
-        .AddBuffer(5, ctx.csr_values_buffer, csr_val_sz)
-        .AddBuffer(6, ctx.diag_buffer, diag_sz)
-        .AddBuffer(7, edge_csr_buffer_->GetHandle(), csr_map_sz)
-        .AddBuffer(8, spring_params_buffer_->GetHandle(), sizeof(SpringParams))
-        .Build(bgl);
+    auto common = [&](const std::string& label) {
+        return BindGroupBuilder(label)
+            .AddBuffer(0, ctx.physics_buffer, ctx.physics_size)
+            .AddBuffer(1, ctx.params_buffer, ctx.params_size)
+            .AddBuffer(2, ctx.position_buffer, pos_sz, ctx.position_offset)
+            .AddBuffer(3, ctx.force_buffer, force_sz)
+            .AddBuffer(4, edge_buffer_->GetHandle(), edge_sz)
+            .AddBuffer(5, ctx.csr_values_buffer, csr_val_sz)
+            .AddBuffer(6, ctx.diag_buffer, diag_sz)
+            .AddBuffer(7, edge_csr_buffer_->GetHandle(), csr_map_sz)
+            .AddSlice(8, spring_params_buffer_);
+    };
+    bg_springs_.clear();
+    wg_counts_.clear();
+
+    if (gather) {
+        const auto& offsets = incidence.GetOffsets();
+        const auto& entries = incidence.GetEntries();
+        incidence_offsets_buffer_ = std::make_unique<GPUBuffer<uint32>>(
+            BufferUsage::Storage, std::span<const uint32>(offsets), "spring_incidence_offsets");
+        incidence_buffer_ = std::make_unique<GPUBuffer<simulate::IncidenceEntry>>(
+            BufferUsage::Storage, simulate::NonEmptyUpload(entries), "spring_incidence");
+
+        bg_springs_.push_back(common("bg_springs_gather")
+            .AddBuffer(9, incidence_offsets_buffer_->GetHandle(), offsets.size() * sizeof(uint32))
+            .AddBuffer(10, incidence_buffer_->GetHandle(), incidence_buffer_->GetByteLength())
+            .AddBuffer(11, ctx.csr_row_ptr_buffer, uint64(ctx.node_count + 1) * sizeof(uint32))
+            .Build(bgl));
+        wg_counts_.push_back((ctx.node_count + wg - 1) / wg);
+    } else {
+        // Per-color ranges, one 256-byte uniform slot each
+        const auto& ranges = coloring.GetRanges();
+        if (!ranges.empty()) {
+            color_range_buffer_ = GPUBufferPool::GetInstance().Allocate(
+                BufferUsage::Uniform, std::span<const simulate::ColorRange>(ranges));
+        }
+        for (uint32 c = 0; c < coloring.GetColorCount(); ++c) {
+            bg_springs_.push_back(common("bg_springs_c" + std::to_string(c))
+                .AddSlice(9, color_range_buffer_, simulate::kColorRangeBindingSize,
+                          uint64(c) * sizeof(simulate::ColorRange))
+                .Build(bgl));
+            wg_counts_.push_back((ranges[c].count + wg - 1) / wg);
+        }
+    }
     wgpuBindGroupLayoutRelease(bgl);
 
-    wg_count_ = (E + ctx.workgroup_size - 1) / ctx.workgroup_size;
+    if (gather) {
+        LogInfo("SpringTerm: initialized (", E, " edges, nnz=", nnz_, ", gather, max valence ",
+                incidence.GetMaxValence(), ")");
+    } else {
+        LogInfo("SpringTerm: initialized (", E, " edges, nnz=", nnz_, ", ",
+                coloring.GetColorCount(), " colors)");
+    }
+}
 
-    LogInfo("SpringTerm: initialized (", E, " edges, nnz=", nnz_, ")");
+void SpringTerm::Assemble(ComputePassRecorder& recorder) {
+    // Scatter: colors run as ordered dispatches; edges within one never write the same entry.
+    // Gather: a single node-parallel dispatch.
+    for (size_t i = 0; i < bg_springs_.size(); ++i) {
+        recorder.Dispatch(pipeline_.GetHandle(), bg_springs_[i].GetHandle(), wg_counts_[i]);
+    }
 }
 
-void SpringTerm::Assemble(WGPUCommandEncoder encoder) {
-    WGPUComputePassDescriptor pd = WGPU_COMPUTE_PASS_DESCRIPTOR_INIT;
-    WGPUComputePassEncoder pass = wgpuCommandEncoderBeginComputePass(encoder, &pd);
-    ComputeEncoder enc(pass);
-    enc.SetPipeline(pipeline_.GetHandle());
-    enc.SetBindGroup(0, bg_springs_.GetHandle());
-    enc.Dispatch(wg_count_);
-    wgpuComputePassEncoderEnd(pass);
-    wgpuComputePassEncoderRelease(pass);
+bool SpringTerm::InitializeHost(const simulate::SparsityBuilder& sparsity, uint32 node_count) {
+    nnz_ = sparsity.GetNNZ();
+
+    // Host assembly always scatters: colors run in order, edges of one color in parallel
+    simulate::ElementColoring coloring;
+    coloring.Build(EdgeNodes(edges_), 2, node_count);
+    edges_ = coloring.Reorder(edges_);
+    host_colors_ = coloring.GetRanges();
+    BuildCSRMappings(sparsity);
+
+    LogInfo("SpringTerm: host initialized (", edges_.size(), " edges, nnz=", nnz_, ", ",
+            coloring.GetColorCount(), " colors)");
+    return true;
+}
+
+// Host port of accumulate_springs.wgsl
+void SpringTerm::AssembleHost(const simulate::HostAssemblyContext& ctx) {
+    const float32 k = stiffness_;
+    const float32 dt2 = ctx.dt_sq;
+
+    for (const auto& color : host_colors_) {
+        ThreadPool::GetInstance().ParallelFor(color.count, simulate::kHostElementGrain,
+            [&](uint32 begin, uint32 end) {
+            for (uint32 e = color.offset + begin; e < color.offset + end; ++e) {
+                uint32 a = edges_[e].n0;
+                uint32 b = edges_[e].n1;
+                float32 dx[3];
+                for (uint32 c = 0; c < 3; ++c) {
+                    dx[c] = ctx.position[c][a] - ctx.position[c][b];
+                }
+                float32 dist = std::sqrt(dx[0] * dx[0] + dx[1] * dx[1] + dx[2] * dx[2]);
+                if (dist < 1e-8f) continue;
+
+                float32 dir[3] = {dx[0] / dist, dx[1] / dist, dx[2] / dist};
+                float32 rest_len = edges_[e].rest_length;
+
+                // f = -k * (dist - rest_len) * dir on a, opposite on b
+                for (uint32 c = 0; c < 3; ++c) {
+                    float32 f = -k * (dist - rest_len) * dir[c];
+                    ctx.force[c][a] += f;
+                    ctx.force[c][b] -= f;
+                }
+
+                // PSD-clamped block H_ab = k(1-ratio) I + k ratio dir dir^T, scaled by dt^2
+                float32 ratio = std::min(rest_len / dist, 1.0f);
+                float32 coeff_i = k * (1.0f - ratio);
+                float32 coeff_d = k * ratio;
+                float32* csr_ab = ctx.csr_values + uint64(edge_csr_mappings_[e].block_ab) * 9;
+                float32* csr_ba = ctx.csr_values + uint64(edge_csr_mappings_[e].block_ba) * 9;
+                float32* diag_a = ctx.diag + uint64(a) * 9;
+                float32* diag_b = ctx.diag + uint64(b) * 9;
+                for (uint32 r = 0; r < 3; ++r) {
+                    for (uint32 c = 0; c < 3; ++c) {
+                        float32 h = dt2 * (coeff_d * dir[r] * dir[c] + (r == c ? coeff_i : 0.0f));
+                        csr_ab[r * 3 + c] -= h;
+                        csr_ba[r * 3 + c] -= h;
+                        diag_a[r * 3 + c] += h;
+                        diag_b[r * 3 + c] += h;
+                    }
+                }
+            }
+        });
+    }
 }
 
 void SpringTerm::Shutdown() {
-    bg_springs_ = {};
+    bg_springs_.clear();
+    wg_counts_.clear();
     pipeline_ = {};
     edge_buffer_.reset();
     edge_csr_buffer_.reset();
-    spring_params_buffer_.reset();
+    spring_params_buffer_ = {};
+    color_range_buffer_ = {};
+    incidence_offsets_buffer_.reset();
+    incidence_buffer_.reset();
+    host_colors_.clear();
     LogInfo("SpringTerm: shutdown");
 }
 
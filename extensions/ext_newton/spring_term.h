@@ -1,9 +1,12 @@
 #pragma once
 
 #include "core_simulate/dynamics_term.h"
+#include "core_simulate/element_coloring.h"
+#include "core_simulate/node_incidence.h"
 #include "ext_dynamics/spring_types.h"
 #include "core_gpu/gpu_handle.h"
 #include "core_gpu/gpu_buffer.h"
+#include "core_gpu/gpu_buffer_pool.h"
 #include <memory>
 #include <string>
 #include <vector>
@@ -17,27 +20,41 @@ struct alignas(16) SpringParams {
 
 class SpringTerm : public mps::simulate::IDynamicsTerm {
 public:
+    // WorkgroupTuner kernel name of the spring accumulation (scatter and gather)
+    static constexpr const char* kAccumulateKernel = "accumulate_springs";
+
     SpringTerm(const std::vector<ext_dynamics::SpringEdge>& edges, mps::float32 stiffness);
 
     [[nodiscard]] const std::string& GetName() const override;
     void DeclareSparsity(mps::simulate::SparsityBuilder& builder) override;
     void Initialize(const mps::simulate::SparsityBuilder& sparsity,
                     const mps::simulate::AssemblyContext& ctx) override;
-    void Assemble(WGPUCommandEncoder encoder) override;
+    void Assemble(mps::gpu::ComputePassRecorder& recorder) override;
+    void SetAssemblyMode(mps::simulate::AssemblyMode mode) override;
+    [[nodiscard]] mps::simulate::AssemblyMode GetAssemblyMode() const override;
+    bool InitializeHost(const mps::simulate::SparsityBuilder& sparsity, mps::uint32 node_count) override;
+    void AssembleHost(const mps::simulate::HostAssemblyContext& ctx) override;
     void Shutdown() override;
 
 private:
+    void BuildCSRMappings(const mps::simulate::SparsityBuilder& sparsity);
+
     std::vector<ext_dynamics::SpringEdge> edges_;
     std::vector<ext_dynamics::EdgeCSRMapping> edge_csr_mappings_;
     mps::float32 stiffness_;
     mps::uint32 nnz_ = 0;
+    mps::simulate::AssemblyMode mode_ = mps::simulate::AssemblyMode::Scatter;
 
     std::unique_ptr<mps::gpu::GPUBuffer<ext_dynamics::SpringEdge>> edge_buffer_;
     std::unique_ptr<mps::gpu::GPUBuffer<ext_dynamics::EdgeCSRMapping>> edge_csr_buffer_;
-    std::unique_ptr<mps::gpu::GPUBuffer<SpringParams>> spring_params_buffer_;
+    mps::gpu::GPUBufferSlice spring_params_buffer_;
+    mps::gpu::GPUBufferSlice color_range_buffer_;       // scatter
+    std::unique_ptr<mps::gpu::GPUBuffer<mps::uint32>> incidence_offsets_buffer_;              // gather
+    std::unique_ptr<mps::gpu::GPUBuffer<mps::simulate::IncidenceEntry>> incidence_buffer_;    // gather
     mps::gpu::GPUComputePipeline pipeline_;
-    mps::gpu::GPUBindGroup bg_springs_;
-    mps::uint32 wg_count_ = 0;
+    std::vector<mps::gpu::GPUBindGroup> bg_springs_;   // one per edge color, or one gather group
+    std::vector<mps::uint32> wg_counts_;               // per bind group
+    std::vector<mps::simulate::ColorRange> host_colors_;  // CPU backend: edge color batches
 
     static const std::string kName;
 };
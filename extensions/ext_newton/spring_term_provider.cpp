@@ -52,20 +52,9 @@ std::unique_ptr<IDynamicsTerm> SpringTermProvider::CreateTerm(
         all_edges.assign(data, data + count);
     } else {
         // Global: merge ALL entities' edges with position offsets
-        auto entities = storage->GetEntities();
-        std::sort(entities.begin(), entities.end());
-
-        auto* pos_storage = db.GetArrayStorageById(GetComponentTypeId<SimPosition>());
-        std::unordered_map<Entity, uint32> pos_offset_map;
-        if (pos_storage) {
-            auto pos_entities = pos_storage->GetEntities();
-            std::sort(pos_entities.begin(), pos_entities.end());
-            uint32 offset = 0;
-            for (Entity e : pos_entities) {
-                pos_offset_map[e] = offset;
-                offset += pos_storage->GetArrayCount(e);
-            }
-        }
+        const auto& entities = storage->GetEntities();
+
+        auto pos_offset_map = NodeRegionOffsets(db.GetArrayStorageById(GetComponentTypeId<SimPosition>()));
 
         for (Entity mesh_e : entities) {
             uint32 count = storage->GetArrayCount(mesh_e);
@@ -90,7 +79,9 @@ std::unique_ptr<IDynamicsTerm> SpringTermProvider::CreateTerm(
     if (all_edges.empty()) return nullptr;
 
     edge_count_ = static_cast<uint32>(all_edges.size());
-    return std::make_unique<SpringTerm>(all_edges, config->stiffness);
+    auto term = std::make_unique<SpringTerm>(all_edges, config->stiffness);
+    term->SetAssemblyMode(static_cast<AssemblyMode>(config->assembly_mode));
+    return term;
 }
 
 void SpringTermProvider::DeclareTopology(uint32& out_edge_count, uint32& out_face_count) {
@@ -111,7 +102,7 @@ void SpringTermProvider::QueryTopology(const Database& db, Entity entity,
         out_edge_count = storage->GetArrayCount(entity);
     } else {
         // Global: sum across ALL entities
-        auto entities = storage->GetEntities();
+        const auto& entities = storage->GetEntities();
         uint32 total = 0;
         for (Entity e : entities) {
             total += storage->GetArrayCount(e);
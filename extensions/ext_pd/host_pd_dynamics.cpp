@@ -0,0 +1,304 @@
+#include "ext_pd/host_pd_dynamics.h"
+#include "ext_pd/pd_dynamics.h"
+#include "core_util/thread_pool.h"
+#include "core_util/logger.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace mps;
+using namespace mps::util;
+using namespace mps::simulate;
+using ext_dynamics::HostNodeState;
+
+namespace ext_pd {
+
+HostPDDynamics::HostPDDynamics() = default;
+HostPDDynamics::~HostPDDynamics() = default;
+
+void HostPDDynamics::AddTerm(std::unique_ptr<IProjectiveTerm> term) {
+    terms_.push_back(std::move(term));
+}
+
+void HostPDDynamics::Initialize(uint32 node_count) {
+    node_count_ = node_count;
+
+    sparsity_ = std::make_unique<SparsityBuilder>(node_count);
+    for (auto& term : terms_) {
+        term->DeclareSparsity(*sparsity_);
+    }
+    sparsity_->Build();
+
+    std::erase_if(terms_, [&](const std::unique_ptr<IProjectiveTerm>& term) {
+        if (term->InitializeHost(*sparsity_, node_count)) return false;
+        LogError("HostPDDynamics: term '", term->GetName(), "' has no host path, skipped");
+        return true;
+    });
+
+    diag_values_.assign(uint64(node_count) * 9, 0.0f);
+    csr_values_.assign(uint64(sparsity_->GetNNZ()) * 9, 0.0f);
+    d_inv_.assign(uint64(node_count) * 9, 0.0f);
+    x_old_.Assign(node_count);
+    s_.Assign(node_count);
+    rhs_.Assign(node_count);
+    for (auto& q : q_) {
+        q.Assign(node_count);
+    }
+    partials_.assign(ThreadPool::GetChunkCount(node_count, kHostNodeGrain), 0.0);
+
+    lhs_dt_ = 0.0f;
+    omegas_.clear();
+    if (chebyshev_rho_ > 0.0f) {
+        omegas_ = ComputeChebyshevOmegas(chebyshev_rho_, iterations_);
+    }
+
+    LogInfo("HostPDDynamics: initialized (", node_count, " nodes, nnz=", sparsity_->GetNNZ(),
+            ", ", terms_.size(), " terms, ", ThreadPool::GetInstance().GetThreadCount(), " threads)");
+}
+
+// diag = M/dt² * I + term blocks, then D⁻¹ per node (identity for singular blocks)
+void HostPDDynamics::RebuildLHS(const HostNodeState& state, float32 inv_dt_sq) {
+    auto& pool = ThreadPool::GetInstance();
+    const float32* mass = state.mass.data();
+
+    pool.ParallelFor(node_count_, kHostNodeGrain, [&](uint32 begin, uint32 end) {
+        for (uint32 i = begin; i < end; ++i) {
+            float32* d = diag_values_.data() + uint64(i) * 9;
+            std::fill(d, d + 9, 0.0f);
+            float32 val = mass[i] * inv_dt_sq;
+            d[0] = val;
+            d[4] = val;
+            d[8] = val;
+        }
+    });
+    std::fill(csr_values_.begin(), csr_values_.end(), 0.0f);
+
+    PDHostAssemblyContext ctx{};
+    ctx.diag = diag_values_.data();
+    ctx.csr_values = csr_values_.data();
+    ctx.node_count = node_count_;
+    for (auto& term : terms_) {
+        term->AssembleLHSHost(ctx);
+    }
+
+    pool.ParallelFor(node_count_, kHostNodeGrain, [&](uint32 begin, uint32 end) {
+        for (uint32 i = begin; i < end; ++i) {
+            const float32* a = diag_values_.data() + uint64(i) * 9;
+            float32* m = d_inv_.data() + uint64(i) * 9;
+            float32 c00 = a[4] * a[8] - a[5] * a[7];
+            float32 c01 = a[5] * a[6] - a[3] * a[8];
+            float32 c02 = a[3] * a[7] - a[4] * a[6];
+            float32 det = a[0] * c00 + a[1] * c01 + a[2] * c02;
+            if (std::abs(det) < 1e-20f) {
+                m[0] = 1.0f; m[1] = 0.0f; m[2] = 0.0f;
+                m[3] = 0.0f; m[4] = 1.0f; m[5] = 0.0f;
+                m[6] = 0.0f; m[7] = 0.0f; m[8] = 1.0f;
+                continue;
+            }
+            float32 inv_det = 1.0f / det;
+            m[0] = c00 * inv_det;
+            m[1] = (a[2] * a[7] - a[1] * a[8]) * inv_det;
+            m[2] = (a[1] * a[5] - a[2] * a[4]) * inv_det;
+            m[3] = c01 * inv_det;
+            m[4] = (a[0] * a[8] - a[2] * a[6]) * inv_det;
+            m[5] = (a[2] * a[3] - a[0] * a[5]) * inv_det;
+            m[6] = c02 * inv_det;
+            m[7] = (a[1] * a[6] - a[0] * a[7]) * inv_det;
+            m[8] = (a[0] * a[4] - a[1] * a[3]) * inv_det;
+        }
+    });
+}
+
+// x_old = x; s = x_old + dt*v + dt²*g (pinned: s = x_old); q_0 = s
+void HostPDDynamics::Predict(const HostNodeState& state, const PhysicsParamsGPU& physics) {
+    const HostVec3Array& pos = state.positions;
+    const HostVec3Array& vel = state.velocities;
+    const float32* inv_mass = state.inv_mass.data();
+    HostVec3Array& q0 = q_[0];
+
+    ThreadPool::GetInstance().ParallelFor(node_count_, kHostNodeGrain, [&](uint32 begin, uint32 end) {
+        for (uint32 i = begin; i < end; ++i) {
+            bool free = inv_mass[i] > 0.0f;
+            float32 h = free ? physics.dt : 0.0f;
+            float32 h2 = free ? physics.dt_sq : 0.0f;
+            x_old_.x[i] = pos.x[i];
+            x_old_.y[i] = pos.y[i];
+            x_old_.z[i] = pos.z[i];
+            s_.x[i] = pos.x[i] + h * vel.x[i] + h2 * physics.gravity_x;
+            s_.y[i] = pos.y[i] + h * vel.y[i] + h2 * physics.gravity_y;
+            s_.z[i] = pos.z[i] + h * vel.z[i] + h2 * physics.gravity_z;
+            q0.x[i] = s_.x[i];
+            q0.y[i] = s_.y[i];
+            q0.z[i] = s_.z[i];
+        }
+    });
+}
+
+void HostPDDynamics::Iterate(const HostNodeState& state, float32 inv_dt_sq, uint32 k,
+                             float32 omega, bool first_step) {
+    auto& pool = ThreadPool::GetInstance();
+    const HostVec3Array& q_curr = q_[k % kPDIterateBufferCount];
+    const HostVec3Array& q_prev = q_[(k + 2) % kPDIterateBufferCount];
+    HostVec3Array& q_new = q_[(k + 1) % kPDIterateBufferCount];
+    const float32* mass = state.mass.data();
+    const float32* inv_mass = state.inv_mass.data();
+
+    // rhs = (M/dt²) * s + term projections of q_curr
+    pool.ParallelFor(node_count_, kHostNodeGrain, [&](uint32 begin, uint32 end) {
+        for (uint32 i = begin; i < end; ++i) {
+            float32 coeff = mass[i] * inv_dt_sq;
+            rhs_.x[i] = coeff * s_.x[i];
+            rhs_.y[i] = coeff * s_.y[i];
+            rhs_.z[i] = coeff * s_.z[i];
+        }
+    });
+
+    PDHostAssemblyContext ctx{};
+    ctx.q[0] = q_curr.x.data();
+    ctx.q[1] = q_curr.y.data();
+    ctx.q[2] = q_curr.z.data();
+    ctx.rhs[0] = rhs_.x.data();
+    ctx.rhs[1] = rhs_.y.data();
+    ctx.rhs[2] = rhs_.z.data();
+    ctx.node_count = node_count_;
+    for (auto& term : terms_) {
+        term->ProjectRHSHost(ctx);
+    }
+
+    // z = D⁻¹ (b - (A-D) q_curr); q_new = ω (z - q_prev) + q_prev (pure z on the first step).
+    // Pinned nodes keep q_curr.
+    const uint32* row_ptr = sparsity_->GetRowPtr().data();
+    const uint32* col_idx = sparsity_->GetColIdx().data();
+    pool.ParallelFor(node_count_, kHostNodeGrain, [&](uint32 begin, uint32 end) {
+        for (uint32 i = begin; i < end; ++i) {
+            if (inv_mass[i] <= 0.0f) {
+                q_new.x[i] = q_curr.x[i];
+                q_new.y[i] = q_curr.y[i];
+                q_new.z[i] = q_curr.z[i];
+                continue;
+            }
+            float32 bx = rhs_.x[i], by = rhs_.y[i], bz = rhs_.z[i];
+            for (uint32 idx = row_ptr[i]; idx < row_ptr[i + 1]; ++idx) {
+                const float32* b = csr_values_.data() + uint64(idx) * 9;
+                uint32 j = col_idx[idx];
+                float32 qx = q_curr.x[j], qy = q_curr.y[j], qz = q_curr.z[j];
+                bx -= b[0] * qx + b[1] * qy + b[2] * qz;
+                by -= b[3] * qx + b[4] * qy + b[5] * qz;
+                bz -= b[6] * qx + b[7] * qy + b[8] * qz;
+            }
+            const float32* d = d_inv_.data() + uint64(i) * 9;
+            float32 zx = d[0] * bx + d[1] * by + d[2] * bz;
+            float32 zy = d[3] * bx + d[4] * by + d[5] * bz;
+            float32 zz = d[6] * bx + d[7] * by + d[8] * bz;
+            if (first_step) {
+                q_new.x[i] = zx;
+                q_new.y[i] = zy;
+                q_new.z[i] = zz;
+            } else {
+                q_new.x[i] = omega * (zx - q_prev.x[i]) + q_prev.x[i];
+                q_new.y[i] = omega * (zy - q_prev.y[i]) + q_prev.y[i];
+                q_new.z[i] = omega * (zz - q_prev.z[i]) + q_prev.z[i];
+            }
+        }
+    });
+}
+
+// Same measurement as PDDynamics::CalibrateRho: pure Jacobi from q_0 = s, recording
+// ||q_{k+1} - q_k|| per iteration. Node state is not modified.
+void HostPDDynamics::CalibrateRho(const HostNodeState& state, const PhysicsParamsGPU& physics) {
+    const uint32 cal_iters = std::min(iterations_, uint32(15));
+    Predict(state, physics);
+
+    std::vector<float32> delta_norms;
+    for (uint32 k = 0; k < cal_iters; ++k) {
+        Iterate(state, physics.inv_dt_sq, k, 1.0f, true);
+
+        const HostVec3Array& q_curr = q_[k % kPDIterateBufferCount];
+        const HostVec3Array& q_new = q_[(k + 1) % kPDIterateBufferCount];
+        ThreadPool::GetInstance().ParallelFor(node_count_, kHostNodeGrain, [&](uint32 begin, uint32 end) {
+            float64 delta_sq = 0.0;
+            for (uint32 i = begin; i < end; ++i) {
+                float64 dx = float64(q_new.x[i]) - q_curr.x[i];
+                float64 dy = float64(q_new.y[i]) - q_curr.y[i];
+                float64 dz = float64(q_new.z[i]) - q_curr.z[i];
+                delta_sq += dx * dx + dy * dy + dz * dz;
+            }
+            partials_[begin / kHostNodeGrain] = delta_sq;
+        });
+        float64 delta_sq = 0.0;
+        for (float64 partial : partials_) delta_sq += partial;
+        delta_norms.push_back(float32(std::sqrt(delta_sq)));
+    }
+
+    chebyshev_rho_ = EstimateChebyshevRho(delta_norms);
+    omegas_ = ComputeChebyshevOmegas(chebyshev_rho_, iterations_);
+    LogInfo("HostPDDynamics: calibrated rho=", chebyshev_rho_, " (", cal_iters, " Jacobi iterations)");
+}
+
+void HostPDDynamics::Step(HostNodeState& state, const PhysicsParamsGPU& physics) {
+    if (node_count_ == 0 || state.GetNodeCount() != node_count_) return;
+
+    if (lhs_dt_ != physics.dt) {
+        RebuildLHS(state, physics.inv_dt_sq);
+        lhs_dt_ = physics.dt;
+    }
+    if (omegas_.size() != iterations_) {
+        CalibrateRho(state, physics);
+    }
+
+    Predict(state, physics);
+    for (uint32 k = 0; k < iterations_; ++k) {
+        Iterate(state, physics.inv_dt_sq, k, omegas_[k], k == 0);
+    }
+
+    // v = (q - x_old) / dt * damping, clamped to 50 m/s; x = x_old + v * dt.
+    // Pinned nodes get zero velocity and keep their position.
+    constexpr float32 kMaxSpeed = 50.0f;
+    const HostVec3Array& q = q_[iterations_ % kPDIterateBufferCount];
+    HostVec3Array& pos = state.positions;
+    HostVec3Array& vel = state.velocities;
+    const float32* inv_mass = state.inv_mass.data();
+    const float32 scale = physics.inv_dt * physics.damping;
+    ThreadPool::GetInstance().ParallelFor(node_count_, kHostNodeGrain, [&](uint32 begin, uint32 end) {
+        for (uint32 i = begin; i < end; ++i) {
+            if (inv_mass[i] <= 0.0f) {
+                vel.x[i] = 0.0f;
+                vel.y[i] = 0.0f;
+                vel.z[i] = 0.0f;
+                continue;
+            }
+            float32 vx = (q.x[i] - x_old_.x[i]) * scale;
+            float32 vy = (q.y[i] - x_old_.y[i]) * scale;
+            float32 vz = (q.z[i] - x_old_.z[i]) * scale;
+            float32 speed = std::sqrt(vx * vx + vy * vy + vz * vz);
+            if (speed > kMaxSpeed) {
+                float32 s = kMaxSpeed / speed;
+                vx *= s;
+                vy *= s;
+                vz *= s;
+            }
+            vel.x[i] = vx;
+            vel.y[i] = vy;
+            vel.z[i] = vz;
+            pos.x[i] = x_old_.x[i] + vx * physics.dt;
+            pos.y[i] = x_old_.y[i] + vy * physics.dt;
+            pos.z[i] = x_old_.z[i] + vz * physics.dt;
+        }
+    });
+}
+
+void HostPDDynamics::Shutdown() {
+    for (auto& term : terms_) {
+        term->Shutdown();
+    }
+    terms_.clear();
+    sparsity_.reset();
+    diag_values_.clear();
+    csr_values_.clear();
+    d_inv_.clear();
+    omegas_.clear();
+    node_count_ = 0;
+    lhs_dt_ = 0.0f;
+    LogInfo("HostPDDynamics: shutdown");
+}
+
+}  // namespace ext_pd
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "core_simulate/projective_term.h"
+#include "core_simulate/dynamics_term.h"
+#include "core_simulate/host_cg_solver.h"
+#include "ext_dynamics/global_physics_params.h"
+#include "ext_dynamics/host_node_state.h"
+#include <array>
+#include <memory>
+#include <vector>
+
+namespace ext_pd {
+
+using namespace mps;
+
+// CPU reference backend for PDDynamics.
+// Runs the same Chebyshev-accelerated Jacobi loop (predict, project, Jacobi step)
+// plus the velocity/position update on host SoA arrays, using the terms' host
+// paths and the ThreadPool. Needs no GPU device, so it doubles as a fallback and
+// as an oracle for validating the GPU solver.
+class HostPDDynamics {
+public:
+    HostPDDynamics();
+    ~HostPDDynamics();
+
+    // Add a projective term (call before Initialize)
+    void AddTerm(std::unique_ptr<simulate::IProjectiveTerm> term);
+
+    void SetIterations(uint32 iterations) { iterations_ = iterations; }
+    void SetChebyshevRho(float32 rho) { chebyshev_rho_ = rho; }
+
+    // Initialize after all terms are added. Terms without a host path are dropped.
+    void Initialize(uint32 node_count);
+
+    // Advance state by one timestep (velocities and positions are updated in place).
+    // The LHS is rebuilt whenever dt changes; with auto ρ the first call calibrates it.
+    void Step(ext_dynamics::HostNodeState& state, const simulate::PhysicsParamsGPU& physics);
+
+    void Shutdown();
+
+private:
+    void RebuildLHS(const ext_dynamics::HostNodeState& state, float32 inv_dt_sq);
+    void Predict(const ext_dynamics::HostNodeState& state, const simulate::PhysicsParamsGPU& physics);
+    // One Jacobi/Chebyshev iteration k (reads q_[k%3], q_[(k+2)%3], writes q_[(k+1)%3])
+    void Iterate(const ext_dynamics::HostNodeState& state, float32 inv_dt_sq, uint32 k,
+                 float32 omega, bool first_step);
+    void CalibrateRho(const ext_dynamics::HostNodeState& state,
+                      const simulate::PhysicsParamsGPU& physics);
+
+    std::vector<std::unique_ptr<simulate::IProjectiveTerm>> terms_;
+    std::unique_ptr<simulate::SparsityBuilder> sparsity_;
+
+    uint32 node_count_ = 0;
+    uint32 iterations_ = 20;
+    float32 chebyshev_rho_ = 0.0f;  // 0 = auto-calibrate; >0 = manual override
+    std::vector<float32> omegas_;   // empty until ρ is known
+    float32 lhs_dt_ = 0.0f;         // dt the LHS was built for (0 = not built)
+
+    // LHS (GPU block layout) and per-node inverse diagonal blocks
+    std::vector<float32> diag_values_;
+    std::vector<float32> csr_values_;
+    std::vector<float32> d_inv_;
+
+    // Solver state
+    simulate::HostVec3Array x_old_;
+    simulate::HostVec3Array s_;
+    simulate::HostVec3Array rhs_;
+    std::array<simulate::HostVec3Array, simulate::kPDIterateBufferCount> q_;
+    std::vector<float64> partials_;
+};
+
+}  // namespace ext_pd
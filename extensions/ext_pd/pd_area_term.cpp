@@ -1,11 +1,14 @@
 #include "ext_pd/pd_area_term.h"
 #include "ext_newton/area_term.h"
 #include "core_gpu/gpu_core.h"
-#include "core_gpu/shader_loader.h"
+#include "core_gpu/pipeline_registry.h"
 #include "core_gpu/bind_group_builder.h"
-#include "core_gpu/compute_encoder.h"
+#include "core_gpu/compute_pass_recorder.h"
 #include "core_util/logger.h"
+#include "core_util/math.h"
+#include "core_util/thread_pool.h"
 #include <webgpu/webgpu.h>
+#include <cmath>
 #include <span>
 
 using namespace mps;
@@ -32,9 +35,20 @@ void PDAreaTerm::DeclareSparsity(SparsityBuilder& builder) {
     }
 }
 
-void PDAreaTerm::Initialize(const SparsityBuilder& sparsity, const PDAssemblyContext& ctx) {
+ElementColoring PDAreaTerm::PrepareFaces(const SparsityBuilder& sparsity, uint32 node_count) {
     uint32 F = static_cast<uint32>(triangles_.size());
-    nnz_ = sparsity.GetNNZ();
+
+    // Color faces so the per-iteration RHS scatter needs no atomics
+    std::vector<uint32> face_nodes;
+    face_nodes.reserve(uint64(F) * 3);
+    for (const auto& tri : triangles_) {
+        face_nodes.push_back(tri.n0);
+        face_nodes.push_back(tri.n1);
+        face_nodes.push_back(tri.n2);
+    }
+    ElementColoring coloring;
+    coloring.Build(face_nodes, 3, node_count);
+    triangles_ = coloring.Reorder(triangles_);
 
     // Build face-to-CSR mapping
     face_csr_mappings_.resize(F);
@@ -49,6 +63,13 @@ void PDAreaTerm::Initialize(const SparsityBuilder& sparsity, const PDAssemblyCon
         face_csr_mappings_[f].csr_12 = sparsity.GetCSRIndex(n1, n2);
         face_csr_mappings_[f].csr_21 = sparsity.GetCSRIndex(n2, n1);
     }
+    return coloring;
+}
+
+void PDAreaTerm::Initialize(const SparsityBuilder& sparsity, const PDAssemblyContext& ctx) {
+    uint32 F = static_cast<uint32>(triangles_.size());
+    nnz_ = sparsity.GetNNZ();
+    ElementColoring coloring = PrepareFaces(sparsity, ctx.node_count);
 
     // Upload GPU buffers
     triangle_buffer_ = std::make_unique<GPUBuffer<AreaTriangle>>(
@@ -59,23 +80,21 @@ void PDAreaTerm::Initialize(const SparsityBuilder& sparsity, const PDAssemblyCon
     AreaParams params;
     params.stiffness = stiffness_;
     params.shear_stiffness = 0.0f;
-    area_params_buffer_ = std::make_unique<GPUBuffer<AreaParams>>(
-        BufferUsage::Uniform, std::span<const AreaParams>(&params, 1), "pd_area_params");
+    auto& pool = GPUBufferPool::GetInstance();
+    area_params_buffer_ = pool.Allocate(BufferUsage::Uniform, std::span<const AreaParams>(&params, 1));
 
-    // Create pipelines
-    auto make_pipeline = [](const std::string& path, const std::string& label) -> GPUComputePipeline {
-        auto shader = ShaderLoader::CreateModule("ext_pd/" + path, label);
-        WGPUComputePipelineDescriptor desc = WGPU_COMPUTE_PIPELINE_DESCRIPTOR_INIT;
-        desc.label = {label.data(), label.size()};
-        desc.layout = nullptr;
-        desc.compute.module = shader.GetHandle();
-        std::string entry = "cs_main";
-        desc.compute.entryPoint = {entry.data(), entry.size()};
-        return GPUComputePipeline(wgpuDeviceCreateComputePipeline(GPUCore::GetInstance().GetDevice(), &desc));
-    };
+    const auto& ranges = coloring.GetRanges();
+    if (!ranges.empty()) {
+        color_range_buffer_ = pool.Allocate(BufferUsage::Uniform, std::span<const ColorRange>(ranges));
+    }
 
-    lhs_pipeline_ = make_pipeline("pd_area_lhs.wgsl", "pd_area_lhs");
-    project_rhs_pipeline_ = make_pipeline("pd_area_project_rhs.wgsl", "pd_area_project_rhs");
+    // Create pipelines
+    PipelineBatch batch;
+    batch.Add(ComputePipelineDesc{"ext_pd/pd_area_lhs.wgsl", "pd_area_lhs"}
+                  .SetWorkgroupSize(ctx.workgroup_size), lhs_pipeline_);
+    batch.Add(ComputePipelineDesc{"ext_pd/pd_area_project_rhs.wgsl", "pd_area_project_rhs"}
+                  .SetWorkgroupSize(ctx.workgroup_size), project_rhs_pipeline_);
+    batch.Resolve();
 
     // Cache bind groups
     uint64 tri_sz = uint64(F) * sizeof(AreaTriangle);
@@ -86,11 +105,11 @@ void PDAreaTerm::Initialize(const SparsityBuilder& sparsity, const PDAssemblyCon
     uint64 q_sz = uint64(ctx.node_count) * 4 * sizeof(float32);
 
     auto make_bg = [](const GPUComputePipeline& pipeline, const std::string& label,
-                      std::initializer_list<std::pair<uint32, std::pair<WGPUBuffer, uint64>>> entries) {
+                      std::initializer_list<std::pair<uint32, BufferBinding>> entries) {
         auto bgl = wgpuComputePipelineGetBindGroupLayout(pipeline.GetHandle(), 0);
         auto builder = BindGroupBuilder(label);
-        for (auto& [binding, buf_size] : entries) {
-            builder = std::move(builder).AddBuffer(binding, buf_size.first, buf_size.second);
+        for (auto& [binding, range] : entries) {
+            builder = std::move(builder).AddBuffer(binding, range);
         }
         auto bg = std::move(builder).Build(bgl);
         wgpuBindGroupLayoutRelease(bgl);
@@ -104,51 +123,165 @@ void PDAreaTerm::Initialize(const SparsityBuilder& sparsity, const PDAssemblyCon
          {2, {ctx.diag_buffer, diag_sz}},
          {3, {ctx.csr_values_buffer, std::max(csr_val_sz, uint64(4))}},
          {4, {face_csr_buffer_->GetHandle(), csr_map_sz}},
-         {5, {area_params_buffer_->GetHandle(), sizeof(AreaParams)}}});
+         {5, area_params_buffer_.GetBinding()}});
 
-    // Fused project+RHS bind group
-    bg_project_rhs_ = make_bg(project_rhs_pipeline_, "bg_pd_area_proj_rhs",
-        {{0, {ctx.params_buffer, ctx.params_size}},
-         {1, {triangle_buffer_->GetHandle(), tri_sz}},
-         {2, {ctx.q_buffer, q_sz}},
-         {3, {ctx.rhs_buffer, rhs_sz}},
-         {4, {area_params_buffer_->GetHandle(), sizeof(AreaParams)}}});
+    // Fused project+RHS bind groups, one per rotating q slot and face color
+    auto proj_bgl = wgpuComputePipelineGetBindGroupLayout(project_rhs_pipeline_.GetHandle(), 0);
+    color_wg_counts_.clear();
+    for (uint32 slot = 0; slot < kPDIterateBufferCount; ++slot) {
+        bg_project_rhs_[slot].clear();
+        for (uint32 c = 0; c < coloring.GetColorCount(); ++c) {
+            bg_project_rhs_[slot].push_back(BindGroupBuilder(
+                    "bg_pd_area_proj_rhs_" + std::to_string(slot) + "_c" + std::to_string(c))
+                .AddBuffer(0, ctx.params_buffer, ctx.params_size)
+                .AddBuffer(1, triangle_buffer_->GetHandle(), tri_sz)
+                .AddBuffer(2, ctx.q_buffers[slot], q_sz)
+                .AddBuffer(3, ctx.rhs_buffer, rhs_sz)
+                .AddSlice(4, area_params_buffer_)
+                .AddSlice(5, color_range_buffer_, kColorRangeBindingSize, uint64(c) * sizeof(ColorRange))
+                .Build(proj_bgl));
+        }
+    }
+    wgpuBindGroupLayoutRelease(proj_bgl);
+    for (const auto& range : ranges) {
+        color_wg_counts_.push_back((range.count + ctx.workgroup_size - 1) / ctx.workgroup_size);
+    }
 
     wg_count_ = (F + ctx.workgroup_size - 1) / ctx.workgroup_size;
 
-    LogInfo("PDAreaTerm: initialized (", F, " faces, nnz=", nnz_, ")");
+    LogInfo("PDAreaTerm: initialized (", F, " faces, nnz=", nnz_, ", ",
+            coloring.GetColorCount(), " colors)");
 }
 
-void PDAreaTerm::AssembleLHS(WGPUCommandEncoder encoder) {
-    WGPUComputePassDescriptor pd = WGPU_COMPUTE_PASS_DESCRIPTOR_INIT;
-    WGPUComputePassEncoder pass = wgpuCommandEncoderBeginComputePass(encoder, &pd);
-    ComputeEncoder enc(pass);
-    enc.SetPipeline(lhs_pipeline_.GetHandle());
-    enc.SetBindGroup(0, bg_lhs_.GetHandle());
-    enc.Dispatch(wg_count_);
-    wgpuComputePassEncoderEnd(pass);
-    wgpuComputePassEncoderRelease(pass);
+void PDAreaTerm::AssembleLHS(ComputePassRecorder& recorder) {
+    recorder.Dispatch(lhs_pipeline_.GetHandle(), bg_lhs_.GetHandle(), wg_count_);
 }
 
-void PDAreaTerm::ProjectRHS(WGPUCommandEncoder encoder) {
-    WGPUComputePassDescriptor pd = WGPU_COMPUTE_PASS_DESCRIPTOR_INIT;
-    WGPUComputePassEncoder pass = wgpuCommandEncoderBeginComputePass(encoder, &pd);
-    ComputeEncoder enc(pass);
-    enc.SetPipeline(project_rhs_pipeline_.GetHandle());
-    enc.SetBindGroup(0, bg_project_rhs_.GetHandle());
-    enc.Dispatch(wg_count_);
-    wgpuComputePassEncoderEnd(pass);
-    wgpuComputePassEncoderRelease(pass);
+void PDAreaTerm::ProjectRHS(ComputePassRecorder& recorder, uint32 q_slot) {
+    const auto& bgs = bg_project_rhs_[q_slot];
+    for (size_t c = 0; c < bgs.size(); ++c) {
+        recorder.Dispatch(project_rhs_pipeline_.GetHandle(), bgs[c].GetHandle(), color_wg_counts_[c]);
+    }
+}
+
+bool PDAreaTerm::InitializeHost(const SparsityBuilder& sparsity, uint32 node_count) {
+    nnz_ = sparsity.GetNNZ();
+    ElementColoring coloring = PrepareFaces(sparsity, node_count);
+    host_colors_ = coloring.GetRanges();
+    LogInfo("PDAreaTerm: host initialized (", triangles_.size(), " faces, nnz=", nnz_, ", ",
+            coloring.GetColorCount(), " colors)");
+    return true;
+}
+
+// Host port of pd_area_lhs.wgsl: c_ab * w * I blocks with c_ab = dot(ci_a, ci_b)
+void PDAreaTerm::AssembleLHSHost(const PDHostAssemblyContext& ctx) {
+    for (const auto& color : host_colors_) {
+        ThreadPool::GetInstance().ParallelFor(color.count, kHostElementGrain,
+            [&](uint32 begin, uint32 end) {
+            for (uint32 f = color.offset + begin; f < color.offset + end; ++f) {
+                const AreaTriangle& tri = triangles_[f];
+                float32 w = stiffness_ * tri.rest_area;
+                vec2 ci1(tri.dm_inv_00, tri.dm_inv_01);
+                vec2 ci2(tri.dm_inv_10, tri.dm_inv_11);
+                vec2 ci0 = -(ci1 + ci2);
+                float32 c01 = glm::dot(ci0, ci1);
+                float32 c02 = glm::dot(ci0, ci2);
+                float32 c12 = glm::dot(ci1, ci2);
+
+                const FaceCSRMapping& mapping = face_csr_mappings_[f];
+                const std::pair<float32*, float32> blocks[9] = {
+                    {ctx.diag + uint64(tri.n0) * 9, glm::dot(ci0, ci0) * w},
+                    {ctx.diag + uint64(tri.n1) * 9, glm::dot(ci1, ci1) * w},
+                    {ctx.diag + uint64(tri.n2) * 9, glm::dot(ci2, ci2) * w},
+                    {ctx.csr_values + uint64(mapping.csr_01) * 9, c01 * w},
+                    {ctx.csr_values + uint64(mapping.csr_10) * 9, c01 * w},
+                    {ctx.csr_values + uint64(mapping.csr_02) * 9, c02 * w},
+                    {ctx.csr_values + uint64(mapping.csr_20) * 9, c02 * w},
+                    {ctx.csr_values + uint64(mapping.csr_12) * 9, c12 * w},
+                    {ctx.csr_values + uint64(mapping.csr_21) * 9, c12 * w}};
+                for (const auto& [block, value] : blocks) {
+                    block[0] += value;
+                    block[4] += value;
+                    block[8] += value;
+                }
+            }
+        });
+    }
+}
+
+// Host port of pd_area_project_rhs.wgsl: project F onto the closest rotation R = U * V^T
+// and scatter w * S^T * R
+void PDAreaTerm::ProjectRHSHost(const PDHostAssemblyContext& ctx) {
+    auto load = [&](uint32 n) { return vec3(ctx.q[0][n], ctx.q[1][n], ctx.q[2][n]); };
+
+    for (const auto& color : host_colors_) {
+        ThreadPool::GetInstance().ParallelFor(color.count, kHostElementGrain,
+            [&](uint32 begin, uint32 end) {
+            for (uint32 f = color.offset + begin; f < color.offset + end; ++f) {
+                const AreaTriangle& tri = triangles_[f];
+                float32 w = stiffness_ * tri.rest_area;
+
+                vec3 x0 = load(tri.n0);
+                vec3 ds0 = load(tri.n1) - x0;
+                vec3 ds1 = load(tri.n2) - x0;
+                vec3 f0 = ds0 * tri.dm_inv_00 + ds1 * tri.dm_inv_10;
+                vec3 f1 = ds0 * tri.dm_inv_01 + ds1 * tri.dm_inv_11;
+
+                float32 c00 = glm::dot(f0, f0);
+                float32 c01 = glm::dot(f0, f1);
+                float32 c11 = glm::dot(f1, f1);
+
+                // Degenerate triangle: identity rotation
+                vec3 r0(1.0f, 0.0f, 0.0f);
+                vec3 r1(0.0f, 1.0f, 0.0f);
+                if (c00 * c11 - c01 * c01 >= 1e-20f) {
+                    float32 half_sum = 0.5f * (c00 + c11);
+                    float32 half_diff = 0.5f * (c00 - c11);
+                    float32 disc = std::sqrt(half_diff * half_diff + c01 * c01);
+                    float32 sig1 = std::sqrt(std::max(half_sum + disc, 1e-12f));
+                    float32 sig2 = std::sqrt(std::max(half_sum - disc, 1e-12f));
+
+                    float32 atan_y = 2.0f * c01;
+                    float32 atan_x = c00 - c11;
+                    float32 theta = 0.0f;
+                    if (std::abs(atan_y) > 1e-20f || std::abs(atan_x) > 1e-20f) {
+                        theta = 0.5f * std::atan2(atan_y, atan_x);
+                    }
+                    vec2 v1(std::cos(theta), std::sin(theta));
+                    vec2 v2(-v1.y, v1.x);
+
+                    vec3 u1 = (f0 * v1.x + f1 * v1.y) / sig1;
+                    vec3 u2 = (f0 * v2.x + f1 * v2.y) / sig2;
+                    r0 = u1 * v1.x + u2 * v2.x;
+                    r1 = u1 * v1.y + u2 * v2.y;
+                }
+
+                vec2 ci1(tri.dm_inv_00, tri.dm_inv_01);
+                vec2 ci2(tri.dm_inv_10, tri.dm_inv_11);
+                vec2 ci0 = -(ci1 + ci2);
+                const std::pair<uint32, vec2> nodes[3] = {{tri.n0, ci0}, {tri.n1, ci1}, {tri.n2, ci2}};
+                for (const auto& [node, ci] : nodes) {
+                    vec3 contrib = (r0 * ci.x + r1 * ci.y) * w;
+                    ctx.rhs[0][node] += contrib.x;
+                    ctx.rhs[1][node] += contrib.y;
+                    ctx.rhs[2][node] += contrib.z;
+                }
+            }
+        });
+    }
 }
 
 void PDAreaTerm::Shutdown() {
     bg_lhs_ = {};
     bg_project_rhs_ = {};
+    color_wg_counts_.clear();
     lhs_pipeline_ = {};
     project_rhs_pipeline_ = {};
     triangle_buffer_.reset();
     face_csr_buffer_.reset();
-    area_params_buffer_.reset();
+    area_params_buffer_ = {};
+    color_range_buffer_ = {};
+    host_colors_.clear();
     LogInfo("PDAreaTerm: shutdown");
 }
 
@@ -1,10 +1,13 @@
 #pragma once
 
 #include "core_simulate/projective_term.h"
+#include "core_simulate/element_coloring.h"
 #include "ext_dynamics/area_types.h"
 #include "ext_newton/area_term.h"
 #include "core_gpu/gpu_handle.h"
 #include "core_gpu/gpu_buffer.h"
+#include "core_gpu/gpu_buffer_pool.h"
+#include <array>
 #include <memory>
 #include <string>
 #include <vector>
@@ -19,11 +22,18 @@ public:
     void DeclareSparsity(mps::simulate::SparsityBuilder& builder) override;
     void Initialize(const mps::simulate::SparsityBuilder& sparsity,
                     const mps::simulate::PDAssemblyContext& ctx) override;
-    void AssembleLHS(WGPUCommandEncoder encoder) override;
-    void ProjectRHS(WGPUCommandEncoder encoder) override;
+    void AssembleLHS(mps::gpu::ComputePassRecorder& recorder) override;
+    void ProjectRHS(mps::gpu::ComputePassRecorder& recorder, mps::uint32 q_slot) override;
+    bool InitializeHost(const mps::simulate::SparsityBuilder& sparsity, mps::uint32 node_count) override;
+    void AssembleLHSHost(const mps::simulate::PDHostAssemblyContext& ctx) override;
+    void ProjectRHSHost(const mps::simulate::PDHostAssemblyContext& ctx) override;
     void Shutdown() override;
 
 private:
+    // Color faces (reordering triangles_) and build the face-to-CSR mapping
+    mps::simulate::ElementColoring PrepareFaces(const mps::simulate::SparsityBuilder& sparsity,
+                                                mps::uint32 node_count);
+
     std::vector<ext_dynamics::AreaTriangle> triangles_;
     std::vector<ext_dynamics::FaceCSRMapping> face_csr_mappings_;
     mps::float32 stiffness_;
@@ -31,15 +41,21 @@ private:
 
     std::unique_ptr<mps::gpu::GPUBuffer<ext_dynamics::AreaTriangle>> triangle_buffer_;
     std::unique_ptr<mps::gpu::GPUBuffer<ext_dynamics::FaceCSRMapping>> face_csr_buffer_;
-    std::unique_ptr<mps::gpu::GPUBuffer<ext_newton::AreaParams>> area_params_buffer_;
+    mps::gpu::GPUBufferSlice area_params_buffer_;
+    mps::gpu::GPUBufferSlice color_range_buffer_;
 
     mps::gpu::GPUComputePipeline lhs_pipeline_;
     mps::gpu::GPUComputePipeline project_rhs_pipeline_;
 
     mps::gpu::GPUBindGroup bg_lhs_;
-    mps::gpu::GPUBindGroup bg_project_rhs_;
+    // Fused project+RHS: [q slot][face color]
+    std::array<std::vector<mps::gpu::GPUBindGroup>, mps::simulate::kPDIterateBufferCount> bg_project_rhs_;
+    std::vector<mps::uint32> color_wg_counts_;
     mps::uint32 wg_count_ = 0;
 
+    // CPU backend: face color batches
+    std::vector<mps::simulate::ColorRange> host_colors_;
+
     static const std::string kName;
 };
 
@@ -1,14 +1,19 @@
 #include "ext_pd/pd_dynamics.h"
 #include "core_simulate/sim_components.h"
 #include "core_gpu/gpu_core.h"
-#include "core_gpu/shader_loader.h"
+#include "core_gpu/pipeline_registry.h"
 #include "core_gpu/bind_group_builder.h"
-#include "core_gpu/compute_encoder.h"
+#include "core_gpu/bind_group_layout_builder.h"
+#include "core_gpu/pipeline_layout_builder.h"
+#include "core_gpu/compute_pass_recorder.h"
+#include "core_gpu/gpu_readback.h"
+#include "core_gpu/workgroup_tuner.h"
 #include "core_simulate/simulate_config.h"
 #include "core_util/logger.h"
 #include <webgpu/webgpu.h>
 #include <algorithm>
 #include <cmath>
+#include <cstring>
 #include <span>
 
 using namespace mps;
@@ -24,41 +29,25 @@ namespace ext_pd {
 
 static GPUBindGroup MakeBG(const GPUComputePipeline& pipeline,
                            const std::string& label,
-                           std::initializer_list<std::pair<uint32, std::pair<WGPUBuffer, uint64>>> entries) {
+                           std::initializer_list<std::pair<uint32, BufferBinding>> entries) {
     auto bgl = wgpuComputePipelineGetBindGroupLayout(pipeline.GetHandle(), 0);
     auto builder = BindGroupBuilder(label);
-    for (auto& [binding, buf_size] : entries) {
-        builder = std::move(builder).AddBuffer(binding, buf_size.first, buf_size.second);
+    for (auto& [binding, buf] : entries) {
+        builder = std::move(builder).AddBuffer(binding, buf.buffer, buf.size, buf.offset);
     }
     auto bg = std::move(builder).Build(bgl);
     wgpuBindGroupLayoutRelease(bgl);
     return bg;
 }
 
-static void Dispatch(WGPUCommandEncoder encoder,
-                     const GPUComputePipeline& pipeline,
-                     const GPUBindGroup& bg,
-                     uint32 workgroup_count) {
-    WGPUComputePassDescriptor pd = WGPU_COMPUTE_PASS_DESCRIPTOR_INIT;
-    WGPUComputePassEncoder pass = wgpuCommandEncoderBeginComputePass(encoder, &pd);
-    ComputeEncoder enc(pass);
-    enc.SetPipeline(pipeline.GetHandle());
-    enc.SetBindGroup(0, bg.GetHandle());
-    enc.Dispatch(workgroup_count);
-    wgpuComputePassEncoderEnd(pass);
-    wgpuComputePassEncoderRelease(pass);
-}
-
-static GPUComputePipeline MakePipeline(const std::string& shader_path,
-                                        const std::string& label) {
-    auto shader = ShaderLoader::CreateModule("ext_pd/" + shader_path, label);
-    WGPUComputePipelineDescriptor desc = WGPU_COMPUTE_PIPELINE_DESCRIPTOR_INIT;
-    desc.label = {label.data(), label.size()};
-    desc.layout = nullptr;
-    desc.compute.module = shader.GetHandle();
-    std::string entry = "cs_main";
-    desc.compute.entryPoint = {entry.data(), entry.size()};
-    return GPUComputePipeline(wgpuDeviceCreateComputePipeline(GPUCore::GetInstance().GetDevice(), &desc));
+static ComputePipelineDesc PipelineDesc(const std::string& shader_path,
+                                        const std::string& label,
+                                        uint32 workgroup_size,
+                                        WGPUPipelineLayout layout = nullptr) {
+    ComputePipelineDesc desc{"ext_pd/" + shader_path, label};
+    desc.layout = layout;
+    desc.SetWorkgroupSize(workgroup_size);
+    return desc;
 }
 
 // ============================================================================
@@ -81,7 +70,9 @@ void PDDynamics::Initialize(uint32 node_count, uint32 edge_count, uint32 face_co
     edge_count_ = edge_count;
     face_count_ = face_count;
     workgroup_size_ = workgroup_size;
+    jacobi_workgroup_size_ = WorkgroupTuner::GetInstance().GetSize(kJacobiKernel, workgroup_size);
     node_wg_count_ = (node_count + workgroup_size - 1) / workgroup_size;
+    jacobi_wg_count_ = (node_count + jacobi_workgroup_size_ - 1) / jacobi_workgroup_size_;
     physics_buffer_ = physics_buffer;
     physics_size_ = physics_size;
 
@@ -93,9 +84,12 @@ void PDDynamics::Initialize(uint32 node_count, uint32 edge_count, uint32 face_co
     PDAssemblyContext ctx{};
     ctx.physics_buffer = physics_buffer;
     ctx.physics_size = physics_size;
-    ctx.q_buffer = q_curr_buffer_->GetHandle();
+    for (uint32 slot = 0; slot < kPDIterateBufferCount; ++slot) {
+        ctx.q_buffers[slot] = q_buffers_[slot]->GetHandle();
+    }
     ctx.s_buffer = s_buffer_->GetHandle();
     ctx.mass_buffer = mass_buffer;
+    ctx.mass_offset = uint64(node_offset_) * sizeof(SimMass);
     ctx.rhs_buffer = rhs_buffer_->GetHandle();
     ctx.diag_buffer = diag_buffer_->GetHandle();
     ctx.csr_values_buffer = csr_values_buffer_->GetHandle();
@@ -118,7 +112,9 @@ void PDDynamics::Initialize(uint32 node_count, uint32 edge_count, uint32 face_co
         auto& gpu_inst = GPUCore::GetInstance();
         WGPUCommandEncoderDescriptor enc_desc = WGPU_COMMAND_ENCODER_DESCRIPTOR_INIT;
         WGPUCommandEncoder encoder = wgpuDeviceCreateCommandEncoder(gpu_inst.GetDevice(), &enc_desc);
-        RebuildLHS(encoder);
+        ComputePassRecorder recorder(encoder, "pd_lhs");
+        RebuildLHS(recorder);
+        recorder.Flush();
         WGPUCommandBuffer cmd = wgpuCommandEncoderFinish(encoder, nullptr);
         wgpuQueueSubmit(gpu_inst.GetQueue(), 1, &cmd);
         wgpuCommandBufferRelease(cmd);
@@ -130,9 +126,9 @@ void PDDynamics::Initialize(uint32 node_count, uint32 edge_count, uint32 face_co
         BuildChebyshevParams(chebyshev_rho_);
         rho_calibrated_ = true;
     } else {
-        // Fill staging with pure Jacobi as temporary fallback until calibration
-        std::vector<JacobiParams> pure_jacobi(iterations_, {1.0f, 1, 0.0f, 0.0f});
-        jacobi_staging_buffer_->WriteData(std::span<const JacobiParams>(pure_jacobi));
+        // Fill params with pure Jacobi as temporary fallback until calibration
+        std::vector<JacobiParamsSlot> pure_jacobi(iterations_, {{1.0f, 1, 0.0f, 0.0f}});
+        jacobi_params_buffer_.WriteData(std::span<const JacobiParamsSlot>(pure_jacobi));
         rho_calibrated_ = false;
     }
 
@@ -166,16 +162,11 @@ void PDDynamics::CreateBuffers(WGPUBuffer position_buffer, WGPUBuffer velocity_b
     params_buffer_ = std::make_unique<GPUBuffer<SolverParams>>(
         BufferUsage::Uniform, std::span<const SolverParams>(&params_, 1), "pd_solver_params");
 
-    // Jacobi params uniform (CopyDst so command encoder can update per-iteration)
-    jacobi_params_buffer_ = std::make_unique<GPUBuffer<JacobiParams>>(
-        BufferConfig{.usage = BufferUsage::Uniform | BufferUsage::CopyDst,
-                     .size = sizeof(JacobiParams), .label = "pd_jacobi_params"});
-
-    // Chebyshev staging buffer (filled after LHS build when ρ is known)
-    jacobi_staging_buffer_ = std::make_unique<GPUBuffer<JacobiParams>>(
-        BufferConfig{.usage = BufferUsage::Storage | BufferUsage::CopySrc | BufferUsage::CopyDst,
-                     .size = uint64(iterations_) * sizeof(JacobiParams),
-                     .label = "pd_jacobi_staging"});
+    // Per-iteration Chebyshev params (filled after LHS build when ρ is known).
+    // Bound as a dynamic-offset uniform so each iteration selects its own slot;
+    // dynamic offsets are relative to the slice's binding offset.
+    jacobi_params_buffer_ = GPUBufferPool::GetInstance().Allocate(
+        BufferUsage::Uniform, uint64(std::max(iterations_, uint32(1))) * sizeof(JacobiParamsSlot));
 
     // CSR structure
     const auto& row_ptr = sparsity_->GetRowPtr();
@@ -203,24 +194,52 @@ void PDDynamics::CreateBuffers(WGPUBuffer position_buffer, WGPUBuffer velocity_b
         BufferConfig{.usage = srw, .size = vec_sz, .label = "pd_x_old"});
     s_buffer_ = std::make_unique<GPUBuffer<float32>>(
         BufferConfig{.usage = srw, .size = vec_sz, .label = "pd_s"});
-    q_curr_buffer_ = std::make_unique<GPUBuffer<float32>>(
-        BufferConfig{.usage = srw, .size = vec_sz, .label = "pd_q_curr"});
-    q_prev_buffer_ = std::make_unique<GPUBuffer<float32>>(
-        BufferConfig{.usage = srw, .size = vec_sz, .label = "pd_q_prev"});
-    q_new_buffer_ = std::make_unique<GPUBuffer<float32>>(
-        BufferConfig{.usage = srw, .size = vec_sz, .label = "pd_q_new"});
+    for (uint32 slot = 0; slot < kPDIterateBufferCount; ++slot) {
+        q_buffers_[slot] = std::make_unique<GPUBuffer<float32>>(
+            BufferConfig{.usage = srw, .size = vec_sz, .label = "pd_q_" + std::to_string(slot)});
+    }
     rhs_buffer_ = std::make_unique<GPUBuffer<float32>>(
         BufferConfig{.usage = srw, .size = uint64(node_count_) * 4 * sizeof(uint32), .label = "pd_rhs"});
 }
 
 void PDDynamics::CreatePipelines() {
-    pd_init_pipeline_ = MakePipeline("pd_init.wgsl", "pd_init");
-    pd_predict_pipeline_ = MakePipeline("pd_predict.wgsl", "pd_predict");
-    pd_copy_pipeline_ = MakePipeline("pd_copy_vec4.wgsl", "pd_copy");
-    pd_mass_rhs_pipeline_ = MakePipeline("pd_mass_rhs.wgsl", "pd_mass_rhs");
-    pd_inertial_lhs_pipeline_ = MakePipeline("pd_inertial_lhs.wgsl", "pd_inertial_lhs");
-    pd_compute_d_inv_pipeline_ = MakePipeline("pd_compute_d_inv.wgsl", "pd_compute_d_inv");
-    pd_jacobi_step_pipeline_ = MakePipeline("pd_jacobi_step.wgsl", "pd_jacobi_step");
+    PipelineBatch batch;
+    uint32 wg = workgroup_size_;
+    batch.Add(PipelineDesc("pd_init.wgsl", "pd_init", wg), pd_init_pipeline_);
+    batch.Add(PipelineDesc("pd_predict.wgsl", "pd_predict", wg), pd_predict_pipeline_);
+    batch.Add(PipelineDesc("pd_copy_vec4.wgsl", "pd_copy", wg), pd_copy_pipeline_);
+    batch.Add(PipelineDesc("pd_mass_rhs.wgsl", "pd_mass_rhs", wg), pd_mass_rhs_pipeline_);
+    batch.Add(PipelineDesc("pd_inertial_lhs.wgsl", "pd_inertial_lhs", wg), pd_inertial_lhs_pipeline_);
+    batch.Add(PipelineDesc("pd_compute_d_inv.wgsl", "pd_compute_d_inv", wg), pd_compute_d_inv_pipeline_);
+
+    // pd_jacobi_step needs an explicit layout: binding 9 uses a dynamic offset.
+    // The layout is shared across re-initialization so the cached pipeline is reused.
+    WGPUPipelineLayout layout = PipelineRegistry::GetInstance().GetSharedLayout(
+        "pd_jacobi_step_layout", [] {
+            auto bgl = BindGroupLayoutBuilder("bgl_pd_jacobi_step")
+                .AddUniformBinding(0, ShaderStage::Compute)
+                .AddReadOnlyStorageBinding(1, ShaderStage::Compute)
+                .AddReadOnlyStorageBinding(2, ShaderStage::Compute)
+                .AddReadOnlyStorageBinding(3, ShaderStage::Compute)
+                .AddReadOnlyStorageBinding(4, ShaderStage::Compute)
+                .AddReadOnlyStorageBinding(5, ShaderStage::Compute)
+                .AddReadOnlyStorageBinding(6, ShaderStage::Compute)
+                .AddReadOnlyStorageBinding(7, ShaderStage::Compute)
+                .AddStorageBinding(8, ShaderStage::Compute)
+                .AddDynamicUniformBinding(9, ShaderStage::Compute)
+                .AddReadOnlyStorageBinding(10, ShaderStage::Compute)
+                .Build();
+            return PipelineLayoutBuilder("pd_jacobi_step_layout")
+                .AddBindGroupLayout(bgl.GetHandle())
+                .Build();
+        });
+    batch.Add(PipelineDesc("pd_jacobi_step.wgsl", "pd_jacobi_step", jacobi_workgroup_size_, layout),
+              pd_jacobi_step_pipeline_);
+    batch.Resolve();
+
+    // The explicit bind group layout (with the dynamic offset) comes back from the pipeline
+    bgl_jacobi_step_ = GPUBindGroupLayout(
+        wgpuComputePipelineGetBindGroupLayout(pd_jacobi_step_pipeline_.GetHandle(), 0));
 }
 
 void PDDynamics::CacheBindGroups(WGPUBuffer position_buffer,
@@ -232,6 +251,11 @@ void PDDynamics::CacheBindGroups(WGPUBuffer position_buffer,
     uint64 rhs_sz = uint64(node_count_) * 4 * sizeof(uint32);
     uint64 diag_sz = uint64(node_count_) * 9 * sizeof(float32);
     uint64 row_ptr_sz = csr_row_ptr_buffer_->GetByteLength();
+
+    // Node region of the external buffers (non-zero for scoped systems)
+    uint64 pos_off = uint64(node_offset_) * sizeof(SimPosition);
+    uint64 vel_off = uint64(node_offset_) * sizeof(SimVelocity);
+    uint64 mass_off = uint64(node_offset_) * sizeof(SimMass);
     uint64 col_idx_sz = csr_col_idx_buffer_->GetByteLength();
     uint64 csr_val_sz = csr_values_buffer_->GetByteLength();
 
@@ -240,9 +264,6 @@ void PDDynamics::CacheBindGroups(WGPUBuffer position_buffer,
     WGPUBuffer params_h = params_buffer_->GetHandle();
     WGPUBuffer x_old_h = x_old_buffer_->GetHandle();
     WGPUBuffer s_h = s_buffer_->GetHandle();
-    WGPUBuffer q_curr_h = q_curr_buffer_->GetHandle();
-    WGPUBuffer q_prev_h = q_prev_buffer_->GetHandle();
-    WGPUBuffer q_new_h = q_new_buffer_->GetHandle();
     WGPUBuffer rhs_h = rhs_buffer_->GetHandle();
     WGPUBuffer diag_h = diag_buffer_->GetHandle();
     WGPUBuffer d_inv_h = d_inv_buffer_->GetHandle();
@@ -250,32 +271,32 @@ void PDDynamics::CacheBindGroups(WGPUBuffer position_buffer,
     // pd_init: x_old = positions
     bg_init_ = MakeBG(pd_init_pipeline_, "bg_pd_init",
         {{0, {params_h, params_sz}},
-         {1, {position_buffer, vec_sz}},
+         {1, {position_buffer, vec_sz, pos_off}},
          {2, {x_old_h, vec_sz}}});
 
     // pd_predict: s = x_old + dt*v + dt²*g
     bg_predict_ = MakeBG(pd_predict_pipeline_, "bg_pd_predict",
         {{0, {phys_h, phys_sz}}, {1, {params_h, params_sz}},
          {2, {x_old_h, vec_sz}},
-         {3, {velocity_buffer, vec_sz}}, {4, {mass_buffer, mass_sz}},
+         {3, {velocity_buffer, vec_sz, vel_off}}, {4, {mass_buffer, mass_sz, mass_off}},
          {5, {s_h, vec_sz}}});
 
-    // pd_copy: q_curr = s (initial guess)
+    // pd_copy: q_0 = s (initial guess, iteration 0 reads slot 0)
     bg_copy_q_from_s_ = MakeBG(pd_copy_pipeline_, "bg_pd_copy_q_s",
         {{0, {params_h, params_sz}},
          {1, {s_h, vec_sz}},
-         {2, {q_curr_h, vec_sz}}});
+         {2, {q_buffers_[0]->GetHandle(), vec_sz}}});
 
     // pd_mass_rhs: rhs += (M/dt²) * s
     bg_mass_rhs_ = MakeBG(pd_mass_rhs_pipeline_, "bg_pd_mass_rhs",
         {{0, {phys_h, phys_sz}}, {1, {params_h, params_sz}},
-         {2, {mass_buffer, mass_sz}},
+         {2, {mass_buffer, mass_sz, mass_off}},
          {3, {s_h, vec_sz}}, {4, {rhs_h, rhs_sz}}});
 
     // pd_inertial_lhs: diag += (M/dt²) * I₃
     bg_inertial_lhs_ = MakeBG(pd_inertial_lhs_pipeline_, "bg_pd_inertial_lhs",
         {{0, {phys_h, phys_sz}}, {1, {params_h, params_sz}},
-         {2, {mass_buffer, mass_sz}},
+         {2, {mass_buffer, mass_sz, mass_off}},
          {3, {diag_h, diag_sz}}});
 
     // pd_compute_d_inv: d_inv = inverse(diag)
@@ -284,96 +305,103 @@ void PDDynamics::CacheBindGroups(WGPUBuffer position_buffer,
          {1, {diag_h, diag_sz}},
          {2, {d_inv_h, diag_sz}}});
 
-    // pd_jacobi_step: fused SpMV + Jacobi + Chebyshev
-    // rhs_buffer_ stores float bits as u32 via atomicAddFloat; binding as vec4f reinterprets correctly
-    bg_jacobi_step_ = MakeBG(pd_jacobi_step_pipeline_, "bg_pd_jacobi_step",
-        {{0, {params_h, params_sz}},
-         {1, {q_curr_h, vec_sz}},
-         {2, {csr_row_ptr_buffer_->GetHandle(), row_ptr_sz}},
-         {3, {csr_col_idx_buffer_->GetHandle(), col_idx_sz}},
-         {4, {csr_values_buffer_->GetHandle(), csr_val_sz}},
-         {5, {rhs_h, rhs_sz}},
-         {6, {d_inv_h, diag_sz}},
-         {7, {q_prev_h, vec_sz}},
-         {8, {q_new_h, vec_sz}},
-         {9, {jacobi_params_buffer_->GetHandle(), sizeof(JacobiParams)}},
-         {10, {mass_buffer, mass_sz}}});
+    // pd_jacobi_step: fused SpMV + Jacobi + Chebyshev, one variant per q_curr slot.
+    // rhs_buffer_ is a flat f32 array; binding it as vec4f reads the same layout
+    for (uint32 curr = 0; curr < kPDIterateBufferCount; ++curr) {
+        uint32 prev = (curr + kPDIterateBufferCount - 1) % kPDIterateBufferCount;
+        uint32 next = (curr + 1) % kPDIterateBufferCount;
+        bg_jacobi_step_[curr] = BindGroupBuilder("bg_pd_jacobi_step_" + std::to_string(curr))
+            .AddBuffer(0, params_h, params_sz)
+            .AddBuffer(1, q_buffers_[curr]->GetHandle(), vec_sz)
+            .AddBuffer(2, csr_row_ptr_buffer_->GetHandle(), row_ptr_sz)
+            .AddBuffer(3, csr_col_idx_buffer_->GetHandle(), col_idx_sz)
+            .AddBuffer(4, csr_values_buffer_->GetHandle(), csr_val_sz)
+            .AddBuffer(5, rhs_h, rhs_sz)
+            .AddBuffer(6, d_inv_h, diag_sz)
+            .AddBuffer(7, q_buffers_[prev]->GetHandle(), vec_sz)
+            .AddBuffer(8, q_buffers_[next]->GetHandle(), vec_sz)
+            .AddSlice(9, jacobi_params_buffer_, sizeof(JacobiParams))
+            .AddBuffer(10, mass_buffer, mass_sz, mass_off)
+            .Build(bgl_jacobi_step_.GetHandle());
+    }
 }
 
-void PDDynamics::RebuildLHS(WGPUCommandEncoder encoder) {
+void PDDynamics::RebuildLHS(ComputePassRecorder& recorder) {
     uint64 diag_sz = uint64(node_count_) * 9 * sizeof(float32);
     uint64 csr_val_sz = uint64(nnz_) * 9 * sizeof(float32);
 
     // Clear diagonal and CSR values
-    wgpuCommandEncoderClearBuffer(encoder, diag_buffer_->GetHandle(), 0, diag_sz);
+    recorder.ClearBuffer(diag_buffer_->GetHandle(), 0, diag_sz);
     if (csr_val_sz > 0) {
-        wgpuCommandEncoderClearBuffer(encoder, csr_values_buffer_->GetHandle(), 0, csr_val_sz);
+        recorder.ClearBuffer(csr_values_buffer_->GetHandle(), 0, csr_val_sz);
     }
 
     // Inertial LHS: diag += M/dt² * I₃
-    Dispatch(encoder, pd_inertial_lhs_pipeline_, bg_inertial_lhs_, node_wg_count_);
+    recorder.Dispatch(pd_inertial_lhs_pipeline_, bg_inertial_lhs_, node_wg_count_);
 
     // Term LHS contributions
     for (auto& term : terms_) {
-        term->AssembleLHS(encoder);
+        term->AssembleLHS(recorder);
     }
 
     // Compute D⁻¹
-    Dispatch(encoder, pd_compute_d_inv_pipeline_, bg_compute_d_inv_, node_wg_count_);
+    recorder.Dispatch(pd_compute_d_inv_pipeline_, bg_compute_d_inv_, node_wg_count_);
+}
+
+void PDDynamics::Solve(ComputePassRecorder& recorder) {
+    // Per-iteration Chebyshev ω lives in its own 256-byte JacobiParamsSlot of the jacobi
+    // params uniform, selected by the dynamic offset of DispatchWithOffset, so the command
+    // sequence never changes between frames: capture once, replay thereafter.
+    if (solve_program_.IsEmpty()) {
+        ComputePassRecorder capture(solve_program_);
+        RecordSolve(capture);
+        LogInfo("PDDynamics: recorded solve program (", solve_program_.GetCommandCount(),
+                " commands, ", capture.GetDispatchCount(), " dispatches)");
+    }
+    solve_program_.Replay(recorder);
 }
 
-void PDDynamics::Solve(WGPUCommandEncoder encoder) {
+void PDDynamics::RecordSolve(ComputePassRecorder& recorder) {
     // Init: x_old = positions
-    Dispatch(encoder, pd_init_pipeline_, bg_init_, node_wg_count_);
+    recorder.Dispatch(pd_init_pipeline_, bg_init_, node_wg_count_);
 
     // Predict: s = x_old + dt*v + dt²*g
-    Dispatch(encoder, pd_predict_pipeline_, bg_predict_, node_wg_count_);
+    recorder.Dispatch(pd_predict_pipeline_, bg_predict_, node_wg_count_);
 
-    // Initial guess: q_curr = s
-    Dispatch(encoder, pd_copy_pipeline_, bg_copy_q_from_s_, node_wg_count_);
-
-    // Wang 2015 single fused loop with correct Chebyshev 3-buffer rotation.
-    // q_prev = q_{k-1}, q_curr = q_k, q_new = q_{k+1}
-    uint64 vec_sz = uint64(node_count_) * 4 * sizeof(float32);
-    uint64 rhs_sz = uint64(node_count_) * 4 * sizeof(uint32);
-
-    // Save initial guess: q_prev = q_0 (before iteration loop)
-    wgpuCommandEncoderCopyBufferToBuffer(encoder,
-        q_curr_buffer_->GetHandle(), 0,
-        q_prev_buffer_->GetHandle(), 0, vec_sz);
+    // Initial guess: q_0 = s (slot 0)
+    recorder.Dispatch(pd_copy_pipeline_, bg_copy_q_from_s_, node_wg_count_);
 
+    // Wang 2015 single fused loop with Chebyshev 3-buffer rotation.
+    // The rotation is done by bind group selection; q_prev is only read for k >= 1
+    // (is_first_step = 1 at k = 0), so slot 2 needs no initialization.
     for (uint32 k = 0; k < iterations_; ++k) {
-        // Clear RHS
-        wgpuCommandEncoderClearBuffer(encoder, rhs_buffer_->GetHandle(), 0, rhs_sz);
+        RecordIteration(recorder, k, k);
+    }
+}
 
-        // Inertial RHS: rhs += (M/dt²) * s
-        Dispatch(encoder, pd_mass_rhs_pipeline_, bg_mass_rhs_, node_wg_count_);
+void PDDynamics::RecordIteration(ComputePassRecorder& recorder, uint32 k, uint32 params_index) {
+    uint64 rhs_sz = uint64(node_count_) * 4 * sizeof(uint32);
+    uint32 curr = k % kPDIterateBufferCount;
 
-        // Fused local projection + RHS assembly per term
-        for (auto& term : terms_) {
-            term->ProjectRHS(encoder);
-        }
+    // Clear RHS
+    recorder.ClearBuffer(rhs_buffer_->GetHandle(), 0, rhs_sz);
+
+    // Inertial RHS: rhs += (M/dt²) * s
+    recorder.Dispatch(pd_mass_rhs_pipeline_, bg_mass_rhs_, node_wg_count_);
 
-        // Copy pre-computed Jacobi params for this iteration (staging → uniform)
-        wgpuCommandEncoderCopyBufferToBuffer(encoder,
-            jacobi_staging_buffer_->GetHandle(), uint64(k) * sizeof(JacobiParams),
-            jacobi_params_buffer_->GetHandle(), 0, sizeof(JacobiParams));
-
-        // Fused SpMV + Jacobi + Chebyshev: q_new = ω*(D⁻¹*(b-(A-D)*q_curr) - q_prev) + q_prev
-        Dispatch(encoder, pd_jacobi_step_pipeline_, bg_jacobi_step_, node_wg_count_);
-
-        // 3-buffer rotation: prev ← curr, curr ← new
-        wgpuCommandEncoderCopyBufferToBuffer(encoder,
-            q_curr_buffer_->GetHandle(), 0,
-            q_prev_buffer_->GetHandle(), 0, vec_sz);
-        wgpuCommandEncoderCopyBufferToBuffer(encoder,
-            q_new_buffer_->GetHandle(), 0,
-            q_curr_buffer_->GetHandle(), 0, vec_sz);
+    // Fused local projection + RHS assembly per term (reads q_k)
+    for (auto& term : terms_) {
+        term->ProjectRHS(recorder, curr);
     }
+
+    // Fused SpMV + Jacobi + Chebyshev: q_new = ω*(D⁻¹*(b-(A-D)*q_curr) - q_prev) + q_prev
+    // ω for this iteration is selected by the dynamic offset into jacobi_params_buffer_.
+    recorder.DispatchWithOffset(pd_jacobi_step_pipeline_.GetHandle(), bg_jacobi_step_[curr].GetHandle(),
+                                params_index * uint32(sizeof(JacobiParamsSlot)), jacobi_wg_count_);
 }
 
 WGPUBuffer PDDynamics::GetQCurrBuffer() const {
-    return q_curr_buffer_ ? q_curr_buffer_->GetHandle() : nullptr;
+    return q_buffers_[GetResultSlot()] ? q_buffers_[GetResultSlot()]->GetHandle() : nullptr;
 }
 
 WGPUBuffer PDDynamics::GetXOldBuffer() const {
@@ -395,42 +423,10 @@ uint64 PDDynamics::GetVec4BufferSize() const {
 // ---------------------------------------------------------------------------
 // Debug readback — reads GPU buffers to CPU and logs values for sample nodes.
 // ---------------------------------------------------------------------------
-static std::vector<float32> ReadbackBuffer(WGPUBuffer src, uint64 size) {
-    auto& gpu = GPUCore::GetInstance();
-
-    WGPUBufferDescriptor bd = WGPU_BUFFER_DESCRIPTOR_INIT;
-    bd.usage = WGPUBufferUsage_MapRead | WGPUBufferUsage_CopyDst;
-    bd.size  = size;
-    WGPUBuffer staging = wgpuDeviceCreateBuffer(gpu.GetDevice(), &bd);
-
-    WGPUCommandEncoderDescriptor ed = WGPU_COMMAND_ENCODER_DESCRIPTOR_INIT;
-    WGPUCommandEncoder enc = wgpuDeviceCreateCommandEncoder(gpu.GetDevice(), &ed);
-    wgpuCommandEncoderCopyBufferToBuffer(enc, src, 0, staging, 0, size);
-    WGPUCommandBuffer cb = wgpuCommandEncoderFinish(enc, nullptr);
-    wgpuQueueSubmit(gpu.GetQueue(), 1, &cb);
-    wgpuCommandBufferRelease(cb);
-    wgpuCommandEncoderRelease(enc);
-
-    simulate::WaitForGPU();
-
-    struct Ctx { bool done = false; };
-    Ctx ctx;
-    WGPUBufferMapCallbackInfo mi = WGPU_BUFFER_MAP_CALLBACK_INFO_INIT;
-    mi.mode = WGPUCallbackMode_WaitAnyOnly;
-    mi.callback = [](WGPUMapAsyncStatus, WGPUStringView, void* ud, void*) {
-        static_cast<Ctx*>(ud)->done = true;
-    };
-    mi.userdata1 = &ctx;
-    WGPUFuture future = wgpuBufferMapAsync(staging, WGPUMapMode_Read, 0, size, mi);
-    WGPUFutureWaitInfo wi = WGPU_FUTURE_WAIT_INFO_INIT;
-    wi.future = future;
-    wgpuInstanceWaitAny(gpu.GetWGPUInstance(), 1, &wi, UINT64_MAX);
-
-    const float32* ptr = static_cast<const float32*>(
-        wgpuBufferGetConstMappedRange(staging, 0, size));
-    std::vector<float32> result(ptr, ptr + size / sizeof(float32));
-    wgpuBufferUnmap(staging);
-    wgpuBufferRelease(staging);
+static std::vector<float32> ReadbackBuffer(WGPUBuffer src, uint64 size, uint64 offset = 0) {
+    auto raw = GPUReadback::GetInstance().Read(src, offset, size);
+    std::vector<float32> result(raw.size() / sizeof(float32));
+    std::memcpy(result.data(), raw.data(), result.size() * sizeof(float32));
     return result;
 }
 
@@ -445,21 +441,24 @@ void PDDynamics::DebugDump() {
     auto rhs   = ReadbackBuffer(rhs_buffer_->GetHandle(), vec_sz);
     auto diag  = ReadbackBuffer(diag_buffer_->GetHandle(), diag_sz);
     auto d_inv = ReadbackBuffer(d_inv_buffer_->GetHandle(), diag_sz);
-    auto q     = ReadbackBuffer(q_curr_buffer_->GetHandle(), vec_sz);
-    auto q_prev_d = ReadbackBuffer(q_prev_buffer_->GetHandle(), vec_sz);
+    uint32 result = GetResultSlot();
+    uint32 prev = (result + kPDIterateBufferCount - 1) % kPDIterateBufferCount;
+    auto q     = ReadbackBuffer(q_buffers_[result]->GetHandle(), vec_sz);
+    auto q_prev_d = ReadbackBuffer(q_buffers_[prev]->GetHandle(), vec_sz);
 
-    // Also read jacobi staging (first 5 entries)
+    // Also read jacobi params (first 5 slots)
     uint32 jp_count = std::min(uint32(5), iterations_);
-    auto jp_data = ReadbackBuffer(jacobi_staging_buffer_->GetHandle(),
-                                   uint64(jp_count) * sizeof(JacobiParams));
+    auto jp_data = ReadbackBuffer(jacobi_params_buffer_.GetHandle(),
+                                   uint64(jp_count) * sizeof(JacobiParamsSlot),
+                                   jacobi_params_buffer_.GetOffset());
 
     LogInfo("===== PD DEBUG DUMP (first frame) =====");
 
     // Jacobi params
-    const JacobiParams* jp = reinterpret_cast<const JacobiParams*>(jp_data.data());
+    const JacobiParamsSlot* jp = reinterpret_cast<const JacobiParamsSlot*>(jp_data.data());
     for (uint32 k = 0; k < jp_count; ++k) {
-        LogInfo("[PD] jacobi[", k, "] omega=", jp[k].omega,
-                " is_first=", jp[k].is_first_step);
+        LogInfo("[PD] jacobi[", k, "] omega=", jp[k].params.omega,
+                " is_first=", jp[k].params.is_first_step);
     }
 
     // Sample nodes: 0 (pinned), 1, 64, 2048
@@ -513,24 +512,22 @@ bool PDDynamics::CalibrateRho() {
 
     auto& gpu = GPUCore::GetInstance();
     uint64 vec_sz = uint64(node_count_) * 4 * sizeof(float32);
-    uint64 rhs_sz = uint64(node_count_) * 4 * sizeof(uint32);
 
     // Use a subset of iterations for calibration (pure Jacobi + readback)
     const uint32 cal_iters = std::min(iterations_, uint32(15));
 
     LogInfo("PDDynamics: calibrating rho with ", cal_iters, " pure Jacobi iterations...");
 
-    // Setup: init + predict + q_curr=s + q_prev=s
+    // Setup: init + predict + q_0=s
     {
         WGPUCommandEncoderDescriptor ed = WGPU_COMMAND_ENCODER_DESCRIPTOR_INIT;
         WGPUCommandEncoder enc = wgpuDeviceCreateCommandEncoder(gpu.GetDevice(), &ed);
+        ComputePassRecorder recorder(enc, "pd_calibrate");
 
-        Dispatch(enc, pd_init_pipeline_, bg_init_, node_wg_count_);
-        Dispatch(enc, pd_predict_pipeline_, bg_predict_, node_wg_count_);
-        Dispatch(enc, pd_copy_pipeline_, bg_copy_q_from_s_, node_wg_count_);
-        wgpuCommandEncoderCopyBufferToBuffer(enc,
-            q_curr_buffer_->GetHandle(), 0,
-            q_prev_buffer_->GetHandle(), 0, vec_sz);
+        recorder.Dispatch(pd_init_pipeline_, bg_init_, node_wg_count_);
+        recorder.Dispatch(pd_predict_pipeline_, bg_predict_, node_wg_count_);
+        recorder.Dispatch(pd_copy_pipeline_, bg_copy_q_from_s_, node_wg_count_);
+        recorder.Flush();
 
         WGPUCommandBuffer cmd = wgpuCommandEncoderFinish(enc, nullptr);
         wgpuQueueSubmit(gpu.GetQueue(), 1, &cmd);
@@ -540,10 +537,12 @@ bool PDDynamics::CalibrateRho() {
     simulate::WaitForGPU();
 
     // Save initial q_0 for delta measurement
-    auto q_prev_data = ReadbackBuffer(q_curr_buffer_->GetHandle(), vec_sz);
+    auto q_prev_data = ReadbackBuffer(q_buffers_[0]->GetHandle(), vec_sz);
 
-    // Write pure-Jacobi params (ω=1, is_first=1)
-    JacobiParams pure_jacobi = {1.0f, 1, 0.0f, 0.0f};
+    // Write pure-Jacobi params (ω=1, is_first=1) to slot 0; every calibration
+    // iteration selects it. BuildChebyshevParams() overwrites it afterwards.
+    JacobiParamsSlot pure_jacobi = {{1.0f, 1, 0.0f, 0.0f}};
+    jacobi_params_buffer_.WriteData(std::span<const JacobiParamsSlot>(&pure_jacobi, 1));
 
     std::vector<float32> delta_norms;
 
@@ -552,29 +551,9 @@ bool PDDynamics::CalibrateRho() {
         {
             WGPUCommandEncoderDescriptor ed = WGPU_COMMAND_ENCODER_DESCRIPTOR_INIT;
             WGPUCommandEncoder enc = wgpuDeviceCreateCommandEncoder(gpu.GetDevice(), &ed);
-
-            wgpuCommandEncoderClearBuffer(enc, rhs_buffer_->GetHandle(), 0, rhs_sz);
-            Dispatch(enc, pd_mass_rhs_pipeline_, bg_mass_rhs_, node_wg_count_);
-
-            for (auto& term : terms_) {
-                term->ProjectRHS(enc);
-            }
-
-            // Set Jacobi params to ω=1
-            jacobi_staging_buffer_->WriteData(std::span<const JacobiParams>(&pure_jacobi, 1));
-            wgpuCommandEncoderCopyBufferToBuffer(enc,
-                jacobi_staging_buffer_->GetHandle(), 0,
-                jacobi_params_buffer_->GetHandle(), 0, sizeof(JacobiParams));
-
-            Dispatch(enc, pd_jacobi_step_pipeline_, bg_jacobi_step_, node_wg_count_);
-
-            // Rotate: prev ← curr, curr ← new
-            wgpuCommandEncoderCopyBufferToBuffer(enc,
-                q_curr_buffer_->GetHandle(), 0,
-                q_prev_buffer_->GetHandle(), 0, vec_sz);
-            wgpuCommandEncoderCopyBufferToBuffer(enc,
-                q_new_buffer_->GetHandle(), 0,
-                q_curr_buffer_->GetHandle(), 0, vec_sz);
+            ComputePassRecorder recorder(enc, "pd_calibrate");
+            RecordIteration(recorder, k, 0);
+            recorder.Flush();
 
             WGPUCommandBuffer cmd = wgpuCommandEncoderFinish(enc, nullptr);
             wgpuQueueSubmit(gpu.GetQueue(), 1, &cmd);
@@ -583,8 +562,9 @@ bool PDDynamics::CalibrateRho() {
         }
         simulate::WaitForGPU();
 
-        // Readback current q
-        auto q_curr_data = ReadbackBuffer(q_curr_buffer_->GetHandle(), vec_sz);
+        // Readback q_{k+1}
+        auto q_curr_data = ReadbackBuffer(
+            q_buffers_[(k + 1) % kPDIterateBufferCount]->GetHandle(), vec_sz);
 
         // Compute ||q_curr - q_prev||
         float64 delta_sq = 0.0;
@@ -598,27 +578,7 @@ bool PDDynamics::CalibrateRho() {
         q_prev_data = std::move(q_curr_data);
     }
 
-    // Compute convergence ratios (skip first 2 for warmup)
-    std::vector<float32> ratios;
-    for (uint32 k = 2; k < uint32(delta_norms.size()); ++k) {
-        if (delta_norms[k - 1] > 1e-12f) {
-            ratios.push_back(delta_norms[k] / delta_norms[k - 1]);
-        }
-    }
-
-    float32 rho_est = 0.95f;  // Fallback
-    if (!ratios.empty()) {
-        // Sort and use 75th percentile (conservative but robust)
-        std::sort(ratios.begin(), ratios.end());
-        uint32 idx = std::min(uint32(float32(ratios.size()) * 0.75f),
-                              uint32(ratios.size() - 1));
-        rho_est = ratios[idx];
-
-        // Safety margin: slightly overestimate (never underestimate!)
-        // Underestimating ρ causes Chebyshev to amplify modes above ρ_est.
-        rho_est = rho_est * 1.05f;
-        rho_est = std::clamp(rho_est, 0.5f, 0.9999f);
-    }
+    float32 rho_est = EstimateChebyshevRho(delta_norms);
 
     // Log calibration results
     float32 sq = std::sqrt(1.0f - rho_est * rho_est);
@@ -647,24 +607,58 @@ bool PDDynamics::CalibrateRho() {
 }
 
 void PDDynamics::BuildChebyshevParams(float32 rho) {
-    std::vector<JacobiParams> all_params(iterations_);
-    float32 omega = 1.0f;
+    std::vector<float32> omegas = ComputeChebyshevOmegas(rho, iterations_);
+    std::vector<JacobiParamsSlot> all_params(iterations_);
     for (uint32 k = 0; k < iterations_; ++k) {
+        all_params[k].params = {omegas[k], k == 0 ? 1u : 0u, 0.0f, 0.0f};
+    }
+    jacobi_params_buffer_.WriteData(std::span<const JacobiParamsSlot>(all_params));
+}
+
+std::vector<float32> ComputeChebyshevOmegas(float32 rho, uint32 iterations) {
+    std::vector<float32> omegas(iterations);
+    float32 omega = 1.0f;
+    for (uint32 k = 0; k < iterations; ++k) {
         if (k == 0) {
             omega = 1.0f;
-            all_params[k] = {omega, 1, 0.0f, 0.0f};
         } else if (k == 1) {
             omega = 2.0f / (2.0f - rho * rho);
-            all_params[k] = {omega, 0, 0.0f, 0.0f};
         } else {
             omega = 4.0f / (4.0f - rho * rho * omega);
-            all_params[k] = {omega, 0, 0.0f, 0.0f};
+        }
+        omegas[k] = omega;
+    }
+    return omegas;
+}
+
+float32 EstimateChebyshevRho(const std::vector<float32>& delta_norms) {
+    // Compute convergence ratios (skip first 2 for warmup)
+    std::vector<float32> ratios;
+    for (uint32 k = 2; k < uint32(delta_norms.size()); ++k) {
+        if (delta_norms[k - 1] > 1e-12f) {
+            ratios.push_back(delta_norms[k] / delta_norms[k - 1]);
         }
     }
-    jacobi_staging_buffer_->WriteData(std::span<const JacobiParams>(all_params));
+
+    float32 rho_est = 0.95f;  // Fallback
+    if (!ratios.empty()) {
+        // Sort and use 75th percentile (conservative but robust)
+        std::sort(ratios.begin(), ratios.end());
+        uint32 idx = std::min(uint32(float32(ratios.size()) * 0.75f),
+                              uint32(ratios.size() - 1));
+        rho_est = ratios[idx];
+
+        // Safety margin: slightly overestimate (never underestimate!)
+        // Underestimating ρ causes Chebyshev to amplify modes above ρ_est.
+        rho_est = rho_est * 1.05f;
+        rho_est = std::clamp(rho_est, 0.5f, 0.9999f);
+    }
+    return rho_est;
 }
 
 void PDDynamics::Shutdown() {
+    solve_program_.Clear();
+
     for (auto& term : terms_) {
         term->Shutdown();
     }
@@ -677,6 +671,7 @@ void PDDynamics::Shutdown() {
     bg_inertial_lhs_ = {};
     bg_compute_d_inv_ = {};
     bg_jacobi_step_ = {};
+    bgl_jacobi_step_ = {};
 
     pd_init_pipeline_ = {};
     pd_predict_pipeline_ = {};
@@ -687,8 +682,7 @@ void PDDynamics::Shutdown() {
     pd_jacobi_step_pipeline_ = {};
 
     params_buffer_.reset();
-    jacobi_params_buffer_.reset();
-    jacobi_staging_buffer_.reset();
+    jacobi_params_buffer_ = {};
     csr_row_ptr_buffer_.reset();
     csr_col_idx_buffer_.reset();
     csr_values_buffer_.reset();
@@ -696,9 +690,7 @@ void PDDynamics::Shutdown() {
     d_inv_buffer_.reset();
     x_old_buffer_.reset();
     s_buffer_.reset();
-    q_curr_buffer_.reset();
-    q_prev_buffer_.reset();
-    q_new_buffer_.reset();
+    for (auto& q : q_buffers_) q.reset();
     rhs_buffer_.reset();
     sparsity_.reset();
 
@@ -5,6 +5,9 @@
 #include "core_simulate/solver_params.h"
 #include "core_gpu/gpu_handle.h"
 #include "core_gpu/gpu_buffer.h"
+#include "core_gpu/gpu_buffer_pool.h"
+#include "core_gpu/compute_program.h"
+#include <array>
 #include <memory>
 #include <string>
 #include <vector>
@@ -24,20 +27,42 @@ struct alignas(16) JacobiParams {
     float32 _pad1 = 0.0f;
 };
 
+// One JacobiParams per iteration, padded so iteration k is selected by a dynamic
+// uniform offset of k * sizeof(JacobiParamsSlot) (256 = max minUniformBufferOffsetAlignment).
+struct alignas(256) JacobiParamsSlot {
+    JacobiParams params;
+};
+static_assert(sizeof(JacobiParamsSlot) == 256);
+
+// Chebyshev weights for the given spectral radius estimate, one per iteration.
+// Iteration 0 is the pure Jacobi step (omega = 1).
+std::vector<float32> ComputeChebyshevOmegas(float32 rho, uint32 iterations);
+
+// Estimate the Jacobi spectral radius from the per-iteration update norms
+// ||q_{k+1} - q_k|| of a pure Jacobi run (Wang 2015). Falls back to 0.95.
+float32 EstimateChebyshevRho(const std::vector<float32>& delta_norms);
+
 // Projective Dynamics solver with Chebyshev-accelerated Jacobi iteration.
 // Replaces CG with GPU-friendly Jacobi (no dot product reductions).
 class PDDynamics {
 public:
+    // Tuned workgroup size key for the fused Jacobi step (gpu::WorkgroupTuner)
+    static constexpr const char* kJacobiKernel = "pd_jacobi_step";
+
     PDDynamics();
     ~PDDynamics();
 
     // Add a projective term (call before Initialize)
     void AddTerm(std::unique_ptr<simulate::IProjectiveTerm> term);
 
-    // Configure solver iterations (call before Initialize or anytime)
-    void SetIterations(uint32 iterations) { iterations_ = iterations; }
+    // Configure solver iterations (call before Initialize)
+    void SetIterations(uint32 iterations) { iterations_ = iterations; solve_program_.Clear(); }
     void SetChebyshevRho(float32 rho) { chebyshev_rho_ = rho; }
 
+    // First node of this system in the position/velocity/mass buffers (call before
+    // Initialize). Scoped systems bind their region of the shared DeviceDB buffers.
+    void SetNodeOffset(uint32 node_offset) { node_offset_ = node_offset; }
+
     // Initialize after all terms are added.
     // physics_buffer: DeviceDB singleton uniform (binding 0).
     void Initialize(uint32 node_count, uint32 edge_count, uint32 face_count,
@@ -46,7 +71,9 @@ public:
                     WGPUBuffer mass_buffer, uint32 workgroup_size = 64);
 
     // Run the PD solver for one timestep (Wang 2015 single fused loop).
-    void Solve(WGPUCommandEncoder encoder);
+    // The fixed iteration loop is captured into a ComputeProgram on the first call
+    // and replayed into the recorder afterwards.
+    void Solve(gpu::ComputePassRecorder& recorder);
 
     // Adaptive ρ calibration (Wang 2015 gradient decrease rate method).
     // Runs a full PD solve with pure Jacobi, measures convergence rate,
@@ -77,7 +104,10 @@ private:
     void CreatePipelines();
     void CacheBindGroups(WGPUBuffer position_buffer, WGPUBuffer velocity_buffer,
                          WGPUBuffer mass_buffer);
-    void RebuildLHS(WGPUCommandEncoder encoder);
+    void RebuildLHS(gpu::ComputePassRecorder& recorder);
+    void RecordSolve(gpu::ComputePassRecorder& recorder);
+    void RecordIteration(gpu::ComputePassRecorder& recorder, uint32 k, uint32 params_index);
+    [[nodiscard]] uint32 GetResultSlot() const { return iterations_ % simulate::kPDIterateBufferCount; }
     void BuildChebyshevParams(float32 rho);
 
     // Terms
@@ -92,7 +122,10 @@ private:
     uint32 edge_count_ = 0;
     uint32 face_count_ = 0;
     uint32 workgroup_size_ = 64;
+    uint32 jacobi_workgroup_size_ = 64;   // tuned per adapter (kJacobiKernel)
+    uint32 node_offset_ = 0;
     uint32 node_wg_count_ = 0;
+    uint32 jacobi_wg_count_ = 0;
 
     // PD config
     uint32 iterations_ = 20;
@@ -107,9 +140,8 @@ private:
     std::unique_ptr<gpu::GPUBuffer<simulate::SolverParams>> params_buffer_;
     simulate::SolverParams params_{};
 
-    // Jacobi params: uniform (CopyDst) + staging (CopySrc, pre-computed per iteration)
-    std::unique_ptr<gpu::GPUBuffer<JacobiParams>> jacobi_params_buffer_;
-    std::unique_ptr<gpu::GPUBuffer<JacobiParams>> jacobi_staging_buffer_;
+    // Jacobi params: one slot per iteration, bound with a dynamic offset
+    gpu::GPUBufferSlice jacobi_params_buffer_;
 
     // CSR structure
     std::unique_ptr<gpu::GPUBuffer<uint32>> csr_row_ptr_buffer_;
@@ -123,9 +155,9 @@ private:
     // Solver buffers
     std::unique_ptr<gpu::GPUBuffer<float32>> x_old_buffer_;
     std::unique_ptr<gpu::GPUBuffer<float32>> s_buffer_;
-    std::unique_ptr<gpu::GPUBuffer<float32>> q_curr_buffer_;
-    std::unique_ptr<gpu::GPUBuffer<float32>> q_prev_buffer_;
-    std::unique_ptr<gpu::GPUBuffer<float32>> q_new_buffer_;
+    // Rotating iterates: iteration k reads q_curr = slot k%3, q_prev = slot (k+2)%3
+    // and writes q_new = slot (k+1)%3, so no per-iteration copies are needed.
+    std::array<std::unique_ptr<gpu::GPUBuffer<float32>>, simulate::kPDIterateBufferCount> q_buffers_;
     std::unique_ptr<gpu::GPUBuffer<float32>> rhs_buffer_;
 
     // Pipelines
@@ -144,7 +176,11 @@ private:
     gpu::GPUBindGroup bg_mass_rhs_;
     gpu::GPUBindGroup bg_inertial_lhs_;
     gpu::GPUBindGroup bg_compute_d_inv_;
-    gpu::GPUBindGroup bg_jacobi_step_;
+    gpu::GPUBindGroupLayout bgl_jacobi_step_;
+    std::array<gpu::GPUBindGroup, simulate::kPDIterateBufferCount> bg_jacobi_step_;  // by q_curr slot
+
+    // Captured Solve() dispatch sequence (rebuilt lazily when cleared)
+    gpu::ComputeProgram solve_program_{"pd_step"};
 
     static constexpr uint32 kWorkgroupSize = 64;
 };
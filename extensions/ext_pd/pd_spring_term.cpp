@@ -1,11 +1,13 @@
 #include "ext_pd/pd_spring_term.h"
 #include "ext_newton/spring_term.h"
 #include "core_gpu/gpu_core.h"
-#include "core_gpu/shader_loader.h"
+#include "core_gpu/pipeline_registry.h"
 #include "core_gpu/bind_group_builder.h"
-#include "core_gpu/compute_encoder.h"
+#include "core_gpu/compute_pass_recorder.h"
 #include "core_util/logger.h"
+#include "core_util/thread_pool.h"
 #include <webgpu/webgpu.h>
+#include <cmath>
 #include <span>
 
 using namespace mps;
@@ -30,9 +32,19 @@ void PDSpringTerm::DeclareSparsity(SparsityBuilder& builder) {
     }
 }
 
-void PDSpringTerm::Initialize(const SparsityBuilder& sparsity, const PDAssemblyContext& ctx) {
+ElementColoring PDSpringTerm::PrepareEdges(const SparsityBuilder& sparsity, uint32 node_count) {
     uint32 E = static_cast<uint32>(edges_.size());
-    nnz_ = sparsity.GetNNZ();
+
+    // Color edges so the per-iteration RHS scatter needs no atomics
+    std::vector<uint32> edge_nodes;
+    edge_nodes.reserve(uint64(E) * 2);
+    for (const auto& edge : edges_) {
+        edge_nodes.push_back(edge.n0);
+        edge_nodes.push_back(edge.n1);
+    }
+    ElementColoring coloring;
+    coloring.Build(edge_nodes, 2, node_count);
+    edges_ = coloring.Reorder(edges_);
 
     // Build edge-to-CSR mapping
     edge_csr_mappings_.resize(E);
@@ -44,6 +56,13 @@ void PDSpringTerm::Initialize(const SparsityBuilder& sparsity, const PDAssemblyC
         edge_csr_mappings_[e].block_aa = a;
         edge_csr_mappings_[e].block_bb = b;
     }
+    return coloring;
+}
+
+void PDSpringTerm::Initialize(const SparsityBuilder& sparsity, const PDAssemblyContext& ctx) {
+    uint32 E = static_cast<uint32>(edges_.size());
+    nnz_ = sparsity.GetNNZ();
+    ElementColoring coloring = PrepareEdges(sparsity, ctx.node_count);
 
     // Upload GPU buffers
     edge_buffer_ = std::make_unique<GPUBuffer<SpringEdge>>(
@@ -53,23 +72,21 @@ void PDSpringTerm::Initialize(const SparsityBuilder& sparsity, const PDAssemblyC
 
     SpringParams params;
     params.stiffness = stiffness_;
-    spring_params_buffer_ = std::make_unique<GPUBuffer<SpringParams>>(
-        BufferUsage::Uniform, std::span<const SpringParams>(&params, 1), "pd_spring_params");
+    auto& pool = GPUBufferPool::GetInstance();
+    spring_params_buffer_ = pool.Allocate(BufferUsage::Uniform, std::span<const SpringParams>(&params, 1));
 
-    // Create pipelines
-    auto make_pipeline = [](const std::string& path, const std::string& label) -> GPUComputePipeline {
-        auto shader = ShaderLoader::CreateModule("ext_pd/" + path, label);
-        WGPUComputePipelineDescriptor desc = WGPU_COMPUTE_PIPELINE_DESCRIPTOR_INIT;
-        desc.label = {label.data(), label.size()};
-        desc.layout = nullptr;
-        desc.compute.module = shader.GetHandle();
-        std::string entry = "cs_main";
-        desc.compute.entryPoint = {entry.data(), entry.size()};
-        return GPUComputePipeline(wgpuDeviceCreateComputePipeline(GPUCore::GetInstance().GetDevice(), &desc));
-    };
+    const auto& ranges = coloring.GetRanges();
+    if (!ranges.empty()) {
+        color_range_buffer_ = pool.Allocate(BufferUsage::Uniform, std::span<const ColorRange>(ranges));
+    }
 
-    lhs_pipeline_ = make_pipeline("pd_spring_lhs.wgsl", "pd_spring_lhs");
-    project_rhs_pipeline_ = make_pipeline("pd_spring_project_rhs.wgsl", "pd_spring_project_rhs");
+    // Create pipelines
+    PipelineBatch batch;
+    batch.Add(ComputePipelineDesc{"ext_pd/pd_spring_lhs.wgsl", "pd_spring_lhs"}
+                  .SetWorkgroupSize(ctx.workgroup_size), lhs_pipeline_);
+    batch.Add(ComputePipelineDesc{"ext_pd/pd_spring_project_rhs.wgsl", "pd_spring_project_rhs"}
+                  .SetWorkgroupSize(ctx.workgroup_size), project_rhs_pipeline_);
+    batch.Resolve();
 
     // Cache bind groups
     uint64 edge_sz = uint64(E) * sizeof(SpringEdge);
@@ -80,11 +97,11 @@ void PDSpringTerm::Initialize(const SparsityBuilder& sparsity, const PDAssemblyC
     uint64 q_sz = uint64(ctx.node_count) * 4 * sizeof(float32);
 
     auto make_bg = [](const GPUComputePipeline& pipeline, const std::string& label,
-                      std::initializer_list<std::pair<uint32, std::pair<WGPUBuffer, uint64>>> entries) {
+                      std::initializer_list<std::pair<uint32, BufferBinding>> entries) {
         auto bgl = wgpuComputePipelineGetBindGroupLayout(pipeline.GetHandle(), 0);
         auto builder = BindGroupBuilder(label);
-        for (auto& [binding, buf_size] : entries) {
-            builder = std::move(builder).AddBuffer(binding, buf_size.first, buf_size.second);
+        for (auto& [binding, range] : entries) {
+            builder = std::move(builder).AddBuffer(binding, range);
         }
         auto bg = std::move(builder).Build(bgl);
         wgpuBindGroupLayoutRelease(bgl);
@@ -98,51 +115,115 @@ void PDSpringTerm::Initialize(const SparsityBuilder& sparsity, const PDAssemblyC
          {2, {ctx.diag_buffer, diag_sz}},
          {3, {ctx.csr_values_buffer, std::max(csr_val_sz, uint64(4))}},
          {4, {edge_csr_buffer_->GetHandle(), csr_map_sz}},
-         {5, {spring_params_buffer_->GetHandle(), sizeof(SpringParams)}}});
-
-    // Fused project+RHS bind group
-    bg_project_rhs_ = make_bg(project_rhs_pipeline_, "bg_pd_spring_proj_rhs",
-        {{0, {ctx.params_buffer, ctx.params_size}},
-         {1, {edge_buffer_->GetHandle(), edge_sz}},
-         {2, {ctx.q_buffer, q_sz}},
-         {3, {ctx.rhs_buffer, rhs_sz}},
-         {4, {spring_params_buffer_->GetHandle(), sizeof(SpringParams)}}});
+         {5, spring_params_buffer_.GetBinding()}});
+
+    // Fused project+RHS bind groups, one per rotating q slot and edge color
+    auto proj_bgl = wgpuComputePipelineGetBindGroupLayout(project_rhs_pipeline_.GetHandle(), 0);
+    color_wg_counts_.clear();
+    for (uint32 slot = 0; slot < kPDIterateBufferCount; ++slot) {
+        bg_project_rhs_[slot].clear();
+        for (uint32 c = 0; c < coloring.GetColorCount(); ++c) {
+            bg_project_rhs_[slot].push_back(BindGroupBuilder(
+                    "bg_pd_spring_proj_rhs_" + std::to_string(slot) + "_c" + std::to_string(c))
+                .AddBuffer(0, ctx.params_buffer, ctx.params_size)
+                .AddBuffer(1, edge_buffer_->GetHandle(), edge_sz)
+                .AddBuffer(2, ctx.q_buffers[slot], q_sz)
+                .AddBuffer(3, ctx.rhs_buffer, rhs_sz)
+                .AddSlice(4, spring_params_buffer_)
+                .AddSlice(5, color_range_buffer_, kColorRangeBindingSize, uint64(c) * sizeof(ColorRange))
+                .Build(proj_bgl));
+        }
+    }
+    wgpuBindGroupLayoutRelease(proj_bgl);
+    for (const auto& range : ranges) {
+        color_wg_counts_.push_back((range.count + ctx.workgroup_size - 1) / ctx.workgroup_size);
+    }
 
     wg_count_ = (E + ctx.workgroup_size - 1) / ctx.workgroup_size;
 
-    LogInfo("PDSpringTerm: initialized (", E, " edges, nnz=", nnz_, ")");
+    LogInfo("PDSpringTerm: initialized (", E, " edges, nnz=", nnz_, ", ",
+            coloring.GetColorCount(), " colors)");
+}
+
+void PDSpringTerm::AssembleLHS(ComputePassRecorder& recorder) {
+    recorder.Dispatch(lhs_pipeline_.GetHandle(), bg_lhs_.GetHandle(), wg_count_);
 }
 
-void PDSpringTerm::AssembleLHS(WGPUCommandEncoder encoder) {
-    WGPUComputePassDescriptor pd = WGPU_COMPUTE_PASS_DESCRIPTOR_INIT;
-    WGPUComputePassEncoder pass = wgpuCommandEncoderBeginComputePass(encoder, &pd);
-    ComputeEncoder enc(pass);
-    enc.SetPipeline(lhs_pipeline_.GetHandle());
-    enc.SetBindGroup(0, bg_lhs_.GetHandle());
-    enc.Dispatch(wg_count_);
-    wgpuComputePassEncoderEnd(pass);
-    wgpuComputePassEncoderRelease(pass);
+void PDSpringTerm::ProjectRHS(ComputePassRecorder& recorder, uint32 q_slot) {
+    const auto& bgs = bg_project_rhs_[q_slot];
+    for (size_t c = 0; c < bgs.size(); ++c) {
+        recorder.Dispatch(project_rhs_pipeline_.GetHandle(), bgs[c].GetHandle(), color_wg_counts_[c]);
+    }
 }
 
-void PDSpringTerm::ProjectRHS(WGPUCommandEncoder encoder) {
-    WGPUComputePassDescriptor pd = WGPU_COMPUTE_PASS_DESCRIPTOR_INIT;
-    WGPUComputePassEncoder pass = wgpuCommandEncoderBeginComputePass(encoder, &pd);
-    ComputeEncoder enc(pass);
-    enc.SetPipeline(project_rhs_pipeline_.GetHandle());
-    enc.SetBindGroup(0, bg_project_rhs_.GetHandle());
-    enc.Dispatch(wg_count_);
-    wgpuComputePassEncoderEnd(pass);
-    wgpuComputePassEncoderRelease(pass);
+bool PDSpringTerm::InitializeHost(const SparsityBuilder& sparsity, uint32 node_count) {
+    nnz_ = sparsity.GetNNZ();
+    ElementColoring coloring = PrepareEdges(sparsity, node_count);
+    host_colors_ = coloring.GetRanges();
+    LogInfo("PDSpringTerm: host initialized (", edges_.size(), " edges, nnz=", nnz_, ", ",
+            coloring.GetColorCount(), " colors)");
+    return true;
+}
+
+// Host port of pd_spring_lhs.wgsl: w * I on both diagonals, -w * I on both CSR blocks
+void PDSpringTerm::AssembleLHSHost(const PDHostAssemblyContext& ctx) {
+    const float32 w = stiffness_;
+    for (const auto& color : host_colors_) {
+        ThreadPool::GetInstance().ParallelFor(color.count, kHostElementGrain,
+            [&](uint32 begin, uint32 end) {
+            for (uint32 e = color.offset + begin; e < color.offset + end; ++e) {
+                float32* diag_a = ctx.diag + uint64(edges_[e].n0) * 9;
+                float32* diag_b = ctx.diag + uint64(edges_[e].n1) * 9;
+                float32* csr_ab = ctx.csr_values + uint64(edge_csr_mappings_[e].block_ab) * 9;
+                float32* csr_ba = ctx.csr_values + uint64(edge_csr_mappings_[e].block_ba) * 9;
+                for (uint32 i = 0; i < 9; i += 4) {
+                    diag_a[i] += w;
+                    diag_b[i] += w;
+                    csr_ab[i] -= w;
+                    csr_ba[i] -= w;
+                }
+            }
+        });
+    }
+}
+
+// Host port of pd_spring_project_rhs.wgsl: p = rest_length * normalize(q[a] - q[b])
+void PDSpringTerm::ProjectRHSHost(const PDHostAssemblyContext& ctx) {
+    const float32 w = stiffness_;
+    for (const auto& color : host_colors_) {
+        ThreadPool::GetInstance().ParallelFor(color.count, kHostElementGrain,
+            [&](uint32 begin, uint32 end) {
+            for (uint32 e = color.offset + begin; e < color.offset + end; ++e) {
+                uint32 a = edges_[e].n0;
+                uint32 b = edges_[e].n1;
+                float32 dx[3];
+                for (uint32 c = 0; c < 3; ++c) {
+                    dx[c] = ctx.q[c][a] - ctx.q[c][b];
+                }
+                float32 dist = std::sqrt(dx[0] * dx[0] + dx[1] * dx[1] + dx[2] * dx[2]);
+                if (dist <= 1e-8f) continue;
+
+                float32 scale = w * edges_[e].rest_length / dist;
+                for (uint32 c = 0; c < 3; ++c) {
+                    ctx.rhs[c][a] += scale * dx[c];
+                    ctx.rhs[c][b] -= scale * dx[c];
+                }
+            }
+        });
+    }
 }
 
 void PDSpringTerm::Shutdown() {
     bg_lhs_ = {};
     bg_project_rhs_ = {};
+    color_wg_counts_.clear();
     lhs_pipeline_ = {};
     project_rhs_pipeline_ = {};
     edge_buffer_.reset();
     edge_csr_buffer_.reset();
-    spring_params_buffer_.reset();
+    spring_params_buffer_ = {};
+    color_range_buffer_ = {};
+    host_colors_.clear();
     LogInfo("PDSpringTerm: shutdown");
 }
 
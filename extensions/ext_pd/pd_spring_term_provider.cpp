@@ -49,20 +49,9 @@ std::unique_ptr<IProjectiveTerm> PDSpringTermProvider::CreateTerm(
         all_edges.assign(data, data + count);
     } else {
         // Global: merge ALL entities' edges with position offsets
-        auto entities = storage->GetEntities();
-        std::sort(entities.begin(), entities.end());
-
-        auto* pos_storage = db.GetArrayStorageById(GetComponentTypeId<SimPosition>());
-        std::unordered_map<Entity, uint32> pos_offset_map;
-        if (pos_storage) {
-            auto pos_entities = pos_storage->GetEntities();
-            std::sort(pos_entities.begin(), pos_entities.end());
-            uint32 offset = 0;
-            for (Entity e : pos_entities) {
-                pos_offset_map[e] = offset;
-                offset += pos_storage->GetArrayCount(e);
-            }
-        }
+        const auto& entities = storage->GetEntities();
+
+        auto pos_offset_map = NodeRegionOffsets(db.GetArrayStorageById(GetComponentTypeId<SimPosition>()));
 
         for (Entity mesh_e : entities) {
             uint32 count = storage->GetArrayCount(mesh_e);
@@ -106,7 +95,7 @@ void PDSpringTermProvider::QueryTopology(const Database& db, Entity entity,
     if (storage->GetArrayCount(entity) > 0) {
         out_edge_count = storage->GetArrayCount(entity);
     } else {
-        auto entities = storage->GetEntities();
+        const auto& entities = storage->GetEntities();
         uint32 total = 0;
         for (Entity e : entities) {
             total += storage->GetArrayCount(e);
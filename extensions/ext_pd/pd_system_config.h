@@ -19,7 +19,8 @@ struct PDSystemConfig {
     uint32 constraint_entities[MAX_CONSTRAINTS] = {};
 
     uint32 mesh_entity        = database::kInvalidEntity;  // kInvalidEntity = global mode, valid entity = scoped
-    uint32 padding[4]         = {};
+    uint32 backend            = 0;      // SolverBackend: 0 = GPU, 1 = CPU reference backend
+    uint32 padding[3]         = {};
     // Total: 64 bytes
 };
 
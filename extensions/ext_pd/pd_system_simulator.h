@@ -8,10 +8,13 @@
 struct WGPUBufferImpl;  typedef WGPUBufferImpl* WGPUBuffer;
 
 namespace mps { namespace system { class System; } }
+namespace ext_dynamics { struct HostNodeState; }
 
 namespace ext_pd {
 
 class PDDynamics;
+class HostPDDynamics;
+struct PDSystemConfig;
 
 // Projective Dynamics simulator with Chebyshev-accelerated Jacobi.
 // Discovers PD constraint terms from entity references in PDSystemConfig,
@@ -26,13 +29,25 @@ public:
     void Update() override;
     void Shutdown() override;
     void OnDatabaseChanged() override;
+    void OnReset() override;
+    [[nodiscard]] bool RequiresGPU() const override;
 
 private:
+    // CPU backend (PDSystemConfig::backend == SolverBackend::CPU)
+    void InitializeHost(const PDSystemConfig& config);
+    void UpdateHost();
+
     mps::system::System& system_;
 
     // PD solver
     std::unique_ptr<PDDynamics> dynamics_;
 
+    // CPU backend: host solver and node state (published per frame), plus the gathered
+    // initial state for OnReset (a host-only System overwrites the Database copy)
+    std::unique_ptr<HostPDDynamics> host_dynamics_;
+    std::unique_ptr<ext_dynamics::HostNodeState> host_state_;
+    std::unique_ptr<ext_dynamics::HostNodeState> host_initial_;
+
     // Velocity/position update pipelines
     mps::gpu::GPUComputePipeline update_velocity_pipeline_;
     mps::gpu::GPUComputePipeline update_position_pipeline_;
@@ -48,12 +63,8 @@ private:
     bool rho_calibrated_ = false;
     mps::uint32 debug_frame_ = 0;
 
-    // Scoped mode (mesh_entity != 0): local buffer copy
-    WGPUBuffer local_pos_ = nullptr;
-    WGPUBuffer local_vel_ = nullptr;
-    WGPUBuffer local_mass_ = nullptr;
-    WGPUBuffer global_pos_ = nullptr;
-    WGPUBuffer global_vel_ = nullptr;
+    // Scoped mode (mesh_entity != 0): the solver binds this node region of the
+    // global DeviceDB buffers
     mps::uint32 mesh_entity_ = 0;
     mps::uint32 node_offset_ = 0;
     bool scoped_ = false;
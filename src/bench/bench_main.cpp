@@ -0,0 +1,364 @@
+#include "bench/bench_scene.h"
+#include "bench/bench_report.h"
+#include "core_system/system.h"
+#include "core_simulate/simulate_config.h"
+#include "core_simulate/cg_solver.h"
+#include "core_gpu/gpu_core.h"
+#include "core_gpu/gpu_profiler.h"
+#include "core_gpu/workgroup_tuner.h"
+#include "core_util/thread_pool.h"
+#include "core_util/logger.h"
+#include "core_util/memory_tracker.h"
+#include "ext_newton/newton_extension.h"
+#include "ext_newton/spring_term.h"
+#include "ext_pd/pd_extension.h"
+#include "ext_pd/pd_dynamics.h"
+#include "ext_mesh/mesh_extension.h"
+#include "ext_dynamics/dynamics_extension.h"
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace mps;
+using namespace mps::bench;
+using namespace mps::system;
+using namespace mps::database;
+using namespace mps::simulate;
+using namespace mps::util;
+
+// Scene-scaling benchmark: runs every (solver x mode x backend x scene) case in a
+// fresh headless System and reports per-phase timings as JSON.
+//
+//   mps_bench [--frames N] [--warmup N] [--sizes 32,64,...] [--obj file.obj]...
+//             [--solver newton|pd|all] [--mode scoped|global|all] [--backend gpu|cpu|all]
+//             [--newton-iters N] [--cg-iters N] [--pd-iters N]
+//             [--out results.json|-] [--compare baseline.json] [--threshold 0.10]
+//             [--tune-workgroups [sizes.txt]]
+//
+// With --compare the exit code is the number of cases that regressed (capped at 255).
+// --tune-workgroups instead measures each workgroup size candidate for the tunable
+// solver kernels on the largest grid, and writes the fastest per kernel for this
+// adapter to the file System loads at startup (default mps_workgroup_sizes.txt).
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct BenchOptions {
+    uint32 frames = 120;
+    uint32 warmup = 10;
+    std::vector<uint32> sizes = {32, 64, 128, 256, 512, 1024};
+    std::vector<std::string> objs;
+    std::vector<BenchSolver> solvers = {BenchSolver::Newton, BenchSolver::PD};
+    std::vector<bool> scoped = {true, false};
+    std::vector<SolverBackend> backends = {SolverBackend::GPU};
+    uint32 newton_iterations = 15;
+    uint32 cg_max_iterations = 30;
+    uint32 pd_iterations = 450;
+    std::string out = "mps_bench.json";
+    std::string compare;
+    float64 threshold = 0.10;
+    std::string tune_workgroups;   // sizes file to write; empty = run the benchmark
+};
+
+float64 ElapsedMs(Clock::time_point start) {
+    return std::chrono::duration<float64, std::milli>(Clock::now() - start).count();
+}
+
+// The whole of text must be a number
+template<typename T>
+bool ParseNumber(std::string_view text, T& out) {
+    const char* end = text.data() + text.size();
+    auto [ptr, ec] = std::from_chars(text.data(), end, out);
+    return ec == std::errc() && ptr == end && !text.empty();
+}
+
+bool ParseSizes(const std::string& list, std::vector<uint32>& sizes) {
+    sizes.clear();
+    std::stringstream stream(list);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        if (item.empty()) continue;
+        uint32 size = 0;
+        if (!ParseNumber(item, size)) return false;
+        sizes.push_back(size);
+    }
+    return true;
+}
+
+bool ParseOptions(int argc, char** argv, BenchOptions& options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string_view arg = argv[i];
+        auto value = [&]() -> std::string {
+            return i + 1 < argc ? argv[++i] : "";
+        };
+        auto invalid = [&](const std::string& v) {
+            LogError("mps_bench: invalid value for ", arg, ": '", v, "'");
+            return false;
+        };
+        auto number = [&](auto& out) {
+            std::string v = value();
+            return ParseNumber(v, out) || invalid(v);
+        };
+
+        if (arg == "--frames") {
+            if (!number(options.frames)) return false;
+        } else if (arg == "--warmup") {
+            if (!number(options.warmup)) return false;
+        } else if (arg == "--sizes") {
+            std::string v = value();
+            if (!ParseSizes(v, options.sizes)) return invalid(v);
+        } else if (arg == "--obj") {
+            options.objs.push_back(value());
+        } else if (arg == "--solver") {
+            std::string v = value();
+            if (v == "newton") options.solvers = {BenchSolver::Newton};
+            else if (v == "pd") options.solvers = {BenchSolver::PD};
+            else if (v != "all") return invalid(v);
+        } else if (arg == "--mode") {
+            std::string v = value();
+            if (v == "scoped") options.scoped = {true};
+            else if (v == "global") options.scoped = {false};
+            else if (v != "all") return invalid(v);
+        } else if (arg == "--backend") {
+            std::string v = value();
+            if (v == "gpu") options.backends = {SolverBackend::GPU};
+            else if (v == "cpu") options.backends = {SolverBackend::CPU};
+            else if (v == "all") options.backends = {SolverBackend::GPU, SolverBackend::CPU};
+            else return invalid(v);
+        } else if (arg == "--newton-iters") {
+            if (!number(options.newton_iterations)) return false;
+        } else if (arg == "--cg-iters") {
+            if (!number(options.cg_max_iterations)) return false;
+        } else if (arg == "--pd-iters") {
+            if (!number(options.pd_iterations)) return false;
+        } else if (arg == "--out") {
+            options.out = value();
+        } else if (arg == "--compare") {
+            options.compare = value();
+        } else if (arg == "--threshold") {
+            if (!number(options.threshold)) return false;
+        } else if (arg == "--tune-workgroups") {
+            bool has_path = i + 1 < argc && std::string_view(argv[i + 1]).substr(0, 2) != "--";
+            options.tune_workgroups = has_path ? value() : gpu::WorkgroupTuner::kDefaultPath;
+        } else {
+            LogError("mps_bench: unknown option '", arg, "'");
+            return false;
+        }
+    }
+    if (options.frames == 0) {
+        LogError("mps_bench: --frames must be greater than 0");
+        return false;
+    }
+    return true;
+}
+
+std::vector<BenchCase> ExpandCases(const BenchOptions& options) {
+    std::vector<BenchCase> cases;
+    auto add = [&](uint32 grid_size, const std::string& obj) {
+        for (BenchSolver solver : options.solvers) {
+            for (bool scoped : options.scoped) {
+                for (SolverBackend backend : options.backends) {
+                    BenchCase c;
+                    c.solver = solver;
+                    c.scoped = scoped;
+                    c.backend = backend;
+                    c.grid_size = grid_size;
+                    c.obj = obj;
+                    c.newton_iterations = options.newton_iterations;
+                    c.cg_max_iterations = options.cg_max_iterations;
+                    c.pd_iterations = options.pd_iterations;
+                    cases.push_back(std::move(c));
+                }
+            }
+        }
+    };
+    for (uint32 size : options.sizes) add(size, "");
+    for (const auto& obj : options.objs) add(0, obj);
+    return cases;
+}
+
+// pass_timings: when set, time every dispatch separately and return the per-label averages
+BenchResult RunCase(const BenchCase& bench_case, const BenchOptions& options, BenchEnvironment& env,
+                    std::vector<gpu::PassTiming>* pass_timings = nullptr) {
+    BenchResult result;
+    result.name = GetCaseName(bench_case);
+    result.frames = options.frames;
+    LogInfo("mps_bench: ---- ", result.name, " ----");
+
+    SystemConfig config;
+    config.headless = true;
+    System system;
+    if (!system.Initialize(config)) {
+        result.ok = false;
+        return result;
+    }
+    if (system.IsHostOnly() && bench_case.backend == SolverBackend::GPU) {
+        LogError("mps_bench: no GPU device for ", result.name, " (use --backend cpu)");
+        result.ok = false;
+        return result;
+    }
+
+    auto& gpu = gpu::GPUCore::GetInstance();
+    env.adapter = gpu.GetAdapterName();
+    env.backend = gpu.GetBackendType();
+    env.timestamp_queries = gpu::GPUProfiler::GetInstance().IsEnabled();
+    gpu::GPUProfiler::GetInstance().SetPerDispatchTiming(pass_timings != nullptr);
+    MemoryTracker::GetInstance().ResetHighWater();
+
+    system.AddExtension(std::make_unique<ext_dynamics::DynamicsExtension>(system));
+    system.AddExtension(std::make_unique<ext_mesh::MeshExtension>(system));
+    system.AddExtension(std::make_unique<ext_newton::NewtonExtension>(system));
+    system.AddExtension(std::make_unique<ext_pd::PDExtension>(system));
+
+    // Host setup: scene construction and the initial DeviceDB upload
+    auto start = Clock::now();
+    SceneInfo info;
+    system.Transact([&](Database& db) { info = BuildScene(db, bench_case); });
+    WaitForGPU();
+    result.host_setup_ms = ElapsedMs(start);
+    result.node_count = info.node_count;
+    result.edge_count = info.edge_count;
+    result.face_count = info.face_count;
+    if (info.node_count == 0) {
+        LogError("mps_bench: empty scene for ", result.name);
+        result.ok = false;
+        return result;
+    }
+
+    // Initialize: simulators build solvers, pipelines and bind groups on the first Step
+    start = Clock::now();
+    system.Step(0);
+    WaitForGPU();
+    result.initialize_ms = ElapsedMs(start);
+
+    system.Step(options.warmup);
+    WaitForGPU();
+
+    // Measured frames: encode = CPU time inside Step, frame = wall time to GPU idle
+    float64 encode_ms = 0.0;
+    start = Clock::now();
+    for (uint32 i = 0; i < options.frames; ++i) {
+        auto frame_start = Clock::now();
+        system.Step(1);
+        encode_ms += ElapsedMs(frame_start);
+    }
+    WaitForGPU();
+    float64 total_ms = ElapsedMs(start);
+
+    // Let the profiler's in-flight timestamp readbacks land
+    for (uint32 i = 0; i < 4; ++i) gpu.ProcessEvents();
+
+    result.encode_ms = encode_ms / options.frames;
+    result.frame_ms = total_ms / options.frames;
+    result.steps_per_sec = total_ms > 0.0 ? 1000.0 * options.frames / total_ms : 0.0;
+    auto& profiler = gpu::GPUProfiler::GetInstance();
+    result.gpu_ms = profiler.IsEnabled() ? profiler.GetFrameTimeMs() : -1.0;
+    result.peak_rss_bytes = GetPeakResidentBytes();
+    result.gpu_peak_bytes = MemoryTracker::GetInstance().GetTotals(MemoryDomain::GPU).high_water_bytes;
+    if (pass_timings) {
+        *pass_timings = profiler.GetPassTimings();
+        profiler.SetPerDispatchTiming(false);
+    }
+
+    LogInfo("mps_bench: ", result.name, ": ", result.node_count, " nodes, setup ",
+            result.host_setup_ms, " ms, init ", result.initialize_ms, " ms, encode ",
+            result.encode_ms, " ms, gpu ", result.gpu_ms, " ms, frame ", result.frame_ms,
+            " ms (", result.steps_per_sec, " steps/s), GPU peak ",
+            result.gpu_peak_bytes >> 20, " MiB");
+    return result;
+}
+
+// Tune each kernel's workgroup size on the largest grid, one fresh System per candidate.
+// A candidate is scored by the GPU time of the kernel's passes, or by the wall-clock
+// frame time when timestamp queries are unavailable.
+bool TuneWorkgroups(const BenchOptions& options, BenchEnvironment& env) {
+    struct TunedKernel {
+        const char* kernel;
+        BenchSolver solver;
+        const char* label;   // profiler label prefix of the kernel's pipelines
+    };
+    // SpMV first: the dot-product and spring tuning then run against the tuned SpMV
+    const TunedKernel kernels[] = {
+        {CGSolver::kSpMVKernel, BenchSolver::Newton, "cg_spmv"},
+        {CGSolver::kDotKernel, BenchSolver::Newton, "cg_dot"},
+        {ext_newton::SpringTerm::kAccumulateKernel, BenchSolver::Newton, "accumulate_springs"},
+        {ext_pd::PDDynamics::kJacobiKernel, BenchSolver::PD, "pd_jacobi_step"},
+    };
+
+    auto& tuner = gpu::WorkgroupTuner::GetInstance();
+    tuner.SetPath(options.tune_workgroups);
+    uint32 grid_size = options.sizes.empty() ? 128
+        : *std::max_element(options.sizes.begin(), options.sizes.end());
+
+    for (const auto& tuned : kernels) {
+        if (std::find(options.solvers.begin(), options.solvers.end(), tuned.solver) == options.solvers.end()) {
+            continue;
+        }
+        BenchCase bench_case;
+        bench_case.solver = tuned.solver;
+        bench_case.scoped = options.scoped.front();
+        bench_case.grid_size = grid_size;
+        bench_case.newton_iterations = options.newton_iterations;
+        bench_case.cg_max_iterations = options.cg_max_iterations;
+        bench_case.pd_iterations = options.pd_iterations;
+
+        std::string_view prefix = tuned.label;
+        auto benchmark = [&](uint32) -> float64 {
+            std::vector<gpu::PassTiming> timings;
+            BenchResult result = RunCase(bench_case, options, env, &timings);
+            if (!result.ok) return -1.0;
+            float64 kernel_ms = 0.0;
+            bool found = false;
+            for (const auto& timing : timings) {
+                if (std::string_view(timing.label).substr(0, prefix.size()) != prefix) continue;
+                kernel_ms += timing.avg_ms;
+                found = true;
+            }
+            return found ? kernel_ms : result.frame_ms;
+        };
+        tuner.Tune(tuned.kernel, tuner.GetCandidates(), benchmark);
+    }
+    return tuner.Save();
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    BenchOptions options;
+    if (!ParseOptions(argc, argv, options)) {
+        LogError("usage: mps_bench [--frames N] [--warmup N] [--sizes 32,64,...] [--obj file.obj] "
+                 "[--solver newton|pd|all] [--mode scoped|global|all] [--backend gpu|cpu|all] "
+                 "[--newton-iters N] [--cg-iters N] [--pd-iters N] [--out file|-] "
+                 "[--compare baseline.json] [--threshold 0.10] [--tune-workgroups [file]]");
+        return 1;
+    }
+
+    BenchEnvironment env;
+    env.host_threads = ThreadPool::GetInstance().GetThreadCount();
+
+    if (!options.tune_workgroups.empty()) {
+        return TuneWorkgroups(options, env) ? 0 : 1;
+    }
+
+    std::vector<BenchResult> results;
+    for (const auto& bench_case : ExpandCases(options)) {
+        results.push_back(RunCase(bench_case, options, env));
+    }
+
+    if (!WriteResultsJson(options.out, env, results)) return 1;
+
+    if (!options.compare.empty()) {
+        std::vector<BenchResult> baseline;
+        if (!LoadResultsJson(options.compare, baseline)) return 1;
+        uint32 regressions = CompareResults(results, baseline, options.threshold);
+        LogInfo("mps_bench: ", regressions, " regression(s)");
+        return static_cast<int>(std::min<uint32>(regressions, 255));
+    }
+    return 0;
+}
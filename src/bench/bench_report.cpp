@@ -0,0 +1,265 @@
+#include "bench/bench_report.h"
+#include "core_util/logger.h"
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+using namespace mps::util;
+
+namespace mps {
+namespace bench {
+
+uint64 GetPeakResidentBytes() {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters{};
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return uint64(counters.PeakWorkingSetSize);
+    }
+    return 0;
+#else
+    rusage usage{};
+    if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+#ifdef __APPLE__
+    return uint64(usage.ru_maxrss);            // bytes
+#else
+    return uint64(usage.ru_maxrss) * 1024;     // kilobytes
+#endif
+#endif
+}
+
+// ============================================================================
+// Writing
+// ============================================================================
+
+static std::string Escape(const std::string& s) {
+    std::string out;
+    for (char c : s) {
+        if (c == '"' || c == '\\') out += '\\';
+        out += c;
+    }
+    return out;
+}
+
+bool WriteResultsJson(const std::string& path, const BenchEnvironment& env,
+                      const std::vector<BenchResult>& results) {
+    std::ostringstream json;
+    json.precision(6);
+    json << std::fixed;
+    json << "{\n  \"environment\": {\n"
+         << "    \"adapter\": \"" << Escape(env.adapter) << "\",\n"
+         << "    \"backend\": \"" << Escape(env.backend) << "\",\n"
+         << "    \"host_threads\": " << env.host_threads << ",\n"
+         << "    \"timestamp_queries\": " << (env.timestamp_queries ? "true" : "false") << "\n"
+         << "  },\n  \"results\": [";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const BenchResult& r = results[i];
+        json << (i ? ",\n" : "\n")
+             << "    {\"name\": \"" << Escape(r.name) << "\", \"ok\": " << (r.ok ? "true" : "false")
+             << ", \"nodes\": " << r.node_count << ", \"edges\": " << r.edge_count
+             << ", \"faces\": " << r.face_count << ", \"frames\": " << r.frames
+             << ", \"host_setup_ms\": " << r.host_setup_ms
+             << ", \"initialize_ms\": " << r.initialize_ms
+             << ", \"encode_ms\": " << r.encode_ms
+             << ", \"gpu_ms\": " << r.gpu_ms
+             << ", \"frame_ms\": " << r.frame_ms
+             << ", \"steps_per_sec\": " << r.steps_per_sec
+             << ", \"peak_rss_bytes\": " << r.peak_rss_bytes
+             << ", \"gpu_peak_bytes\": " << r.gpu_peak_bytes << "}";
+    }
+    json << "\n  ]\n}\n";
+
+    if (path == "-") {
+        std::cout << json.str();
+        return true;
+    }
+    std::ofstream file(path, std::ios::binary);
+    if (!file) {
+        LogError("mps_bench: cannot write ", path);
+        return false;
+    }
+    file << json.str();
+    return true;
+}
+
+// ============================================================================
+// Reading (only the flat structure WriteResultsJson produces)
+// ============================================================================
+
+namespace {
+
+class JsonReader {
+public:
+    explicit JsonReader(const std::string& text) : text_(text) {}
+
+    // Parse the "results" array into flat key -> value maps (strings unquoted)
+    bool ReadResults(std::vector<std::map<std::string, std::string>>& out) {
+        size_t key = text_.find("\"results\"");
+        if (key == std::string::npos) return false;
+        pos_ = text_.find('[', key);
+        if (pos_ == std::string::npos) return false;
+        ++pos_;
+
+        while (true) {
+            SkipSpace();
+            if (Peek() == ']') return true;
+            if (Peek() == ',') { ++pos_; continue; }
+            if (Peek() != '{') return false;
+            ++pos_;
+
+            std::map<std::string, std::string> object;
+            while (true) {
+                SkipSpace();
+                if (Peek() == '}') { ++pos_; break; }
+                if (Peek() == ',') { ++pos_; continue; }
+                std::string name, value;
+                if (!ReadString(name)) return false;
+                SkipSpace();
+                if (Peek() != ':') return false;
+                ++pos_;
+                SkipSpace();
+                if (!ReadValue(value)) return false;
+                object[name] = value;
+            }
+            out.push_back(std::move(object));
+        }
+    }
+
+private:
+    char Peek() const { return pos_ < text_.size() ? text_[pos_] : '\0'; }
+
+    void SkipSpace() {
+        while (pos_ < text_.size() && std::isspace(static_cast<unsigned char>(text_[pos_]))) ++pos_;
+    }
+
+    bool ReadString(std::string& out) {
+        if (Peek() != '"') return false;
+        ++pos_;
+        while (pos_ < text_.size() && text_[pos_] != '"') {
+            if (text_[pos_] == '\\' && pos_ + 1 < text_.size()) ++pos_;
+            out += text_[pos_++];
+        }
+        if (pos_ >= text_.size()) return false;
+        ++pos_;
+        return true;
+    }
+
+    bool ReadValue(std::string& out) {
+        if (Peek() == '"') return ReadString(out);
+        while (pos_ < text_.size() && text_[pos_] != ',' && text_[pos_] != '}' &&
+               !std::isspace(static_cast<unsigned char>(text_[pos_]))) {
+            out += text_[pos_++];
+        }
+        return !out.empty();
+    }
+
+    const std::string& text_;
+    size_t pos_ = 0;
+};
+
+}  // namespace
+
+bool LoadResultsJson(const std::string& path, std::vector<BenchResult>& results) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        LogError("mps_bench: cannot read baseline ", path);
+        return false;
+    }
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    std::string text = buffer.str();
+
+    std::vector<std::map<std::string, std::string>> objects;
+    if (!JsonReader(text).ReadResults(objects)) {
+        LogError("mps_bench: malformed baseline ", path);
+        return false;
+    }
+
+    for (const auto& object : objects) {
+        auto number = [&](const char* key) {
+            auto it = object.find(key);
+            return it != object.end() ? std::strtod(it->second.c_str(), nullptr) : 0.0;
+        };
+        BenchResult r;
+        auto name = object.find("name");
+        if (name == object.end()) continue;
+        r.name = name->second;
+        auto ok = object.find("ok");
+        r.ok = ok == object.end() || ok->second == "true";
+        r.node_count = uint32(number("nodes"));
+        r.edge_count = uint32(number("edges"));
+        r.face_count = uint32(number("faces"));
+        r.frames = uint32(number("frames"));
+        r.host_setup_ms = number("host_setup_ms");
+        r.initialize_ms = number("initialize_ms");
+        r.encode_ms = number("encode_ms");
+        r.gpu_ms = object.count("gpu_ms") ? number("gpu_ms") : -1.0;
+        r.frame_ms = number("frame_ms");
+        r.steps_per_sec = number("steps_per_sec");
+        r.peak_rss_bytes = uint64(number("peak_rss_bytes"));
+        r.gpu_peak_bytes = uint64(number("gpu_peak_bytes"));
+        results.push_back(std::move(r));
+    }
+    return true;
+}
+
+// ============================================================================
+// Comparison
+// ============================================================================
+
+uint32 CompareResults(const std::vector<BenchResult>& current,
+                      const std::vector<BenchResult>& baseline, float64 threshold) {
+    std::map<std::string, const BenchResult*> by_name;
+    for (const auto& r : baseline) by_name[r.name] = &r;
+
+    auto delta = [](float64 now, float64 base) {
+        return base > 0.0 ? (now - base) / base : 0.0;
+    };
+
+    uint32 regressions = 0;
+    LogInfo("mps_bench: comparing against baseline (threshold ", threshold * 100.0, "%)");
+    for (const auto& r : current) {
+        auto it = by_name.find(r.name);
+        if (it == by_name.end()) {
+            LogInfo("  ", r.name, ": no baseline");
+            continue;
+        }
+        const BenchResult& base = *it->second;
+
+        float64 frame_delta = delta(r.frame_ms, base.frame_ms);
+        bool has_gpu = r.gpu_ms >= 0.0 && base.gpu_ms > 0.0;
+        float64 gpu_delta = has_gpu ? delta(r.gpu_ms, base.gpu_ms) : 0.0;
+        bool regressed = !r.ok || frame_delta > threshold || gpu_delta > threshold;
+        if (regressed) ++regressions;
+
+        char line[256];
+        std::snprintf(line, sizeof(line),
+                      "  %-40s frame %8.3f ms (%+6.1f%%)  gpu %8.3f ms (%+6.1f%%)  init %8.1f ms (%+6.1f%%)%s",
+                      r.name.c_str(), r.frame_ms, frame_delta * 100.0,
+                      r.gpu_ms, gpu_delta * 100.0,
+                      r.initialize_ms, delta(r.initialize_ms, base.initialize_ms) * 100.0,
+                      regressed ? "  REGRESSION" : "");
+        if (regressed) {
+            LogError(line);
+        } else {
+            LogInfo(line);
+        }
+    }
+    return regressions;
+}
+
+}  // namespace bench
+}  // namespace mps
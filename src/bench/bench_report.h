@@ -0,0 +1,53 @@
+#pragma once
+
+#include "core_util/types.h"
+#include <string>
+#include <vector>
+
+namespace mps {
+namespace bench {
+
+// Measurements of one benchmark case. Times are milliseconds; per-frame values
+// are averages over the measured (post-warmup) frames.
+struct BenchResult {
+    std::string name;                 // GetCaseName()
+    uint32 node_count = 0;
+    uint32 edge_count = 0;
+    uint32 face_count = 0;
+    uint32 frames = 0;
+
+    float64 host_setup_ms = 0.0;      // scene construction + initial DeviceDB sync (Transact)
+    float64 initialize_ms = 0.0;      // simulator Initialize until the GPU is idle
+    float64 encode_ms = 0.0;          // CPU time in System::Step per frame (the solve itself on the CPU backend)
+    float64 gpu_ms = -1.0;            // GPU time per frame from timestamp queries (-1 = unsupported)
+    float64 frame_ms = 0.0;           // wall time per frame, GPU completion included
+    float64 steps_per_sec = 0.0;
+    uint64 peak_rss_bytes = 0;        // process peak resident set after the case
+    uint64 gpu_peak_bytes = 0;        // tracked GPU memory high-water during the case
+    bool ok = true;
+};
+
+struct BenchEnvironment {
+    std::string adapter;
+    std::string backend;
+    uint32 host_threads = 0;
+    bool timestamp_queries = false;
+};
+
+// Peak resident set size of this process in bytes (0 if unavailable)
+uint64 GetPeakResidentBytes();
+
+// Write results as JSON ({"environment": {...}, "results": [...]}). path "-" = stdout.
+bool WriteResultsJson(const std::string& path, const BenchEnvironment& env,
+                      const std::vector<BenchResult>& results);
+
+// Load the "results" array of a file written by WriteResultsJson
+bool LoadResultsJson(const std::string& path, std::vector<BenchResult>& results);
+
+// Log current vs baseline per case (matched by name) and return the number of
+// regressions: frame_ms or gpu_ms more than threshold (fraction) above baseline.
+uint32 CompareResults(const std::vector<BenchResult>& current,
+                      const std::vector<BenchResult>& baseline, float64 threshold);
+
+}  // namespace bench
+}  // namespace mps
@@ -0,0 +1,76 @@
+#include "bench/bench_scene.h"
+#include "ext_newton/newton_system_config.h"
+#include "ext_pd/pd_system_config.h"
+#include "ext_mesh/mesh_generator.h"
+#include "ext_dynamics/constraint_builder.h"
+#include "ext_dynamics/global_physics_params.h"
+#include "core_database/database.h"
+
+using namespace mps::database;
+using namespace mps::simulate;
+
+namespace mps {
+namespace bench {
+
+// Every grid spans the same 0.64 m square, so larger grids only refine it
+static constexpr float32 kGridExtent = 0.64f;
+static constexpr float32 kSpringStiffness = 50000.0f;
+
+std::string GetCaseName(const BenchCase& bench_case) {
+    std::string name = bench_case.solver == BenchSolver::Newton ? "newton" : "pd";
+    name += bench_case.scoped ? "/scoped" : "/global";
+    name += bench_case.backend == SolverBackend::CPU ? "/cpu" : "/gpu";
+    if (bench_case.grid_size > 0) {
+        name += "/grid" + std::to_string(bench_case.grid_size);
+    } else {
+        name += "/obj:" + bench_case.obj;
+    }
+    return name;
+}
+
+SceneInfo BuildScene(Database& db, const BenchCase& bench_case) {
+    db.SetSingleton<GlobalPhysicsParams>({1.0f / 120.0f, {0.0f, -9.81f, 0.0f}, 0.999f});
+
+    ext_mesh::MeshResult mesh;
+    if (bench_case.grid_size > 0) {
+        uint32 n = bench_case.grid_size;
+        mesh = ext_mesh::CreateGrid(db, n, n, kGridExtent / float32(n), {0.0f, 0.0f, 0.0f});
+    } else {
+        mesh = ext_mesh::ImportOBJ(db, bench_case.obj, 0.01f, {0.0f, 0.0f, 0.0f});
+    }
+
+    SceneInfo info;
+    info.node_count = mesh.node_count;
+    info.face_count = mesh.face_count;
+    if (mesh.mesh_entity == kInvalidEntity) return info;
+
+    info.edge_count = ext_dynamics::BuildSpringConstraints(db, mesh.mesh_entity, kSpringStiffness);
+    ext_mesh::PinVertices(db, mesh.mesh_entity, {0});
+
+    Entity config_entity = db.CreateEntity();
+    Entity scope = bench_case.scoped ? mesh.mesh_entity : kInvalidEntity;
+    uint32 backend = static_cast<uint32>(bench_case.backend);
+
+    if (bench_case.solver == BenchSolver::Newton) {
+        ext_newton::NewtonSystemConfig cfg{};
+        cfg.newton_iterations = bench_case.newton_iterations;
+        cfg.cg_max_iterations = bench_case.cg_max_iterations;
+        cfg.mesh_entity = scope;
+        cfg.constraint_count = 1;
+        cfg.constraint_entities[0] = mesh.mesh_entity;
+        cfg.backend = backend;
+        db.AddComponent<ext_newton::NewtonSystemConfig>(config_entity, cfg);
+    } else {
+        ext_pd::PDSystemConfig cfg{};
+        cfg.iterations = bench_case.pd_iterations;
+        cfg.mesh_entity = scope;
+        cfg.constraint_count = 1;
+        cfg.constraint_entities[0] = mesh.mesh_entity;
+        cfg.backend = backend;
+        db.AddComponent<ext_pd::PDSystemConfig>(config_entity, cfg);
+    }
+    return info;
+}
+
+}  // namespace bench
+}  // namespace mps
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "core_simulate/solver_params.h"
+#include "core_util/types.h"
+#include <string>
+#include <vector>
+
+namespace mps { namespace database { class Database; } }
+
+namespace mps {
+namespace bench {
+
+enum class BenchSolver : uint32 { Newton, PD };
+
+// One benchmark scene: a single cloth mesh driven by one solver config.
+struct BenchCase {
+    BenchSolver solver = BenchSolver::Newton;
+    bool scoped = true;                                  // config references the mesh entity
+    simulate::SolverBackend backend = simulate::SolverBackend::GPU;
+    uint32 grid_size = 0;                                // grid_size x grid_size nodes (0 = use obj)
+    std::string obj;                                     // OBJ under assets/objs/ when grid_size == 0
+
+    // Solver settings (defaults match the interactive scene in main.cpp)
+    uint32 newton_iterations = 15;
+    uint32 cg_max_iterations = 30;
+    uint32 pd_iterations = 450;
+};
+
+struct SceneInfo {
+    uint32 node_count = 0;
+    uint32 face_count = 0;
+    uint32 edge_count = 0;
+};
+
+// Stable identifier, e.g. "newton/scoped/gpu/grid128" or "pd/global/cpu/obj:cloth.obj"
+std::string GetCaseName(const BenchCase& bench_case);
+
+// Build the scene (physics singleton, mesh, spring constraints, pins, solver config).
+// Must be called inside a Transact block.
+SceneInfo BuildScene(database::Database& db, const BenchCase& bench_case);
+
+}  // namespace bench
+}  // namespace mps
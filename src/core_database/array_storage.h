@@ -2,7 +2,11 @@
 
 #include "core_database/component_type.h"
 #include "core_database/entity.h"
+#include <algorithm>
+#include <optional>
+#include <span>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 namespace mps {
@@ -18,63 +22,142 @@ public:
     virtual bool IsDirty() const = 0;
     virtual void ClearDirty() = 0;
 
-    // Iteration support (for DeviceArrayBuffer concatenation)
-    virtual std::vector<Entity> GetEntities() const = 0;
+    // Fine-grained dirty state (since last ClearDirty).
+    // Layout is dirty when an entity was added/removed or its array changed length;
+    // otherwise only the contents of GetDirtyEntities() changed.
+    virtual bool IsLayoutDirty() const = 0;
+    virtual std::vector<Entity> GetDirtyEntities() const = 0;
+
+    // Iteration support (for DeviceArrayBuffer concatenation). Entities are sorted by ID.
+    virtual const std::vector<Entity>& GetEntities() const = 0;
     virtual const void* GetArrayData(Entity entity) const = 0;
     virtual uint32 GetArrayCount(Entity entity) const = 0;
     virtual uint32 GetElementSize() const = 0;
+
+    // Contiguous arena holding every entity's elements (GetArenaCount() elements).
+    // After Pack(alignment, padding) the arena is laid out exactly like a DeviceArrayBuffer
+    // with that region alignment, so it can be uploaded in one copy: non-empty arrays in
+    // entity order, each starting on a multiple of `alignment`, gaps set to *padding
+    // (one element). The packed state holds until an array is added, removed or resized.
+    virtual void Pack(uint32 alignment, const void* padding) = 0;
+    virtual bool IsPacked(uint32 alignment) const = 0;
+    virtual const void* GetArenaData() const = 0;
+    virtual uint32 GetArenaCount() const = 0;
+
+    // Host bytes reserved by the storage (arena, range table and entity list; approximate
+    // for the hash tables)
+    virtual uint64 GetMemoryBytes() const = 0;
 };
 
 // Stores variable-length arrays per entity (e.g., faces, edges).
 // T must satisfy the Component concept (trivially_copyable + standard_layout).
+//
+// All arrays share one arena; each entity owns an (offset, count, capacity) range of it.
+// Rewrites that fit the capacity stay in place. An array that outgrows its range moves
+// to the end of the arena with growth slack, leaving a hole; holes are reclaimed by
+// compaction once they make up half of the arena.
+// Views returned by GetArray are invalidated by any non-const call on the storage.
 template<Component T>
 class ArrayStorage : public IArrayStorage {
 public:
     ArrayStorage() = default;
 
-    void SetArray(Entity entity, std::vector<T> data) {
-        arrays_[entity] = std::move(data);
+    // `data` must not point into this storage
+    void SetArray(Entity entity, std::span<const T> data) {
+        uint32 count = static_cast<uint32>(data.size());
+        auto it = ranges_.find(entity);
+        if (it == ranges_.end()) {
+            entities_.insert(std::upper_bound(entities_.begin(), entities_.end(), entity), entity);
+            it = ranges_.emplace(entity, Range{}).first;
+            layout_dirty_ = true;
+        } else if (it->second.count != count) {
+            layout_dirty_ = true;
+        }
+
+        Range& range = it->second;
+        if (count > range.capacity) {
+            // First allocation is exact; arrays that grow get slack for the next growth
+            uint32 capacity = range.capacity > 0 ? count + count / kGrowthSlackDivisor : count;
+            if (range.capacity > 0 && range.offset + range.capacity == GetArenaCount()) {
+                // Last range in the arena: grow in place
+                arena_.resize(range.offset + capacity);
+            } else {
+                free_count_ += range.capacity;
+                range.offset = GetArenaCount();
+                arena_.resize(range.offset + capacity);
+            }
+            range.capacity = capacity;
+            packed_alignment_ = 0;
+        } else if (count != range.count) {
+            packed_alignment_ = 0;
+        }
+        range.count = count;
+        std::copy(data.begin(), data.end(), arena_.begin() + range.offset);
+
+        dirty_entities_.insert(entity);
         dirty_ = true;
+        CompactIfFragmented();
     }
 
-    const std::vector<T>* GetArray(Entity entity) const {
-        auto it = arrays_.find(entity);
-        if (it == arrays_.end()) return nullptr;
-        return &it->second;
+    // Read-only view of the entity's array, or nullopt if it has none
+    std::optional<std::span<const T>> GetArray(Entity entity) const {
+        auto it = ranges_.find(entity);
+        if (it == ranges_.end()) return std::nullopt;
+        return std::span<const T>(arena_.data() + it->second.offset, it->second.count);
     }
 
     bool Has(Entity entity) const override {
-        return arrays_.contains(entity);
+        return ranges_.contains(entity);
     }
 
     uint32 GetCount(Entity entity) const {
-        auto it = arrays_.find(entity);
-        if (it == arrays_.end()) return 0;
-        return static_cast<uint32>(it->second.size());
+        auto it = ranges_.find(entity);
+        if (it == ranges_.end()) return 0;
+        return it->second.count;
     }
 
     void Remove(Entity entity) override {
-        if (arrays_.erase(entity) > 0) {
-            dirty_ = true;
+        auto it = ranges_.find(entity);
+        if (it == ranges_.end()) return;
+
+        const Range& range = it->second;
+        if (range.capacity > 0) {
+            if (range.offset + range.capacity == GetArenaCount()) {
+                arena_.resize(range.offset);
+            } else {
+                free_count_ += range.capacity;
+            }
+            packed_alignment_ = 0;
         }
+        ranges_.erase(it);
+        entities_.erase(std::lower_bound(entities_.begin(), entities_.end(), entity));
+        dirty_entities_.erase(entity);
+        layout_dirty_ = true;
+        dirty_ = true;
+        CompactIfFragmented();
     }
 
     bool IsDirty() const override { return dirty_; }
-    void ClearDirty() override { dirty_ = false; }
+    void ClearDirty() override {
+        dirty_ = false;
+        layout_dirty_ = false;
+        dirty_entities_.clear();
+    }
 
-    std::vector<Entity> GetEntities() const override {
-        std::vector<Entity> result;
-        result.reserve(arrays_.size());
-        for (const auto& [e, _] : arrays_) {
-            result.push_back(e);
-        }
-        return result;
+    bool IsLayoutDirty() const override { return layout_dirty_; }
+
+    std::vector<Entity> GetDirtyEntities() const override {
+        return {dirty_entities_.begin(), dirty_entities_.end()};
+    }
+
+    const std::vector<Entity>& GetEntities() const override {
+        return entities_;
     }
 
     const void* GetArrayData(Entity entity) const override {
-        auto it = arrays_.find(entity);
-        if (it == arrays_.end() || it->second.empty()) return nullptr;
-        return it->second.data();
+        auto it = ranges_.find(entity);
+        if (it == ranges_.end() || it->second.count == 0) return nullptr;
+        return arena_.data() + it->second.offset;
     }
 
     uint32 GetArrayCount(Entity entity) const override {
@@ -85,9 +168,96 @@ public:
         return static_cast<uint32>(sizeof(T));
     }
 
+    void Pack(uint32 alignment, const void* padding) override {
+        alignment = std::max(alignment, 1u);
+        if (packed_alignment_ == alignment) return;
+        const T fill = padding ? *static_cast<const T*>(padding) : T{};
+
+        uint32 total = 0;
+        uint32 used = 0;
+        for (Entity e : entities_) {
+            uint32 count = ranges_.at(e).count;
+            if (count == 0) continue;
+            total = AlignUp(total, alignment) + count;
+            used += count;
+        }
+
+        std::vector<T> packed;
+        packed.reserve(total);
+        for (Entity e : entities_) {
+            Range& range = ranges_.at(e);
+            if (range.count == 0) {
+                range = Range{};
+                continue;
+            }
+            packed.resize(AlignUp(static_cast<uint32>(packed.size()), alignment), fill);
+            uint32 offset = static_cast<uint32>(packed.size());
+            packed.insert(packed.end(), arena_.begin() + range.offset,
+                          arena_.begin() + range.offset + range.count);
+            range = Range{offset, range.count, range.count};
+        }
+        arena_ = std::move(packed);
+        free_count_ = total - used;   // alignment padding counts as holes
+        packed_alignment_ = alignment;
+    }
+
+    bool IsPacked(uint32 alignment) const override {
+        return packed_alignment_ == std::max(alignment, 1u);
+    }
+
+    const void* GetArenaData() const override { return arena_.data(); }
+    uint32 GetArenaCount() const override { return static_cast<uint32>(arena_.size()); }
+
+    uint64 GetMemoryBytes() const override {
+        constexpr uint64 kNodeOverhead = 2 * sizeof(void*);
+        return static_cast<uint64>(arena_.capacity()) * sizeof(T) +
+               static_cast<uint64>(entities_.capacity()) * sizeof(Entity) +
+               static_cast<uint64>(ranges_.size()) * (sizeof(Entity) + sizeof(Range) + kNodeOverhead) +
+               static_cast<uint64>(dirty_entities_.size()) * (sizeof(Entity) + kNodeOverhead);
+    }
+
 private:
-    std::unordered_map<Entity, std::vector<T>> arrays_;
+    struct Range {
+        uint32 offset = 0;
+        uint32 count = 0;
+        uint32 capacity = 0;
+    };
+
+    static constexpr uint32 kGrowthSlackDivisor = 2;     // regrown arrays get count/2 spare
+    static constexpr uint32 kCompactMinElements = 1024;  // ignore small holes
+
+    static uint32 AlignUp(uint32 value, uint32 alignment) {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+
+    // Close the holes left by moved and removed arrays, keeping each range's slack.
+    // A packed arena is left alone: its holes are the alignment padding it was packed with.
+    void CompactIfFragmented() {
+        if (packed_alignment_ != 0) return;
+        if (free_count_ < kCompactMinElements || free_count_ * 2 < GetArenaCount()) return;
+
+        std::vector<T> compacted;
+        compacted.reserve(GetArenaCount() - free_count_);
+        for (Entity e : entities_) {
+            Range& range = ranges_.at(e);
+            uint32 offset = static_cast<uint32>(compacted.size());
+            compacted.insert(compacted.end(), arena_.begin() + range.offset,
+                             arena_.begin() + range.offset + range.capacity);
+            range.offset = offset;
+        }
+        arena_ = std::move(compacted);
+        free_count_ = 0;
+        packed_alignment_ = 0;
+    }
+
+    std::vector<T> arena_;
+    std::unordered_map<Entity, Range> ranges_;
+    std::vector<Entity> entities_;               // sorted by ID
+    std::unordered_set<Entity> dirty_entities_;
+    uint32 free_count_ = 0;                      // arena elements in holes (incl. Pack padding)
+    uint32 packed_alignment_ = 0;                // 0 = not packed
     bool dirty_ = false;
+    bool layout_dirty_ = false;
 };
 
 }  // namespace database
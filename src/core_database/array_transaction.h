@@ -19,6 +19,9 @@ public:
 
     void Apply(Database& db) override;
     void Revert(Database& db) override;
+    uint64 GetByteSize() const override {
+        return sizeof(*this) + (old_data_.capacity() + new_data_.capacity()) * sizeof(T);
+    }
 
 private:
     Entity entity_;
@@ -35,6 +38,9 @@ public:
 
     void Apply(Database& db) override;
     void Revert(Database& db) override;
+    uint64 GetByteSize() const override {
+        return sizeof(*this) + old_data_.capacity() * sizeof(T);
+    }
 
 private:
     Entity entity_;
@@ -33,6 +33,9 @@ public:
 
     // Check if entity has a component in this storage
     virtual bool Contains(Entity entity) const = 0;
+
+    // Host bytes reserved by the storage (vector capacities)
+    virtual uint64 GetMemoryBytes() const = 0;
 };
 
 // Sparse-set based component storage for a specific component type T.
@@ -135,6 +138,12 @@ public:
         Remove(entity);
     }
 
+    uint64 GetMemoryBytes() const override {
+        return static_cast<uint64>(sparse_.capacity()) * sizeof(uint32) +
+               static_cast<uint64>(dense_.capacity()) * sizeof(T) +
+               static_cast<uint64>(dense_to_entity_.capacity()) * sizeof(Entity);
+    }
+
     // Access the dense-to-entity mapping (useful for iteration)
     const std::vector<Entity>& GetEntities() const {
         return dense_to_entity_;
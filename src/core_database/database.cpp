@@ -48,16 +48,22 @@ void Database::Transact(std::function<void()> fn) {
         Commit();
     } catch (...) {
         Rollback();
+        UpdateMemory();
         throw;
     }
+    UpdateMemory();
 }
 
 bool Database::Undo() {
-    return transaction_manager_.Undo(*this);
+    bool undone = transaction_manager_.Undo(*this);
+    if (undone) UpdateMemory();
+    return undone;
 }
 
 bool Database::Redo() {
-    return transaction_manager_.Redo(*this);
+    bool redone = transaction_manager_.Redo(*this);
+    if (redone) UpdateMemory();
+    return redone;
 }
 
 bool Database::CanUndo() const {
@@ -68,6 +74,27 @@ bool Database::CanRedo() const {
     return transaction_manager_.CanRedo();
 }
 
+uint64 Database::TrimUndoHistory(uint64 bytes) {
+    return transaction_manager_.TrimHistory(bytes);
+}
+
+uint64 Database::GetUndoHistoryBytes() const {
+    return transaction_manager_.GetHistoryBytes();
+}
+
+void Database::UpdateMemory() {
+    uint64 component_bytes = 0;
+    for (const auto& [id, storage] : storages_) {
+        component_bytes += storage->GetMemoryBytes();
+    }
+    uint64 array_bytes = 0;
+    for (const auto& [id, storage] : array_storages_) {
+        array_bytes += storage->GetMemoryBytes();
+    }
+    component_memory_.Set(component_bytes);
+    array_memory_.Set(array_bytes);
+}
+
 // --- Storage access ---
 
 IComponentStorage* Database::GetStorageById(ComponentTypeId id) {
@@ -8,6 +8,8 @@
 #include "core_database/transaction.h"
 #include <functional>
 #include <memory>
+#include <optional>
+#include <span>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -74,6 +76,11 @@ public:
     bool CanUndo() const;
     bool CanRedo() const;
 
+    // Drop the oldest undo steps (then far redo steps) until `bytes` are released.
+    // Used by the host memory budget; returns the bytes released.
+    uint64 TrimUndoHistory(uint64 bytes);
+    uint64 GetUndoHistoryBytes() const;
+
     // --- Storage access (for renderers / systems) ---
     IComponentStorage* GetStorageById(ComponentTypeId id);
     const IComponentStorage* GetStorageById(ComponentTypeId id) const;
@@ -89,8 +96,9 @@ public:
     template<Component T>
     void SetArray(Entity entity, std::vector<T> data);
 
+    // View into the array arena; invalidated by the next modification of T arrays
     template<Component T>
-    const std::vector<T>* GetArray(Entity entity) const;
+    std::optional<std::span<const T>> GetArray(Entity entity) const;
 
     template<Component T>
     void RemoveArray(Entity entity);
@@ -100,7 +108,7 @@ public:
 
     // --- Direct array operations (no transaction recording) ---
     template<Component T>
-    void DirectSetArray(Entity entity, std::vector<T> data);
+    void DirectSetArray(Entity entity, std::span<const T> data);
 
     template<Component T>
     void DirectRemoveArray(Entity entity);
@@ -126,6 +134,9 @@ private:
     void Commit();
     void Rollback();
 
+    // Report storage sizes to MemoryTracker (after each transaction, undo and redo)
+    void UpdateMemory();
+
     // Get or create typed storage for component type T
     template<Component T>
     ComponentStorage<T>& GetOrCreateStorage();
@@ -154,6 +165,9 @@ private:
     std::unordered_map<ComponentTypeId, std::unique_ptr<IComponentStorage>> storages_;
     std::unordered_map<ComponentTypeId, std::unique_ptr<IArrayStorage>> array_storages_;
     std::unordered_map<ComponentTypeId, std::unique_ptr<ISingletonStorage>> singletons_;
+
+    util::MemoryAccount component_memory_{util::MemoryDomain::Host, "components", "database"};
+    util::MemoryAccount array_memory_{util::MemoryDomain::Host, "arrays", "database"};
 };
 
 // ============================================================================
@@ -285,9 +299,9 @@ template<Component T>
 void Database::SetArray(Entity entity, std::vector<T> data) {
     auto& storage = GetOrCreateArrayStorage<T>();
     std::vector<T> old_data;
-    const auto* existing = storage.GetArray(entity);
+    auto existing = storage.GetArray(entity);
     if (existing) {
-        old_data = *existing;
+        old_data.assign(existing->begin(), existing->end());
     }
     storage.SetArray(entity, data);
     transaction_manager_.Record(
@@ -295,9 +309,9 @@ void Database::SetArray(Entity entity, std::vector<T> data) {
 }
 
 template<Component T>
-const std::vector<T>* Database::GetArray(Entity entity) const {
+std::optional<std::span<const T>> Database::GetArray(Entity entity) const {
     auto* storage = GetArrayStorage<T>();
-    if (!storage) return nullptr;
+    if (!storage) return std::nullopt;
     return storage->GetArray(entity);
 }
 
@@ -305,9 +319,9 @@ template<Component T>
 void Database::RemoveArray(Entity entity) {
     auto* storage = GetArrayStorage<T>();
     if (!storage) return;
-    const auto* existing = storage->GetArray(entity);
+    auto existing = storage->GetArray(entity);
     if (!existing) return;
-    std::vector<T> old_data = *existing;
+    std::vector<T> old_data(existing->begin(), existing->end());
     storage->Remove(entity);
     transaction_manager_.Record(
         std::make_unique<RemoveArrayOp<T>>(entity, std::move(old_data)));
@@ -323,9 +337,9 @@ bool Database::HasArray(Entity entity) const {
 // --- Direct array operations (no transaction recording) ---
 
 template<Component T>
-void Database::DirectSetArray(Entity entity, std::vector<T> data) {
+void Database::DirectSetArray(Entity entity, std::span<const T> data) {
     auto& storage = GetOrCreateArrayStorage<T>();
-    storage.SetArray(entity, std::move(data));
+    storage.SetArray(entity, data);
 }
 
 template<Component T>
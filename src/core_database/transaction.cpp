@@ -20,8 +20,11 @@ bool TransactionManager::Commit() {
         return false;
     }
     if (!active_->IsEmpty()) {
+        undo_bytes_ += active_->GetByteSize();
         undo_stack_.push_back(std::move(active_));
         redo_stack_.clear();
+        redo_bytes_ = 0;
+        UpdateMemory();
     }
     active_.reset();
     return true;
@@ -44,7 +47,10 @@ bool TransactionManager::Undo(Database& db) {
     auto txn = std::move(undo_stack_.back());
     undo_stack_.pop_back();
     txn->Revert(db);
+    undo_bytes_ -= txn->GetByteSize();
+    redo_bytes_ += txn->GetByteSize();
     redo_stack_.push_back(std::move(txn));
+    UpdateMemory();
     return true;
 }
 
@@ -55,7 +61,10 @@ bool TransactionManager::Redo(Database& db) {
     auto txn = std::move(redo_stack_.back());
     redo_stack_.pop_back();
     txn->Apply(db);
+    redo_bytes_ -= txn->GetByteSize();
+    undo_bytes_ += txn->GetByteSize();
     undo_stack_.push_back(std::move(txn));
+    UpdateMemory();
     return true;
 }
 
@@ -71,6 +80,43 @@ bool TransactionManager::CanRedo() const {
     return !redo_stack_.empty();
 }
 
+uint64 TransactionManager::GetHistoryBytes() const {
+    return undo_bytes_ + redo_bytes_;
+}
+
+uint64 TransactionManager::TrimHistory(uint64 bytes) {
+    uint64 released = 0;
+    size_t undo_count = 0;
+    while (undo_count < undo_stack_.size() && released < bytes) {
+        released += undo_stack_[undo_count++]->GetByteSize();
+    }
+    size_t redo_count = 0;
+    while (redo_count < redo_stack_.size() && released < bytes) {
+        released += redo_stack_[redo_count++]->GetByteSize();
+    }
+    if (released == 0) {
+        return 0;
+    }
+
+    // Both stacks keep their oldest entries at the front
+    undo_stack_.erase(undo_stack_.begin(), undo_stack_.begin() + undo_count);
+    redo_stack_.erase(redo_stack_.begin(), redo_stack_.begin() + redo_count);
+    undo_bytes_ = 0;
+    for (const auto& txn : undo_stack_) undo_bytes_ += txn->GetByteSize();
+    redo_bytes_ = 0;
+    for (const auto& txn : redo_stack_) redo_bytes_ += txn->GetByteSize();
+    UpdateMemory();
+
+    LogInfo("TransactionManager: dropped ", undo_count, " undo and ", redo_count,
+            " redo steps (", released, " bytes)");
+    return released;
+}
+
+void TransactionManager::UpdateMemory() {
+    undo_memory_.Set(undo_bytes_);
+    redo_memory_.Set(redo_bytes_);
+}
+
 void TransactionManager::Record(std::unique_ptr<IOperation> op) {
     if (!active_) {
         return;
@@ -2,6 +2,7 @@
 
 #include "core_database/component_type.h"
 #include "core_database/entity.h"
+#include "core_util/memory_tracker.h"
 #include <memory>
 #include <vector>
 
@@ -21,6 +22,9 @@ public:
 
     // Revert the operation (undo)
     virtual void Revert(Database& db) = 0;
+
+    // Host bytes held by the operation (for undo history accounting)
+    virtual uint64 GetByteSize() const = 0;
 };
 
 // Operation: add a component to an entity
@@ -32,6 +36,7 @@ public:
 
     void Apply(Database& db) override;
     void Revert(Database& db) override;
+    uint64 GetByteSize() const override { return sizeof(*this); }
 
 private:
     Entity entity_;
@@ -47,6 +52,7 @@ public:
 
     void Apply(Database& db) override;
     void Revert(Database& db) override;
+    uint64 GetByteSize() const override { return sizeof(*this); }
 
 private:
     Entity entity_;
@@ -62,6 +68,7 @@ public:
 
     void Apply(Database& db) override;
     void Revert(Database& db) override;
+    uint64 GetByteSize() const override { return sizeof(*this); }
 
 private:
     Entity entity_;
@@ -76,6 +83,7 @@ public:
 
     // Add an operation to this transaction
     void AddOperation(std::unique_ptr<IOperation> op) {
+        byte_size_ += op->GetByteSize() + sizeof(op);
         operations_.push_back(std::move(op));
     }
 
@@ -98,8 +106,14 @@ public:
         return operations_.empty();
     }
 
+    // Host bytes held by this transaction's operations
+    uint64 GetByteSize() const {
+        return sizeof(*this) + byte_size_;
+    }
+
 private:
     std::vector<std::unique_ptr<IOperation>> operations_;
+    uint64 byte_size_ = 0;
 };
 
 // Operation: set a singleton value
@@ -111,6 +125,7 @@ public:
 
     void Apply(Database& db) override;
     void Revert(Database& db) override;
+    uint64 GetByteSize() const override { return sizeof(*this); }
 
 private:
     T old_value_;
@@ -144,14 +159,29 @@ public:
     bool CanUndo() const;
     bool CanRedo() const;
 
+    // Host bytes held by the undo and redo stacks
+    uint64 GetHistoryBytes() const;
+
+    // Drop history until at least `bytes` are released: oldest undo steps first, then
+    // the redo steps farthest from the current state. Returns the bytes released.
+    uint64 TrimHistory(uint64 bytes);
+
     // Record an operation into the active transaction.
     // No-op if no transaction is active (e.g., during undo/redo replay).
     void Record(std::unique_ptr<IOperation> op);
 
 private:
+    // Report the stack sizes to MemoryTracker
+    void UpdateMemory();
+
     std::unique_ptr<Transaction> active_;
     std::vector<std::unique_ptr<Transaction>> undo_stack_;
     std::vector<std::unique_ptr<Transaction>> redo_stack_;
+
+    uint64 undo_bytes_ = 0;
+    uint64 redo_bytes_ = 0;
+    util::MemoryAccount undo_memory_{util::MemoryDomain::Host, "undo_history", "database"};
+    util::MemoryAccount redo_memory_{util::MemoryDomain::Host, "redo_history", "database"};
 };
 
 }  // namespace database
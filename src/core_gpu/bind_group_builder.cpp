@@ -1,4 +1,5 @@
 #include "core_gpu/bind_group_builder.h"
+#include "core_gpu/gpu_buffer_pool.h"
 #include "core_gpu/gpu_core.h"
 #include <webgpu/webgpu.h>
 #include <utility>
@@ -28,6 +29,19 @@ BindGroupBuilder&& BindGroupBuilder::AddBuffer(
     return std::move(*this);
 }
 
+BindGroupBuilder&& BindGroupBuilder::AddBuffer(uint32 binding, const BufferBinding& range) && {
+    return std::move(*this).AddBuffer(binding, range.buffer, range.size, range.offset);
+}
+
+BindGroupBuilder&& BindGroupBuilder::AddSlice(uint32 binding, const GPUBufferSlice& slice) && {
+    return std::move(*this).AddBuffer(binding, slice.GetBinding());
+}
+
+BindGroupBuilder&& BindGroupBuilder::AddSlice(
+    uint32 binding, const GPUBufferSlice& slice, uint64 size, uint64 offset) && {
+    return std::move(*this).AddBuffer(binding, slice.GetBinding(size, offset));
+}
+
 BindGroupBuilder&& BindGroupBuilder::AddTextureView(
     uint32 binding, WGPUTextureView view) && {
     Entry entry;
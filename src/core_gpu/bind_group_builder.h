@@ -14,6 +14,16 @@ struct WGPUBindGroupLayoutImpl;  typedef WGPUBindGroupLayoutImpl* WGPUBindGroupL
 namespace mps {
 namespace gpu {
 
+class GPUBufferSlice;
+
+// Buffer range for one bind group entry (offset 0 binds from the start).
+// Storage offsets must be multiples of minStorageBufferOffsetAlignment.
+struct BufferBinding {
+    WGPUBuffer buffer = nullptr;
+    uint64 size = 0;
+    uint64 offset = 0;
+};
+
 class BindGroupBuilder {
 public:
     BindGroupBuilder() = default;
@@ -25,6 +35,10 @@ public:
     BindGroupBuilder& operator=(BindGroupBuilder&& other) noexcept;
 
     BindGroupBuilder&& AddBuffer(uint32 binding, WGPUBuffer buffer, uint64 size, uint64 offset = 0) &&;
+    BindGroupBuilder&& AddBuffer(uint32 binding, const BufferBinding& range) &&;
+    // Bind a pooled slice whole, or `size` bytes at `offset` within it
+    BindGroupBuilder&& AddSlice(uint32 binding, const GPUBufferSlice& slice) &&;
+    BindGroupBuilder&& AddSlice(uint32 binding, const GPUBufferSlice& slice, uint64 size, uint64 offset = 0) &&;
     BindGroupBuilder&& AddTextureView(uint32 binding, WGPUTextureView view) &&;
     BindGroupBuilder&& AddSampler(uint32 binding, WGPUSampler sampler) &&;
 
@@ -20,6 +20,12 @@ BindGroupLayoutBuilder&& BindGroupLayoutBuilder::AddUniformBinding(
     return std::move(*this).AddBinding(binding, visibility, BindingType::Uniform);
 }
 
+BindGroupLayoutBuilder&& BindGroupLayoutBuilder::AddDynamicUniformBinding(
+    uint32 binding, ShaderStage visibility) && {
+    entries_.push_back({binding, visibility, BindingType::Uniform, true});
+    return std::move(*this);
+}
+
 BindGroupLayoutBuilder&& BindGroupLayoutBuilder::AddStorageBinding(
     uint32 binding, ShaderStage visibility) && {
     return std::move(*this).AddBinding(binding, visibility, BindingType::Storage);
@@ -54,6 +60,7 @@ GPUBindGroupLayout BindGroupLayoutBuilder::Build() && {
         switch (e.type) {
             case BindingType::Uniform:
                 entry.buffer.type = WGPUBufferBindingType_Uniform;
+                entry.buffer.hasDynamicOffset = e.has_dynamic_offset;
                 break;
             case BindingType::Storage:
                 entry.buffer.type = WGPUBufferBindingType_Storage;
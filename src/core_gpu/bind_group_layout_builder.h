@@ -20,6 +20,7 @@ public:
 
     BindGroupLayoutBuilder&& AddBinding(uint32 binding, ShaderStage visibility, BindingType type) &&;
     BindGroupLayoutBuilder&& AddUniformBinding(uint32 binding, ShaderStage visibility) &&;
+    BindGroupLayoutBuilder&& AddDynamicUniformBinding(uint32 binding, ShaderStage visibility) &&;
     BindGroupLayoutBuilder&& AddStorageBinding(uint32 binding, ShaderStage visibility) &&;
     BindGroupLayoutBuilder&& AddReadOnlyStorageBinding(uint32 binding, ShaderStage visibility) &&;
     BindGroupLayoutBuilder&& AddTextureBinding(uint32 binding, ShaderStage visibility) &&;
@@ -32,6 +33,7 @@ private:
         uint32 binding;
         ShaderStage visibility;
         BindingType type;
+        bool has_dynamic_offset = false;
     };
     std::vector<BindingEntry> entries_;
     std::string label_;
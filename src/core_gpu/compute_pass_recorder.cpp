@@ -0,0 +1,131 @@
+#include "core_gpu/compute_pass_recorder.h"
+#include "core_gpu/compute_program.h"
+#include "core_gpu/gpu_profiler.h"
+#include <webgpu/webgpu.h>
+
+namespace mps {
+namespace gpu {
+
+ComputePassRecorder::ComputePassRecorder(WGPUCommandEncoder encoder, const std::string& label)
+    : encoder_(encoder), label_(label) {
+    // Per-kernel timing needs one timestamp pair per dispatch, i.e. one pass each
+    split_per_dispatch_ = GPUProfiler::GetInstance().IsPerDispatchTiming();
+}
+
+ComputePassRecorder::ComputePassRecorder(ComputeProgram& capture)
+    : capture_(&capture), label_(capture.GetLabel()) {}
+
+ComputePassRecorder::~ComputePassRecorder() {
+    Flush();
+}
+
+// -- Dispatch -----------------------------------------------------------------
+
+const ComputeEncoder& ComputePassRecorder::Bind(WGPUComputePipeline pipeline,
+                                                WGPUBindGroup bind_group,
+                                                const uint32* dynamic_offset) {
+    if (!pass_) {
+        auto& profiler = GPUProfiler::GetInstance();
+        WGPUComputePassDescriptor pd = WGPU_COMPUTE_PASS_DESCRIPTOR_INIT;
+        pd.label = {label_.data(), label_.size()};
+        pd.timestampWrites = split_per_dispatch_
+            ? profiler.AllocatePass(pipeline)
+            : profiler.AllocatePass(label_);
+        pass_ = wgpuCommandEncoderBeginComputePass(encoder_, &pd);
+        pass_encoder_.emplace(pass_);
+        bound_pipeline_ = nullptr;
+        bound_group_ = nullptr;
+        ++pass_count_;
+    }
+
+    if (pipeline != bound_pipeline_) {
+        pass_encoder_->SetPipeline(pipeline);
+        bound_pipeline_ = pipeline;
+        // Bindings are not guaranteed to survive a layout change
+        bound_group_ = nullptr;
+    }
+    bool has_offset = dynamic_offset != nullptr;
+    uint32 offset = has_offset ? *dynamic_offset : 0;
+    if (bind_group != bound_group_ || has_offset != bound_has_offset_ || offset != bound_offset_) {
+        pass_encoder_->SetBindGroup(0, bind_group, has_offset ? 1 : 0, dynamic_offset);
+        bound_group_ = bind_group;
+        bound_has_offset_ = has_offset;
+        bound_offset_ = offset;
+    }
+    return *pass_encoder_;
+}
+
+void ComputePassRecorder::EndDispatch() {
+    ++dispatch_count_;
+    if (split_per_dispatch_) Flush();
+}
+
+void ComputePassRecorder::Dispatch(WGPUComputePipeline pipeline, WGPUBindGroup bind_group,
+                                   uint32 workgroup_count) {
+    if (capture_) {
+        capture_->Dispatch(pipeline, bind_group, workgroup_count);
+        ++dispatch_count_;
+        return;
+    }
+    Bind(pipeline, bind_group).Dispatch(workgroup_count);
+    EndDispatch();
+}
+
+void ComputePassRecorder::DispatchWithOffset(WGPUComputePipeline pipeline, WGPUBindGroup bind_group,
+                                             uint32 dynamic_offset, uint32 workgroup_count) {
+    if (capture_) {
+        capture_->DispatchWithOffset(pipeline, bind_group, dynamic_offset, workgroup_count);
+        ++dispatch_count_;
+        return;
+    }
+    Bind(pipeline, bind_group, &dynamic_offset).Dispatch(workgroup_count);
+    EndDispatch();
+}
+
+void ComputePassRecorder::DispatchIndirect(WGPUComputePipeline pipeline, WGPUBindGroup bind_group,
+                                           WGPUBuffer indirect_buffer, uint64 indirect_offset) {
+    if (capture_) {
+        capture_->DispatchIndirect(pipeline, bind_group, indirect_buffer, indirect_offset);
+        ++dispatch_count_;
+        return;
+    }
+    Bind(pipeline, bind_group).DispatchIndirect(indirect_buffer, indirect_offset);
+    EndDispatch();
+}
+
+// -- Encoder-level commands ---------------------------------------------------
+
+void ComputePassRecorder::CopyBufferToBuffer(WGPUBuffer src, uint64 src_offset,
+                                             WGPUBuffer dst, uint64 dst_offset, uint64 size) {
+    if (capture_) {
+        capture_->CopyBufferToBuffer(src, src_offset, dst, dst_offset, size);
+        return;
+    }
+    Flush();
+    wgpuCommandEncoderCopyBufferToBuffer(encoder_, src, src_offset, dst, dst_offset, size);
+}
+
+void ComputePassRecorder::ClearBuffer(WGPUBuffer buffer, uint64 offset, uint64 size) {
+    if (capture_) {
+        capture_->ClearBuffer(buffer, offset, size);
+        return;
+    }
+    Flush();
+    wgpuCommandEncoderClearBuffer(encoder_, buffer, offset, size);
+}
+
+WGPUCommandEncoder ComputePassRecorder::GetEncoder() {
+    Flush();
+    return encoder_;
+}
+
+void ComputePassRecorder::Flush() {
+    if (!pass_) return;
+    pass_encoder_.reset();
+    wgpuComputePassEncoderEnd(pass_);
+    wgpuComputePassEncoderRelease(pass_);
+    pass_ = nullptr;
+}
+
+}  // namespace gpu
+}  // namespace mps
@@ -0,0 +1,97 @@
+#pragma once
+
+#include "core_util/types.h"
+#include "core_gpu/compute_encoder.h"
+#include "core_gpu/gpu_handle.h"
+#include <optional>
+#include <string>
+
+struct WGPUCommandEncoderImpl;      typedef WGPUCommandEncoderImpl*     WGPUCommandEncoder;
+struct WGPUComputePassEncoderImpl;  typedef WGPUComputePassEncoderImpl* WGPUComputePassEncoder;
+struct WGPUComputePipelineImpl;     typedef WGPUComputePipelineImpl*    WGPUComputePipeline;
+struct WGPUBindGroupImpl;           typedef WGPUBindGroupImpl*          WGPUBindGroup;
+struct WGPUBufferImpl;              typedef WGPUBufferImpl*             WGPUBuffer;
+
+namespace mps {
+namespace gpu {
+
+class ComputeProgram;
+
+/// Batches a sequence of compute dispatches into as few compute passes as possible.
+///
+/// A pass is opened lazily by the first dispatch and stays open across subsequent
+/// dispatches; WebGPU already orders storage writes between dispatches of one pass.
+/// Encoder-level commands (copy, clear) are split points: they end the open pass
+/// before being recorded. Redundant SetPipeline/SetBindGroup calls are skipped.
+///
+/// The recorder does not own the command encoder. The open pass is ended by Flush(),
+/// GetEncoder(), or the destructor, whichever comes first.
+///
+/// A recorder constructed from a ComputeProgram captures instead of encoding: every
+/// command is appended to the program, to be replayed later into a live recorder.
+class ComputePassRecorder {
+public:
+    explicit ComputePassRecorder(WGPUCommandEncoder encoder, const std::string& label = "compute");
+    explicit ComputePassRecorder(ComputeProgram& capture);
+    ~ComputePassRecorder();
+
+    ComputePassRecorder(const ComputePassRecorder&) = delete;
+    ComputePassRecorder& operator=(const ComputePassRecorder&) = delete;
+
+    // Dispatches (bind group 0)
+    void Dispatch(WGPUComputePipeline pipeline, WGPUBindGroup bind_group,
+                  uint32 workgroup_count);
+    void DispatchIndirect(WGPUComputePipeline pipeline, WGPUBindGroup bind_group,
+                          WGPUBuffer indirect_buffer, uint64 indirect_offset = 0);
+
+    // Bind group 0 with a single dynamic offset (e.g. per-iteration uniform slices)
+    void DispatchWithOffset(WGPUComputePipeline pipeline, WGPUBindGroup bind_group,
+                            uint32 dynamic_offset, uint32 workgroup_count);
+
+    void Dispatch(const GPUComputePipeline& pipeline, const GPUBindGroup& bind_group,
+                  uint32 workgroup_count) {
+        Dispatch(pipeline.GetHandle(), bind_group.GetHandle(), workgroup_count);
+    }
+    void DispatchIndirect(const GPUComputePipeline& pipeline, const GPUBindGroup& bind_group,
+                          WGPUBuffer indirect_buffer, uint64 indirect_offset = 0) {
+        DispatchIndirect(pipeline.GetHandle(), bind_group.GetHandle(), indirect_buffer, indirect_offset);
+    }
+
+    // Encoder-level commands (end the open pass)
+    void CopyBufferToBuffer(WGPUBuffer src, uint64 src_offset,
+                            WGPUBuffer dst, uint64 dst_offset, uint64 size);
+    void ClearBuffer(WGPUBuffer buffer, uint64 offset, uint64 size);
+
+    // End the open pass and return the encoder for any other encoder-level command.
+    // Returns nullptr while capturing: such commands cannot be replayed.
+    WGPUCommandEncoder GetEncoder();
+    void Flush();
+
+    // Stats (for profiling / tests of batching efficiency)
+    [[nodiscard]] uint32 GetPassCount() const { return pass_count_; }
+    [[nodiscard]] uint32 GetDispatchCount() const { return dispatch_count_; }
+    [[nodiscard]] bool IsCapturing() const { return capture_ != nullptr; }
+
+private:
+    const ComputeEncoder& Bind(WGPUComputePipeline pipeline, WGPUBindGroup bind_group,
+                               const uint32* dynamic_offset = nullptr);
+    void EndDispatch();
+
+    WGPUCommandEncoder encoder_ = nullptr;
+    ComputeProgram* capture_ = nullptr;
+    std::string label_;
+
+    WGPUComputePassEncoder pass_ = nullptr;
+    std::optional<ComputeEncoder> pass_encoder_;
+    WGPUComputePipeline bound_pipeline_ = nullptr;
+    WGPUBindGroup bound_group_ = nullptr;
+    bool bound_has_offset_ = false;
+    uint32 bound_offset_ = 0;
+    bool split_per_dispatch_ = false;
+
+    uint32 pass_count_ = 0;
+    uint32 dispatch_count_ = 0;
+};
+
+}  // namespace gpu
+}  // namespace mps
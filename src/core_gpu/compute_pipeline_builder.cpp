@@ -2,6 +2,7 @@
 #include "core_gpu/gpu_core.h"
 #include <webgpu/webgpu.h>
 #include <utility>
+#include <vector>
 
 namespace mps {
 namespace gpu {
@@ -22,14 +23,35 @@ ComputePipelineBuilder&& ComputePipelineBuilder::SetComputeShader(
     return std::move(*this);
 }
 
+ComputePipelineBuilder&& ComputePipelineBuilder::SetConstant(
+    const std::string& key, float64 value) && {
+    constants_.emplace_back(key, value);
+    return std::move(*this);
+}
+
+ComputePipelineBuilder&& ComputePipelineBuilder::SetWorkgroupSize(uint32 size) && {
+    constants_.emplace_back(kWorkgroupSizeConstant, static_cast<float64>(size));
+    return std::move(*this);
+}
+
 GPUComputePipeline ComputePipelineBuilder::Build() && {
     auto& gpu = GPUCore::GetInstance();
 
+    std::vector<WGPUConstantEntry> constants;
+    for (const auto& [key, value] : constants_) {
+        WGPUConstantEntry constant = WGPU_CONSTANT_ENTRY_INIT;
+        constant.key = {key.data(), key.size()};
+        constant.value = value;
+        constants.push_back(constant);
+    }
+
     WGPUComputePipelineDescriptor desc = WGPU_COMPUTE_PIPELINE_DESCRIPTOR_INIT;
     desc.label = {label_.data(), label_.size()};
     desc.layout = pipeline_layout_;
     desc.compute.module = compute_shader_;
     desc.compute.entryPoint = {compute_entry_.data(), compute_entry_.size()};
+    desc.compute.constantCount = constants.size();
+    desc.compute.constants = constants.data();
 
     return GPUComputePipeline(wgpuDeviceCreateComputePipeline(gpu.GetDevice(), &desc));
 }
@@ -3,6 +3,8 @@
 #include "core_gpu/gpu_types.h"
 #include "core_gpu/gpu_handle.h"
 #include <string>
+#include <utility>
+#include <vector>
 
 struct WGPUPipelineLayoutImpl;   typedef WGPUPipelineLayoutImpl*   WGPUPipelineLayout;
 struct WGPUShaderModuleImpl;     typedef WGPUShaderModuleImpl*     WGPUShaderModule;
@@ -10,6 +12,8 @@ struct WGPUShaderModuleImpl;     typedef WGPUShaderModuleImpl*     WGPUShaderMod
 namespace mps {
 namespace gpu {
 
+/// Builds an uncached pipeline owned by the caller. Not registered with GPUProfiler
+/// (its passes report as "(unlabeled)"); PipelineRegistry pipelines are.
 class ComputePipelineBuilder {
 public:
     ComputePipelineBuilder() = default;
@@ -23,6 +27,8 @@ public:
     ComputePipelineBuilder&& SetPipelineLayout(WGPUPipelineLayout layout) &&;
     ComputePipelineBuilder&& SetComputeShader(WGPUShaderModule module,
                                                const std::string& entry = "cs_main") &&;
+    ComputePipelineBuilder&& SetConstant(const std::string& key, float64 value) &&;
+    ComputePipelineBuilder&& SetWorkgroupSize(uint32 size) &&;
 
     GPUComputePipeline Build() &&;
 
@@ -31,6 +37,7 @@ private:
     WGPUPipelineLayout pipeline_layout_ = nullptr;
     WGPUShaderModule compute_shader_ = nullptr;
     std::string compute_entry_ = "cs_main";
+    std::vector<std::pair<std::string, float64>> constants_;
 };
 
 }  // namespace gpu
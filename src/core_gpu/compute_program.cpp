@@ -0,0 +1,71 @@
+#include "core_gpu/compute_program.h"
+#include "core_gpu/compute_pass_recorder.h"
+
+namespace mps {
+namespace gpu {
+
+ComputeProgram::ComputeProgram(const std::string& label)
+    : label_(label) {}
+
+// -- Recording ----------------------------------------------------------------
+
+void ComputeProgram::Dispatch(WGPUComputePipeline pipeline, WGPUBindGroup bind_group,
+                              uint32 workgroup_count) {
+    commands_.push_back({Op::Dispatch, workgroup_count, 0, pipeline, bind_group,
+                         nullptr, nullptr, 0, 0, 0});
+}
+
+void ComputeProgram::DispatchWithOffset(WGPUComputePipeline pipeline, WGPUBindGroup bind_group,
+                                        uint32 dynamic_offset, uint32 workgroup_count) {
+    commands_.push_back({Op::DispatchWithOffset, workgroup_count, dynamic_offset, pipeline, bind_group,
+                         nullptr, nullptr, 0, 0, 0});
+}
+
+void ComputeProgram::DispatchIndirect(WGPUComputePipeline pipeline, WGPUBindGroup bind_group,
+                                      WGPUBuffer indirect_buffer, uint64 indirect_offset) {
+    commands_.push_back({Op::DispatchIndirect, 0, 0, pipeline, bind_group,
+                         indirect_buffer, nullptr, indirect_offset, 0, 0});
+}
+
+void ComputeProgram::CopyBufferToBuffer(WGPUBuffer src, uint64 src_offset,
+                                        WGPUBuffer dst, uint64 dst_offset, uint64 size) {
+    commands_.push_back({Op::Copy, 0, 0, nullptr, nullptr,
+                         src, dst, src_offset, dst_offset, size});
+}
+
+void ComputeProgram::ClearBuffer(WGPUBuffer buffer, uint64 offset, uint64 size) {
+    commands_.push_back({Op::Clear, 0, 0, nullptr, nullptr,
+                         buffer, nullptr, offset, 0, size});
+}
+
+void ComputeProgram::Clear() {
+    commands_.clear();
+}
+
+// -- Replay -------------------------------------------------------------------
+
+void ComputeProgram::Replay(ComputePassRecorder& recorder) const {
+    for (const auto& cmd : commands_) {
+        switch (cmd.op) {
+            case Op::Dispatch:
+                recorder.Dispatch(cmd.pipeline, cmd.bind_group, cmd.workgroup_count);
+                break;
+            case Op::DispatchWithOffset:
+                recorder.DispatchWithOffset(cmd.pipeline, cmd.bind_group, cmd.dynamic_offset,
+                                            cmd.workgroup_count);
+                break;
+            case Op::DispatchIndirect:
+                recorder.DispatchIndirect(cmd.pipeline, cmd.bind_group, cmd.src, cmd.src_offset);
+                break;
+            case Op::Copy:
+                recorder.CopyBufferToBuffer(cmd.src, cmd.src_offset, cmd.dst, cmd.dst_offset, cmd.size);
+                break;
+            case Op::Clear:
+                recorder.ClearBuffer(cmd.src, cmd.src_offset, cmd.size);
+                break;
+        }
+    }
+}
+
+}  // namespace gpu
+}  // namespace mps
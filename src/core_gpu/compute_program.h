@@ -0,0 +1,68 @@
+#pragma once
+
+#include "core_util/types.h"
+#include <string>
+#include <vector>
+
+struct WGPUComputePipelineImpl;  typedef WGPUComputePipelineImpl* WGPUComputePipeline;
+struct WGPUBindGroupImpl;        typedef WGPUBindGroupImpl*       WGPUBindGroup;
+struct WGPUBufferImpl;           typedef WGPUBufferImpl*          WGPUBuffer;
+
+namespace mps {
+namespace gpu {
+
+class ComputePassRecorder;
+
+/// A prerecorded, replayable list of compute commands.
+///
+/// WebGPU has no compute bundles, so a fixed solver loop is captured once into a
+/// flat command array (via a capturing ComputePassRecorder) and replayed each frame.
+/// Replay skips everything the original code path did on the CPU (virtual calls into
+/// terms, iteration bookkeeping, bind group lookups) and only issues the WebGPU calls.
+///
+/// Handles are non-owning: the pipelines, bind groups and buffers referenced by a
+/// program must outlive it. Re-capture after any of them is recreated.
+class ComputeProgram {
+public:
+    explicit ComputeProgram(const std::string& label = "compute_program");
+
+    // Recording (normally driven by ComputePassRecorder in capture mode)
+    void Dispatch(WGPUComputePipeline pipeline, WGPUBindGroup bind_group, uint32 workgroup_count);
+    void DispatchWithOffset(WGPUComputePipeline pipeline, WGPUBindGroup bind_group,
+                            uint32 dynamic_offset, uint32 workgroup_count);
+    void DispatchIndirect(WGPUComputePipeline pipeline, WGPUBindGroup bind_group,
+                          WGPUBuffer indirect_buffer, uint64 indirect_offset);
+    void CopyBufferToBuffer(WGPUBuffer src, uint64 src_offset,
+                            WGPUBuffer dst, uint64 dst_offset, uint64 size);
+    void ClearBuffer(WGPUBuffer buffer, uint64 offset, uint64 size);
+    void Clear();
+
+    // Replay all commands into recorder (passes are batched by the recorder)
+    void Replay(ComputePassRecorder& recorder) const;
+
+    [[nodiscard]] bool IsEmpty() const { return commands_.empty(); }
+    [[nodiscard]] size_t GetCommandCount() const { return commands_.size(); }
+    [[nodiscard]] const std::string& GetLabel() const { return label_; }
+
+private:
+    enum class Op : uint8 { Dispatch, DispatchWithOffset, DispatchIndirect, Copy, Clear };
+
+    struct Command {
+        Op op;
+        uint32 workgroup_count;
+        uint32 dynamic_offset;
+        WGPUComputePipeline pipeline;
+        WGPUBindGroup bind_group;
+        WGPUBuffer src;          // indirect / copy source / clear target
+        WGPUBuffer dst;          // copy destination
+        uint64 src_offset;
+        uint64 dst_offset;
+        uint64 size;
+    };
+
+    std::string label_;
+    std::vector<Command> commands_;
+};
+
+}  // namespace gpu
+}  // namespace mps
@@ -0,0 +1,106 @@
+# Flatten every WGSL shader under SHADER_DIR (resolving #import the same way
+# ShaderLoader does at runtime) and write them into OUTPUT as a C++ table.
+#
+# Usage: cmake -DSHADER_DIR=<dir> -DOUTPUT=<file.cpp> [-DEMBED=OFF] -P embed_shaders.cmake
+#
+# Shader text is handled as plain strings only (never as CMake lists), since WGSL
+# is full of ';' and '[' ']'.
+
+cmake_minimum_required(VERSION 3.20)
+
+if(NOT SHADER_DIR OR NOT OUTPUT)
+    message(FATAL_ERROR "embed_shaders.cmake: SHADER_DIR and OUTPUT are required")
+endif()
+
+get_filename_component(_out_dir "${OUTPUT}" DIRECTORY)
+set(_flat_dir "${_out_dir}/shader_bundle_flat")
+
+# Append the flattened text of `path` (relative to SHADER_DIR) to the global
+# property MPS_FLAT_SOURCE. Each file is included at most once per root shader.
+function(_mps_flatten_shader path)
+    get_property(_done GLOBAL PROPERTY MPS_FLAT_DONE)
+    if(path IN_LIST _done)
+        return()
+    endif()
+    set_property(GLOBAL APPEND PROPERTY MPS_FLAT_DONE "${path}")
+
+    if(NOT EXISTS "${SHADER_DIR}/${path}")
+        message(WARNING "embed_shaders: missing shader import ${path}")
+        return()
+    endif()
+    file(READ "${SHADER_DIR}/${path}" _content)
+
+    # Leading newline so an import on the first line matches like any other
+    set(_rest "\n${_content}")
+    while(TRUE)
+        string(REGEX MATCH "\n[ \t]*#import[ \t]+\"([^\"\n]*)\"[ \t\r]*" _match "${_rest}")
+        if(_match STREQUAL "")
+            break()
+        endif()
+        set(_import "${CMAKE_MATCH_1}")
+
+        string(FIND "${_rest}" "${_match}" _pos)
+        string(LENGTH "${_match}" _len)
+        math(EXPR _after "${_pos} + ${_len}")
+        string(SUBSTRING "${_rest}" 0 ${_pos} _before)
+        string(SUBSTRING "${_rest}" ${_after} -1 _rest)
+
+        set_property(GLOBAL APPEND_STRING PROPERTY MPS_FLAT_SOURCE "${_before}")
+        _mps_flatten_shader("${_import}")
+    endwhile()
+    set_property(GLOBAL APPEND_STRING PROPERTY MPS_FLAT_SOURCE "${_rest}")
+endfunction()
+
+set(_shaders "")
+if(NOT DEFINED EMBED OR EMBED)
+    file(GLOB_RECURSE _shaders RELATIVE "${SHADER_DIR}" "${SHADER_DIR}/*.wgsl")
+    list(SORT _shaders)
+endif()
+
+# 16 bytes per output line
+string(REPEAT "[0-9a-f]" 32 _hex_line)
+
+set(_body "")
+set(_table "")
+set(_index 0)
+foreach(_shader IN LISTS _shaders)
+    set_property(GLOBAL PROPERTY MPS_FLAT_DONE "")
+    set_property(GLOBAL PROPERTY MPS_FLAT_SOURCE "")
+    _mps_flatten_shader("${_shader}")
+    get_property(_flat GLOBAL PROPERTY MPS_FLAT_SOURCE)
+    string(SUBSTRING "${_flat}" 1 -1 _flat)   # the root file's leading newline
+
+    # Round-trip through a file to get the bytes as hex
+    file(WRITE "${_flat_dir}/${_shader}" "${_flat}")
+    file(READ "${_flat_dir}/${_shader}" _hex HEX)
+    file(SIZE "${_flat_dir}/${_shader}" _size)
+
+    string(REGEX REPLACE "(${_hex_line})" "\\1\n    " _hex "${_hex}")
+    # '\xNN' literals rather than 0xNN so bytes >= 0x80 don't narrow into char
+    string(REGEX REPLACE "([0-9a-f][0-9a-f])" "'\\\\x\\1'," _hex "${_hex}")
+
+    string(APPEND _body "// ${_shader}\nstatic const char kShader${_index}[] = {\n    ${_hex}'\\0'\n};\n\n")
+    string(APPEND _table "    {\"${_shader}\", kShader${_index}, ${_size}},\n")
+    math(EXPR _index "${_index} + 1")
+endforeach()
+
+if(_index EQUAL 0)
+    set(_table "    {nullptr, nullptr, 0},\n")
+endif()
+
+set(_source "// Generated by embed_shaders.cmake from ${SHADER_DIR}. Do not edit.\n\n")
+string(APPEND _source "#include \"core_gpu/shader_bundle.h\"\n\n")
+string(APPEND _source "namespace mps {\nnamespace gpu {\n\n")
+string(APPEND _source "${_body}")
+string(APPEND _source "const EmbeddedShader kEmbeddedShaders[] = {\n${_table}};\n\n")
+string(APPEND _source "const uint32 kEmbeddedShaderCount = ${_index};\n\n")
+string(APPEND _source "}  // namespace gpu\n}  // namespace mps\n")
+
+# Only touch the output when it changes, so unrelated reconfigures don't rebuild it
+set(_previous "")
+if(EXISTS "${OUTPUT}")
+    file(READ "${OUTPUT}" _previous)
+endif()
+if(NOT _previous STREQUAL _source)
+    file(WRITE "${OUTPUT}" "${_source}")
+endif()
@@ -1,5 +1,7 @@
 #include "core_gpu/gpu_buffer.h"
 #include "core_gpu/gpu_core.h"
+#include "core_gpu/gpu_readback.h"
+#include "core_gpu/staging_belt.h"
 #include "core_util/logger.h"
 #include <webgpu/webgpu.h>
 #include <algorithm>
@@ -20,7 +22,8 @@ uint64 GPUBufferCore::AlignUp(uint64 value, uint64 alignment) {
 // -- Construction -------------------------------------------------------------
 
 GPUBufferCore::GPUBufferCore(const BufferConfig& config)
-    : size_(config.size), capacity_(config.size), usage_(config.usage) {
+    : size_(config.size), capacity_(config.size), usage_(config.usage),
+      memory_(util::MemoryDomain::GPU, config.label) {
     auto& core = GPUCore::GetInstance();
     assert(core.IsInitialized());
 
@@ -37,6 +40,7 @@ GPUBufferCore::GPUBufferCore(const BufferConfig& config)
     if (!handle_) {
         throw GPUException("Failed to create GPU buffer: " + config.label);
     }
+    UpdateMemory();
 
     LogInfo("GPUBuffer created: ", config.label, " (", config.size, " bytes)");
 }
@@ -49,7 +53,7 @@ GPUBufferCore::~GPUBufferCore() {
 
 GPUBufferCore::GPUBufferCore(GPUBufferCore&& other) noexcept
     : handle_(other.handle_), size_(other.size_),
-      capacity_(other.capacity_), usage_(other.usage_) {
+      capacity_(other.capacity_), usage_(other.usage_), memory_(std::move(other.memory_)) {
     other.handle_ = nullptr;
     other.size_ = 0;
     other.capacity_ = 0;
@@ -63,6 +67,7 @@ GPUBufferCore& GPUBufferCore::operator=(GPUBufferCore&& other) noexcept {
         size_ = other.size_;
         capacity_ = other.capacity_;
         usage_ = other.usage_;
+        memory_ = std::move(other.memory_);
         other.handle_ = nullptr;
         other.size_ = 0;
         other.capacity_ = 0;
@@ -79,6 +84,18 @@ void GPUBufferCore::WriteRawData(const void* data, uint64 size_bytes, uint64 byt
     wgpuQueueWriteBuffer(core.GetQueue(), handle_, byte_offset, data, static_cast<size_t>(size_bytes));
 }
 
+void GPUBufferCore::WriteRawDataStaged(const void* data, uint64 size_bytes, uint64 byte_offset) {
+    assert(handle_);
+    if (size_bytes == 0) return;
+    StagingBelt::GetInstance().Write(handle_, byte_offset, data, size_bytes);
+}
+
+std::span<uint8> GPUBufferCore::StageRawWrite(uint64 size_bytes, uint64 byte_offset) {
+    assert(handle_);
+    if (size_bytes == 0) return {};
+    return StagingBelt::GetInstance().Allocate(handle_, byte_offset, size_bytes);
+}
+
 void GPUBufferCore::CopyTo(GPUBufferCore& dest, uint64 src_offset,
                             uint64 dst_offset, uint64 size_bytes) const {
     assert(handle_);
@@ -111,130 +128,25 @@ void GPUBufferCore::CopyTo(WGPUCommandEncoder encoder, GPUBufferCore& dest,
 
 std::vector<uint8> GPUBufferCore::ReadRawToHost() const {
     assert(handle_);
+    if (size_ == 0) return {};
 
-    auto& core = GPUCore::GetInstance();
-
-    // Create staging buffer with MapRead | CopyDst
-    WGPUBufferDescriptor staging_desc = WGPU_BUFFER_DESCRIPTOR_INIT;
-    staging_desc.usage = WGPUBufferUsage_MapRead | WGPUBufferUsage_CopyDst;
-    staging_desc.size = size_;
-
-    WGPUBuffer staging = wgpuDeviceCreateBuffer(core.GetDevice(), &staging_desc);
-    if (!staging) {
-        throw GPUException("Failed to create staging buffer for readback");
-    }
-
-    // Copy source -> staging
-    WGPUCommandEncoder encoder = wgpuDeviceCreateCommandEncoder(core.GetDevice(), nullptr);
-    wgpuCommandEncoderCopyBufferToBuffer(encoder, handle_, 0, staging, 0, size_);
-    WGPUCommandBuffer cmd = wgpuCommandEncoderFinish(encoder, nullptr);
-    wgpuQueueSubmit(core.GetQueue(), 1, &cmd);
-    wgpuCommandBufferRelease(cmd);
-    wgpuCommandEncoderRelease(encoder);
-
-    // Map the staging buffer (synchronous)
-    struct MapContext {
-        bool done = false;
-        bool success = false;
-    };
-    MapContext ctx;
-
-    WGPUBufferMapCallbackInfo map_cb = WGPU_BUFFER_MAP_CALLBACK_INFO_INIT;
-#ifdef __EMSCRIPTEN__
-    map_cb.mode = WGPUCallbackMode_AllowProcessEvents;
-#else
-    map_cb.mode = WGPUCallbackMode_WaitAnyOnly;
-#endif
-    map_cb.callback = [](WGPUMapAsyncStatus status, WGPUStringView /*message*/,
-                         void* userdata1, void* /*userdata2*/) {
-        auto* c = static_cast<MapContext*>(userdata1);
-        c->done = true;
-        c->success = (status == WGPUMapAsyncStatus_Success);
-    };
-    map_cb.userdata1 = &ctx;
-
-    WGPUFuture future = wgpuBufferMapAsync(staging, WGPUMapMode_Read, 0,
-                                            static_cast<size_t>(size_), map_cb);
-
-#ifndef __EMSCRIPTEN__
-    WGPUFutureWaitInfo wait = WGPU_FUTURE_WAIT_INFO_INIT;
-    wait.future = future;
-    wgpuInstanceWaitAny(core.GetWGPUInstance(), 1, &wait, UINT64_MAX);
-#else
-    while (!ctx.done) {
-        core.ProcessEvents();
-    }
-#endif
-
-    if (!ctx.success) {
-        wgpuBufferRelease(staging);
-        throw GPUException("Failed to map staging buffer for readback");
-    }
-
-    // Read data
-    const void* mapped = wgpuBufferGetConstMappedRange(staging, 0, static_cast<size_t>(size_));
-    std::vector<uint8> result(static_cast<size_t>(size_));
-    std::memcpy(result.data(), mapped, result.size());
-
-    wgpuBufferUnmap(staging);
-    wgpuBufferRelease(staging);
-
-    return result;
+    // Copies into a pooled staging buffer instead of allocating one per call
+    return GPUReadback::GetInstance().Read(handle_, 0, size_);
 }
 
 void GPUBufferCore::ReadRawToHostAsync(std::function<void(std::vector<uint8>)> callback) const {
     assert(handle_);
-
-    auto& core = GPUCore::GetInstance();
-
-    // Create staging buffer with MapRead | CopyDst
-    WGPUBufferDescriptor staging_desc = WGPU_BUFFER_DESCRIPTOR_INIT;
-    staging_desc.usage = WGPUBufferUsage_MapRead | WGPUBufferUsage_CopyDst;
-    staging_desc.size = size_;
-
-    WGPUBuffer staging = wgpuDeviceCreateBuffer(core.GetDevice(), &staging_desc);
-    if (!staging) {
-        throw GPUException("Failed to create staging buffer for async readback");
+    if (size_ == 0) {
+        callback({});
+        return;
     }
 
-    // Copy source -> staging (submit immediately)
-    WGPUCommandEncoder encoder = wgpuDeviceCreateCommandEncoder(core.GetDevice(), nullptr);
-    wgpuCommandEncoderCopyBufferToBuffer(encoder, handle_, 0, staging, 0, size_);
-    WGPUCommandBuffer cmd = wgpuCommandEncoderFinish(encoder, nullptr);
-    wgpuQueueSubmit(core.GetQueue(), 1, &cmd);
-    wgpuCommandBufferRelease(cmd);
-    wgpuCommandEncoderRelease(encoder);
-
-    // Heap-allocate context to outlive this scope
-    struct AsyncReadContext {
-        WGPUBuffer staging;
-        uint64 size;
-        std::function<void(std::vector<uint8>)> callback;
-    };
-    auto* ctx = new AsyncReadContext{staging, size_, std::move(callback)};
-
-    WGPUBufferMapCallbackInfo map_cb = WGPU_BUFFER_MAP_CALLBACK_INFO_INIT;
-    map_cb.mode = WGPUCallbackMode_AllowProcessEvents;
-    map_cb.callback = [](WGPUMapAsyncStatus status, WGPUStringView /*message*/,
-                         void* userdata1, void* /*userdata2*/) {
-        auto* c = static_cast<AsyncReadContext*>(userdata1);
-        if (status == WGPUMapAsyncStatus_Success) {
-            const void* mapped = wgpuBufferGetConstMappedRange(
-                c->staging, 0, static_cast<size_t>(c->size));
-            std::vector<uint8> result(static_cast<size_t>(c->size));
-            std::memcpy(result.data(), mapped, result.size());
-            wgpuBufferUnmap(c->staging);
-            c->callback(std::move(result));
-        } else {
-            c->callback({});
-        }
-        wgpuBufferRelease(c->staging);
-        delete c;
-    };
-    map_cb.userdata1 = ctx;
-
-    wgpuBufferMapAsync(staging, WGPUMapMode_Read, 0,
-                        static_cast<size_t>(size_), map_cb);
+    // Queued on the readback pool; the copy is submitted with the frame's other
+    // readbacks on the next GPUReadback::Flush() and delivered during ProcessEvents.
+    GPUReadback::GetInstance().Request(handle_, 0, size_,
+        [cb = std::move(callback)](std::span<const uint8> data) {
+            cb(std::vector<uint8>(data.begin(), data.end()));
+        });
 }
 
 // -- Capacity management ------------------------------------------------------
@@ -275,6 +187,7 @@ void GPUBufferCore::SetSize(uint64 new_size_bytes) {
 
     size_ = new_size_bytes;
     capacity_ = new_capacity;
+    UpdateMemory();
 
     LogInfo("GPUBuffer SetSize: ", new_capacity, " bytes (no copy)");
 }
@@ -287,6 +200,7 @@ void GPUBufferCore::ShrinkToFit() {
     if (size_ == 0) {
         Release();
         capacity_ = 0;
+        UpdateMemory();
         return;
     }
 
@@ -318,6 +232,7 @@ void GPUBufferCore::ShrinkToFit() {
     Release();
     handle_ = new_handle;
     capacity_ = target_capacity;
+    UpdateMemory();
 
     LogInfo("GPUBuffer shrunk to ", target_capacity, " bytes");
 }
@@ -361,6 +276,7 @@ void GPUBufferCore::Grow(uint64 min_capacity) {
 
     handle_ = new_handle;
     capacity_ = new_capacity;
+    UpdateMemory();
 
     LogInfo("GPUBuffer grown to ", new_capacity, " bytes");
 }
@@ -381,6 +297,11 @@ void GPUBufferCore::Release() {
         wgpuBufferRelease(handle_);
         handle_ = nullptr;
     }
+    memory_.Set(0);
+}
+
+void GPUBufferCore::UpdateMemory() {
+    memory_.Set(handle_ ? capacity_ : 0);
 }
 
 }  // namespace gpu
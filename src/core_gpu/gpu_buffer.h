@@ -1,6 +1,7 @@
 #pragma once
 
 #include "core_gpu/gpu_types.h"
+#include "core_util/memory_tracker.h"
 #include <cstring>
 #include <functional>
 #include <span>
@@ -34,6 +35,9 @@ public:
 
     // Data operations
     void WriteRawData(const void* data, uint64 size_bytes, uint64 byte_offset = 0);
+    // Upload through the StagingBelt; lands when the belt is next flushed
+    void WriteRawDataStaged(const void* data, uint64 size_bytes, uint64 byte_offset = 0);
+    std::span<uint8> StageRawWrite(uint64 size_bytes, uint64 byte_offset = 0);
     void CopyTo(GPUBufferCore& dest, uint64 src_offset = 0,
                 uint64 dst_offset = 0, uint64 size_bytes = 0) const;
     void CopyTo(WGPUCommandEncoder encoder, GPUBufferCore& dest,
@@ -59,12 +63,14 @@ public:
 private:
     void Release();
     void Grow(uint64 min_capacity);
+    void UpdateMemory();    // report the allocated capacity to the MemoryTracker
     static uint64 AlignUp(uint64 value, uint64 alignment);
 
     WGPUBuffer handle_ = nullptr;
     uint64 size_ = 0;
     uint64 capacity_ = 0;
     BufferUsage usage_ = BufferUsage::None;
+    util::MemoryAccount memory_;    // label + owner scope at creation
 };
 
 // Typed buffer — element type is baked into the class
@@ -94,6 +100,18 @@ public:
         core_.WriteRawData(data.data(), data.size_bytes(), element_offset * sizeof(T));
     }
 
+    // Staged write (see StagingBelt): no driver-side copy, applied on the belt's next Flush()
+    void WriteDataStaged(std::span<const T> data, uint64 element_offset = 0) {
+        core_.WriteRawDataStaged(data.data(), data.size_bytes(), element_offset * sizeof(T));
+    }
+
+    // Mapped staging memory for `element_count` elements at `element_offset`, to be
+    // filled in place before the belt's next Flush(). Previous contents are undefined.
+    std::span<T> StageWrite(uint64 element_count, uint64 element_offset = 0) {
+        auto raw = core_.StageRawWrite(element_count * sizeof(T), element_offset * sizeof(T));
+        return {reinterpret_cast<T*>(raw.data()), static_cast<size_t>(element_count)};
+    }
+
     // Sync read back as typed vector
     std::vector<T> ReadToHost() const {
         auto raw = core_.ReadRawToHost();
@@ -102,7 +120,8 @@ public:
         return result;
     }
 
-    // Async read back as typed vector (callback fires during ProcessEvents)
+    // Async read back as typed vector (copied on the next GPUReadback::Flush(),
+    // callback fires during ProcessEvents)
     void ReadToHostAsync(std::function<void(std::vector<T>)> callback) const {
         core_.ReadRawToHostAsync([cb = std::move(callback)](std::vector<uint8> raw) {
             std::vector<T> result(raw.size() / sizeof(T));
@@ -0,0 +1,243 @@
+#include "core_gpu/gpu_buffer_pool.h"
+#include "core_gpu/gpu_core.h"
+#include <webgpu/webgpu.h>
+#include <algorithm>
+#include <cassert>
+#include <iterator>
+#include <string>
+#include <utility>
+
+using namespace mps::util;
+
+namespace mps {
+namespace gpu {
+
+static uint64 AlignUp(uint64 value, uint64 alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+static bool HasUsage(BufferUsage usage, BufferUsage flag) {
+    return (usage & flag) != BufferUsage::None;
+}
+
+// -- GPUBufferSlice -----------------------------------------------------------
+
+GPUBufferSlice::~GPUBufferSlice() {
+    Release();
+}
+
+GPUBufferSlice::GPUBufferSlice(GPUBufferSlice&& other) noexcept {
+    *this = std::move(other);
+}
+
+GPUBufferSlice& GPUBufferSlice::operator=(GPUBufferSlice&& other) noexcept {
+    if (this != &other) {
+        Release();
+        buffer_ = std::exchange(other.buffer_, nullptr);
+        offset_ = std::exchange(other.offset_, 0);
+        size_ = std::exchange(other.size_, 0);
+        reserved_ = std::exchange(other.reserved_, 0);
+        pool_ = std::exchange(other.pool_, 0);
+        page_ = std::exchange(other.page_, 0);
+    }
+    return *this;
+}
+
+void GPUBufferSlice::WriteRawData(const void* data, uint64 size_bytes, uint64 byte_offset) {
+    assert(buffer_ && byte_offset + size_bytes <= size_);
+    auto& core = GPUCore::GetInstance();
+    wgpuQueueWriteBuffer(core.GetQueue(), buffer_, offset_ + byte_offset, data,
+                         static_cast<size_t>(size_bytes));
+}
+
+void GPUBufferSlice::Release() {
+    if (!buffer_) return;
+    GPUBufferPool::GetInstance().Free(*this);
+    buffer_ = nullptr;
+}
+
+// -- Singleton ----------------------------------------------------------------
+
+GPUBufferPool& GPUBufferPool::GetInstance() {
+    static GPUBufferPool instance;
+    return instance;
+}
+
+GPUBufferPool::~GPUBufferPool() {
+    Shutdown();
+}
+
+// -- Allocation ---------------------------------------------------------------
+
+uint32 GPUBufferPool::FindOrCreatePool(BufferUsage usage) {
+    for (uint32 i = 0; i < pools_.size(); ++i) {
+        if (pools_[i].usage == usage) return i;
+    }
+
+    auto& core = GPUCore::GetInstance();
+    Pool pool;
+    pool.usage = usage;
+    pool.alignment = 16;
+    if (HasUsage(usage, BufferUsage::Uniform)) {
+        pool.alignment = std::max<uint64>(pool.alignment, core.GetMinUniformBufferOffsetAlignment());
+    }
+    if (HasUsage(usage, BufferUsage::Storage)) {
+        pool.alignment = std::max<uint64>(pool.alignment, core.GetMinStorageBufferOffsetAlignment());
+    }
+    pools_.push_back(std::move(pool));
+    return static_cast<uint32>(pools_.size() - 1);
+}
+
+uint32 GPUBufferPool::CreatePage(Pool& pool, uint64 capacity, bool dedicated) {
+    // Reuse the slot of a released page so slice page indices stay stable
+    uint32 index = 0;
+    while (index < pool.pages.size() && pool.pages[index].buffer) ++index;
+    if (index == pool.pages.size()) pool.pages.emplace_back();
+
+    std::string label = HasUsage(pool.usage, BufferUsage::Uniform) ? "pool_uniform" : "pool_storage";
+    WGPUBufferDescriptor desc = WGPU_BUFFER_DESCRIPTOR_INIT;
+    desc.label = {label.data(), label.size()};
+    desc.usage = static_cast<WGPUBufferUsage>(pool.usage);
+    desc.size = capacity;
+
+    Page& page = pool.pages[index];
+    page.buffer = wgpuDeviceCreateBuffer(GPUCore::GetInstance().GetDevice(), &desc);
+    if (!page.buffer) {
+        throw GPUException("Failed to create buffer pool page");
+    }
+    page.capacity = capacity;
+    page.allocated = 0;
+    page.dedicated = dedicated;
+    page.free_blocks.clear();
+    memory_.Set(GetPageBytes());
+    return index;
+}
+
+GPUBufferSlice GPUBufferPool::Allocate(BufferUsage usage, uint64 size) {
+    assert(HasUsage(usage, BufferUsage::Uniform | BufferUsage::Storage));
+    usage = usage | BufferUsage::CopyDst | BufferUsage::CopySrc;
+
+    uint32 pool_index = FindOrCreatePool(usage);
+    Pool& pool = pools_[pool_index];
+    uint64 reserved = AlignUp(std::max<uint64>(size, 4), pool.alignment);
+
+    // First fit over the shared pages; large requests get a page of their own
+    uint32 page_index = UINT32_MAX;
+    uint64 offset = 0;
+    bool dedicated = reserved > page_size_ / 4;
+    if (!dedicated) {
+        for (uint32 p = 0; p < pool.pages.size() && page_index == UINT32_MAX; ++p) {
+            Page& page = pool.pages[p];
+            if (!page.buffer || page.dedicated) continue;
+            for (auto it = page.free_blocks.begin(); it != page.free_blocks.end(); ++it) {
+                if (it->second < reserved) continue;
+                auto [block_offset, block_size] = *it;
+                page.free_blocks.erase(it);
+                if (block_size > reserved) {
+                    page.free_blocks.emplace(block_offset + reserved, block_size - reserved);
+                }
+                page_index = p;
+                offset = block_offset;
+                break;
+            }
+        }
+    }
+    if (page_index == UINT32_MAX) {
+        page_index = CreatePage(pool, dedicated ? reserved : AlignUp(page_size_, pool.alignment), dedicated);
+        Page& page = pool.pages[page_index];
+        if (page.capacity > reserved) {
+            page.free_blocks.emplace(reserved, page.capacity - reserved);
+        }
+        offset = 0;
+    }
+    pool.pages[page_index].allocated += reserved;
+
+    GPUBufferSlice slice;
+    slice.buffer_ = pool.pages[page_index].buffer;
+    slice.offset_ = offset;
+    slice.size_ = size;
+    slice.reserved_ = reserved;
+    slice.pool_ = pool_index;
+    slice.page_ = page_index;
+    return slice;
+}
+
+void GPUBufferPool::Free(const GPUBufferSlice& slice) {
+    // Slices that outlive Shutdown() (or their page) are ignored
+    if (slice.pool_ >= pools_.size()) return;
+    Pool& pool = pools_[slice.pool_];
+    if (slice.page_ >= pool.pages.size()) return;
+    Page& page = pool.pages[slice.page_];
+    if (page.buffer != slice.buffer_) return;
+
+    page.allocated -= slice.reserved_;
+    if (page.dedicated) {
+        wgpuBufferRelease(page.buffer);
+        page = Page{};
+        memory_.Set(GetPageBytes());
+        return;
+    }
+
+    // Insert and coalesce with both neighbours
+    uint64 offset = slice.offset_;
+    uint64 size = slice.reserved_;
+    auto next = page.free_blocks.lower_bound(offset);
+    if (next != page.free_blocks.end() && offset + size == next->first) {
+        size += next->second;
+        next = page.free_blocks.erase(next);
+    }
+    if (next != page.free_blocks.begin()) {
+        auto prev = std::prev(next);
+        if (prev->first + prev->second == offset) {
+            prev->second += size;
+            return;
+        }
+    }
+    page.free_blocks.emplace_hint(next, offset, size);
+}
+
+// -- Maintenance --------------------------------------------------------------
+
+uint64 GPUBufferPool::Trim() {
+    uint64 released = 0;
+    for (auto& pool : pools_) {
+        for (auto& page : pool.pages) {
+            if (page.buffer && page.allocated == 0) {
+                released += page.capacity;
+                wgpuBufferRelease(page.buffer);
+                page = Page{};
+            }
+        }
+    }
+    memory_.Set(GetPageBytes());
+    return released;
+}
+
+void GPUBufferPool::Shutdown() {
+    for (auto& pool : pools_) {
+        for (auto& page : pool.pages) {
+            if (page.buffer) wgpuBufferRelease(page.buffer);
+        }
+    }
+    pools_.clear();
+    memory_.Set(0);
+}
+
+uint64 GPUBufferPool::GetPageBytes() const {
+    uint64 total = 0;
+    for (const auto& pool : pools_) {
+        for (const auto& page : pool.pages) total += page.capacity;
+    }
+    return total;
+}
+
+uint64 GPUBufferPool::GetAllocatedBytes() const {
+    uint64 total = 0;
+    for (const auto& pool : pools_) {
+        for (const auto& page : pool.pages) total += page.allocated;
+    }
+    return total;
+}
+
+}  // namespace gpu
+}  // namespace mps
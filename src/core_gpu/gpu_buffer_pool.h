@@ -0,0 +1,128 @@
+#pragma once
+
+#include "core_gpu/bind_group_builder.h"
+#include "core_gpu/gpu_types.h"
+#include "core_util/memory_tracker.h"
+#include <map>
+#include <span>
+#include <vector>
+
+struct WGPUBufferImpl;  typedef WGPUBufferImpl* WGPUBuffer;
+
+namespace mps {
+namespace gpu {
+
+/// Range of a shared backing buffer handed out by GPUBufferPool.
+/// Move-only; the range returns to the pool when the slice is destroyed.
+class GPUBufferSlice {
+public:
+    GPUBufferSlice() = default;
+    ~GPUBufferSlice();
+
+    GPUBufferSlice(GPUBufferSlice&& other) noexcept;
+    GPUBufferSlice& operator=(GPUBufferSlice&& other) noexcept;
+    GPUBufferSlice(const GPUBufferSlice&) = delete;
+    GPUBufferSlice& operator=(const GPUBufferSlice&) = delete;
+
+    /// Write into the slice (byte_offset is relative to the slice) via wgpuQueueWriteBuffer
+    void WriteRawData(const void* data, uint64 size_bytes, uint64 byte_offset = 0);
+
+    template<typename T>
+    void WriteData(std::span<const T> data, uint64 element_offset = 0) {
+        WriteRawData(data.data(), data.size_bytes(), element_offset * sizeof(T));
+    }
+
+    /// Bind the whole slice, or `size` bytes at `offset` within it
+    BufferBinding GetBinding() const { return {buffer_, size_, offset_}; }
+    BufferBinding GetBinding(uint64 size, uint64 offset = 0) const { return {buffer_, size, offset_ + offset}; }
+
+    WGPUBuffer GetHandle() const { return buffer_; }
+    uint64 GetOffset() const { return offset_; }
+    uint64 GetSize() const { return size_; }
+    bool IsValid() const { return buffer_ != nullptr; }
+
+private:
+    friend class GPUBufferPool;
+
+    void Release();
+
+    WGPUBuffer buffer_ = nullptr;
+    uint64 offset_ = 0;
+    uint64 size_ = 0;
+    uint64 reserved_ = 0;   // size rounded up to the pool alignment
+    uint32 pool_ = 0;
+    uint32 page_ = 0;
+};
+
+/// Sub-allocator for small uniform and storage buffers (solver params, per-term
+/// configs, color ranges). Slices are carved out of large shared pages, one page
+/// list per usage, with offsets aligned to the device's minUniformBufferOffsetAlignment
+/// / minStorageBufferOffsetAlignment. Freed ranges are coalesced and reused, and
+/// empty pages are kept, so re-initialization after a topology change reuses the
+/// same backing buffers instead of creating hundreds of new ones.
+///
+/// Requests larger than a quarter page get a dedicated page, released with the slice.
+class GPUBufferPool {
+public:
+    static GPUBufferPool& GetInstance();
+
+    /// Backing page size for subsequently created pages. Default 256 KiB.
+    void SetPageSize(uint64 page_size) { page_size_ = page_size; }
+
+    /// Allocate `size` bytes. usage must include Uniform or Storage; CopyDst and CopySrc are
+    /// always added. Slices with the same usage share pages. Contents are undefined.
+    GPUBufferSlice Allocate(BufferUsage usage, uint64 size);
+
+    /// Allocate and upload initial data
+    template<typename T>
+    GPUBufferSlice Allocate(BufferUsage usage, std::span<const T> data) {
+        GPUBufferSlice slice = Allocate(usage, data.size_bytes());
+        slice.WriteData(data);
+        return slice;
+    }
+
+    /// Release pages with no live slices; returns the bytes released
+    uint64 Trim();
+
+    /// Release all pages. Outstanding slices become dangling and are ignored when freed.
+    void Shutdown();
+
+    uint64 GetPageBytes() const;
+    uint64 GetAllocatedBytes() const;
+
+private:
+    GPUBufferPool() = default;
+    ~GPUBufferPool();
+
+    GPUBufferPool(const GPUBufferPool&) = delete;
+    GPUBufferPool& operator=(const GPUBufferPool&) = delete;
+
+    friend class GPUBufferSlice;
+
+    struct Page {
+        WGPUBuffer buffer = nullptr;
+        uint64 capacity = 0;
+        uint64 allocated = 0;
+        bool dedicated = false;
+        std::map<uint64, uint64> free_blocks;   // offset -> size, coalesced
+    };
+
+    struct Pool {
+        BufferUsage usage = BufferUsage::None;
+        uint64 alignment = 256;
+        std::vector<Page> pages;
+    };
+
+    uint32 FindOrCreatePool(BufferUsage usage);
+    uint32 CreatePage(Pool& pool, uint64 capacity, bool dedicated);
+    void Free(const GPUBufferSlice& slice);
+
+    std::vector<Pool> pools_;
+    uint64 page_size_ = 256ull << 10;
+
+    // Page bytes, reported to MemoryTracker as (GPU, "gpu", "buffer_pool")
+    util::MemoryAccount memory_{util::MemoryDomain::GPU, "buffer_pool", "gpu"};
+};
+
+}  // namespace gpu
+}  // namespace mps
@@ -1,6 +1,7 @@
 #include "core_gpu/gpu_core.h"
 #include "core_util/logger.h"
 #include <webgpu/webgpu.h>
+#include <algorithm>
 
 using namespace mps::util;
 
@@ -26,6 +27,19 @@ const char* BackendTypeToString(WGPUBackendType type) {
     }
 }
 
+// Create a surface from a platform surface-source struct (unused on platforms without one)
+[[maybe_unused]] WGPUSurface CreateSurfaceFromSource(WGPUInstance instance, WGPUChainedStruct* source) {
+    WGPUSurfaceDescriptor desc = {};
+    desc.nextInChain = source;
+    WGPUSurface surface = wgpuInstanceCreateSurface(instance, &desc);
+    if (!surface) {
+        LogError("Failed to create WebGPU surface");
+        return nullptr;
+    }
+    LogInfo("WebGPU surface created successfully");
+    return surface;
+}
+
 }  // namespace
 
 namespace mps {
@@ -158,6 +172,41 @@ std::string GPUCore::GetBackendType() const {
     return backend;
 }
 
+bool GPUCore::SupportsTimestampQuery() const {
+    if (!device_) return false;
+    return wgpuDeviceHasFeature(device_, WGPUFeatureName_TimestampQuery);
+}
+
+bool GPUCore::SupportsSubgroups() const {
+    if (!device_) return false;
+    return wgpuDeviceHasFeature(device_, WGPUFeatureName_Subgroups);
+}
+
+bool GPUCore::UsesSinglePassReductions() const {
+    return config_.single_pass_reductions;
+}
+
+uint32 GPUCore::GetMinStorageBufferOffsetAlignment() const {
+    if (!device_) return 256;
+    WGPULimits limits = WGPU_LIMITS_INIT;
+    wgpuDeviceGetLimits(device_, &limits);
+    return limits.minStorageBufferOffsetAlignment;
+}
+
+uint32 GPUCore::GetMinUniformBufferOffsetAlignment() const {
+    if (!device_) return 256;
+    WGPULimits limits = WGPU_LIMITS_INIT;
+    wgpuDeviceGetLimits(device_, &limits);
+    return limits.minUniformBufferOffsetAlignment;
+}
+
+uint32 GPUCore::GetMaxComputeWorkgroupSize() const {
+    if (!device_) return 256;
+    WGPULimits limits = WGPU_LIMITS_INIT;
+    wgpuDeviceGetLimits(device_, &limits);
+    return std::min(limits.maxComputeInvocationsPerWorkgroup, limits.maxComputeWorkgroupSizeX);
+}
+
 // -- Events -------------------------------------------------------------------
 
 void GPUCore::ProcessEvents() {
@@ -177,32 +226,26 @@ WGPUSurface GPUCore::CreateSurface(void* native_window, void* native_display) {
         }
     }
 
-#ifdef __EMSCRIPTEN__
+#if defined(__EMSCRIPTEN__)
+    (void)native_window;
+    (void)native_display;
     WGPUEmscriptenSurfaceSourceCanvasHTMLSelector canvasDesc = {};
     canvasDesc.chain.sType = WGPUSType_EmscriptenSurfaceSourceCanvasHTMLSelector;
     canvasDesc.selector = {"#canvas", 7};
-
-    WGPUSurfaceDescriptor surfaceDesc = {};
-    surfaceDesc.nextInChain = reinterpret_cast<WGPUChainedStruct*>(&canvasDesc);
+    return CreateSurfaceFromSource(instance_, reinterpret_cast<WGPUChainedStruct*>(&canvasDesc));
 #elif defined(_WIN32)
     WGPUSurfaceSourceWindowsHWND surfaceSource = {};
     surfaceSource.chain.sType = WGPUSType_SurfaceSourceWindowsHWND;
     surfaceSource.hinstance = native_display;
     surfaceSource.hwnd = native_window;
-
-    WGPUSurfaceDescriptor surfaceDesc = {};
-    surfaceDesc.nextInChain = reinterpret_cast<WGPUChainedStruct*>(&surfaceSource);
+    return CreateSurfaceFromSource(instance_, reinterpret_cast<WGPUChainedStruct*>(&surfaceSource));
 #else
-    #error "Unsupported platform for surface creation"
+    // No native surface source on this platform (e.g. headless servers)
+    (void)native_window;
+    (void)native_display;
+    LogError("Surface creation is not supported on this platform");
+    return nullptr;
 #endif
-
-    WGPUSurface surface = wgpuInstanceCreateSurface(instance_, &surfaceDesc);
-    if (!surface) {
-        LogError("Failed to create WebGPU surface");
-        return nullptr;
-    }
-    LogInfo("WebGPU surface created successfully");
-    return surface;
 }
 
 // -- Internal -----------------------------------------------------------------
@@ -275,6 +318,22 @@ bool GPUCore::RequestDevice() {
     wgpuAdapterGetLimits(adapter_, &adapter_limits);
     desc.requiredLimits = &adapter_limits;
 
+    // Optional features, never required:
+    //   TimestampQuery backs the per-pass GPU profiler
+    //   Subgroups enables the subgroupAdd reduction kernels
+    WGPUFeatureName features[2] = {};
+    uint32 feature_count = 0;
+    if (config_.request_timestamp_query &&
+        wgpuAdapterHasFeature(adapter_, WGPUFeatureName_TimestampQuery)) {
+        features[feature_count++] = WGPUFeatureName_TimestampQuery;
+    }
+    if (config_.request_subgroups &&
+        wgpuAdapterHasFeature(adapter_, WGPUFeatureName_Subgroups)) {
+        features[feature_count++] = WGPUFeatureName_Subgroups;
+    }
+    desc.requiredFeatureCount = feature_count;
+    desc.requiredFeatures = feature_count > 0 ? features : nullptr;
+
     WGPURequestDeviceCallbackInfo cb = WGPU_REQUEST_DEVICE_CALLBACK_INFO_INIT;
 #ifdef __EMSCRIPTEN__
     cb.mode = WGPUCallbackMode_AllowProcessEvents;
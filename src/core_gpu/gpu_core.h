@@ -16,6 +16,13 @@ namespace gpu {
 struct GPUConfig {
     bool enable_validation = true;        // Dawn validation (native only)
     bool prefer_high_performance = true;  // WGPUPowerPreference_HighPerformance
+    bool request_timestamp_query = true;  // Enable TimestampQuery if the adapter has it
+    bool request_subgroups = true;        // Enable Subgroups (WGSL subgroupAdd etc.) if available
+    // Finish global reductions in one dispatch (the last workgroup sums all partials).
+    // WGSL gives no cross-workgroup release/acquire ordering, so this assumes the
+    // adapter makes storage atomics from finished workgroups visible to the last
+    // one (true on current D3D12/Metal/Vulkan drivers). false = two dispatches.
+    bool single_pass_reductions = true;
 };
 
 enum class GPUState : uint8 {
@@ -49,6 +56,12 @@ public:
     // Info
     std::string GetAdapterName() const;
     std::string GetBackendType() const;
+    bool SupportsTimestampQuery() const;
+    bool SupportsSubgroups() const;
+    bool UsesSinglePassReductions() const;   // GPUConfig::single_pass_reductions
+    uint32 GetMinStorageBufferOffsetAlignment() const;
+    uint32 GetMinUniformBufferOffsetAlignment() const;
+    uint32 GetMaxComputeWorkgroupSize() const;   // 1D: min(invocations per workgroup, size x)
 
     // Process async events (call in main loop, required for WASM init)
     void ProcessEvents();
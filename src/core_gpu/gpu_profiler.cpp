@@ -0,0 +1,288 @@
+#include "core_gpu/gpu_profiler.h"
+#include "core_gpu/gpu_core.h"
+#include "core_util/logger.h"
+#include <webgpu/webgpu.h>
+#include <algorithm>
+#include <cstdio>
+
+using namespace mps::util;
+
+namespace mps {
+namespace gpu {
+
+namespace {
+
+// WebGPU caps a query set at 4096 queries; two per pass.
+constexpr uint32 kMaxQueriesPerSet = 4096;
+// Weight of the newest frame in the rolling averages.
+constexpr float64 kAverageWeight = 0.05;
+
+}  // namespace
+
+// -- Callbacks ----------------------------------------------------------------
+
+struct GPUProfiler::Callbacks {
+    static void OnReadbackMapped(WGPUMapAsyncStatus status, WGPUStringView /*message*/,
+                                 void* userdata1, void* userdata2) {
+        auto* profiler = static_cast<GPUProfiler*>(userdata1);
+        auto index = static_cast<uint32>(reinterpret_cast<uintptr_t>(userdata2));
+
+        // Slots are gone after Shutdown(); late callbacks are ignored
+        if (index >= profiler->slots_.size()) return;
+        ReadbackSlot& slot = profiler->slots_[index];
+        if (!slot.pending) return;
+
+        if (status == WGPUMapAsyncStatus_Success) {
+            uint64 bytes = uint64(slot.pass_labels.size()) * 2 * sizeof(uint64);
+            const void* mapped = wgpuBufferGetConstMappedRange(
+                slot.buffer, 0, static_cast<size_t>(bytes));
+            if (mapped) {
+                profiler->Accumulate(slot, static_cast<const uint64*>(mapped));
+            }
+            wgpuBufferUnmap(slot.buffer);
+        }
+        slot.pending = false;
+    }
+};
+
+// -- Singleton ----------------------------------------------------------------
+
+GPUProfiler& GPUProfiler::GetInstance() {
+    static GPUProfiler instance;
+    return instance;
+}
+
+GPUProfiler::GPUProfiler() = default;
+
+GPUProfiler::~GPUProfiler() {
+    Shutdown();
+}
+
+// -- Lifecycle ----------------------------------------------------------------
+
+bool GPUProfiler::Initialize(uint32 max_passes_per_frame, uint32 ring_size) {
+    if (enabled_) return true;
+
+    auto& core = GPUCore::GetInstance();
+    if (!core.IsInitialized() || !core.SupportsTimestampQuery()) {
+        LogWarning("GPUProfiler: TimestampQuery unavailable, pass timings disabled");
+        return false;
+    }
+
+    WGPUDevice device = core.GetDevice();
+    max_passes_ = std::clamp(max_passes_per_frame, 1u, kMaxQueriesPerSet / 2);
+    uint32 query_count = max_passes_ * 2;
+    uint64 resolve_bytes = uint64(query_count) * sizeof(uint64);
+
+    WGPUQuerySetDescriptor qs_desc = WGPU_QUERY_SET_DESCRIPTOR_INIT;
+    qs_desc.label = {"GPUProfiler", WGPU_STRLEN};
+    qs_desc.type = WGPUQueryType_Timestamp;
+    qs_desc.count = query_count;
+    query_set_ = wgpuDeviceCreateQuerySet(device, &qs_desc);
+
+    WGPUBufferDescriptor resolve_desc = WGPU_BUFFER_DESCRIPTOR_INIT;
+    resolve_desc.label = {"GPUProfiler resolve", WGPU_STRLEN};
+    resolve_desc.usage = WGPUBufferUsage_QueryResolve | WGPUBufferUsage_CopySrc;
+    resolve_desc.size = resolve_bytes;
+    resolve_buffer_ = wgpuDeviceCreateBuffer(device, &resolve_desc);
+
+    if (!query_set_ || !resolve_buffer_) {
+        LogError("GPUProfiler: failed to create query resources");
+        Shutdown();
+        return false;
+    }
+
+    slots_.resize(std::max(ring_size, 1u));
+    for (auto& slot : slots_) {
+        WGPUBufferDescriptor rb_desc = WGPU_BUFFER_DESCRIPTOR_INIT;
+        rb_desc.label = {"GPUProfiler readback", WGPU_STRLEN};
+        rb_desc.usage = WGPUBufferUsage_MapRead | WGPUBufferUsage_CopyDst;
+        rb_desc.size = resolve_bytes;
+        slot.buffer = wgpuDeviceCreateBuffer(device, &rb_desc);
+        slot.pass_labels.reserve(max_passes_);
+    }
+
+    // One writes struct per pass, sized once so returned pointers stay stable
+    pass_writes_.assign(max_passes_, WGPUPassTimestampWrites{});
+    for (uint32 i = 0; i < max_passes_; ++i) {
+        pass_writes_[i].querySet = query_set_;
+        pass_writes_[i].beginningOfPassWriteIndex = i * 2;
+        pass_writes_[i].endOfPassWriteIndex = i * 2 + 1;
+    }
+    frame_labels_.assign(max_passes_, 0);
+    pass_count_ = 0;
+    memory_.Set(resolve_bytes * (1 + slots_.size()));
+
+    enabled_ = true;
+    LogInfo("GPUProfiler initialized (", max_passes_, " passes/frame, ",
+            slots_.size(), " readback slots)");
+    return true;
+}
+
+void GPUProfiler::Shutdown() {
+    enabled_ = false;
+    for (auto& slot : slots_) {
+        if (slot.buffer) wgpuBufferRelease(slot.buffer);
+    }
+    slots_.clear();
+    if (resolve_buffer_) { wgpuBufferRelease(resolve_buffer_); resolve_buffer_ = nullptr; }
+    if (query_set_)      { wgpuQuerySetRelease(query_set_);    query_set_ = nullptr; }
+    pass_writes_.clear();
+    frame_labels_.clear();
+    pass_count_ = 0;
+    memory_.Set(0);
+}
+
+// -- Recording ----------------------------------------------------------------
+
+uint32 GPUProfiler::GetLabelIndex(const std::string& label) {
+    auto it = label_lookup_.find(label);
+    if (it != label_lookup_.end()) return it->second;
+
+    uint32 index = static_cast<uint32>(labels_.size());
+    labels_.push_back(label);
+    stats_.emplace_back();
+    label_lookup_.emplace(label, index);
+    return index;
+}
+
+void GPUProfiler::RegisterPipeline(WGPUComputePipeline pipeline, const std::string& label) {
+    if (!pipeline) return;
+    pipeline_labels_[pipeline] = GetLabelIndex(label);
+}
+
+void GPUProfiler::UnregisterPipeline(WGPUComputePipeline pipeline) {
+    pipeline_labels_.erase(pipeline);
+}
+
+const WGPUPassTimestampWrites* GPUProfiler::AllocatePass(WGPUComputePipeline pipeline) {
+    if (!enabled_) return nullptr;
+    auto it = pipeline_labels_.find(pipeline);
+    uint32 label = (it != pipeline_labels_.end()) ? it->second : GetLabelIndex("(unlabeled)");
+    return AllocateLabeledPass(label);
+}
+
+const WGPUPassTimestampWrites* GPUProfiler::AllocatePass(const std::string& label) {
+    if (!enabled_) return nullptr;
+    return AllocateLabeledPass(GetLabelIndex(label));
+}
+
+const WGPUPassTimestampWrites* GPUProfiler::AllocateLabeledPass(uint32 label) {
+    if (pass_count_ >= max_passes_) {
+        ++dropped_passes_;
+        return nullptr;
+    }
+
+    uint32 index = pass_count_++;
+    frame_labels_[index] = label;
+    return &pass_writes_[index];
+}
+
+void GPUProfiler::EndFrame() {
+    if (!enabled_) return;
+
+    auto& core = GPUCore::GetInstance();
+    // Deliver map callbacks of earlier frames before looking for a free slot
+    core.ProcessEvents();
+
+    uint32 pass_count = pass_count_;
+    pass_count_ = 0;
+    if (pass_count == 0) return;
+
+    auto free_it = std::find_if(slots_.begin(), slots_.end(),
+                                [](const ReadbackSlot& s) { return !s.pending; });
+    if (free_it == slots_.end()) {
+        ++dropped_frames_;
+        return;
+    }
+    uint32 slot_index = static_cast<uint32>(free_it - slots_.begin());
+    ReadbackSlot& slot = *free_it;
+
+    uint64 bytes = uint64(pass_count) * 2 * sizeof(uint64);
+    WGPUCommandEncoderDescriptor enc_desc = WGPU_COMMAND_ENCODER_DESCRIPTOR_INIT;
+    WGPUCommandEncoder encoder = wgpuDeviceCreateCommandEncoder(core.GetDevice(), &enc_desc);
+    wgpuCommandEncoderResolveQuerySet(encoder, query_set_, 0, pass_count * 2, resolve_buffer_, 0);
+    wgpuCommandEncoderCopyBufferToBuffer(encoder, resolve_buffer_, 0, slot.buffer, 0, bytes);
+    WGPUCommandBuffer cmd = wgpuCommandEncoderFinish(encoder, nullptr);
+    wgpuQueueSubmit(core.GetQueue(), 1, &cmd);
+    wgpuCommandBufferRelease(cmd);
+    wgpuCommandEncoderRelease(encoder);
+
+    slot.pass_labels.assign(frame_labels_.begin(), frame_labels_.begin() + pass_count);
+    slot.pending = true;
+
+    WGPUBufferMapCallbackInfo map_cb = WGPU_BUFFER_MAP_CALLBACK_INFO_INIT;
+    map_cb.mode = WGPUCallbackMode_AllowProcessEvents;
+    map_cb.callback = Callbacks::OnReadbackMapped;
+    map_cb.userdata1 = this;
+    map_cb.userdata2 = reinterpret_cast<void*>(static_cast<uintptr_t>(slot_index));
+    wgpuBufferMapAsync(slot.buffer, WGPUMapMode_Read, 0, static_cast<size_t>(bytes), map_cb);
+}
+
+void GPUProfiler::Accumulate(const ReadbackSlot& slot, const uint64* timestamps) {
+    std::vector<float64> frame_ms(labels_.size(), 0.0);
+    std::vector<uint32> frame_passes(labels_.size(), 0);
+
+    float64 total_ms = 0.0;
+    for (size_t i = 0; i < slot.pass_labels.size(); ++i) {
+        uint64 begin = timestamps[i * 2];
+        uint64 end = timestamps[i * 2 + 1];
+        // Timestamps are in nanoseconds; reordered or reset pairs count as zero
+        float64 ms = (end > begin) ? float64(end - begin) * 1e-6 : 0.0;
+        frame_ms[slot.pass_labels[i]] += ms;
+        frame_passes[slot.pass_labels[i]] += 1;
+        total_ms += ms;
+    }
+
+    for (size_t l = 0; l < labels_.size(); ++l) {
+        LabelStats& s = stats_[l];
+        if (s.samples == 0 && frame_passes[l] == 0) continue;
+        if (s.samples == 0) {
+            s.avg_ms = frame_ms[l];
+            s.avg_passes = frame_passes[l];
+        } else {
+            s.avg_ms += (frame_ms[l] - s.avg_ms) * kAverageWeight;
+            s.avg_passes += (float64(frame_passes[l]) - s.avg_passes) * kAverageWeight;
+        }
+        ++s.samples;
+    }
+    frame_ms_ = (frame_ms_ == 0.0) ? total_ms : frame_ms_ + (total_ms - frame_ms_) * kAverageWeight;
+}
+
+// -- Reporting ----------------------------------------------------------------
+
+std::vector<PassTiming> GPUProfiler::GetPassTimings() const {
+    std::vector<PassTiming> result;
+    for (size_t l = 0; l < labels_.size(); ++l) {
+        if (stats_[l].samples == 0) continue;
+        result.push_back({labels_[l], stats_[l].avg_ms, stats_[l].avg_passes, stats_[l].samples});
+    }
+    std::sort(result.begin(), result.end(),
+              [](const PassTiming& a, const PassTiming& b) { return a.avg_ms > b.avg_ms; });
+    return result;
+}
+
+void GPUProfiler::LogReport(uint32 max_entries) const {
+    if (!enabled_) return;
+
+    auto timings = GetPassTimings();
+    if (timings.empty()) return;
+
+    LogInfo("GPU frame: ", frame_ms_, " ms across ", timings.size(), " pipelines",
+            dropped_frames_ ? " (dropped frames: " + std::to_string(dropped_frames_) + ")" : "");
+    uint32 count = std::min<uint32>(max_entries, static_cast<uint32>(timings.size()));
+    for (uint32 i = 0; i < count; ++i) {
+        const auto& t = timings[i];
+        char line[160];
+        std::snprintf(line, sizeof(line), "  %-32s %8.3f ms  %7.1f passes  %5.1f%%",
+                      t.label.c_str(), t.avg_ms, t.avg_passes,
+                      frame_ms_ > 0.0 ? 100.0 * t.avg_ms / frame_ms_ : 0.0);
+        LogInfo(line);
+    }
+    if (dropped_passes_ > 0) {
+        LogWarning("GPUProfiler: ", dropped_passes_, " passes exceeded the per-frame query budget");
+    }
+}
+
+}  // namespace gpu
+}  // namespace mps
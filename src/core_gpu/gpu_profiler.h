@@ -0,0 +1,119 @@
+#pragma once
+
+#include "core_util/memory_tracker.h"
+#include "core_util/types.h"
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+struct WGPUComputePipelineImpl;  typedef WGPUComputePipelineImpl* WGPUComputePipeline;
+struct WGPUQuerySetImpl;         typedef WGPUQuerySetImpl*        WGPUQuerySet;
+struct WGPUBufferImpl;           typedef WGPUBufferImpl*          WGPUBuffer;
+struct WGPUPassTimestampWrites;
+
+namespace mps {
+namespace gpu {
+
+/// Rolling GPU timing of one pipeline label, averaged over resolved frames.
+struct PassTiming {
+    std::string label;
+    float64 avg_ms = 0.0;          // GPU time spent in passes with this label per frame
+    float64 avg_passes = 0.0;      // Compute passes with this label per frame
+    uint64 samples = 0;            // Frames that contributed to the average
+};
+
+/// Per-pass GPU timestamp profiler.
+///
+/// Compute pass sites ask for timestampWrites via AllocatePass(); each pass gets a
+/// begin/end query pair and is attributed to the label its pipeline was registered with.
+/// EndFrame() resolves the queries into a ring of MapRead buffers and maps them
+/// asynchronously, so results arrive a few frames late and the CPU never waits on the GPU.
+/// A frame is dropped (not stalled on) when every ring slot is still in flight.
+///
+/// Inactive unless Initialize() succeeded, which requires the TimestampQuery feature.
+class GPUProfiler {
+public:
+    static GPUProfiler& GetInstance();
+
+    bool Initialize(uint32 max_passes_per_frame = 2048, uint32 ring_size = 3);
+    void Shutdown();
+    bool IsEnabled() const { return enabled_; }
+
+    /// Associate a pipeline with a report label. Safe to call before Initialize().
+    /// The owner must call UnregisterPipeline() before releasing the pipeline, or a
+    /// later pipeline reusing the address would inherit the label.
+    void RegisterPipeline(WGPUComputePipeline pipeline, const std::string& label);
+    void UnregisterPipeline(WGPUComputePipeline pipeline);
+
+    /// Timestamp writes for the next compute pass, or nullptr when profiling is off
+    /// or the frame's query budget is exhausted. Valid until the next AllocatePass().
+    const WGPUPassTimestampWrites* AllocatePass(WGPUComputePipeline pipeline);
+    /// Same, attributed to an explicit label (batched passes spanning several pipelines).
+    const WGPUPassTimestampWrites* AllocatePass(const std::string& label);
+
+    /// When set, ComputePassRecorder ends its pass after every dispatch so each kernel
+    /// gets its own timestamp pair (per-pipeline attribution at the cost of batching).
+    void SetPerDispatchTiming(bool enabled) { per_dispatch_timing_ = enabled; }
+    bool IsPerDispatchTiming() const { return enabled_ && per_dispatch_timing_; }
+
+    /// Resolve this frame's queries and start their readback. Call once per frame
+    /// after the last submit.
+    void EndFrame();
+
+    /// Averages sorted by GPU time, most expensive first.
+    std::vector<PassTiming> GetPassTimings() const;
+    float64 GetFrameTimeMs() const { return frame_ms_; }
+    void LogReport(uint32 max_entries = 16) const;
+
+private:
+    GPUProfiler();
+    ~GPUProfiler();
+
+    GPUProfiler(const GPUProfiler&) = delete;
+    GPUProfiler& operator=(const GPUProfiler&) = delete;
+
+    struct ReadbackSlot {
+        WGPUBuffer buffer = nullptr;
+        std::vector<uint32> pass_labels;
+        bool pending = false;
+    };
+
+    struct LabelStats {
+        float64 avg_ms = 0.0;
+        float64 avg_passes = 0.0;
+        uint64 samples = 0;
+    };
+
+    struct Callbacks;
+    friend struct Callbacks;
+
+    uint32 GetLabelIndex(const std::string& label);
+    const WGPUPassTimestampWrites* AllocateLabeledPass(uint32 label);
+    void Accumulate(const ReadbackSlot& slot, const uint64* timestamps);
+
+    bool enabled_ = false;
+    bool per_dispatch_timing_ = false;
+    uint32 max_passes_ = 0;
+
+    WGPUQuerySet query_set_ = nullptr;
+    WGPUBuffer resolve_buffer_ = nullptr;
+    std::vector<ReadbackSlot> slots_;
+
+    std::vector<WGPUPassTimestampWrites> pass_writes_;
+    std::vector<uint32> frame_labels_;
+    uint32 pass_count_ = 0;
+    uint64 dropped_passes_ = 0;
+    uint64 dropped_frames_ = 0;
+
+    std::unordered_map<WGPUComputePipeline, uint32> pipeline_labels_;   // live pipelines only
+    std::unordered_map<std::string, uint32> label_lookup_;
+    std::vector<std::string> labels_;
+    std::vector<LabelStats> stats_;
+    float64 frame_ms_ = 0.0;
+
+    // Resolve and readback bytes, reported to MemoryTracker as (GPU, "gpu", "profiler")
+    util::MemoryAccount memory_{util::MemoryDomain::GPU, "profiler", "gpu"};
+};
+
+}  // namespace gpu
+}  // namespace mps
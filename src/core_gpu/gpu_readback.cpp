@@ -0,0 +1,261 @@
+#include "core_gpu/gpu_readback.h"
+#include "core_gpu/gpu_core.h"
+#include "core_gpu/gpu_types.h"
+#include "core_util/logger.h"
+#include <webgpu/webgpu.h>
+#include <cassert>
+
+using namespace mps::util;
+
+namespace mps {
+namespace gpu {
+
+// -- Callbacks ----------------------------------------------------------------
+
+struct GPUReadback::Callbacks {
+    static void OnMapped(WGPUMapAsyncStatus status, WGPUStringView /*message*/,
+                         void* userdata1, void* userdata2) {
+        auto* readback = static_cast<GPUReadback*>(userdata1);
+        auto index = static_cast<uint32>(reinterpret_cast<uintptr_t>(userdata2));
+
+        // Slots are gone after Shutdown(); late callbacks are ignored
+        if (index >= readback->slots_.size()) return;
+        if (readback->slots_[index].state != SlotState::Mapping) return;
+
+        // The slot stays Mapping while the user callback runs (it may issue new
+        // requests and reallocate slots_), so only locals are used until it returns.
+        WGPUBuffer buffer = readback->slots_[index].buffer;
+        uint64 size = readback->slots_[index].size;
+        Callback callback = std::move(readback->slots_[index].callback);
+
+        if (status == WGPUMapAsyncStatus_Success) {
+            const void* mapped = wgpuBufferGetConstMappedRange(buffer, 0, static_cast<size_t>(size));
+            if (callback) {
+                callback(mapped ? std::span<const uint8>(static_cast<const uint8*>(mapped),
+                                                         static_cast<size_t>(size))
+                                : std::span<const uint8>());
+            }
+            wgpuBufferUnmap(buffer);
+        } else if (callback) {
+            callback({});
+        }
+
+        if (index < readback->slots_.size()) {
+            readback->slots_[index].state = SlotState::Free;
+        }
+    }
+};
+
+// -- Singleton ----------------------------------------------------------------
+
+GPUReadback& GPUReadback::GetInstance() {
+    static GPUReadback instance;
+    return instance;
+}
+
+GPUReadback::~GPUReadback() {
+    Shutdown();
+}
+
+// -- Requests -----------------------------------------------------------------
+
+uint32 GPUReadback::AcquireSlot(uint64 size) {
+    // Best fit among free slots that are already large enough
+    uint32 best = UINT32_MAX;
+    uint32 any_free = UINT32_MAX;
+    for (uint32 i = 0; i < slots_.size(); ++i) {
+        const Slot& slot = slots_[i];
+        if (slot.state != SlotState::Free) continue;
+        if (any_free == UINT32_MAX) any_free = i;
+        if (slot.capacity >= size && (best == UINT32_MAX || slot.capacity < slots_[best].capacity)) {
+            best = i;
+        }
+    }
+
+    if (best == UINT32_MAX) {
+        uint32 index = any_free;
+        if (index == UINT32_MAX && slots_.size() >= max_slots_) {
+            // Pool exhausted: wait for the oldest mapping to be delivered
+            for (uint32 i = 0; i < slots_.size(); ++i) {
+                if (slots_[i].state == SlotState::Mapping) {
+                    WaitForSlot(i);
+                    return AcquireSlot(size);
+                }
+            }
+            // Nothing can complete before the next Flush(); grow past the cap instead
+            LogWarning("GPUReadback: ", slots_.size(), " requests pending in one frame, growing pool");
+        }
+        if (index == UINT32_MAX) {
+            index = static_cast<uint32>(slots_.size());
+            slots_.emplace_back();
+        }
+
+        // (Re)create the staging buffer at the requested size
+        Slot& slot = slots_[index];
+        if (slot.buffer) wgpuBufferRelease(slot.buffer);
+        WGPUBufferDescriptor desc = WGPU_BUFFER_DESCRIPTOR_INIT;
+        desc.label = {"readback_staging", WGPU_STRLEN};
+        desc.usage = WGPUBufferUsage_MapRead | WGPUBufferUsage_CopyDst;
+        desc.size = size;
+        slot.buffer = wgpuDeviceCreateBuffer(GPUCore::GetInstance().GetDevice(), &desc);
+        if (!slot.buffer) {
+            throw GPUException("Failed to create readback staging buffer");
+        }
+        slot.capacity = size;
+        memory_.Set(GetSlotBytes());
+        best = index;
+    }
+
+    slots_[best].size = size;
+    return best;
+}
+
+void GPUReadback::Request(WGPUBuffer src, uint64 offset, uint64 size, Callback callback) {
+    assert(src && size > 0 && size % 4 == 0 && offset % 4 == 0);
+    uint32 index = AcquireSlot(size);
+    Slot& slot = slots_[index];
+    wgpuBufferAddRef(src);   // the caller may release src before SubmitQueued() encodes the copy
+    slot.src = src;
+    slot.src_offset = offset;
+    slot.callback = std::move(callback);
+    slot.state = SlotState::Queued;
+}
+
+void GPUReadback::Request(WGPUCommandEncoder encoder, WGPUBuffer src, uint64 offset, uint64 size,
+                          Callback callback) {
+    assert(encoder && src && size > 0 && size % 4 == 0 && offset % 4 == 0);
+    uint32 index = AcquireSlot(size);
+    Slot& slot = slots_[index];
+    wgpuCommandEncoderCopyBufferToBuffer(encoder, src, offset, slot.buffer, 0, size);
+    slot.src = nullptr;
+    slot.callback = std::move(callback);
+    slot.state = SlotState::Recorded;
+}
+
+void GPUReadback::Flush() {
+    SubmitQueued();
+
+    // Start mapping everything copied this frame
+    for (uint32 i = 0; i < slots_.size(); ++i) {
+        if (slots_[i].state == SlotState::Recorded) StartMap(i);
+    }
+}
+
+// Encode all queued copies into one submit; the slots become Recorded
+void GPUReadback::SubmitQueued() {
+    auto& core = GPUCore::GetInstance();
+
+    WGPUCommandEncoder encoder = nullptr;
+    for (auto& slot : slots_) {
+        if (slot.state != SlotState::Queued) continue;
+        if (!encoder) {
+            WGPUCommandEncoderDescriptor enc_desc = WGPU_COMMAND_ENCODER_DESCRIPTOR_INIT;
+            enc_desc.label = {"readback_copies", WGPU_STRLEN};
+            encoder = wgpuDeviceCreateCommandEncoder(core.GetDevice(), &enc_desc);
+        }
+        wgpuCommandEncoderCopyBufferToBuffer(encoder, slot.src, slot.src_offset,
+                                              slot.buffer, 0, slot.size);
+        wgpuBufferRelease(slot.src);
+        slot.src = nullptr;
+        slot.state = SlotState::Recorded;
+    }
+    if (encoder) {
+        WGPUCommandBuffer cmd = wgpuCommandEncoderFinish(encoder, nullptr);
+        wgpuQueueSubmit(core.GetQueue(), 1, &cmd);
+        wgpuCommandBufferRelease(cmd);
+        wgpuCommandEncoderRelease(encoder);
+    }
+}
+
+void GPUReadback::StartMap(uint32 index) {
+    Slot& slot = slots_[index];
+    slot.state = SlotState::Mapping;
+
+    WGPUBufferMapCallbackInfo map_cb = WGPU_BUFFER_MAP_CALLBACK_INFO_INIT;
+    map_cb.mode = WGPUCallbackMode_AllowProcessEvents;
+    map_cb.callback = Callbacks::OnMapped;
+    map_cb.userdata1 = this;
+    map_cb.userdata2 = reinterpret_cast<void*>(static_cast<uintptr_t>(index));
+    WGPUFuture future = wgpuBufferMapAsync(slot.buffer, WGPUMapMode_Read, 0,
+                                           static_cast<size_t>(slot.size), map_cb);
+    slot.future_id = future.id;
+}
+
+std::vector<uint8> GPUReadback::Read(WGPUBuffer src, uint64 offset, uint64 size) {
+    assert(src && size > 0 && size % 4 == 0 && offset % 4 == 0);
+    std::vector<uint8> result;
+    bool success = false;
+
+    uint32 index = AcquireSlot(size);
+    Slot& slot = slots_[index];
+    wgpuBufferAddRef(src);   // released by SubmitQueued() like a queued Request()
+    slot.src = src;
+    slot.src_offset = offset;
+    slot.callback = [&result, &success](std::span<const uint8> data) {
+        result.assign(data.begin(), data.end());
+        success = !data.empty();
+    };
+    slot.state = SlotState::Queued;
+
+    SubmitQueued();
+    StartMap(index);
+    WaitForSlot(index);
+
+    if (!success) {
+        throw GPUException("Failed to map staging buffer for readback");
+    }
+    return result;
+}
+
+// -- Waiting ------------------------------------------------------------------
+
+void GPUReadback::WaitForSlot(uint32 index) {
+    auto& core = GPUCore::GetInstance();
+#ifndef __EMSCRIPTEN__
+    // AllowProcessEvents callbacks may also fire from WaitAny, which blocks
+    // instead of spinning
+    if (index < slots_.size() && slots_[index].state == SlotState::Mapping) {
+        WGPUFutureWaitInfo wait = WGPU_FUTURE_WAIT_INFO_INIT;
+        wait.future.id = slots_[index].future_id;
+        wgpuInstanceWaitAny(core.GetWGPUInstance(), 1, &wait, UINT64_MAX);
+    }
+#endif
+    while (index < slots_.size() && slots_[index].state == SlotState::Mapping) {
+        core.ProcessEvents();
+    }
+}
+
+void GPUReadback::WaitIdle() {
+    Flush();
+    for (uint32 i = 0; i < slots_.size(); ++i) {
+        WaitForSlot(i);
+    }
+}
+
+uint32 GPUReadback::GetInFlightCount() const {
+    uint32 count = 0;
+    for (const auto& slot : slots_) {
+        if (slot.state != SlotState::Free) ++count;
+    }
+    return count;
+}
+
+uint64 GPUReadback::GetSlotBytes() const {
+    uint64 total = 0;
+    for (const auto& slot : slots_) {
+        total += slot.capacity;
+    }
+    return total;
+}
+
+void GPUReadback::Shutdown() {
+    for (auto& slot : slots_) {
+        if (slot.buffer) wgpuBufferRelease(slot.buffer);
+        if (slot.src) wgpuBufferRelease(slot.src);   // queued copy never encoded
+    }
+    slots_.clear();
+    memory_.Set(0);
+}
+
+}  // namespace gpu
+}  // namespace mps
@@ -0,0 +1,103 @@
+#pragma once
+
+#include "core_util/memory_tracker.h"
+#include "core_util/types.h"
+#include <functional>
+#include <span>
+#include <vector>
+
+struct WGPUBufferImpl;          typedef WGPUBufferImpl*          WGPUBuffer;
+struct WGPUCommandEncoderImpl;  typedef WGPUCommandEncoderImpl*  WGPUCommandEncoder;
+
+namespace mps {
+namespace gpu {
+
+/// Pooled asynchronous GPU -> host readback.
+///
+/// Each request copies a byte range of a GPU buffer into one of a bounded pool of
+/// reusable MapRead staging buffers. Copies are either recorded into the caller's
+/// encoder or batched and submitted together by Flush(). Flush() then maps every
+/// slot copied this frame; callbacks run from ProcessEvents() once the GPU has
+/// caught up (typically one or two frames later), so the CPU never waits.
+///
+/// When every slot is in flight, Request() blocks until the oldest one is delivered.
+/// This keeps memory bounded without dropping results.
+class GPUReadback {
+public:
+    /// Mapped bytes, valid only for the duration of the call. Empty on failure.
+    using Callback = std::function<void(std::span<const uint8> data)>;
+
+    static GPUReadback& GetInstance();
+
+    /// Upper bound on staging buffers (requests in flight). Default 8.
+    void SetMaxSlots(uint32 max_slots) { max_slots_ = max_slots; }
+
+    /// Queue a copy of [offset, offset + size) of src. It is submitted by the next Flush().
+    /// offset and size must be multiples of 4.
+    void Request(WGPUBuffer src, uint64 offset, uint64 size, Callback callback);
+
+    /// Record the copy into encoder instead. The encoder must be submitted before
+    /// the next Flush(), which starts the map.
+    void Request(WGPUCommandEncoder encoder, WGPUBuffer src, uint64 offset, uint64 size,
+                 Callback callback);
+
+    /// Submit queued copies and start mapping every slot copied since the last Flush.
+    /// Call once per frame after the frame's last submit.
+    void Flush();
+
+    /// Synchronous read through the pool (no per-call staging allocation).
+    /// Submits the queued copies but maps only its own slot, so slots recorded into
+    /// caller encoders that are not submitted yet are left for the next Flush().
+    std::vector<uint8> Read(WGPUBuffer src, uint64 offset, uint64 size);
+
+    /// Block until every outstanding request has been delivered.
+    void WaitIdle();
+
+    /// Release all staging buffers. Undelivered callbacks are dropped.
+    void Shutdown();
+
+    uint32 GetInFlightCount() const;
+    uint64 GetSlotBytes() const;
+
+private:
+    GPUReadback() = default;
+    ~GPUReadback();
+
+    GPUReadback(const GPUReadback&) = delete;
+    GPUReadback& operator=(const GPUReadback&) = delete;
+
+    enum class SlotState : uint8 {
+        Free,
+        Queued,     // copy waiting for Flush() to encode it
+        Recorded,   // copy recorded in a caller encoder, waiting for Flush() to map
+        Mapping,    // mapAsync issued, callback pending
+    };
+
+    struct Slot {
+        WGPUBuffer buffer = nullptr;
+        uint64 capacity = 0;
+        uint64 size = 0;
+        WGPUBuffer src = nullptr;   // referenced while Queued
+        uint64 src_offset = 0;
+        SlotState state = SlotState::Free;
+        uint64 future_id = 0;   // WGPUFuture of the pending map
+        Callback callback;
+    };
+
+    struct Callbacks;
+    friend struct Callbacks;
+
+    uint32 AcquireSlot(uint64 size);
+    void SubmitQueued();
+    void StartMap(uint32 index);
+    void WaitForSlot(uint32 index);
+
+    std::vector<Slot> slots_;
+    uint32 max_slots_ = 8;
+
+    // Slot bytes, reported to MemoryTracker as (GPU, "gpu", "readback_staging")
+    util::MemoryAccount memory_{util::MemoryDomain::GPU, "readback_staging", "gpu"};
+};
+
+}  // namespace gpu
+}  // namespace mps
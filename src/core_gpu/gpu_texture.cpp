@@ -2,6 +2,7 @@
 #include "core_gpu/gpu_core.h"
 #include "core_util/logger.h"
 #include <webgpu/webgpu.h>
+#include <algorithm>
 #include <cassert>
 #include <utility>
 
@@ -10,10 +11,58 @@ using namespace mps::util;
 namespace mps {
 namespace gpu {
 
+// -- Helpers ------------------------------------------------------------------
+
+// Bytes per texel of uncompressed formats (4 for anything not listed)
+static uint32 BytesPerPixel(TextureFormat format) {
+    switch (format) {
+        case TextureFormat::R8Unorm:
+        case TextureFormat::R8Snorm:
+        case TextureFormat::R8Uint:
+        case TextureFormat::R8Sint:
+            return 1;
+        case TextureFormat::RG8Unorm:
+        case TextureFormat::RG8Snorm:
+        case TextureFormat::R16Float:
+            return 2;
+        case TextureFormat::RGBA8Unorm:
+        case TextureFormat::RGBA8UnormSrgb:
+        case TextureFormat::RGBA8Snorm:
+        case TextureFormat::RGBA8Uint:
+        case TextureFormat::RGBA8Sint:
+        case TextureFormat::BGRA8Unorm:
+        case TextureFormat::BGRA8UnormSrgb:
+        case TextureFormat::RGB10A2Unorm:
+        case TextureFormat::R32Float:
+        case TextureFormat::R32Uint:
+        case TextureFormat::R32Sint:
+            return 4;
+        case TextureFormat::RG32Float:
+        case TextureFormat::RG16Float:
+        case TextureFormat::RGBA16Float:
+            return 8;
+        case TextureFormat::RGBA32Float:
+            return 16;
+        default:
+            return 4;
+    }
+}
+
+// Approximate allocation: every mip level, layer and sample
+static uint64 EstimateBytes(const TextureConfig& config) {
+    uint64 bytes = 0;
+    for (uint32 mip = 0; mip < config.mip_level_count; ++mip) {
+        uint64 w = std::max(config.width >> mip, 1u);
+        uint64 h = std::max(config.height >> mip, 1u);
+        bytes += w * h;
+    }
+    return bytes * config.depth_or_array_layers * config.sample_count * BytesPerPixel(config.format);
+}
+
 // -- Construction -------------------------------------------------------------
 
 GPUTexture::GPUTexture(const TextureConfig& config)
-    : config_(config) {
+    : config_(config), memory_(util::MemoryDomain::GPU, config.label) {
     auto& core = GPUCore::GetInstance();
     assert(core.IsInitialized());
 
@@ -38,6 +87,7 @@ GPUTexture::GPUTexture(const TextureConfig& config)
         handle_ = nullptr;
         throw GPUException("Failed to create default texture view: " + config.label);
     }
+    memory_.Set(EstimateBytes(config));
 
     LogInfo("GPUTexture created: ", config.label,
             " (", config.width, "x", config.height, ")");
@@ -50,7 +100,8 @@ GPUTexture::~GPUTexture() {
 // -- Move semantics -----------------------------------------------------------
 
 GPUTexture::GPUTexture(GPUTexture&& other) noexcept
-    : handle_(other.handle_), default_view_(other.default_view_), config_(std::move(other.config_)) {
+    : handle_(other.handle_), default_view_(other.default_view_), config_(std::move(other.config_)),
+      memory_(std::move(other.memory_)) {
     other.handle_ = nullptr;
     other.default_view_ = nullptr;
 }
@@ -61,6 +112,7 @@ GPUTexture& GPUTexture::operator=(GPUTexture&& other) noexcept {
         handle_ = other.handle_;
         default_view_ = other.default_view_;
         config_ = std::move(other.config_);
+        memory_ = std::move(other.memory_);
         other.handle_ = nullptr;
         other.default_view_ = nullptr;
     }
@@ -73,45 +125,7 @@ void GPUTexture::WriteData(const void* data, uint64 data_size, uint32 mip_level)
     assert(handle_);
     auto& core = GPUCore::GetInstance();
 
-    // Compute bytes per row based on format
-    uint32 bytes_per_pixel = 4;  // Default for RGBA8
-    switch (config_.format) {
-        case TextureFormat::R8Unorm:
-        case TextureFormat::R8Snorm:
-        case TextureFormat::R8Uint:
-        case TextureFormat::R8Sint:
-            bytes_per_pixel = 1;
-            break;
-        case TextureFormat::RG8Unorm:
-        case TextureFormat::RG8Snorm:
-        case TextureFormat::R16Float:
-            bytes_per_pixel = 2;
-            break;
-        case TextureFormat::RGBA8Unorm:
-        case TextureFormat::RGBA8UnormSrgb:
-        case TextureFormat::RGBA8Snorm:
-        case TextureFormat::RGBA8Uint:
-        case TextureFormat::RGBA8Sint:
-        case TextureFormat::BGRA8Unorm:
-        case TextureFormat::BGRA8UnormSrgb:
-        case TextureFormat::RGB10A2Unorm:
-        case TextureFormat::R32Float:
-        case TextureFormat::R32Uint:
-        case TextureFormat::R32Sint:
-            bytes_per_pixel = 4;
-            break;
-        case TextureFormat::RG32Float:
-        case TextureFormat::RG16Float:
-        case TextureFormat::RGBA16Float:
-            bytes_per_pixel = 8;
-            break;
-        case TextureFormat::RGBA32Float:
-            bytes_per_pixel = 16;
-            break;
-        default:
-            bytes_per_pixel = 4;
-            break;
-    }
+    uint32 bytes_per_pixel = BytesPerPixel(config_.format);
 
     uint32 mip_width = config_.width >> mip_level;
     uint32 mip_height = config_.height >> mip_level;
@@ -152,6 +166,7 @@ void GPUTexture::Release() {
         wgpuTextureRelease(handle_);
         handle_ = nullptr;
     }
+    memory_.Set(0);
 }
 
 }  // namespace gpu
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "core_gpu/gpu_types.h"
+#include "core_util/memory_tracker.h"
 #include <string>
 
 // Forward-declare WebGPU handle types
@@ -47,6 +48,7 @@ private:
     WGPUTexture handle_ = nullptr;
     WGPUTextureView default_view_ = nullptr;
     TextureConfig config_;
+    util::MemoryAccount memory_;    // estimated size, all mips/layers/samples
 };
 
 }  // namespace gpu
@@ -193,5 +193,9 @@ enum class PrimitiveTopology : uint32 {
     TriangleStrip = 0x05,
 };
 
+// Override constant every compute shader sizes its workgroup with
+// (assets/shaders/header/workgroup_size.wgsl)
+inline constexpr const char* kWorkgroupSizeConstant = "workgroup_size";
+
 }  // namespace gpu
 }  // namespace mps
@@ -0,0 +1,224 @@
+#include "core_gpu/pipeline_registry.h"
+#include "core_gpu/gpu_core.h"
+#include "core_gpu/gpu_profiler.h"
+#include "core_gpu/shader_loader.h"
+#include "core_util/logger.h"
+#include <webgpu/webgpu.h>
+#include <algorithm>
+#include <cstdio>
+
+using namespace mps::util;
+
+namespace mps {
+namespace gpu {
+
+// Fills a descriptor whose string views point into desc and constants
+static WGPUComputePipelineDescriptor MakeDescriptor(const ComputePipelineDesc& desc,
+                                                    WGPUShaderModule module,
+                                                    std::vector<WGPUConstantEntry>& constants) {
+    constants.clear();
+    for (const auto& [key, value] : desc.constants) {
+        WGPUConstantEntry constant = WGPU_CONSTANT_ENTRY_INIT;
+        constant.key = {key.data(), key.size()};
+        constant.value = value;
+        constants.push_back(constant);
+    }
+
+    WGPUComputePipelineDescriptor wgpu_desc = WGPU_COMPUTE_PIPELINE_DESCRIPTOR_INIT;
+    wgpu_desc.label = {desc.label.data(), desc.label.size()};
+    wgpu_desc.layout = desc.layout;
+    wgpu_desc.compute.module = module;
+    wgpu_desc.compute.entryPoint = {desc.entry_point.data(), desc.entry_point.size()};
+    wgpu_desc.compute.constantCount = constants.size();
+    wgpu_desc.compute.constants = constants.empty() ? nullptr : constants.data();
+    return wgpu_desc;
+}
+
+// -- Callbacks ----------------------------------------------------------------
+
+struct PipelineRegistry::Callbacks {
+    static void OnPipelineCreated(WGPUCreatePipelineAsyncStatus status, WGPUComputePipeline pipeline,
+                                  WGPUStringView message, void* /*userdata1*/, void* userdata2) {
+        auto* entry = static_cast<Entry*>(userdata2);
+        entry->pending = false;
+        if (status == WGPUCreatePipelineAsyncStatus_Success) {
+            entry->pipeline = GPUComputePipeline(pipeline);
+            GPUProfiler::GetInstance().RegisterPipeline(pipeline, entry->label);
+        } else {
+            LogError("Async pipeline creation failed (", entry->label, "): ",
+                     std::string(message.data ? message.data : "", message.data ? message.length : 0));
+            if (pipeline) wgpuComputePipelineRelease(pipeline);
+        }
+    }
+};
+
+// -- Singleton ----------------------------------------------------------------
+
+PipelineRegistry& PipelineRegistry::GetInstance() {
+    static PipelineRegistry instance;
+    return instance;
+}
+
+// -- Requests -----------------------------------------------------------------
+
+void PipelineRegistry::Request(const ComputePipelineDesc& desc) {
+#ifndef __EMSCRIPTEN__
+    FindOrCreateEntry(desc, true);
+#else
+    (void)desc;
+#endif
+}
+
+GPUComputePipeline PipelineRegistry::Get(const ComputePipelineDesc& desc) {
+    Entry& entry = FindOrCreateEntry(desc, false);
+    Wait(entry);
+
+    if (!entry.pipeline) {
+        // Async creation failed: create synchronously so the device reports the
+        // error as usual and the caller still gets a (error) pipeline object
+        const Source& source = ResolveSource(desc);
+        std::vector<WGPUConstantEntry> constants;
+        auto wgpu_desc = MakeDescriptor(desc, source.module->GetHandle(), constants);
+        entry.pipeline = GPUComputePipeline(
+            wgpuDeviceCreateComputePipeline(GPUCore::GetInstance().GetDevice(), &wgpu_desc));
+        GPUProfiler::GetInstance().RegisterPipeline(entry.pipeline.GetHandle(), entry.label);
+    }
+
+    WGPUComputePipeline handle = entry.pipeline.GetHandle();
+    if (handle) wgpuComputePipelineAddRef(handle);
+    return GPUComputePipeline(handle);
+}
+
+WGPUPipelineLayout PipelineRegistry::GetSharedLayout(const std::string& name,
+                                                    const std::function<GPUPipelineLayout()>& create) {
+    auto it = layouts_.find(name);
+    if (it == layouts_.end()) {
+        it = layouts_.emplace(name, create()).first;
+    }
+    return it->second.GetHandle();
+}
+
+void PipelineRegistry::InvalidateSources() {
+    sources_.clear();
+    ShaderLoader::InvalidateCache();
+}
+
+uint32 PipelineRegistry::GetPendingCount() const {
+    uint32 count = 0;
+    for (const auto& [key, entry] : pipelines_) {
+        if (entry->pending) ++count;
+    }
+    return count;
+}
+
+void PipelineRegistry::Shutdown() {
+    auto& profiler = GPUProfiler::GetInstance();
+    for (auto& [key, entry] : pipelines_) {
+        Wait(*entry);
+        profiler.UnregisterPipeline(entry->pipeline.GetHandle());
+    }
+    pipelines_.clear();
+    layouts_.clear();
+    modules_.clear();
+    sources_.clear();
+}
+
+// -- Internal -----------------------------------------------------------------
+
+const PipelineRegistry::Source& PipelineRegistry::ResolveSource(const ComputePipelineDesc& desc) {
+    auto it = sources_.find(desc.shader_path);
+    if (it != sources_.end()) return it->second;
+
+    const ShaderSource& source = ShaderLoader::GetSource(desc.shader_path);
+    if (source.code.empty()) {
+        LogError("Shader source is empty: ", desc.shader_path);
+    }
+
+    // Identical sources share one module
+    auto& module = modules_[source.hash];
+    if (!module) {
+        std::string label = desc.label.empty() ? desc.shader_path : desc.label;
+        module = std::make_unique<GPUShader>(ShaderConfig{std::string(source.code), label});
+    }
+    return sources_.emplace(desc.shader_path, Source{source.hash, module.get()}).first->second;
+}
+
+std::string PipelineRegistry::MakeKey(const ComputePipelineDesc& desc, uint64 source_hash) const {
+    auto constants = desc.constants;
+    std::sort(constants.begin(), constants.end());
+
+    char buffer[64];
+    std::snprintf(buffer, sizeof(buffer), "|%016llx|%p|",
+                  static_cast<unsigned long long>(source_hash), static_cast<void*>(desc.layout));
+    std::string key = desc.shader_path + buffer + desc.entry_point;
+    for (const auto& [name, value] : constants) {
+        std::snprintf(buffer, sizeof(buffer), "=%.17g", value);
+        key += '|' + name + buffer;
+    }
+    return key;
+}
+
+PipelineRegistry::Entry& PipelineRegistry::FindOrCreateEntry(const ComputePipelineDesc& desc,
+                                                             bool async) {
+    const Source& source = ResolveSource(desc);
+    std::string key = MakeKey(desc, source.hash);
+    auto it = pipelines_.find(key);
+    if (it != pipelines_.end()) return *it->second;
+
+    auto& entry = pipelines_[key];
+    entry = std::make_unique<Entry>();
+    entry->label = desc.label;
+    if (desc.layout) {
+        wgpuPipelineLayoutAddRef(desc.layout);
+        entry->layout = GPUPipelineLayout(desc.layout);
+    }
+
+    auto& core = GPUCore::GetInstance();
+    std::vector<WGPUConstantEntry> constants;
+    auto wgpu_desc = MakeDescriptor(desc, source.module->GetHandle(), constants);
+    if (async) {
+        WGPUCreateComputePipelineAsyncCallbackInfo cb = WGPU_CREATE_COMPUTE_PIPELINE_ASYNC_CALLBACK_INFO_INIT;
+        cb.mode = WGPUCallbackMode_AllowProcessEvents;
+        cb.callback = Callbacks::OnPipelineCreated;
+        cb.userdata1 = this;
+        cb.userdata2 = entry.get();
+        entry->pending = true;
+        WGPUFuture future = wgpuDeviceCreateComputePipelineAsync(core.GetDevice(), &wgpu_desc, cb);
+        entry->future_id = future.id;
+    } else {
+        entry->pipeline = GPUComputePipeline(wgpuDeviceCreateComputePipeline(core.GetDevice(), &wgpu_desc));
+        GPUProfiler::GetInstance().RegisterPipeline(entry->pipeline.GetHandle(), entry->label);
+    }
+    return *entry;
+}
+
+void PipelineRegistry::Wait(Entry& entry) {
+    if (!entry.pending) return;
+    auto& core = GPUCore::GetInstance();
+#ifndef __EMSCRIPTEN__
+    WGPUFutureWaitInfo wait = WGPU_FUTURE_WAIT_INFO_INIT;
+    wait.future.id = entry.future_id;
+    wgpuInstanceWaitAny(core.GetWGPUInstance(), 1, &wait, UINT64_MAX);
+#endif
+    while (entry.pending) {
+        core.ProcessEvents();
+    }
+}
+
+// -- PipelineBatch ------------------------------------------------------------
+
+void PipelineBatch::Add(ComputePipelineDesc desc, GPUComputePipeline& target) {
+    PipelineRegistry::GetInstance().Request(desc);
+    items_.emplace_back(std::move(desc), &target);
+}
+
+void PipelineBatch::Resolve() {
+    auto& registry = PipelineRegistry::GetInstance();
+    for (auto& [desc, target] : items_) {
+        *target = registry.Get(desc);
+    }
+    items_.clear();
+}
+
+}  // namespace gpu
+}  // namespace mps
@@ -0,0 +1,128 @@
+#pragma once
+
+#include "core_util/types.h"
+#include "core_gpu/gpu_handle.h"
+#include "core_gpu/gpu_types.h"
+#include "core_gpu/gpu_shader.h"
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace mps {
+namespace gpu {
+
+/// Everything that identifies a compute pipeline.
+struct ComputePipelineDesc {
+    std::string shader_path;                 // relative to assets/shaders/
+    std::string label;                       // shader/pipeline label and profiler name
+    std::string entry_point = "cs_main";
+    WGPUPipelineLayout layout = nullptr;     // nullptr = auto layout; see GetSharedLayout()
+    std::vector<std::pair<std::string, float64>> constants;  // pipeline-overridable constants
+
+    /// Specialize the shader's workgroup size (the shader default is 64)
+    ComputePipelineDesc& SetWorkgroupSize(uint32 size) {
+        constants.emplace_back(kWorkgroupSizeConstant, static_cast<float64>(size));
+        return *this;
+    }
+};
+
+/// Process-wide cache of compute pipelines.
+///
+/// Pipelines are keyed by (shader path, hash of the #import-resolved source, entry
+/// point, layout, constants), so identical requests share one pipeline and a solver
+/// that is torn down and re-initialized gets its pipelines back without recompiling.
+/// The label is not part of the key: the first request names the pipeline.
+///
+/// Request() starts compilation with wgpuDeviceCreateComputePipelineAsync and returns
+/// immediately; Get() hands out a new reference to the pipeline, waiting for a pending
+/// compile or compiling synchronously on a miss. Requesting a batch of pipelines before
+/// getting the first one lets the driver compile them concurrently (see PipelineBatch).
+/// Under __EMSCRIPTEN__, Request() is a no-op and Get() always compiles synchronously.
+///
+/// Sources come from ShaderLoader (embedded at build time). InvalidateSources() drops
+/// the per-path cache so that, with MPS_SHADER_DIR set, edited shaders get fresh
+/// pipelines on the next request while unchanged ones stay cached.
+/// Main thread only.
+class PipelineRegistry {
+public:
+    static PipelineRegistry& GetInstance();
+
+    /// Start compiling desc in the background. No-op if it is cached or pending.
+    void Request(const ComputePipelineDesc& desc);
+
+    /// New reference to the pipeline for desc (the registry keeps its own).
+    GPUComputePipeline Get(const ComputePipelineDesc& desc);
+
+    /// Explicit pipeline layout registered under name, built by create() on first use and
+    /// kept until Shutdown(). The layout handle is part of the pipeline key, so a solver
+    /// that is re-initialized must take its layout from here to get its cached pipeline
+    /// back instead of adding a new entry. Non-owning.
+    WGPUPipelineLayout GetSharedLayout(const std::string& name,
+                                       const std::function<GPUPipelineLayout()>& create);
+
+    /// Re-read shader sources on the next request (cached pipelines are kept).
+    void InvalidateSources();
+
+    /// Wait for pending compiles and release every pipeline and shader module.
+    /// Call before GPUCore::Shutdown().
+    void Shutdown();
+
+    uint32 GetPipelineCount() const { return static_cast<uint32>(pipelines_.size()); }
+    uint32 GetPendingCount() const;
+
+private:
+    PipelineRegistry() = default;
+    ~PipelineRegistry() = default;
+
+    PipelineRegistry(const PipelineRegistry&) = delete;
+    PipelineRegistry& operator=(const PipelineRegistry&) = delete;
+
+    struct Entry {
+        GPUComputePipeline pipeline;
+        GPUPipelineLayout layout;   // reference held so the key's layout address stays unique
+        std::string label;
+        bool pending = false;
+        uint64 future_id = 0;    // WGPUFuture of the pending creation
+    };
+
+    struct Source {
+        uint64 hash = 0;
+        GPUShader* module = nullptr;   // owned by modules_
+    };
+
+    struct Callbacks;
+    friend struct Callbacks;
+
+    const Source& ResolveSource(const ComputePipelineDesc& desc);
+    std::string MakeKey(const ComputePipelineDesc& desc, uint64 source_hash) const;
+    Entry& FindOrCreateEntry(const ComputePipelineDesc& desc, bool async);
+    void Wait(Entry& entry);
+
+    std::unordered_map<std::string, Source> sources_;                    // by shader path
+    std::unordered_map<uint64, std::unique_ptr<GPUShader>> modules_;      // by source hash
+    std::unordered_map<std::string, std::unique_ptr<Entry>> pipelines_;  // by MakeKey()
+    std::unordered_map<std::string, GPUPipelineLayout> layouts_;          // by GetSharedLayout() name
+};
+
+/// Requests a set of pipelines up front, then resolves them into their targets.
+///
+///   PipelineBatch batch;
+///   batch.Add({"ext_foo/a.wgsl", "foo_a"}, a_pipeline_);
+///   batch.Add({"ext_foo/b.wgsl", "foo_b"}, b_pipeline_);
+///   batch.Resolve();   // both compiled concurrently
+///
+/// Targets must stay valid until Resolve().
+class PipelineBatch {
+public:
+    void Add(ComputePipelineDesc desc, GPUComputePipeline& target);
+    void Resolve();
+
+private:
+    std::vector<std::pair<ComputePipelineDesc, GPUComputePipeline*>> items_;
+};
+
+}  // namespace gpu
+}  // namespace mps
@@ -0,0 +1,21 @@
+#pragma once
+
+#include "core_util/types.h"
+
+namespace mps {
+namespace gpu {
+
+// One shader from assets/shaders with its #imports already resolved, embedded at
+// build time by embed_shaders.cmake (see core_gpu/CMakeLists.txt).
+struct EmbeddedShader {
+    const char* path;   // relative to assets/shaders/, '/' separated
+    const char* code;   // flattened WGSL, null-terminated
+    uint64 size;        // bytes, excluding the terminator
+};
+
+// Sorted by path. Empty (count 0) when MPS_EMBED_SHADERS is off.
+extern const EmbeddedShader kEmbeddedShaders[];
+extern const uint32 kEmbeddedShaderCount;
+
+}  // namespace gpu
+}  // namespace mps
@@ -1,31 +1,97 @@
 #include "core_gpu/shader_loader.h"
 #include "core_gpu/asset_path.h"
+#include "core_gpu/shader_bundle.h"
 #include "core_util/logger.h"
+#include <cstdlib>
 #include <fstream>
 #include <sstream>
-#include <regex>
+#include <unordered_map>
 #include <unordered_set>
 #include <filesystem>
 #include <functional>
+#include <memory>
 
 using namespace mps::util;
 
 namespace mps {
 namespace gpu {
 
+namespace {
+
+struct CachedSource {
+    std::string storage;   // owns the code of disk-loaded shaders
+    ShaderSource source;
+};
+
+std::unordered_map<std::string, std::unique_ptr<CachedSource>>& SourceCache() {
+    static std::unordered_map<std::string, std::unique_ptr<CachedSource>> cache;
+    return cache;
+}
+
+const EmbeddedShader* FindEmbedded(const std::string& path) {
+    static const auto table = [] {
+        std::unordered_map<std::string_view, const EmbeddedShader*> map;
+        for (uint32 i = 0; i < kEmbeddedShaderCount; ++i) {
+            map.emplace(kEmbeddedShaders[i].path, &kEmbeddedShaders[i]);
+        }
+        return map;
+    }();
+    auto it = table.find(path);
+    return it != table.end() ? it->second : nullptr;
+}
+
+// Directory from MPS_SHADER_DIR with a trailing separator, or empty when unset
+const std::string& OverrideDir() {
+    static const std::string dir = [] {
+        const char* env = std::getenv("MPS_SHADER_DIR");
+        std::string value = env ? env : "";
+        if (!value.empty() && value.back() != '/' && value.back() != '\\') value += '/';
+        if (!value.empty()) LogInfo("Loading shaders from MPS_SHADER_DIR: ", value);
+        return value;
+    }();
+    return dir;
+}
+
+// FNV-1a over the resolved source
+uint64 HashSource(std::string_view source) {
+    uint64 hash = 14695981039346656037ull;
+    for (char c : source) {
+        hash ^= static_cast<uint8>(c);
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+// Matches `#import "path"` with optional surrounding blanks; returns the path
+bool ParseImport(std::string_view line, std::string_view& import_path) {
+    auto is_blank = [](char c) { return c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '\f' || c == '\v'; };
+
+    size_t pos = line.find_first_not_of(" \t");
+    if (pos == std::string_view::npos || line.compare(pos, 7, "#import") != 0) return false;
+    pos += 7;
+    size_t quote = line.find_first_not_of(" \t", pos);
+    if (quote == pos || quote == std::string_view::npos || line[quote] != '"') return false;
+    size_t close = line.rfind('"');
+    if (close == quote) return false;
+    for (size_t i = close + 1; i < line.size(); ++i) {
+        if (!is_blank(line[i])) return false;
+    }
+    import_path = line.substr(quote + 1, close - quote - 1);
+    return true;
+}
+
+}  // namespace
+
 // -- Base path resolution -----------------------------------------------------
 
 std::string ShaderLoader::ResolveBasePath() {
     return ResolveAssetPath("shaders/");
 }
 
-// -- Source loading with #import support ---------------------------------------
-
-std::string ShaderLoader::LoadSource(const std::string& path) {
-    static std::string base = ResolveBasePath();
+// -- Disk loading with #import support ----------------------------------------
 
+std::string ShaderLoader::ReadFlattened(const std::string& base, const std::string& path) {
     std::string source;
-    const std::regex import_pattern{R"_(^[ \t]*#import[ \t]+"(.*)"\s*$)_", std::regex::optimize};
     std::unordered_set<std::string> processed;
 
     std::function<void(const std::string&)> read_source;
@@ -40,34 +106,71 @@ std::string ShaderLoader::LoadSource(const std::string& path) {
         }
         std::stringstream ss;
         ss << file.rdbuf();
-        file.close();
-
-        std::string line;
-        std::smatch matches;
-        while (std::getline(ss, line)) {
-            if (std::regex_search(line, matches, import_pattern)) {
-                read_source(base + matches[1].str());
+        std::string content = ss.str();
+
+        std::string_view rest = content;
+        while (!rest.empty()) {
+            size_t end = rest.find('\n');
+            std::string_view line = rest.substr(0, end);
+            rest = end == std::string_view::npos ? std::string_view{} : rest.substr(end + 1);
+
+            std::string_view import_path;
+            if (ParseImport(line, import_path)) {
+                read_source(base + std::string(import_path));
+            } else {
+                source.append(line);
+                source += '\n';
             }
-            else
-                source.append(line + '\n');
         }
     };
 
     read_source(base + path);
-
     return source;
 }
 
+// -- Cached lookup ------------------------------------------------------------
+
+const ShaderSource& ShaderLoader::GetSource(const std::string& path) {
+    auto& cache = SourceCache();
+    auto it = cache.find(path);
+    if (it != cache.end()) return it->second->source;
+
+    auto entry = std::make_unique<CachedSource>();
+    const EmbeddedShader* embedded = OverrideDir().empty() ? FindEmbedded(path) : nullptr;
+    if (embedded) {
+        entry->source.code = std::string_view(embedded->code, static_cast<size_t>(embedded->size));
+    } else {
+        if (!OverrideDir().empty()) {
+            entry->storage = ReadFlattened(OverrideDir(), path);
+        } else {
+            static const std::string base = ResolveBasePath();
+            entry->storage = ReadFlattened(base, path);
+        }
+        entry->source.code = entry->storage;
+    }
+    // Same function for both origins, so modules and pipelines dedup by content alone
+    entry->source.hash = HashSource(entry->source.code);
+    return cache.emplace(path, std::move(entry)).first->second->source;
+}
+
+std::string ShaderLoader::LoadSource(const std::string& path) {
+    return std::string(GetSource(path).code);
+}
+
+void ShaderLoader::InvalidateCache() {
+    SourceCache().clear();
+}
+
 // -- Module creation ----------------------------------------------------------
 
 GPUShader ShaderLoader::CreateModule(const std::string& path, const std::string& label) {
-    auto code = LoadSource(path);
-    if (code.empty()) {
+    const ShaderSource& source = GetSource(path);
+    if (source.code.empty()) {
         LogError("Shader source is empty: ", path);
     }
 
     std::string shader_label = label.empty() ? path : label;
-    ShaderConfig config{code, shader_label};
+    ShaderConfig config{std::string(source.code), shader_label};
     return GPUShader(config);
 }
 
@@ -1,18 +1,42 @@
 #pragma once
 
+#include "core_util/types.h"
 #include "core_gpu/gpu_shader.h"
 #include <string>
+#include <string_view>
 
 namespace mps {
 namespace gpu {
 
+/// #import-resolved WGSL for one shader path.
+struct ShaderSource {
+    std::string_view code;
+    uint64 hash = 0;   // FNV-1a of code, embedded or loaded from disk: equal code gives equal hash
+};
+
+/// Shader sources by path (relative to assets/shaders/).
+///
+/// Sources come from the table embed_shaders.cmake builds into the binary, with
+/// #imports already resolved, so a lookup costs no file I/O or parsing. Paths that
+/// are not embedded (MPS_EMBED_SHADERS=OFF) are read and flattened from assets/shaders/.
+/// Setting the MPS_SHADER_DIR environment variable loads every shader from that
+/// directory instead, for editing shaders without rebuilding.
+///
+/// Results are cached per path for the life of the process. Main thread only.
 class ShaderLoader {
 public:
+    /// Cached source for path. The reference stays valid until InvalidateCache().
+    static const ShaderSource& GetSource(const std::string& path);
+
     static std::string LoadSource(const std::string& path);
     static GPUShader CreateModule(const std::string& path, const std::string& label = "");
 
+    /// Drop cached sources so disk-loaded shaders are re-read on the next lookup.
+    static void InvalidateCache();
+
 private:
     static std::string ResolveBasePath();
+    static std::string ReadFlattened(const std::string& base, const std::string& path);
 };
 
 }  // namespace gpu
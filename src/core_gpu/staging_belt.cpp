@@ -0,0 +1,246 @@
+#include "core_gpu/staging_belt.h"
+#include "core_gpu/gpu_core.h"
+#include "core_gpu/gpu_types.h"
+#include "core_util/logger.h"
+#include <webgpu/webgpu.h>
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+using namespace mps::util;
+
+namespace mps {
+namespace gpu {
+
+// Sub-allocation alignment within a chunk (CopyBufferToBuffer needs 4; 16 keeps
+// vec4-aligned element types aligned in mapped memory)
+static constexpr uint64 kAllocAlignment = 16;
+
+static uint64 AlignUp(uint64 value, uint64 alignment) {
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+// -- Callbacks ----------------------------------------------------------------
+
+struct StagingBelt::Callbacks {
+    static void OnMapped(WGPUMapAsyncStatus status, WGPUStringView /*message*/,
+                         void* userdata1, void* userdata2) {
+        auto* belt = static_cast<StagingBelt*>(userdata1);
+        auto index = static_cast<uint32>(reinterpret_cast<uintptr_t>(userdata2));
+
+        // Chunks are gone after Shutdown(); late callbacks are ignored
+        if (index >= belt->chunks_.size()) return;
+        Chunk& chunk = belt->chunks_[index];
+        if (chunk.state != ChunkState::Mapping) return;
+
+        chunk.state = ChunkState::Free;
+        chunk.used = 0;
+        if (status == WGPUMapAsyncStatus_Success && belt->GetPooledBytes() <= belt->max_retained_bytes_) {
+            chunk.mapped = static_cast<uint8*>(
+                wgpuBufferGetMappedRange(chunk.buffer, 0, static_cast<size_t>(chunk.capacity)));
+        }
+        if (!chunk.mapped) {
+            belt->ReleaseChunk(chunk);
+        }
+    }
+};
+
+// -- Singleton ----------------------------------------------------------------
+
+StagingBelt& StagingBelt::GetInstance() {
+    static StagingBelt instance;
+    return instance;
+}
+
+StagingBelt::~StagingBelt() {
+    Shutdown();
+}
+
+// -- Allocation ---------------------------------------------------------------
+
+uint32 StagingBelt::AcquireChunk(uint64 size) {
+    // Room left in a chunk already being filled, else the smallest free chunk that fits
+    uint32 best = UINT32_MAX;
+    uint32 empty = UINT32_MAX;
+    for (uint32 i = 0; i < chunks_.size(); ++i) {
+        const Chunk& chunk = chunks_[i];
+        if (!chunk.buffer) {
+            if (empty == UINT32_MAX) empty = i;
+            continue;
+        }
+        if (chunk.state == ChunkState::Filling &&
+            AlignUp(chunk.used, kAllocAlignment) + size <= chunk.capacity) {
+            return i;
+        }
+        if (chunk.state == ChunkState::Free && chunk.capacity >= size &&
+            (best == UINT32_MAX || chunk.capacity < chunks_[best].capacity)) {
+            best = i;
+        }
+    }
+    if (best != UINT32_MAX) return best;
+
+    // Nothing fits: create a chunk, mapped at creation so it can be filled immediately
+    uint32 index = empty;
+    if (index == UINT32_MAX) {
+        index = static_cast<uint32>(chunks_.size());
+        chunks_.emplace_back();
+    }
+    uint64 capacity = std::max(chunk_size_, AlignUp(size, kAllocAlignment));
+
+    WGPUBufferDescriptor desc = WGPU_BUFFER_DESCRIPTOR_INIT;
+    desc.label = {"upload_staging", WGPU_STRLEN};
+    desc.usage = WGPUBufferUsage_MapWrite | WGPUBufferUsage_CopySrc;
+    desc.size = capacity;
+    desc.mappedAtCreation = WGPU_TRUE;
+
+    Chunk& chunk = chunks_[index];
+    chunk.buffer = wgpuDeviceCreateBuffer(GPUCore::GetInstance().GetDevice(), &desc);
+    if (!chunk.buffer) {
+        throw GPUException("Failed to create upload staging buffer");
+    }
+    chunk.mapped = static_cast<uint8*>(wgpuBufferGetMappedRange(chunk.buffer, 0, static_cast<size_t>(capacity)));
+    if (!chunk.mapped) {
+        ReleaseChunk(chunk);
+        throw GPUException("Failed to map upload staging buffer");
+    }
+    chunk.capacity = capacity;
+    chunk.used = 0;
+    chunk.state = ChunkState::Free;
+    memory_.Set(GetPooledBytes());
+    return index;
+}
+
+std::span<uint8> StagingBelt::Allocate(WGPUBuffer dst, uint64 dst_offset, uint64 size) {
+    assert(dst && size > 0 && size % 4 == 0 && dst_offset % 4 == 0);
+    uint32 index = AcquireChunk(size);
+    Chunk& chunk = chunks_[index];
+    uint64 offset = AlignUp(chunk.used, kAllocAlignment);
+    chunk.used = offset + size;
+    chunk.state = ChunkState::Filling;
+
+    // Extend the previous copy when both ranges continue it
+    Copy* last = copies_.empty() ? nullptr : &copies_.back();
+    if (last && last->chunk == index && last->dst == dst &&
+        last->chunk_offset + last->size == offset && last->dst_offset + last->size == dst_offset) {
+        last->size += size;
+    } else {
+        wgpuBufferAddRef(dst);
+        copies_.push_back({index, offset, dst, dst_offset, size});
+    }
+    return {chunk.mapped + offset, static_cast<size_t>(size)};
+}
+
+void StagingBelt::Write(WGPUBuffer dst, uint64 dst_offset, const void* data, uint64 size) {
+    auto mapped = Allocate(dst, dst_offset, size);
+    std::memcpy(mapped.data(), data, static_cast<size_t>(size));
+}
+
+// -- Flush / recall -----------------------------------------------------------
+
+void StagingBelt::Flush(WGPUCommandEncoder encoder) {
+    assert(encoder);
+    for (auto& chunk : chunks_) {
+        if (chunk.state != ChunkState::Filling) continue;
+        wgpuBufferUnmap(chunk.buffer);
+        chunk.mapped = nullptr;
+        chunk.state = ChunkState::Flushed;
+    }
+    for (const auto& copy : copies_) {
+        wgpuCommandEncoderCopyBufferToBuffer(encoder, chunks_[copy.chunk].buffer, copy.chunk_offset,
+                                              copy.dst, copy.dst_offset, copy.size);
+        wgpuBufferRelease(copy.dst);
+    }
+    copies_.clear();
+}
+
+void StagingBelt::Flush() {
+    if (copies_.empty()) return;
+    auto& core = GPUCore::GetInstance();
+
+    WGPUCommandEncoderDescriptor enc_desc = WGPU_COMMAND_ENCODER_DESCRIPTOR_INIT;
+    enc_desc.label = {"staging_belt_copies", WGPU_STRLEN};
+    WGPUCommandEncoder encoder = wgpuDeviceCreateCommandEncoder(core.GetDevice(), &enc_desc);
+    Flush(encoder);
+
+    WGPUCommandBuffer cmd = wgpuCommandEncoderFinish(encoder, nullptr);
+    wgpuQueueSubmit(core.GetQueue(), 1, &cmd);
+    wgpuCommandBufferRelease(cmd);
+    wgpuCommandEncoderRelease(encoder);
+
+    Recall();
+}
+
+void StagingBelt::Recall() {
+    for (uint32 i = 0; i < chunks_.size(); ++i) {
+        Chunk& chunk = chunks_[i];
+        if (chunk.state != ChunkState::Flushed) continue;
+        chunk.state = ChunkState::Mapping;
+
+        WGPUBufferMapCallbackInfo map_cb = WGPU_BUFFER_MAP_CALLBACK_INFO_INIT;
+        map_cb.mode = WGPUCallbackMode_AllowProcessEvents;
+        map_cb.callback = Callbacks::OnMapped;
+        map_cb.userdata1 = this;
+        map_cb.userdata2 = reinterpret_cast<void*>(static_cast<uintptr_t>(i));
+        WGPUFuture future = wgpuBufferMapAsync(chunk.buffer, WGPUMapMode_Write, 0,
+                                               static_cast<size_t>(chunk.capacity), map_cb);
+        chunk.future_id = future.id;
+    }
+}
+
+// -- Waiting / teardown -------------------------------------------------------
+
+void StagingBelt::WaitIdle() {
+    auto& core = GPUCore::GetInstance();
+    for (uint32 i = 0; i < chunks_.size(); ++i) {
+#ifndef __EMSCRIPTEN__
+        if (chunks_[i].state == ChunkState::Mapping) {
+            WGPUFutureWaitInfo wait = WGPU_FUTURE_WAIT_INFO_INIT;
+            wait.future.id = chunks_[i].future_id;
+            wgpuInstanceWaitAny(core.GetWGPUInstance(), 1, &wait, UINT64_MAX);
+        }
+#endif
+        while (i < chunks_.size() && chunks_[i].state == ChunkState::Mapping) {
+            core.ProcessEvents();
+        }
+    }
+}
+
+uint64 StagingBelt::GetPooledBytes() const {
+    uint64 total = 0;
+    for (const auto& chunk : chunks_) {
+        total += chunk.capacity;
+    }
+    return total;
+}
+
+void StagingBelt::ReleaseChunk(Chunk& chunk) {
+    if (chunk.buffer) wgpuBufferRelease(chunk.buffer);
+    chunk = Chunk{};
+    memory_.Set(GetPooledBytes());
+}
+
+uint64 StagingBelt::Trim() {
+    uint64 released = 0;
+    for (auto& chunk : chunks_) {
+        if (chunk.buffer && chunk.state == ChunkState::Free) {
+            released += chunk.capacity;
+            ReleaseChunk(chunk);
+        }
+    }
+    return released;
+}
+
+void StagingBelt::Shutdown() {
+    for (const auto& copy : copies_) {
+        wgpuBufferRelease(copy.dst);
+    }
+    copies_.clear();
+    for (auto& chunk : chunks_) {
+        if (chunk.buffer) wgpuBufferRelease(chunk.buffer);
+    }
+    chunks_.clear();
+    memory_.Set(0);
+}
+
+}  // namespace gpu
+}  // namespace mps
@@ -0,0 +1,115 @@
+#pragma once
+
+#include "core_util/memory_tracker.h"
+#include "core_util/types.h"
+#include <span>
+#include <vector>
+
+struct WGPUBufferImpl;          typedef WGPUBufferImpl*          WGPUBuffer;
+struct WGPUCommandEncoderImpl;  typedef WGPUCommandEncoderImpl*  WGPUCommandEncoder;
+
+namespace mps {
+namespace gpu {
+
+/// Pooled host -> GPU uploads through persistently mapped staging memory.
+///
+/// A ring of MapWrite chunks is sub-allocated by Allocate(), which returns mapped
+/// memory the caller fills in place (no intermediate host copy and no driver-side
+/// staging copy as with wgpuQueueWriteBuffer). Flush() unmaps the chunks written
+/// since the last flush and records one CopyBufferToBuffer per upload; once that
+/// work is submitted, Recall() starts remapping the chunks, which return to the
+/// ring from ProcessEvents() when the GPU has consumed them. The CPU never waits:
+/// if no chunk is free a new one is created.
+///
+/// Uploads land when the flush's commands execute, not at Allocate() time. Writes to
+/// the same range through wgpuQueueWriteBuffer before that are overwritten, so each
+/// destination range should be written through one path per flush.
+class StagingBelt {
+public:
+    static StagingBelt& GetInstance();
+
+    /// Size of a regular chunk. Larger uploads get a dedicated chunk. Default 4 MiB.
+    void SetChunkSize(uint64 chunk_size) { chunk_size_ = chunk_size; }
+
+    /// Chunks that come back while the pool holds more than this are released
+    /// instead of being kept mapped. Default 256 MiB.
+    void SetMaxRetainedBytes(uint64 max_bytes) { max_retained_bytes_ = max_bytes; }
+
+    /// Mapped memory for [dst_offset, dst_offset + size) of dst, valid until the next
+    /// Flush(). dst_offset and size must be multiples of 4. The memory is 16-byte
+    /// aligned and its previous contents are undefined.
+    std::span<uint8> Allocate(WGPUBuffer dst, uint64 dst_offset, uint64 size);
+
+    /// Allocate() and copy data into it.
+    void Write(WGPUBuffer dst, uint64 dst_offset, const void* data, uint64 size);
+
+    /// Record all pending uploads into encoder. Submit the encoder, then call Recall().
+    void Flush(WGPUCommandEncoder encoder);
+
+    /// Record pending uploads into an internal encoder, submit it and Recall().
+    void Flush();
+
+    /// Start remapping the chunks of every flushed (and since submitted) upload.
+    void Recall();
+
+    bool HasPendingUploads() const { return !copies_.empty(); }
+
+    /// Block until every recalled chunk is mapped again.
+    void WaitIdle();
+
+    /// Release idle (mapped, empty) chunks; returns the bytes released.
+    uint64 Trim();
+
+    /// Release all chunks. Pending uploads are dropped.
+    void Shutdown();
+
+    uint64 GetPooledBytes() const;
+
+private:
+    StagingBelt() = default;
+    ~StagingBelt();
+
+    StagingBelt(const StagingBelt&) = delete;
+    StagingBelt& operator=(const StagingBelt&) = delete;
+
+    enum class ChunkState : uint8 {
+        Free,       // mapped, nothing allocated
+        Filling,    // mapped, holds uploads not yet flushed
+        Flushed,    // unmapped, copies recorded, waiting for Recall()
+        Mapping,    // mapAsync issued, callback pending
+    };
+
+    struct Chunk {
+        WGPUBuffer buffer = nullptr;
+        uint8* mapped = nullptr;
+        uint64 capacity = 0;
+        uint64 used = 0;
+        ChunkState state = ChunkState::Free;
+        uint64 future_id = 0;   // WGPUFuture of the pending map
+    };
+
+    struct Copy {
+        uint32 chunk = 0;
+        uint64 chunk_offset = 0;
+        WGPUBuffer dst = nullptr;   // referenced until recorded
+        uint64 dst_offset = 0;
+        uint64 size = 0;
+    };
+
+    struct Callbacks;
+    friend struct Callbacks;
+
+    uint32 AcquireChunk(uint64 size);
+    void ReleaseChunk(Chunk& chunk);
+
+    std::vector<Chunk> chunks_;
+    std::vector<Copy> copies_;
+    uint64 chunk_size_ = 4ull << 20;
+    uint64 max_retained_bytes_ = 256ull << 20;
+
+    // Chunk bytes, reported to MemoryTracker as (GPU, "gpu", "upload_staging")
+    util::MemoryAccount memory_{util::MemoryDomain::GPU, "upload_staging", "gpu"};
+};
+
+}  // namespace gpu
+}  // namespace mps
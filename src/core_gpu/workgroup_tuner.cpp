@@ -0,0 +1,141 @@
+#include "core_gpu/workgroup_tuner.h"
+#include "core_gpu/gpu_core.h"
+#include "core_util/logger.h"
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+
+using namespace mps::util;
+
+namespace mps {
+namespace gpu {
+
+// File format, one entry per line: adapter<TAB>kernel<TAB>size ('#' starts a comment)
+static constexpr char kSeparator = '\t';
+
+WorkgroupTuner& WorkgroupTuner::GetInstance() {
+    static WorkgroupTuner instance;
+    return instance;
+}
+
+bool WorkgroupTuner::IsValidSize(uint32 size) const {
+    bool power_of_two = size >= 32 && (size & (size - 1)) == 0;
+    return power_of_two && size <= max_size_;
+}
+
+// -- Lookup -------------------------------------------------------------------
+
+uint32 WorkgroupTuner::GetSize(const std::string& kernel, uint32 fallback) const {
+    auto candidate = candidates_.find(kernel);
+    if (candidate != candidates_.end()) return candidate->second;
+
+    auto adapter = sizes_.find(adapter_key_);
+    if (adapter == sizes_.end()) return fallback;
+    auto it = adapter->second.find(kernel);
+    if (it == adapter->second.end() || !IsValidSize(it->second)) return fallback;
+    return it->second;
+}
+
+void WorkgroupTuner::SetSize(const std::string& kernel, uint32 size) {
+    if (!IsValidSize(size)) {
+        LogWarning("WorkgroupTuner: ignoring invalid workgroup size ", size, " for ", kernel);
+        return;
+    }
+    sizes_[adapter_key_][kernel] = size;
+}
+
+void WorkgroupTuner::ClearSize(const std::string& kernel) {
+    auto adapter = sizes_.find(adapter_key_);
+    if (adapter != sizes_.end()) adapter->second.erase(kernel);
+}
+
+std::vector<uint32> WorkgroupTuner::GetCandidates() const {
+    std::vector<uint32> candidates;
+    uint32 limit = std::min<uint32>(256, max_size_);
+    for (uint32 size = 32; size <= limit; size *= 2) {
+        candidates.push_back(size);
+    }
+    return candidates;
+}
+
+// -- Tuning -------------------------------------------------------------------
+
+uint32 WorkgroupTuner::Tune(const std::string& kernel, std::span<const uint32> candidates,
+                            const Benchmark& benchmark, uint32 fallback) {
+    uint32 best = 0;
+    float64 best_ms = 0.0;
+    for (uint32 size : candidates) {
+        if (!IsValidSize(size)) continue;
+        candidates_[kernel] = size;
+        float64 ms = benchmark(size);
+        LogInfo("WorkgroupTuner: ", kernel, " @ ", size, ": ", ms, " ms");
+        if (ms >= 0.0 && (best == 0 || ms < best_ms)) {
+            best = size;
+            best_ms = ms;
+        }
+    }
+    candidates_.erase(kernel);
+
+    if (best == 0) {
+        LogWarning("WorkgroupTuner: no candidate succeeded for ", kernel, ", keeping its current size");
+        return GetSize(kernel, fallback);
+    }
+    SetSize(kernel, best);
+    LogInfo("WorkgroupTuner: ", kernel, " -> ", best, " (", best_ms, " ms) on ", adapter_key_);
+    return best;
+}
+
+// -- Persistence --------------------------------------------------------------
+
+bool WorkgroupTuner::Load() {
+    auto& gpu = GPUCore::GetInstance();
+    adapter_key_ = gpu.GetAdapterName() + " (" + gpu.GetBackendType() + ")";
+    max_size_ = gpu.GetMaxComputeWorkgroupSize();
+
+    std::ifstream file(path_);
+    if (!file.is_open()) return false;
+
+    uint32 count = 0;
+    std::string line;
+    while (std::getline(file, line)) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (line.empty() || line[0] == '#') continue;
+
+        size_t first = line.find(kSeparator);
+        size_t second = first == std::string::npos ? first : line.find(kSeparator, first + 1);
+        if (second == std::string::npos) {
+            LogWarning("WorkgroupTuner: skipping malformed line in ", path_, ": ", line);
+            continue;
+        }
+        uint32 size = static_cast<uint32>(std::strtoul(line.c_str() + second + 1, nullptr, 10));
+        // Sizes recorded earlier in this process (e.g. just tuned) win over the file
+        sizes_[line.substr(0, first)].try_emplace(line.substr(first + 1, second - first - 1), size);
+        ++count;
+    }
+
+    auto adapter = sizes_.find(adapter_key_);
+    uint32 matching = adapter != sizes_.end() ? static_cast<uint32>(adapter->second.size()) : 0;
+    LogInfo("WorkgroupTuner: loaded ", count, " entries from ", path_, " (", matching,
+            " for this adapter)");
+    return true;
+}
+
+bool WorkgroupTuner::Save() const {
+    std::ofstream file(path_, std::ios::trunc);
+    if (!file.is_open()) {
+        LogError("WorkgroupTuner: failed to write ", path_);
+        return false;
+    }
+
+    file << "# Workgroup sizes per adapter: adapter<TAB>kernel<TAB>size (written by mps_bench)\n";
+    for (const auto& [adapter, kernels] : sizes_) {
+        for (const auto& [kernel, size] : kernels) {
+            file << adapter << kSeparator << kernel << kSeparator << size << '\n';
+        }
+    }
+    LogInfo("WorkgroupTuner: saved ", path_);
+    return true;
+}
+
+}  // namespace gpu
+}  // namespace mps
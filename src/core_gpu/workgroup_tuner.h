@@ -0,0 +1,88 @@
+#pragma once
+
+#include "core_util/types.h"
+#include <functional>
+#include <map>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace mps {
+namespace gpu {
+
+/// Per-adapter workgroup sizes for the compute kernels whose best size depends on the GPU.
+///
+/// Every compute shader declares `override workgroup_size` (header/workgroup_size.wgsl)
+/// and pipeline creators pass the size as a constant (ComputePipelineDesc::SetWorkgroupSize),
+/// computing dispatch counts from the same value. Tunable kernels look their size up here
+/// by name and fall back to the caller's default when nothing was recorded.
+///
+/// Tune() measures each candidate with a caller-supplied benchmark and keeps the fastest;
+/// mps_bench --tune-workgroups drives it for the solver kernels. Winners are stored per
+/// adapter (name and backend) in a text file that System loads once the GPU is up, so one
+/// file can carry results for both the integrated and the discrete GPU of a machine.
+/// Load() also binds the tuner to that adapter; the binding outlives GPU shutdown so a
+/// benchmark may create and destroy a System per candidate.
+///
+/// Sizes are powers of two (the workgroup reductions halve their stride) within the
+/// device's compute workgroup limits. Main thread only.
+class WorkgroupTuner {
+public:
+    static constexpr const char* kDefaultPath = "mps_workgroup_sizes.txt";
+
+    /// Measures one candidate size; returns milliseconds, or a negative value on failure
+    using Benchmark = std::function<float64(uint32 workgroup_size)>;
+
+    static WorkgroupTuner& GetInstance();
+
+    /// Size being measured by Tune(), else the size recorded for kernel on the bound
+    /// adapter, else fallback
+    uint32 GetSize(const std::string& kernel, uint32 fallback) const;
+
+    /// Record a size for kernel on the bound adapter (ignored if invalid)
+    void SetSize(const std::string& kernel, uint32 size);
+    void ClearSize(const std::string& kernel);
+
+    /// Powers of two from 32 up to min(256, device limit)
+    std::vector<uint32> GetCandidates() const;
+
+    /// Benchmark every candidate, record and return the fastest. If every candidate fails
+    /// the recorded size is kept and returned (fallback when there is none).
+    /// While a candidate is measured GetSize(kernel) returns it, so pipelines created
+    /// inside the benchmark (e.g. by a fresh System) are specialized for it.
+    uint32 Tune(const std::string& kernel, std::span<const uint32> candidates,
+                const Benchmark& benchmark, uint32 fallback = 64);
+
+    /// File used by Load() and Save() (kDefaultPath unless changed)
+    void SetPath(const std::string& path) { path_ = path; }
+    const std::string& GetPath() const { return path_; }
+
+    /// Bind to the current adapter and read recorded sizes, keeping any already recorded
+    /// in this process; false if the file does not exist (nothing tuned yet). Call once
+    /// the GPU device is ready.
+    bool Load();
+    /// Write recorded sizes for every adapter seen in the loaded file and this run
+    bool Save() const;
+
+private:
+    WorkgroupTuner() = default;
+
+    WorkgroupTuner(const WorkgroupTuner&) = delete;
+    WorkgroupTuner& operator=(const WorkgroupTuner&) = delete;
+
+    bool IsValidSize(uint32 size) const;
+
+    std::string path_ = kDefaultPath;
+
+    // Bound adapter ("name (backend)") and its workgroup size limit, set by Load()
+    std::string adapter_key_;
+    uint32 max_size_ = 256;
+
+    // adapter key -> kernel -> size (std::map keeps the saved file stable)
+    std::map<std::string, std::map<std::string, uint32>> sizes_;
+    // kernel -> candidate currently being measured by Tune()
+    std::map<std::string, uint32> candidates_;
+};
+
+}  // namespace gpu
+}  // namespace mps
@@ -1,10 +1,12 @@
 #include "core_simulate/cg_solver.h"
 #include "core_gpu/gpu_core.h"
-#include "core_gpu/shader_loader.h"
+#include "core_gpu/pipeline_registry.h"
 #include "core_gpu/bind_group_builder.h"
-#include "core_gpu/compute_encoder.h"
+#include "core_gpu/compute_pass_recorder.h"
+#include "core_gpu/workgroup_tuner.h"
 #include "core_util/logger.h"
 #include <webgpu/webgpu.h>
+#include <algorithm>
 
 using namespace mps;
 using namespace mps::util;
@@ -19,41 +21,28 @@ namespace simulate {
 
 static GPUBindGroup MakeBG(const GPUComputePipeline& pipeline,
                            const std::string& label,
-                           std::initializer_list<std::pair<uint32, std::pair<WGPUBuffer, uint64>>> entries) {
+                           std::initializer_list<std::pair<uint32, BufferBinding>> entries) {
     auto bgl = wgpuComputePipelineGetBindGroupLayout(pipeline.GetHandle(), 0);
     auto builder = BindGroupBuilder(label);
-    for (auto& [binding, buf_size] : entries) {
-        builder = std::move(builder).AddBuffer(binding, buf_size.first, buf_size.second);
+    for (auto& [binding, buf] : entries) {
+        builder = std::move(builder).AddBuffer(binding, buf.buffer, buf.size, buf.offset);
     }
     auto bg = std::move(builder).Build(bgl);
     wgpuBindGroupLayoutRelease(bgl);
     return bg;
 }
 
-static void Dispatch(WGPUCommandEncoder encoder,
-                     const GPUComputePipeline& pipeline,
-                     const GPUBindGroup& bg,
-                     uint32 workgroup_count) {
-    WGPUComputePassDescriptor pd = WGPU_COMPUTE_PASS_DESCRIPTOR_INIT;
-    WGPUComputePassEncoder pass = wgpuCommandEncoderBeginComputePass(encoder, &pd);
-    ComputeEncoder enc(pass);
-    enc.SetPipeline(pipeline.GetHandle());
-    enc.SetBindGroup(0, bg.GetHandle());
-    enc.Dispatch(workgroup_count);
-    wgpuComputePassEncoderEnd(pass);
-    wgpuComputePassEncoderRelease(pass);
-}
-
-static GPUComputePipeline MakePipeline(const std::string& shader_path,
-                                        const std::string& label) {
-    auto shader = ShaderLoader::CreateModule("core_simulate/" + shader_path, label);
-    WGPUComputePipelineDescriptor desc = WGPU_COMPUTE_PIPELINE_DESCRIPTOR_INIT;
-    desc.label = {label.data(), label.size()};
-    desc.layout = nullptr;
-    desc.compute.module = shader.GetHandle();
-    std::string entry = "cs_main";
-    desc.compute.entryPoint = {entry.data(), entry.size()};
-    return GPUComputePipeline(wgpuDeviceCreateComputePipeline(GPUCore::GetInstance().GetDevice(), &desc));
+// flag_off: optional bool override constant to set to false
+static ComputePipelineDesc PipelineDesc(const std::string& shader_path,
+                                        const std::string& label,
+                                        uint32 workgroup_size,
+                                        const std::string& flag_off = "") {
+    ComputePipelineDesc desc{"core_simulate/" + shader_path, label};
+    desc.SetWorkgroupSize(workgroup_size);
+    if (!flag_off.empty()) {
+        desc.constants.emplace_back(flag_off, 0.0);
+    }
+    return desc;
 }
 
 // ============================================================================
@@ -63,15 +52,20 @@ static GPUComputePipeline MakePipeline(const std::string& shader_path,
 CGSolver::CGSolver() = default;
 CGSolver::~CGSolver() = default;
 
-void CGSolver::Initialize(uint32 node_count, uint32 workgroup_size) {
+void CGSolver::Initialize(uint32 node_count, uint32 workgroup_size, uint32 spmv_workgroup_size) {
+    if (spmv_workgroup_size == 0) spmv_workgroup_size = workgroup_size;
     node_count_ = node_count;
     workgroup_size_ = workgroup_size;
     workgroup_count_ = (node_count + workgroup_size - 1) / workgroup_size;
-    dot_partial_count_ = workgroup_count_;
+    dot_workgroup_size_ = WorkgroupTuner::GetInstance().GetSize(kDotKernel, workgroup_size);
+    dot_partial_count_ = (node_count + dot_workgroup_size_ - 1) / dot_workgroup_size_;
+    spmv_workgroup_count_ = (node_count + spmv_workgroup_size - 1) / spmv_workgroup_size;
+    single_pass_dot_ = GPUCore::GetInstance().UsesSinglePassReductions();
 
     CreateBuffers();
     CreatePipelines();
-    LogInfo("CGSolver: initialized (", node_count_, " nodes)");
+    LogInfo("CGSolver: initialized (", node_count_, " nodes, workgroup sizes ", workgroup_size_,
+            " / dot ", dot_workgroup_size_, " / spmv ", spmv_workgroup_size, ")");
 }
 
 void CGSolver::CreateBuffers() {
@@ -83,33 +77,72 @@ void CGSolver::CreateBuffers() {
     cg_p_ = std::make_unique<GPUBuffer<float32>>(BufferConfig{.usage = srw, .size = vec_sz, .label = "cg_p"});
     cg_ap_ = std::make_unique<GPUBuffer<float32>>(BufferConfig{.usage = srw, .size = vec_sz, .label = "cg_ap"});
 
-    uint64 partial_sz = uint64(dot_partial_count_) * sizeof(float32);
+    // One u32 per dot workgroup (classic) or a vec2f per SpMV workgroup (pipelined)
+    uint64 partial_sz = uint64(std::max(dot_partial_count_, spmv_workgroup_count_)) * 2 * sizeof(float32);
     uint64 scalar_sz = 8 * sizeof(float32);
     partial_ = std::make_unique<GPUBuffer<float32>>(BufferConfig{.usage = srw, .size = partial_sz, .label = "cg_partials"});
+    if (single_pass_dot_) {
+        dot_ticket_ = std::make_unique<GPUBuffer<uint32>>(BufferConfig{.usage = srw, .size = sizeof(uint32), .label = "cg_dot_ticket"});
+    }
     scalar_ = std::make_unique<GPUBuffer<float32>>(BufferConfig{.usage = srw, .size = scalar_sz, .label = "cg_scalars"});
 
+    // Indirect dispatch args (zeroed by cg_compute_scalars on convergence)
+    uint32 indirect_init[12] = {workgroup_count_, 1, 1, 1, 1, 1,
+                                dot_partial_count_, 1, 1, spmv_workgroup_count_, 1, 1};
+    indirect_reset_ = std::make_unique<GPUBuffer<uint32>>(
+        BufferUsage::CopySrc, std::span<const uint32>(indirect_init), "cg_indirect_reset");
+    indirect_args_ = std::make_unique<GPUBuffer<uint32>>(
+        BufferUsage::Storage | BufferUsage::Indirect, std::span<const uint32>(indirect_init), "cg_indirect_args");
+
+    auto& pool = GPUBufferPool::GetInstance();
+
     // Dot product config uniforms
     DotConfig dc_rr{0, dot_partial_count_};
     DotConfig dc_pap{1, dot_partial_count_};
     DotConfig dc_rr_new{2, dot_partial_count_};
-    dc_rr_ = std::make_unique<GPUBuffer<DotConfig>>(BufferUsage::Uniform, std::span<const DotConfig>(&dc_rr, 1), "dc_rr");
-    dc_pap_ = std::make_unique<GPUBuffer<DotConfig>>(BufferUsage::Uniform, std::span<const DotConfig>(&dc_pap, 1), "dc_pap");
-    dc_rr_new_ = std::make_unique<GPUBuffer<DotConfig>>(BufferUsage::Uniform, std::span<const DotConfig>(&dc_rr_new, 1), "dc_rr_new");
+    dc_rr_ = pool.Allocate(BufferUsage::Uniform, std::span<const DotConfig>(&dc_rr, 1));
+    dc_pap_ = pool.Allocate(BufferUsage::Uniform, std::span<const DotConfig>(&dc_pap, 1));
+    dc_rr_new_ = pool.Allocate(BufferUsage::Uniform, std::span<const DotConfig>(&dc_rr_new, 1));
 
     // Scalar mode uniforms
     ScalarMode mode_alpha{0};
     ScalarMode mode_beta{1};
-    mode_alpha_ = std::make_unique<GPUBuffer<ScalarMode>>(BufferUsage::Uniform, std::span<const ScalarMode>(&mode_alpha, 1), "cg_mode_alpha");
-    mode_beta_ = std::make_unique<GPUBuffer<ScalarMode>>(BufferUsage::Uniform, std::span<const ScalarMode>(&mode_beta, 1), "cg_mode_beta");
+    ScalarMode mode_rr0{2};
+    mode_alpha_ = pool.Allocate(BufferUsage::Uniform, std::span<const ScalarMode>(&mode_alpha, 1));
+    mode_beta_ = pool.Allocate(BufferUsage::Uniform, std::span<const ScalarMode>(&mode_beta, 1));
+    mode_rr0_ = pool.Allocate(BufferUsage::Uniform, std::span<const ScalarMode>(&mode_rr0, 1));
+
+    // Pipelined CG reduction configs
+    ReduceConfig reduce_init{0, spmv_workgroup_count_};
+    ReduceConfig reduce_iterate{1, spmv_workgroup_count_};
+    reduce_init_ = pool.Allocate(BufferUsage::Uniform, std::span<const ReduceConfig>(&reduce_init, 1));
+    reduce_iterate_ = pool.Allocate(BufferUsage::Uniform, std::span<const ReduceConfig>(&reduce_iterate, 1));
 }
 
 void CGSolver::CreatePipelines() {
-    cg_init_pipeline_ = MakePipeline("cg_init.wgsl", "cg_init");
-    cg_dot_pipeline_ = MakePipeline("cg_dot.wgsl", "cg_dot");
-    cg_dot_final_pipeline_ = MakePipeline("cg_dot_final.wgsl", "cg_dot_final");
-    cg_compute_scalars_pipeline_ = MakePipeline("cg_compute_scalars.wgsl", "cg_compute_scalars");
-    cg_update_xr_pipeline_ = MakePipeline("cg_update_xr.wgsl", "cg_update_xr");
-    cg_update_p_pipeline_ = MakePipeline("cg_update_p.wgsl", "cg_update_p");
+    PipelineBatch batch;
+    uint32 wg = workgroup_size_;
+    batch.Add(PipelineDesc("cg_init.wgsl", "cg_init", wg), cg_init_pipeline_);
+    // Dots finish in one dispatch; subgroupAdd replaces the shared-memory tree when available.
+    // Without single-pass reductions, partials and the final sum are separate dispatches.
+    if (single_pass_dot_) {
+        bool subgroups = GPUCore::GetInstance().SupportsSubgroups();
+        batch.Add(PipelineDesc(subgroups ? "cg_dot_reduce_subgroup.wgsl" : "cg_dot_reduce.wgsl", "cg_dot",
+                               dot_workgroup_size_),
+                  cg_dot_pipeline_);
+    } else {
+        batch.Add(PipelineDesc("cg_dot.wgsl", "cg_dot", dot_workgroup_size_), cg_dot_pipeline_);
+        batch.Add(PipelineDesc("cg_dot_final.wgsl", "cg_dot_final", dot_workgroup_size_),
+                  cg_dot_final_pipeline_);
+    }
+    // Single-thread kernel (@workgroup_size(1)); the constant is unused there
+    batch.Add(ComputePipelineDesc{"core_simulate/cg_compute_scalars.wgsl", "cg_compute_scalars"},
+              cg_compute_scalars_pipeline_);
+    batch.Add(PipelineDesc("cg_update_xr.wgsl", "cg_update_xr", wg), cg_update_xr_pipeline_);
+    batch.Add(PipelineDesc("cg_update_p.wgsl", "cg_update_p", wg), cg_update_p_pipeline_);
+    batch.Add(PipelineDesc("cg_precond_invert.wgsl", "cg_precond_invert", wg), cg_precond_invert_pipeline_);
+    batch.Add(PipelineDesc("cg_precond_apply.wgsl", "cg_precond_apply", wg), cg_precond_apply_pipeline_);
+    batch.Resolve();
 }
 
 WGPUBuffer CGSolver::GetRHSBuffer() const { return cg_r_ ? cg_r_->GetHandle() : nullptr; }
@@ -119,7 +152,9 @@ uint64 CGSolver::GetVectorSize() const { return uint64(node_count_) * 4 * sizeof
 void CGSolver::CacheBindGroups(WGPUBuffer physics_buffer, uint64 physics_size,
                                WGPUBuffer params_buffer, uint64 params_size,
                                WGPUBuffer mass_buffer, uint64 mass_size,
-                               ISpMVOperator& spmv) {
+                               ISpMVOperator& spmv,
+                               WGPUBuffer diag_buffer, uint64 diag_size,
+                               uint64 mass_offset) {
     uint64 vec_sz = GetVectorSize();
     uint64 partial_sz = uint64(dot_partial_count_) * sizeof(float32);
     uint64 scalar_sz = 8 * sizeof(float32);
@@ -130,87 +165,335 @@ void CGSolver::CacheBindGroups(WGPUBuffer physics_buffer, uint64 physics_size,
     WGPUBuffer ap_h = cg_ap_->GetHandle();
     WGPUBuffer partial_h = partial_->GetHandle();
     WGPUBuffer scalar_h = scalar_->GetHandle();
+    WGPUBuffer indirect_h = indirect_args_->GetHandle();
+    uint64 indirect_sz = indirect_args_->GetByteLength();
+
+    // Preconditioned residual z = D^-1 r. Without a preconditioner z aliases r,
+    // so the same bind group layout serves both variants.
+    WGPUBuffer z_h = r_h;
+    block_jacobi_ = preconditioner_ == CGPreconditioner::BlockJacobi && diag_buffer;
+    if (preconditioner_ == CGPreconditioner::BlockJacobi && !diag_buffer) {
+        LogWarning("CGSolver: block-Jacobi requested without a diagonal buffer, running unpreconditioned");
+    }
+    if (block_jacobi_) {
+        auto srw = BufferUsage::Storage | BufferUsage::CopyDst | BufferUsage::CopySrc;
+        uint64 inv_sz = uint64(node_count_) * 12 * sizeof(float32);
+        cg_z_ = std::make_unique<GPUBuffer<float32>>(BufferConfig{.usage = srw, .size = vec_sz, .label = "cg_z"});
+        block_inv_ = std::make_unique<GPUBuffer<float32>>(BufferConfig{.usage = srw, .size = inv_sz, .label = "cg_block_inv"});
+        z_h = cg_z_->GetHandle();
+
+        bg_precond_invert_ = MakeBG(cg_precond_invert_pipeline_, "bg_precond_invert",
+            {{0, {params_buffer, params_size}},
+             {1, {diag_buffer, diag_size}}, {2, {block_inv_->GetHandle(), inv_sz}},
+             {3, {mass_buffer, mass_size, mass_offset}}});
+        bg_precond_apply_ = MakeBG(cg_precond_apply_pipeline_, "bg_precond_apply",
+            {{0, {params_buffer, params_size}},
+             {1, {r_h, vec_sz}}, {2, {block_inv_->GetHandle(), inv_sz}},
+             {3, {z_h, vec_sz}}, {4, {mass_buffer, mass_size, mass_offset}}});
+    } else {
+        cg_z_.reset();
+        block_inv_.reset();
+        bg_precond_invert_ = {};
+        bg_precond_apply_ = {};
+    }
 
+    // p = z
     bg_init_ = MakeBG(cg_init_pipeline_, "bg_cg_init",
         {{0, {params_buffer, params_size}},
-         {1, {x_h, vec_sz}}, {2, {r_h, vec_sz}}, {3, {p_h, vec_sz}}});
-
-    bg_dot_rr_ = MakeBG(cg_dot_pipeline_, "bg_dot_rr",
-        {{0, {params_buffer, params_size}},
-         {1, {r_h, vec_sz}}, {2, {r_h, vec_sz}}, {3, {partial_h, partial_sz}}});
-
-    bg_dot_pap_ = MakeBG(cg_dot_pipeline_, "bg_dot_pap",
-        {{0, {params_buffer, params_size}},
-         {1, {p_h, vec_sz}}, {2, {ap_h, vec_sz}}, {3, {partial_h, partial_sz}}});
-
-    bg_df_rr_ = MakeBG(cg_dot_final_pipeline_, "bg_df_rr",
-        {{0, {partial_h, partial_sz}}, {1, {scalar_h, scalar_sz}}, {2, {dc_rr_->GetHandle(), sizeof(DotConfig)}}});
-    bg_df_pap_ = MakeBG(cg_dot_final_pipeline_, "bg_df_pap",
-        {{0, {partial_h, partial_sz}}, {1, {scalar_h, scalar_sz}}, {2, {dc_pap_->GetHandle(), sizeof(DotConfig)}}});
-    bg_df_rr_new_ = MakeBG(cg_dot_final_pipeline_, "bg_df_rr_new",
-        {{0, {partial_h, partial_sz}}, {1, {scalar_h, scalar_sz}}, {2, {dc_rr_new_->GetHandle(), sizeof(DotConfig)}}});
+         {1, {x_h, vec_sz}}, {2, {z_h, vec_sz}}, {3, {p_h, vec_sz}}});
+
+    // Dots: rz = dot(r, z) (rr when unpreconditioned) → scalars[0] / [2],
+    // pAp = dot(p, Ap) → scalars[1]
+    if (single_pass_dot_) {
+        WGPUBuffer ticket_h = dot_ticket_->GetHandle();
+        auto make_dot_bg = [&](const std::string& label, WGPUBuffer a, WGPUBuffer b,
+                               const GPUBufferSlice& config) {
+            return MakeBG(cg_dot_pipeline_, label,
+                {{0, {params_buffer, params_size}},
+                 {1, {a, vec_sz}}, {2, {b, vec_sz}}, {3, {partial_h, partial_sz}},
+                 {4, {scalar_h, scalar_sz}}, {5, config.GetBinding()},
+                 {6, {ticket_h, sizeof(uint32)}}});
+        };
+        bg_dot_rr_ = make_dot_bg("bg_dot_rr", r_h, z_h, dc_rr_);
+        bg_dot_pap_ = make_dot_bg("bg_dot_pap", p_h, ap_h, dc_pap_);
+        bg_dot_rr_new_ = make_dot_bg("bg_dot_rr_new", r_h, z_h, dc_rr_new_);
+    } else {
+        auto make_dot_bg = [&](const std::string& label, WGPUBuffer a, WGPUBuffer b) {
+            return MakeBG(cg_dot_pipeline_, label,
+                {{0, {params_buffer, params_size}},
+                 {1, {a, vec_sz}}, {2, {b, vec_sz}}, {3, {partial_h, partial_sz}}});
+        };
+        auto make_final_bg = [&](const std::string& label, const GPUBufferSlice& config) {
+            return MakeBG(cg_dot_final_pipeline_, label,
+                {{0, {partial_h, partial_sz}}, {1, {scalar_h, scalar_sz}},
+                 {2, config.GetBinding()}});
+        };
+        bg_dot_rr_ = make_dot_bg("bg_dot_rr", r_h, z_h);
+        bg_dot_pap_ = make_dot_bg("bg_dot_pap", p_h, ap_h);
+        bg_dot_rr_new_ = make_dot_bg("bg_dot_rr_new", r_h, z_h);
+        bg_dot_final_rr_ = make_final_bg("bg_dot_final_rr", dc_rr_);
+        bg_dot_final_pap_ = make_final_bg("bg_dot_final_pap", dc_pap_);
+        bg_dot_final_rr_new_ = make_final_bg("bg_dot_final_rr_new", dc_rr_new_);
+    }
 
     bg_alpha_ = MakeBG(cg_compute_scalars_pipeline_, "bg_alpha",
-        {{0, {scalar_h, scalar_sz}}, {1, {mode_alpha_->GetHandle(), sizeof(ScalarMode)}}});
+        {{0, {scalar_h, scalar_sz}}, {1, mode_alpha_.GetBinding()},
+         {2, {params_buffer, params_size}}, {3, {indirect_h, indirect_sz}}});
     bg_beta_ = MakeBG(cg_compute_scalars_pipeline_, "bg_beta",
-        {{0, {scalar_h, scalar_sz}}, {1, {mode_beta_->GetHandle(), sizeof(ScalarMode)}}});
+        {{0, {scalar_h, scalar_sz}}, {1, mode_beta_.GetBinding()},
+         {2, {params_buffer, params_size}}, {3, {indirect_h, indirect_sz}}});
+    bg_rr0_ = MakeBG(cg_compute_scalars_pipeline_, "bg_rr0",
+        {{0, {scalar_h, scalar_sz}}, {1, mode_rr0_.GetBinding()},
+         {2, {params_buffer, params_size}}, {3, {indirect_h, indirect_sz}}});
 
     bg_xr_ = MakeBG(cg_update_xr_pipeline_, "bg_xr",
         {{0, {params_buffer, params_size}},
          {1, {x_h, vec_sz}}, {2, {r_h, vec_sz}},
          {3, {p_h, vec_sz}}, {4, {ap_h, vec_sz}}, {5, {scalar_h, scalar_sz}},
-         {6, {mass_buffer, mass_size}}});
+         {6, {mass_buffer, mass_size, mass_offset}}});
 
+    // p = z + beta * p
     bg_p_ = MakeBG(cg_update_p_pipeline_, "bg_p",
         {{0, {params_buffer, params_size}},
-         {1, {r_h, vec_sz}}, {2, {p_h, vec_sz}},
-         {3, {scalar_h, scalar_sz}}, {4, {mass_buffer, mass_size}}});
+         {1, {z_h, vec_sz}}, {2, {p_h, vec_sz}},
+         {3, {scalar_h, scalar_sz}}, {4, {mass_buffer, mass_size, mass_offset}}});
 
     // Prepare SpMV operator with CG buffers and cache pointer
     spmv.PrepareSolve(p_h, vec_sz, ap_h, vec_sz);
     spmv_ = &spmv;
 
-    LogInfo("CGSolver: bind groups cached");
+    pipelined_active_ = false;
+    if (pipelined_) {
+        CachePipelinedBindGroups(params_buffer, params_size, mass_buffer, mass_size, mass_offset,
+                                 diag_buffer, diag_size);
+    }
+
+    LogInfo("CGSolver: bind groups cached", pipelined_active_ ? " (pipelined)" : "");
+}
+
+void CGSolver::CachePipelinedBindGroups(WGPUBuffer params_buffer, uint64 params_size,
+                                        WGPUBuffer mass_buffer, uint64 mass_size, uint64 mass_offset,
+                                        WGPUBuffer diag_buffer, uint64 diag_size) {
+    auto srw = BufferUsage::Storage | BufferUsage::CopyDst | BufferUsage::CopySrc;
+    uint64 vec_sz = GetVectorSize();
+    uint64 inv_sz = uint64(node_count_) * 12 * sizeof(float32);
+    uint64 partial_sz = uint64(spmv_workgroup_count_) * 2 * sizeof(float32);
+    uint64 scalar_sz = 8 * sizeof(float32);
+
+    // u = M^-1 r lives in cg_z_; block_inv_ doubles as the MPCG filter, so it
+    // exists even without block-Jacobi (identity blocks for free nodes).
+    if (!cg_z_) {
+        cg_z_ = std::make_unique<GPUBuffer<float32>>(BufferConfig{.usage = srw, .size = vec_sz, .label = "cg_z"});
+    }
+    if (!block_inv_) {
+        block_inv_ = std::make_unique<GPUBuffer<float32>>(BufferConfig{.usage = srw, .size = inv_sz, .label = "cg_block_inv"});
+    }
+    cg_w_ = std::make_unique<GPUBuffer<float32>>(BufferConfig{.usage = srw, .size = vec_sz, .label = "cg_w"});
+
+    WGPUBuffer u_h = cg_z_->GetHandle();
+    WGPUBuffer w_h = cg_w_->GetHandle();
+    WGPUBuffer r_h = cg_r_->GetHandle();
+    WGPUBuffer partial_h = partial_->GetHandle();
+
+    if (!spmv_->PrepareFusedSolve(u_h, w_h, r_h, vec_sz, partial_h, partial_sz)) {
+        LogWarning("CGSolver: SpMV operator has no fused variant, using classic CG");
+        cg_w_.reset();
+        if (!block_jacobi_) {
+            cg_z_.reset();
+            block_inv_.reset();
+        }
+        return;
+    }
+
+    if (!cg_pipelined_update_pipeline_) {
+        PipelineBatch batch;
+        uint32 wg = workgroup_size_;
+        batch.Add(PipelineDesc("cg_precond_invert.wgsl", "cg_precond_identity", wg, "invert_blocks"),
+                  cg_precond_identity_pipeline_);
+        batch.Add(PipelineDesc("cg_pipelined_init.wgsl", "cg_pipelined_init", wg), cg_pipelined_init_pipeline_);
+        batch.Add(PipelineDesc("cg_pipelined_update.wgsl", "cg_pipelined_update", wg), cg_pipelined_update_pipeline_);
+        batch.Add(PipelineDesc("cg_pipelined_scalars.wgsl", "cg_pipelined_scalars", wg), cg_pipelined_scalars_pipeline_);
+        batch.Resolve();
+    }
+
+    // Without block-Jacobi the identity setup pass runs instead; diag is unread
+    // there but still bound, so any read-only buffer not written by it will do.
+    if (!block_jacobi_) {
+        bg_precond_invert_ = MakeBG(cg_precond_identity_pipeline_, "bg_precond_identity",
+            {{0, {params_buffer, params_size}},
+             {1, {partial_h, partial_sz}}, {2, {block_inv_->GetHandle(), inv_sz}},
+             {3, {mass_buffer, mass_size, mass_offset}}});
+    }
+
+    WGPUBuffer x_h = cg_x_->GetHandle();
+    WGPUBuffer p_h = cg_p_->GetHandle();
+    WGPUBuffer s_h = cg_ap_->GetHandle();
+    WGPUBuffer scalar_h = scalar_->GetHandle();
+    WGPUBuffer inv_h = block_inv_->GetHandle();
+    WGPUBuffer indirect_h = indirect_args_->GetHandle();
+    uint64 indirect_sz = indirect_args_->GetByteLength();
+
+    bg_pl_init_ = MakeBG(cg_pipelined_init_pipeline_, "bg_pl_init",
+        {{0, {params_buffer, params_size}},
+         {1, {x_h, vec_sz}}, {2, {r_h, vec_sz}}, {3, {p_h, vec_sz}},
+         {4, {s_h, vec_sz}}, {5, {u_h, vec_sz}}, {6, {inv_h, inv_sz}}});
+
+    bg_pl_update_ = MakeBG(cg_pipelined_update_pipeline_, "bg_pl_update",
+        {{0, {params_buffer, params_size}},
+         {1, {x_h, vec_sz}}, {2, {r_h, vec_sz}}, {3, {p_h, vec_sz}},
+         {4, {s_h, vec_sz}}, {5, {u_h, vec_sz}}, {6, {w_h, vec_sz}},
+         {7, {scalar_h, scalar_sz}}, {8, {inv_h, inv_sz}}});
+
+    bg_pl_reduce_init_ = MakeBG(cg_pipelined_scalars_pipeline_, "bg_pl_reduce_init",
+        {{0, {partial_h, partial_sz}}, {1, {scalar_h, scalar_sz}},
+         {2, reduce_init_.GetBinding()},
+         {3, {params_buffer, params_size}}, {4, {indirect_h, indirect_sz}}});
+    bg_pl_reduce_iterate_ = MakeBG(cg_pipelined_scalars_pipeline_, "bg_pl_reduce_iterate",
+        {{0, {partial_h, partial_sz}}, {1, {scalar_h, scalar_sz}},
+         {2, reduce_iterate_.GetBinding()},
+         {3, {params_buffer, params_size}}, {4, {indirect_h, indirect_sz}}});
+
+    pipelined_active_ = true;
+}
+
+void CGSolver::Solve(ComputePassRecorder& recorder, uint32 cg_iterations) {
+    if (pipelined_active_) {
+        SolvePipelined(recorder, cg_iterations);
+    } else {
+        SolveClassic(recorder, cg_iterations);
+    }
 }
 
-void CGSolver::Solve(WGPUCommandEncoder encoder, uint32 cg_iterations) {
+void CGSolver::SolveClassic(ComputePassRecorder& recorder, uint32 cg_iterations) {
     uint64 scalar_sz = 8 * sizeof(float32);
     WGPUBuffer scalar_h = scalar_->GetHandle();
+    WGPUBuffer indirect_h = indirect_args_->GetHandle();
+
+    // Per-iteration passes: indirect when the convergence check is enabled,
+    // so they collapse to empty dispatches once the residual is small enough.
+    auto node_pass = [&](const GPUComputePipeline& pipeline, const GPUBindGroup& bg) {
+        if (convergence_check_) {
+            recorder.DispatchIndirect(pipeline, bg, indirect_h, kIndirectNodeOffset);
+        } else {
+            recorder.Dispatch(pipeline, bg, workgroup_count_);
+        }
+    };
+    auto dot_pass = [&](const GPUBindGroup& bg, const GPUBindGroup& final_bg) {
+        if (convergence_check_) {
+            recorder.DispatchIndirect(cg_dot_pipeline_, bg, indirect_h, kIndirectDotOffset);
+        } else {
+            recorder.Dispatch(cg_dot_pipeline_, bg, dot_partial_count_);
+        }
+        if (single_pass_dot_) return;
+        if (convergence_check_) {
+            recorder.DispatchIndirect(cg_dot_final_pipeline_, final_bg, indirect_h, kIndirectSingleOffset);
+        } else {
+            recorder.Dispatch(cg_dot_final_pipeline_, final_bg, 1);
+        }
+    };
+
+    // Clear scalar buffer and re-arm indirect args (a previous Solve may have
+    // zeroed them). These are the only pass splits; the loop below is one pass.
+    recorder.ClearBuffer(scalar_h, 0, scalar_sz);
+    if (convergence_check_) {
+        recorder.CopyBufferToBuffer(indirect_reset_->GetHandle(), 0, indirect_h, 0,
+                                    indirect_args_->GetByteLength());
+    }
+
+    // Block-Jacobi: invert the diagonal blocks assembled for this Newton
+    // iteration, then z = D^-1 r
+    bool block_jacobi = block_jacobi_;
+    if (block_jacobi) {
+        recorder.Dispatch(cg_precond_invert_pipeline_, bg_precond_invert_, workgroup_count_);
+        recorder.Dispatch(cg_precond_apply_pipeline_, bg_precond_apply_, workgroup_count_);
+    }
 
-    // Clear scalar buffer
-    wgpuCommandEncoderClearBuffer(encoder, scalar_h, 0, scalar_sz);
+    // CG init: x = 0, p = z
+    recorder.Dispatch(cg_init_pipeline_, bg_init_, workgroup_count_);
 
-    // CG init: x = 0, p = r
-    Dispatch(encoder, cg_init_pipeline_, bg_init_, workgroup_count_);
+    // Initial rr = dot(r, z) → scalars[0]
+    recorder.Dispatch(cg_dot_pipeline_, bg_dot_rr_, dot_partial_count_);
+    if (!single_pass_dot_) {
+        recorder.Dispatch(cg_dot_final_pipeline_, bg_dot_final_rr_, 1);
+    }
 
-    // Initial rr = dot(r, r) → scalars[0]
-    Dispatch(encoder, cg_dot_pipeline_, bg_dot_rr_, workgroup_count_);
-    Dispatch(encoder, cg_dot_final_pipeline_, bg_df_rr_, 1);
+    // rr0 = rr → scalars[5] (convergence reference)
+    if (convergence_check_) {
+        recorder.Dispatch(cg_compute_scalars_pipeline_, bg_rr0_, 1);
+    }
 
     // CG iterations
     for (uint32 cit = 0; cit < cg_iterations; ++cit) {
         // Ap = A * p (SpMV operator dispatches with its own cached bind group)
-        spmv_->Apply(encoder, workgroup_count_);
+        if (convergence_check_) {
+            spmv_->ApplyIndirect(recorder, indirect_h, kIndirectSpMVOffset);
+        } else {
+            spmv_->Apply(recorder, spmv_workgroup_count_);
+        }
 
         // pAp = dot(p, Ap) → scalars[1]
-        Dispatch(encoder, cg_dot_pipeline_, bg_dot_pap_, workgroup_count_);
-        Dispatch(encoder, cg_dot_final_pipeline_, bg_df_pap_, 1);
+        dot_pass(bg_dot_pap_, bg_dot_final_pap_);
 
         // alpha = rr / pAp → scalars[3]
-        Dispatch(encoder, cg_compute_scalars_pipeline_, bg_alpha_, 1);
+        // (scalar passes stay direct: they write the indirect args buffer)
+        recorder.Dispatch(cg_compute_scalars_pipeline_, bg_alpha_, 1);
 
         // x += alpha*p, r -= alpha*Ap
-        Dispatch(encoder, cg_update_xr_pipeline_, bg_xr_, workgroup_count_);
+        node_pass(cg_update_xr_pipeline_, bg_xr_);
+
+        // z = D^-1 r
+        if (block_jacobi) {
+            node_pass(cg_precond_apply_pipeline_, bg_precond_apply_);
+        }
+
+        // rr_new = dot(r, z) → scalars[2]
+        dot_pass(bg_dot_rr_new_, bg_dot_final_rr_new_);
+
+        // beta = rr_new / rr, advance rr = rr_new, test convergence
+        recorder.Dispatch(cg_compute_scalars_pipeline_, bg_beta_, 1);
+
+        // p = z + beta * p
+        node_pass(cg_update_p_pipeline_, bg_p_);
+    }
+}
+
+void CGSolver::SolvePipelined(ComputePassRecorder& recorder, uint32 cg_iterations) {
+    uint64 scalar_sz = 8 * sizeof(float32);
+    WGPUBuffer scalar_h = scalar_->GetHandle();
+    WGPUBuffer indirect_h = indirect_args_->GetHandle();
 
-        // rr_new = dot(r, r) → scalars[2]
-        Dispatch(encoder, cg_dot_pipeline_, bg_dot_rr_, workgroup_count_);
-        Dispatch(encoder, cg_dot_final_pipeline_, bg_df_rr_new_, 1);
+    recorder.ClearBuffer(scalar_h, 0, scalar_sz);
+    if (convergence_check_) {
+        recorder.CopyBufferToBuffer(indirect_reset_->GetHandle(), 0, indirect_h, 0,
+                                    indirect_args_->GetByteLength());
+    }
+
+    // M^-1 blocks: D^-1 (block-Jacobi) or identity, zero on pinned nodes
+    recorder.Dispatch(block_jacobi_ ? cg_precond_invert_pipeline_ : cg_precond_identity_pipeline_,
+                      bg_precond_invert_, workgroup_count_);
 
-        // beta = rr_new / rr, advance rr = rr_new
-        Dispatch(encoder, cg_compute_scalars_pipeline_, bg_beta_, 1);
+    // x = p = s = 0, u = M^-1 r
+    recorder.Dispatch(cg_pipelined_init_pipeline_, bg_pl_init_, workgroup_count_);
 
-        // p = r + beta * p
-        Dispatch(encoder, cg_update_p_pipeline_, bg_p_, workgroup_count_);
+    // w = A u with (r.u, w.u) partials, then gamma0 / alpha0
+    spmv_->ApplyFused(recorder, spmv_workgroup_count_);
+    recorder.Dispatch(cg_pipelined_scalars_pipeline_, bg_pl_reduce_init_, 1);
+
+    // Three dispatches per iteration; the scalar pass stays direct since it
+    // writes the indirect args.
+    for (uint32 cit = 0; cit < cg_iterations; ++cit) {
+        // p, s, x, r, u update
+        if (convergence_check_) {
+            recorder.DispatchIndirect(cg_pipelined_update_pipeline_, bg_pl_update_,
+                                      indirect_h, kIndirectNodeOffset);
+            spmv_->ApplyFusedIndirect(recorder, indirect_h, kIndirectSpMVOffset);
+        } else {
+            recorder.Dispatch(cg_pipelined_update_pipeline_, bg_pl_update_, workgroup_count_);
+            spmv_->ApplyFused(recorder, spmv_workgroup_count_);
+        }
+
+        // gamma, delta -> alpha, beta; test convergence
+        recorder.Dispatch(cg_pipelined_scalars_pipeline_, bg_pl_reduce_iterate_, 1);
     }
 }
 
@@ -219,13 +502,21 @@ void CGSolver::Shutdown() {
     bg_init_ = {};
     bg_dot_rr_ = {};
     bg_dot_pap_ = {};
-    bg_df_rr_ = {};
-    bg_df_pap_ = {};
-    bg_df_rr_new_ = {};
+    bg_dot_rr_new_ = {};
+    bg_dot_final_rr_ = {};
+    bg_dot_final_pap_ = {};
+    bg_dot_final_rr_new_ = {};
     bg_alpha_ = {};
     bg_beta_ = {};
+    bg_rr0_ = {};
     bg_xr_ = {};
     bg_p_ = {};
+    bg_precond_invert_ = {};
+    bg_precond_apply_ = {};
+    bg_pl_init_ = {};
+    bg_pl_update_ = {};
+    bg_pl_reduce_init_ = {};
+    bg_pl_reduce_iterate_ = {};
     spmv_ = nullptr;
 
     cg_init_pipeline_ = {};
@@ -234,18 +525,33 @@ void CGSolver::Shutdown() {
     cg_compute_scalars_pipeline_ = {};
     cg_update_xr_pipeline_ = {};
     cg_update_p_pipeline_ = {};
+    cg_precond_invert_pipeline_ = {};
+    cg_precond_apply_pipeline_ = {};
+    cg_precond_identity_pipeline_ = {};
+    cg_pipelined_init_pipeline_ = {};
+    cg_pipelined_update_pipeline_ = {};
+    cg_pipelined_scalars_pipeline_ = {};
 
     cg_x_.reset();
     cg_r_.reset();
     cg_p_.reset();
     cg_ap_.reset();
+    cg_z_.reset();
+    block_inv_.reset();
+    cg_w_.reset();
     partial_.reset();
+    dot_ticket_.reset();
     scalar_.reset();
-    dc_rr_.reset();
-    dc_pap_.reset();
-    dc_rr_new_.reset();
-    mode_alpha_.reset();
-    mode_beta_.reset();
+    indirect_args_.reset();
+    indirect_reset_.reset();
+    dc_rr_ = {};
+    dc_pap_ = {};
+    dc_rr_new_ = {};
+    mode_alpha_ = {};
+    mode_beta_ = {};
+    mode_rr0_ = {};
+    reduce_init_ = {};
+    reduce_iterate_ = {};
 
     LogInfo("CGSolver: shutdown");
 }
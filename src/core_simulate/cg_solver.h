@@ -3,12 +3,15 @@
 #include "core_util/types.h"
 #include "core_gpu/gpu_handle.h"
 #include "core_gpu/gpu_buffer.h"
+#include "core_gpu/gpu_buffer_pool.h"
+#include "core_simulate/solver_params.h"
 #include <memory>
 
 struct WGPUCommandEncoderImpl;  typedef WGPUCommandEncoderImpl* WGPUCommandEncoder;
 struct WGPUBufferImpl;          typedef WGPUBufferImpl*          WGPUBuffer;
 
 namespace mps {
+namespace gpu { class ComputePassRecorder; }
 namespace simulate {
 
 // Interface for sparse matrix-vector product used by the CG solver.
@@ -21,18 +24,74 @@ public:
     virtual void PrepareSolve(WGPUBuffer p_buffer, uint64 p_size,
                               WGPUBuffer ap_buffer, uint64 ap_size) = 0;
 
-    // Dispatch Ap = A * p (one compute pass)
-    virtual void Apply(WGPUCommandEncoder encoder, uint32 workgroup_count) = 0;
+    // Dispatch Ap = A * p (one dispatch, batched into the recorder's open pass)
+    virtual void Apply(gpu::ComputePassRecorder& recorder, uint32 workgroup_count) = 0;
+
+    // Same as Apply, but the workgroup count is read from indirect_buffer at
+    // indirect_offset (x, y, z as u32). Used by the convergence-aware CG loop.
+    virtual void ApplyIndirect(gpu::ComputePassRecorder& recorder,
+                               WGPUBuffer indirect_buffer, uint64 indirect_offset) = 0;
+
+    // Optional fused variant for pipelined CG: w = A * u, plus per-workgroup
+    // partial sums (r.u, w.u) written as vec2f to partials[workgroup_id] in the
+    // same dispatch (spmv_workgroup_size-node workgroups, see CGSolver::Initialize).
+    // Returns false if unsupported, in which case the solver keeps the classic loop.
+    virtual bool PrepareFusedSolve(WGPUBuffer /*u_buffer*/, WGPUBuffer /*w_buffer*/,
+                                   WGPUBuffer /*r_buffer*/, uint64 /*vec_size*/,
+                                   WGPUBuffer /*partial_buffer*/, uint64 /*partial_size*/) {
+        return false;
+    }
+    virtual void ApplyFused(gpu::ComputePassRecorder& /*recorder*/, uint32 /*workgroup_count*/) {}
+    virtual void ApplyFusedIndirect(gpu::ComputePassRecorder& /*recorder*/,
+                                    WGPUBuffer /*indirect_buffer*/, uint64 /*indirect_offset*/) {}
 };
 
 // Generic GPU conjugate gradient solver.
 // Uses MPCG (mass-filtered CG) for pinned nodes (inv_mass == 0).
+//
+// With CGPreconditioner::BlockJacobi, each solve first inverts the assembled
+// 3x3 diagonal blocks, then iterates on z = D^-1 r: the scalar passes work on
+// r.z instead of r.r and the search direction is built from z.
+//
+// Pipelined mode (Chronopoulos-Gear CG) restructures the iteration so both dot
+// products come from one reduction: three dispatches per iteration instead of
+// seven (vector update; SpMV with fused partial dots; final reduction with the
+// scalar update). It needs ISpMVOperator::PrepareFusedSolve support and costs
+// two extra vectors. Recurrence rounding differs slightly from classic CG.
+//
+// With the convergence check enabled (default), all per-iteration passes are
+// dispatched indirectly. Once rr <= cg_tolerance^2 * rr0 (SolverParams), the
+// scalar pass zeroes the indirect workgroup counts and the remaining
+// iterations become empty dispatches.
+//
+// The vector passes run with workgroup_size. The dot kernel and the SpMV
+// operator have their own sizes, tuned per adapter (gpu::WorkgroupTuner, kernels
+// kDotKernel and kSpMVKernel), each with its own indirect dispatch slot.
+//
+// Dots finish in one dispatch (last-workgroup reduction) unless
+// gpu::GPUConfig::single_pass_reductions is off; then each dot is a partials
+// dispatch followed by a one-workgroup final sum, two more per iteration.
 class CGSolver {
 public:
+    // WorkgroupTuner kernel names
+    static constexpr const char* kDotKernel = "cg_dot";
+    static constexpr const char* kSpMVKernel = "cg_spmv";
+
     CGSolver();
     ~CGSolver();
 
-    void Initialize(uint32 node_count, uint32 workgroup_size = 64);
+    // spmv_workgroup_size: workgroup size the ISpMVOperator's pipelines were created
+    // with (0 = workgroup_size); the solver sizes SpMV dispatches and fused partials by it.
+    void Initialize(uint32 node_count, uint32 workgroup_size = 64, uint32 spmv_workgroup_size = 0);
+
+    // Toggle residual-based early termination (call anytime)
+    void SetConvergenceCheck(bool enabled) { convergence_check_ = enabled; }
+
+    // Select the preconditioner (call before CacheBindGroups)
+    void SetPreconditioner(CGPreconditioner preconditioner) { preconditioner_ = preconditioner; }
+
+    // Use the pipelined (fused) iteration (call before CacheBindGroups)
+    void SetPipelined(bool enabled) { pipelined_ = enabled; }
 
     // Callers write RHS into this buffer before calling Solve()
     [[nodiscard]] WGPUBuffer GetRHSBuffer() const;
@@ -45,25 +104,42 @@ public:
 
     // Cache all bind groups for the CG loop. Call after Initialize().
     // Also calls spmv.PrepareSolve() with p and ap buffers.
+    // diag_buffer (3x3 row-major blocks, 9 f32 per node) is required for BlockJacobi.
+    // mass_offset: byte offset of the solved node range in mass_buffer.
     void CacheBindGroups(WGPUBuffer physics_buffer, uint64 physics_size,
                          WGPUBuffer params_buffer, uint64 params_size,
                          WGPUBuffer mass_buffer, uint64 mass_size,
-                         ISpMVOperator& spmv);
+                         ISpMVOperator& spmv,
+                         WGPUBuffer diag_buffer = nullptr, uint64 diag_size = 0,
+                         uint64 mass_offset = 0);
 
     // Run CG solver. RHS must already be in GetRHSBuffer().
     // Bind groups must be cached via CacheBindGroups() first.
-    void Solve(WGPUCommandEncoder encoder, uint32 cg_iterations);
+    void Solve(gpu::ComputePassRecorder& recorder, uint32 cg_iterations);
 
     void Shutdown();
 
 private:
     void CreateBuffers();
     void CreatePipelines();
+    void CachePipelinedBindGroups(WGPUBuffer params_buffer, uint64 params_size,
+                                  WGPUBuffer mass_buffer, uint64 mass_size, uint64 mass_offset,
+                                  WGPUBuffer diag_buffer, uint64 diag_size);
+    void SolveClassic(gpu::ComputePassRecorder& recorder, uint32 cg_iterations);
+    void SolvePipelined(gpu::ComputePassRecorder& recorder, uint32 cg_iterations);
 
     uint32 node_count_ = 0;
     uint32 workgroup_size_ = 64;
     uint32 workgroup_count_ = 0;
-    uint32 dot_partial_count_ = 0;
+    uint32 dot_workgroup_size_ = 64;
+    uint32 dot_partial_count_ = 0;     // dot workgroup count
+    uint32 spmv_workgroup_count_ = 0;  // also the pipelined partial count
+    bool convergence_check_ = true;
+    CGPreconditioner preconditioner_ = CGPreconditioner::None;
+    bool block_jacobi_ = false;       // BlockJacobi selected and a diagonal buffer was given
+    bool pipelined_ = false;
+    bool pipelined_active_ = false;   // pipelined_ and the SpMV operator supports it
+    bool single_pass_dot_ = true;     // GPUCore::UsesSinglePassReductions(), read in Initialize
 
     // CG vectors
     std::unique_ptr<gpu::GPUBuffer<float32>> cg_x_;
@@ -71,38 +147,74 @@ private:
     std::unique_ptr<gpu::GPUBuffer<float32>> cg_p_;
     std::unique_ptr<gpu::GPUBuffer<float32>> cg_ap_;
 
-    // Reduction buffers
+    // Block-Jacobi preconditioner (created in CacheBindGroups when selected)
+    std::unique_ptr<gpu::GPUBuffer<float32>> cg_z_;
+    std::unique_ptr<gpu::GPUBuffer<float32>> block_inv_;   // mat3x3f per node (48 B)
+
+    // Pipelined CG: w = A * u (u reuses cg_z_, s reuses cg_ap_ as A * p)
+    std::unique_ptr<gpu::GPUBuffer<float32>> cg_w_;
+
+    // Reduction buffers (partial_ holds a vec2f per workgroup for pipelined CG)
     std::unique_ptr<gpu::GPUBuffer<float32>> partial_;
+    std::unique_ptr<gpu::GPUBuffer<uint32>> dot_ticket_;   // last-workgroup counter, self-resetting
     std::unique_ptr<gpu::GPUBuffer<float32>> scalar_;
 
-    // CG constant uniforms
+    // Indirect dispatch args: [0..2] node-sized, [3..5] single workgroup,
+    // [6..8] dot, [9..11] SpMV. Reset from indirect_reset_ at the start of every Solve().
+    static constexpr uint64 kIndirectNodeOffset = 0;
+    static constexpr uint64 kIndirectSingleOffset = 3 * sizeof(uint32);
+    static constexpr uint64 kIndirectDotOffset = 6 * sizeof(uint32);
+    static constexpr uint64 kIndirectSpMVOffset = 9 * sizeof(uint32);
+    std::unique_ptr<gpu::GPUBuffer<uint32>> indirect_args_;
+    std::unique_ptr<gpu::GPUBuffer<uint32>> indirect_reset_;
+
+    // CG constant uniforms (slices of the shared GPUBufferPool)
     struct alignas(16) DotConfig { uint32 target; uint32 count; };
     struct alignas(16) ScalarMode { uint32 mode; };
-    std::unique_ptr<gpu::GPUBuffer<DotConfig>> dc_rr_;
-    std::unique_ptr<gpu::GPUBuffer<DotConfig>> dc_pap_;
-    std::unique_ptr<gpu::GPUBuffer<DotConfig>> dc_rr_new_;
-    std::unique_ptr<gpu::GPUBuffer<ScalarMode>> mode_alpha_;
-    std::unique_ptr<gpu::GPUBuffer<ScalarMode>> mode_beta_;
+    struct alignas(16) ReduceConfig { uint32 mode; uint32 partial_count; };
+    gpu::GPUBufferSlice dc_rr_;
+    gpu::GPUBufferSlice dc_pap_;
+    gpu::GPUBufferSlice dc_rr_new_;
+    gpu::GPUBufferSlice mode_alpha_;
+    gpu::GPUBufferSlice mode_beta_;
+    gpu::GPUBufferSlice mode_rr0_;
+    gpu::GPUBufferSlice reduce_init_;
+    gpu::GPUBufferSlice reduce_iterate_;
 
     // Pipelines
     gpu::GPUComputePipeline cg_init_pipeline_;
-    gpu::GPUComputePipeline cg_dot_pipeline_;
-    gpu::GPUComputePipeline cg_dot_final_pipeline_;
+    gpu::GPUComputePipeline cg_dot_pipeline_;   // single-dispatch dot (subgroup variant if supported),
+                                                // or level-1 partials when single_pass_dot_ is off
+    gpu::GPUComputePipeline cg_dot_final_pipeline_;   // two-dispatch fallback only
     gpu::GPUComputePipeline cg_compute_scalars_pipeline_;
     gpu::GPUComputePipeline cg_update_xr_pipeline_;
     gpu::GPUComputePipeline cg_update_p_pipeline_;
+    gpu::GPUComputePipeline cg_precond_invert_pipeline_;
+    gpu::GPUComputePipeline cg_precond_apply_pipeline_;
+    gpu::GPUComputePipeline cg_precond_identity_pipeline_;   // cg_precond_invert, invert_blocks = false
+    gpu::GPUComputePipeline cg_pipelined_init_pipeline_;
+    gpu::GPUComputePipeline cg_pipelined_update_pipeline_;
+    gpu::GPUComputePipeline cg_pipelined_scalars_pipeline_;
 
     // Cached bind groups (created in CacheBindGroups)
     gpu::GPUBindGroup bg_init_;
     gpu::GPUBindGroup bg_dot_rr_;
     gpu::GPUBindGroup bg_dot_pap_;
-    gpu::GPUBindGroup bg_df_rr_;
-    gpu::GPUBindGroup bg_df_pap_;
-    gpu::GPUBindGroup bg_df_rr_new_;
+    gpu::GPUBindGroup bg_dot_rr_new_;
+    gpu::GPUBindGroup bg_dot_final_rr_;       // two-dispatch fallback only
+    gpu::GPUBindGroup bg_dot_final_pap_;
+    gpu::GPUBindGroup bg_dot_final_rr_new_;
     gpu::GPUBindGroup bg_alpha_;
     gpu::GPUBindGroup bg_beta_;
+    gpu::GPUBindGroup bg_rr0_;
     gpu::GPUBindGroup bg_xr_;
     gpu::GPUBindGroup bg_p_;
+    gpu::GPUBindGroup bg_precond_invert_;
+    gpu::GPUBindGroup bg_precond_apply_;
+    gpu::GPUBindGroup bg_pl_init_;
+    gpu::GPUBindGroup bg_pl_update_;
+    gpu::GPUBindGroup bg_pl_reduce_init_;
+    gpu::GPUBindGroup bg_pl_reduce_iterate_;
 
     // Cached SpMV operator (non-owning, set in CacheBindGroups)
     ISpMVOperator* spmv_ = nullptr;
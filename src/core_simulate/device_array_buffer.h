@@ -28,6 +28,8 @@ public:
     virtual ~IDeviceArrayEntry() = default;
     virtual void SyncFromHost(database::Database& db) = 0;
     virtual void ForceSyncFromHost(database::Database& db) = 0;
+    // Recompute the entity regions only (no GPU buffer); used by a host-only DeviceDB
+    virtual void SyncLayoutFromHost(database::Database& db) = 0;
     virtual WGPUBuffer GetBufferHandle() const = 0;
     virtual uint32 GetTotalCount() const = 0;
 
@@ -46,7 +48,12 @@ struct ArrayRegion {
 };
 
 // Concatenates per-entity ArrayStorage<T> data into a single contiguous GPU buffer.
-// Entities are sorted by ID for deterministic layout.
+// Entities are sorted by ID for deterministic layout. While the layout (entity set
+// and per-entity counts) is unchanged, sync only rewrites the regions of dirty entities.
+// With a region alignment > 1, each region starts on a multiple of that many elements
+// and the gaps are filled with a padding element, so a region can be bound directly
+// with a storage buffer offset. Uploads go through the gpu::StagingBelt; DeviceDB
+// flushes it at the end of each sync.
 template<database::Component T>
 class DeviceArrayBuffer : public IDeviceArrayEntry {
 public:
@@ -57,7 +64,7 @@ public:
 
     void SyncFromHost(database::Database& db) override {
         auto type_id = database::GetComponentTypeId<T>();
-        const auto* storage = db.GetArrayStorageById(type_id);
+        auto* storage = db.GetArrayStorageById(type_id);
         if (!storage) {
             if (buffer_) buffer_->Clear();
             regions_.clear();
@@ -65,13 +72,17 @@ public:
             return;
         }
         if (!storage->IsDirty() && !ref_layout_changed_ && buffer_) return;
+        if (buffer_ && !storage->IsLayoutDirty() && !ref_layout_changed_) {
+            WriteDirtyRegions(storage);
+            return;
+        }
         RebuildFromStorage(storage);
         ref_layout_changed_ = false;
     }
 
     void ForceSyncFromHost(database::Database& db) override {
         auto type_id = database::GetComponentTypeId<T>();
-        const auto* storage = db.GetArrayStorageById(type_id);
+        auto* storage = db.GetArrayStorageById(type_id);
         if (!storage) {
             if (buffer_) buffer_->Clear();
             regions_.clear();
@@ -82,6 +93,17 @@ public:
         ref_layout_changed_ = false;
     }
 
+    void SyncLayoutFromHost(database::Database& db) override {
+        auto* storage = db.GetArrayStorageById(database::GetComponentTypeId<T>());
+        if (storage) {
+            BuildRegions(storage);
+        } else {
+            regions_.clear();
+            total_count_ = 0;
+        }
+        ref_layout_changed_ = false;
+    }
+
     WGPUBuffer GetBufferHandle() const override {
         return buffer_ ? buffer_->GetHandle() : nullptr;
     }
@@ -100,12 +122,21 @@ public:
     const std::vector<ArrayRegion>& GetRegions() const { return regions_; }
 
     const ArrayRegion* GetRegion(database::Entity entity) const {
-        for (const auto& r : regions_) {
-            if (r.entity == entity) return &r;
-        }
+        // regions_ is sorted by entity ID
+        auto it = std::lower_bound(regions_.begin(), regions_.end(), entity,
+            [](const ArrayRegion& r, database::Entity e) { return r.entity < e; });
+        if (it != regions_.end() && it->entity == entity) return &*it;
         return nullptr;
     }
 
+    // Start each region on a multiple of `alignment` elements (takes effect on the
+    // next rebuild). Gap elements are set to `padding`.
+    void SetRegionAlignment(uint32 alignment, const T& padding = T{}) {
+        region_alignment_ = std::max(alignment, 1u);
+        padding_ = padding;
+        ref_layout_changed_ = true;
+    }
+
     // Configure index offset transform: ref array provides entity offsets,
     // fn applies the offset to each element during GPU upload.
     void SetOffsetSource(IDeviceArrayEntry* ref, IndexOffsetFn<T> fn) {
@@ -114,47 +145,84 @@ public:
     }
 
 private:
-    void RebuildFromStorage(const database::IArrayStorage* storage) {
-        auto entities = storage->GetEntities();
-        std::sort(entities.begin(), entities.end());
-
-        regions_.clear();
-        std::vector<T> concat;
-        uint32 offset = 0;
-
-        for (database::Entity e : entities) {
-            uint32 count = storage->GetArrayCount(e);
-            if (count == 0) continue;
+    // Same layout as the current buffer: upload each dirty entity's region in place.
+    void WriteDirtyRegions(const database::IArrayStorage* storage) {
+        for (database::Entity e : storage->GetDirtyEntities()) {
+            const auto* region = GetRegion(e);
+            if (!region) continue;  // empty array, not mapped
             const auto* data = static_cast<const T*>(storage->GetArrayData(e));
-            regions_.push_back({e, offset, count});
 
-            // Copy elements, applying index offset if configured
             uint32 node_offset = (ref_array_ && offset_fn_) ? ref_array_->GetEntityOffset(e) : 0;
-            for (uint32 i = 0; i < count; ++i) {
-                T elem = data[i];
-                if (node_offset > 0) {
-                    offset_fn_(elem, node_offset);
-                }
-                concat.push_back(elem);
+            if (node_offset > 0) {
+                // Apply the offset transform directly in staging memory
+                auto staged = buffer_->StageWrite(region->count, region->offset);
+                std::copy(data, data + region->count, staged.begin());
+                for (auto& elem : staged) offset_fn_(elem, node_offset);
+            } else {
+                buffer_->WriteDataStaged(std::span<const T>(data, region->count), region->offset);
             }
-
-            offset += count;
         }
-        total_count_ = offset;
+    }
 
-        if (concat.empty()) {
+    // Without an index offset transform the buffer is a byte copy of the storage arena
+    // packed to this buffer's region alignment; otherwise concatenate region by region
+    // straight into staging memory.
+    void RebuildFromStorage(database::IArrayStorage* storage) {
+        BuildRegions(storage);
+        if (total_count_ == 0) {
             if (buffer_) buffer_->Clear();
             return;
         }
 
-        auto data_span = std::span<const T>(concat);
+        // Every element is rewritten, so growing skips the copy of the old contents
+        uint64 size_bytes = static_cast<uint64>(total_count_) * sizeof(T);
         if (!buffer_) {
-            buffer_ = std::make_unique<gpu::GPUBuffer<T>>(usage_, data_span, label_);
+            buffer_ = std::make_unique<gpu::GPUBuffer<T>>(
+                gpu::BufferConfig{.usage = usage_, .size = size_bytes, .label = label_});
+        } else if (buffer_->GetCount() != static_cast<uint64>(total_count_)) {
+            buffer_->SetSize(total_count_);
+        }
+
+        if (!ref_array_ || !offset_fn_) {
+            storage->Pack(region_alignment_, &padding_);
+            buffer_->WriteDataStaged(std::span<const T>(static_cast<const T*>(storage->GetArenaData()),
+                                                        storage->GetArenaCount()));
         } else {
-            if (buffer_->GetCount() != static_cast<uint64>(total_count_)) {
-                buffer_->Resize(total_count_);
+            ConcatRegions(storage, buffer_->StageWrite(total_count_));
+        }
+    }
+
+    // Lay out the non-empty arrays in entity order, each on a multiple of the alignment
+    void BuildRegions(const database::IArrayStorage* storage) {
+        regions_.clear();
+        uint32 offset = 0;
+        for (database::Entity e : storage->GetEntities()) {
+            uint32 count = storage->GetArrayCount(e);
+            if (count == 0) continue;
+            offset = (offset + region_alignment_ - 1) / region_alignment_ * region_alignment_;
+            regions_.push_back({e, offset, count});
+            offset += count;
+        }
+        total_count_ = offset;
+    }
+
+    // Copy elements region by region into out, padding the gaps and applying the
+    // index offset transform
+    void ConcatRegions(const database::IArrayStorage* storage, std::span<T> out) const {
+        uint32 cursor = 0;
+        for (const auto& region : regions_) {
+            const auto* data = static_cast<const T*>(storage->GetArrayData(region.entity));
+            std::fill(out.begin() + cursor, out.begin() + region.offset, padding_);
+            T* first = out.data() + region.offset;
+            std::copy(data, data + region.count, first);
+            cursor = region.offset + region.count;
+
+            uint32 node_offset = (ref_array_ && offset_fn_) ? ref_array_->GetEntityOffset(region.entity) : 0;
+            if (node_offset > 0) {
+                for (uint32 i = 0; i < region.count; ++i) {
+                    offset_fn_(first[i], node_offset);
+                }
             }
-            buffer_->WriteData(data_span);
         }
     }
 
@@ -163,6 +231,8 @@ private:
     std::unique_ptr<gpu::GPUBuffer<T>> buffer_;
     std::vector<ArrayRegion> regions_;
     uint32 total_count_ = 0;
+    uint32 region_alignment_ = 1;
+    T padding_{};
 
     // Offset transform support
     IDeviceArrayEntry* ref_array_ = nullptr;
@@ -46,16 +46,15 @@ public:
         auto data_span = std::span<const T>(data, count);
 
         if (!buffer_) {
-            // Lazily create the buffer with initial data
-            buffer_ = std::make_unique<gpu::GPUBuffer<T>>(usage_, data_span, label_);
-            return;
-        }
-
-        // Resize if element count changed, then write
-        if (buffer_->GetCount() != static_cast<uint64>(count)) {
-            buffer_->Resize(count);
+            // Lazily create the buffer; the data is staged below
+            buffer_ = std::make_unique<gpu::GPUBuffer<T>>(gpu::BufferConfig{
+                .usage = usage_, .size = data_span.size_bytes(), .label = label_});
+        } else if (buffer_->GetCount() != static_cast<uint64>(count)) {
+            // The whole dense array is rewritten, so old contents need not be copied
+            buffer_->SetSize(count);
         }
-        buffer_->WriteData(data_span);
+        // Through the StagingBelt; DeviceDB flushes it at the end of the sync
+        buffer_->WriteDataStaged(data_span);
     }
 
     WGPUBuffer GetBufferHandle() const override {
@@ -1,4 +1,7 @@
 #include "core_simulate/device_db.h"
+#include "core_gpu/staging_belt.h"
+#include "core_util/memory_tracker.h"
+#include <algorithm>
 
 using namespace mps;
 using namespace mps::simulate;
@@ -8,6 +11,12 @@ DeviceDB::DeviceDB(Database& host_db)
     : host_db_(host_db) {}
 
 void DeviceDB::Sync() {
+    if (host_only_) {
+        SyncLayouts(false);
+        return;
+    }
+    util::MemoryScope memory_scope("device_db");
+
     // 0. Singleton sync (always check — singletons don't have dirty flags)
     for (auto& [id, entry] : singleton_entries_) {
         entry->SyncFromHost(host_db_);
@@ -52,10 +61,19 @@ void DeviceDB::Sync() {
         entry->SyncFromHost(host_db_);
     }
 
+    // 5. Submit the staged uploads in one copy pass
+    gpu::StagingBelt::GetInstance().Flush();
+
     host_db_.ClearAllDirty();
 }
 
 void DeviceDB::ForceSync() {
+    if (host_only_) {
+        SyncLayouts(true);
+        return;
+    }
+    util::MemoryScope memory_scope("device_db");
+
     // Singletons
     for (auto& [id, entry] : singleton_entries_) {
         entry->SyncFromHost(host_db_);
@@ -84,6 +102,23 @@ void DeviceDB::ForceSync() {
         entry->ForceSyncFromHost(host_db_);
     }
 
+    gpu::StagingBelt::GetInstance().Flush();
+
+    host_db_.ClearAllDirty();
+}
+
+void DeviceDB::SyncLayouts(bool force) {
+    // Same order as Sync(): reference arrays before the indexed arrays that follow them
+    auto dirty_array_ids = host_db_.GetDirtyArrayTypeIds();
+    auto is_dirty = [&](ComponentTypeId id) {
+        return force || std::find(dirty_array_ids.begin(), dirty_array_ids.end(), id) != dirty_array_ids.end();
+    };
+    for (auto& [id, entry] : array_entries_) {
+        if (is_dirty(id)) entry->SyncLayoutFromHost(host_db_);
+    }
+    for (auto& [id, entry] : indexed_entries_) {
+        if (is_dirty(id)) entry->SyncLayoutFromHost(host_db_);
+    }
     host_db_.ClearAllDirty();
 }
 
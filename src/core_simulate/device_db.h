@@ -3,6 +3,7 @@
 #include "core_database/component_type.h"
 #include "core_database/database.h"
 #include "core_gpu/gpu_buffer.h"
+#include "core_gpu/gpu_core.h"
 #include "core_gpu/gpu_types.h"
 #include "core_simulate/device_array_buffer.h"
 #include "core_simulate/device_buffer_entry.h"
@@ -33,14 +34,14 @@ class SingletonBufferEntry : public ISingletonBufferEntry {
 public:
     SingletonBufferEntry(std::function<GpuT(const HostT&)> transform,
                          const std::string& label)
-        : transform_(std::move(transform)) {
-        GpuT initial = transform_(HostT{});
-        buffer_ = std::make_unique<gpu::GPUBuffer<GpuT>>(
-            gpu::BufferUsage::Uniform,
-            std::span<const GpuT>(&initial, 1), label);
+        : transform_(std::move(transform))
+        , label_(label) {
+        // Without a device yet (WASM startup, host-only System) the first sync creates it
+        if (gpu::GPUCore::GetInstance().IsInitialized()) CreateBuffer();
     }
 
     bool SyncFromHost(const database::Database& db) override {
+        if (!buffer_) CreateBuffer();
         const auto& host_val = db.GetSingleton<HostT>();
         if (first_sync_ || std::memcmp(&host_val, &cached_, sizeof(HostT)) != 0) {
             cached_ = host_val;
@@ -53,11 +54,19 @@ public:
     }
 
     WGPUBuffer GetBufferHandle() const override {
-        return buffer_->GetHandle();
+        return buffer_ ? buffer_->GetHandle() : nullptr;
     }
 
 private:
+    void CreateBuffer() {
+        GpuT initial = transform_(HostT{});
+        buffer_ = std::make_unique<gpu::GPUBuffer<GpuT>>(
+            gpu::BufferUsage::Uniform,
+            std::span<const GpuT>(&initial, 1), label_);
+    }
+
     std::function<GpuT(const HostT&)> transform_;
+    std::string label_;
     std::unique_ptr<gpu::GPUBuffer<GpuT>> buffer_;
     HostT cached_{};
     bool first_sync_ = true;
@@ -65,10 +74,17 @@ private:
 
 // Mirrors host ECS data (components and arrays) into GPU buffers.
 // Register component/array types, then call Sync() each frame to upload dirty data.
+//
+// Host-only mode (no GPU device, see System::IsHostOnly): Sync() keeps the array
+// layouts (entity offsets and total counts) current but creates and uploads nothing,
+// so every buffer handle is null.
 class DeviceDB {
 public:
     explicit DeviceDB(database::Database& host_db);
 
+    void SetHostOnly(bool host_only) { host_only_ = host_only; }
+    bool IsHostOnly() const { return host_only_; }
+
     // Register a component type for GPU mirroring (sparse-set backed).
     template<database::Component T>
     void Register(gpu::BufferUsage extra_usage = gpu::BufferUsage::None,
@@ -86,6 +102,11 @@ public:
     void RegisterIndexedArray(gpu::BufferUsage extra_usage, const std::string& label,
                               IndexOffsetFn<T> offset_fn);
 
+    // Align each entity's region of a registered array to a multiple of `alignment`
+    // elements, filling gaps with `padding` (see DeviceArrayBuffer::SetRegionAlignment).
+    template<database::Component T>
+    void SetArrayRegionAlignment(uint32 alignment, const T& padding = T{});
+
     // Upload all dirty data to GPU, then clear dirty flags.
     void Sync();
 
@@ -119,7 +140,11 @@ public:
     bool IsRegistered(database::ComponentTypeId id) const;
 
 private:
+    // Host-only Sync/ForceSync: recompute the layouts of the given array types
+    void SyncLayouts(bool force);
+
     database::Database& host_db_;
+    bool host_only_ = false;
     std::unordered_map<database::ComponentTypeId, std::unique_ptr<IDeviceBufferEntry>> entries_;
     std::unordered_map<database::ComponentTypeId, std::unique_ptr<IDeviceArrayEntry>> array_entries_;
 
@@ -170,6 +195,13 @@ void DeviceDB::RegisterIndexedArray(gpu::BufferUsage extra_usage, const std::str
     indexed_ref_map_.emplace(id, ref_id);
 }
 
+template<database::Component T>
+void DeviceDB::SetArrayRegionAlignment(uint32 alignment, const T& padding) {
+    auto it = array_entries_.find(database::GetComponentTypeId<T>());
+    if (it == array_entries_.end()) return;
+    static_cast<DeviceArrayBuffer<T>*>(it->second.get())->SetRegionAlignment(alignment, padding);
+}
+
 template<database::Component T>
 WGPUBuffer DeviceDB::GetBufferHandle() const {
     database::ComponentTypeId id = database::GetComponentTypeId<T>();
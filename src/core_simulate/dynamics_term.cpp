@@ -5,32 +5,58 @@ namespace mps {
 namespace simulate {
 
 SparsityBuilder::SparsityBuilder(uint32 node_count)
-    : node_count_(node_count), adjacency_(node_count) {}
+    : node_count_(node_count) {}
 
 void SparsityBuilder::AddEdge(uint32 node_a, uint32 node_b) {
-    adjacency_[node_a].insert(node_b);
-    adjacency_[node_b].insert(node_a);
+    entries_.push_back((uint64(node_a) << 32) | node_b);
+    entries_.push_back((uint64(node_b) << 32) | node_a);
 }
 
 void SparsityBuilder::Build() {
-    row_ptr_.resize(node_count_ + 1, 0);
-    col_idx_.clear();
-    csr_lookup_.clear();
+    // Counting sort of entries into row buckets
+    row_ptr_.assign(node_count_ + 1, 0);
+    for (uint64 entry : entries_) {
+        ++row_ptr_[(entry >> 32) + 1];
+    }
+    for (uint32 i = 0; i < node_count_; ++i) {
+        row_ptr_[i + 1] += row_ptr_[i];
+    }
 
+    col_idx_.resize(entries_.size());
+    std::vector<uint32> cursor(row_ptr_.begin(), row_ptr_.end() - 1);
+    for (uint64 entry : entries_) {
+        col_idx_[cursor[entry >> 32]++] = static_cast<uint32>(entry);
+    }
+    entries_.clear();
+    entries_.shrink_to_fit();
+
+    // Sort and deduplicate each row, compacting in place (write position never passes read)
+    uint32 out = 0;
+    uint32 begin = 0;
     for (uint32 i = 0; i < node_count_; ++i) {
-        row_ptr_[i] = static_cast<uint32>(col_idx_.size());
-        for (uint32 j : adjacency_[i]) {
-            csr_lookup_[{i, j}] = static_cast<uint32>(col_idx_.size());
-            col_idx_.push_back(j);
+        uint32 end = row_ptr_[i + 1];
+        auto first = col_idx_.begin() + begin;
+        std::sort(first, col_idx_.begin() + end);
+        auto last = std::unique(first, col_idx_.begin() + end);
+
+        row_ptr_[i] = out;
+        for (auto it = first; it != last; ++it) {
+            col_idx_[out++] = *it;
         }
+        begin = end;
     }
-    row_ptr_[node_count_] = static_cast<uint32>(col_idx_.size());
+    row_ptr_[node_count_] = out;
+    col_idx_.resize(out);
+    col_idx_.shrink_to_fit();
     built_ = true;
 }
 
 uint32 SparsityBuilder::GetCSRIndex(uint32 row, uint32 col) const {
-    auto it = csr_lookup_.find({row, col});
-    if (it != csr_lookup_.end()) return it->second;
+    if (row >= node_count_) return UINT32_MAX;
+    auto first = col_idx_.begin() + row_ptr_[row];
+    auto last = col_idx_.begin() + row_ptr_[row + 1];
+    auto it = std::lower_bound(first, last, col);
+    if (it != last && *it == col) return static_cast<uint32>(it - col_idx_.begin());
     return UINT32_MAX;
 }
 
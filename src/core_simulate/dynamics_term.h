@@ -3,35 +3,62 @@
 #include "core_util/types.h"
 #include <string>
 #include <vector>
-#include <map>
-#include <set>
-#include <utility>
 
 struct WGPUCommandEncoderImpl;  typedef WGPUCommandEncoderImpl* WGPUCommandEncoder;
 struct WGPUBufferImpl;          typedef WGPUBufferImpl*          WGPUBuffer;
 
 namespace mps {
+namespace gpu { class ComputePassRecorder; }
 namespace simulate {
 
+// How a term writes its contributions into forces / diag / CSR values.
+//   Scatter: one thread per element, elements colored so each dispatch is conflict-free.
+//   Gather:  one thread per node, summing incident elements into its own row.
+enum class AssemblyMode : uint32 {
+    Scatter = 0,
+    Gather = 1,
+};
+
 // Context passed to terms during Initialize for bind group caching
 struct AssemblyContext {
     WGPUBuffer physics_buffer;      // global physics params uniform (binding 0)
     WGPUBuffer position_buffer;     // predicted positions (read)
     WGPUBuffer velocity_buffer;     // current velocities (read)
     WGPUBuffer mass_buffer;         // mass data (read)
-    WGPUBuffer force_buffer;        // RHS force vector (atomic u32, read_write)
-    WGPUBuffer diag_buffer;         // A diagonal 3x3 blocks (atomic u32 for springs, read_write)
+    WGPUBuffer force_buffer;        // RHS force vector (f32, read_write)
+    WGPUBuffer diag_buffer;         // A diagonal 3x3 blocks (f32, read_write)
     WGPUBuffer csr_values_buffer;   // A off-diagonal 3x3 blocks (read_write)
     WGPUBuffer params_buffer;       // solver params uniform (binding 1)
     WGPUBuffer dv_total_buffer;     // accumulated velocity delta (read)
+    WGPUBuffer csr_row_ptr_buffer;  // CSR row offsets (read)
+    uint64 position_offset = 0;     // byte offsets of this system's node region in the
+    uint64 velocity_offset = 0;     // position/velocity/mass buffers (scoped systems)
+    uint64 mass_offset = 0;
     uint32 node_count;
     uint32 edge_count;
     uint32 workgroup_size;
     uint64 physics_size;        // size of physics buffer in bytes
     uint64 params_size;         // size of solver params buffer in bytes
+    bool zero_csr_rows = false; // gather term runs first: zero own CSR rows instead of a buffer clear
+};
+
+// Host buffers handed to terms by the CPU backend (HostNewtonDynamics).
+// Node vectors are structure-of-arrays: [0] = x, [1] = y, [2] = z.
+struct HostAssemblyContext {
+    const float32* position[3];  // predicted positions (read)
+    float32* force[3];           // RHS force vector (accumulate)
+    float32* diag;               // A diagonal 3x3 blocks, 9 f32 per node (accumulate)
+    float32* csr_values;         // A off-diagonal 3x3 blocks, 9 f32 per nnz (accumulate)
+    float32 dt_sq;
+    uint32 node_count;
 };
 
-// Builds CSR sparsity pattern from declared edges
+// Elements per ThreadPool chunk in host term assembly
+inline constexpr uint32 kHostElementGrain = 256;
+
+// Builds CSR sparsity pattern from declared edges.
+// Edges are collected into a flat list and bucketed by row at Build(), so
+// building is linear in the edge count and allocation-free per entry.
 class SparsityBuilder {
 public:
     explicit SparsityBuilder(uint32 node_count);
@@ -48,15 +75,15 @@ public:
     [[nodiscard]] uint32 GetNNZ() const { return static_cast<uint32>(col_idx_.size()); }
     [[nodiscard]] uint32 GetNodeCount() const { return node_count_; }
 
-    // Get CSR index for entry (row, col). Returns UINT32_MAX if not found.
+    // Get CSR index for entry (row, col) by binary search within the row.
+    // Returns UINT32_MAX if not found.
     [[nodiscard]] uint32 GetCSRIndex(uint32 row, uint32 col) const;
 
 private:
     uint32 node_count_;
-    std::vector<std::set<uint32>> adjacency_;
+    std::vector<uint64> entries_;   // declared directed entries, (row << 32) | col; freed by Build
     std::vector<uint32> row_ptr_;
-    std::vector<uint32> col_idx_;
-    std::map<std::pair<uint32, uint32>, uint32> csr_lookup_;
+    std::vector<uint32> col_idx_;   // sorted ascending within each row
     bool built_ = false;
 };
 
@@ -74,7 +101,18 @@ public:
     virtual void Initialize(const SparsityBuilder& sparsity, const AssemblyContext& ctx) = 0;
 
     // Phase 3: Dispatch cached bind groups to assemble contributions to A and b
-    virtual void Assemble(WGPUCommandEncoder encoder) = 0;
+    virtual void Assemble(gpu::ComputePassRecorder& recorder) = 0;
+
+    // Assembly strategy. Terms without a gather kernel ignore the request.
+    // Must be set before Initialize.
+    virtual void SetAssemblyMode(AssemblyMode mode) {}
+    [[nodiscard]] virtual AssemblyMode GetAssemblyMode() const { return AssemblyMode::Scatter; }
+
+    // CPU backend (used instead of Initialize/Assemble). Terms without a host path
+    // return false and are skipped by HostNewtonDynamics. AssembleHost accumulates
+    // the same forces and blocks as the GPU kernels.
+    virtual bool InitializeHost(const SparsityBuilder& sparsity, uint32 node_count) { return false; }
+    virtual void AssembleHost(const HostAssemblyContext& ctx) {}
 
     virtual void Shutdown() = 0;
 };
@@ -0,0 +1,63 @@
+#include "core_simulate/element_coloring.h"
+#include <bit>
+
+namespace mps {
+namespace simulate {
+
+void ElementColoring::Build(std::span<const uint32> element_nodes, uint32 nodes_per_element,
+                            uint32 node_count) {
+    uint32 element_count = nodes_per_element > 0
+        ? static_cast<uint32>(element_nodes.size() / nodes_per_element) : 0;
+
+    // Per-node bitset of colors already taken by incident elements (64 colors per word)
+    std::vector<std::vector<uint64>> node_used(node_count);
+    std::vector<uint32> colors(element_count);
+    uint32 color_count = 0;
+
+    for (uint32 e = 0; e < element_count; ++e) {
+        const uint32* nodes = element_nodes.data() + uint64(e) * nodes_per_element;
+
+        // First-fit: lowest color not used by any node of this element
+        uint32 color = 0;
+        for (uint32 word = 0;; ++word) {
+            uint64 taken = 0;
+            for (uint32 k = 0; k < nodes_per_element; ++k) {
+                const auto& used = node_used[nodes[k]];
+                if (word < used.size()) taken |= used[word];
+            }
+            if (taken != ~uint64(0)) {
+                color = word * 64 + static_cast<uint32>(std::countr_one(taken));
+                break;
+            }
+        }
+
+        uint32 word = color / 64;
+        uint64 bit = uint64(1) << (color % 64);
+        for (uint32 k = 0; k < nodes_per_element; ++k) {
+            auto& used = node_used[nodes[k]];
+            if (used.size() <= word) used.resize(word + 1, 0);
+            used[word] |= bit;
+        }
+        colors[e] = color;
+        if (color + 1 > color_count) color_count = color + 1;
+    }
+
+    // Counting sort by color (stable: original order is kept within a color)
+    ranges_.assign(color_count, ColorRange{});
+    for (uint32 c : colors) ++ranges_[c].count;
+    uint32 offset = 0;
+    for (auto& range : ranges_) {
+        range.offset = offset;
+        offset += range.count;
+    }
+
+    order_.assign(element_count, 0);
+    std::vector<uint32> cursor(color_count);
+    for (uint32 c = 0; c < color_count; ++c) cursor[c] = ranges_[c].offset;
+    for (uint32 e = 0; e < element_count; ++e) {
+        order_[cursor[colors[e]]++] = e;
+    }
+}
+
+}  // namespace simulate
+}  // namespace mps
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "core_util/types.h"
+#include <span>
+#include <vector>
+
+namespace mps {
+namespace simulate {
+
+// One color batch of a conflict-free element dispatch (matches ColorRange in
+// header/color_range.wgsl). Padded to 256 bytes so each batch can be bound as a
+// uniform at its own offset (minUniformBufferOffsetAlignment).
+struct alignas(256) ColorRange {
+    uint32 offset = 0;   // first element of this color in the reordered element array
+    uint32 count = 0;    // number of elements in this color
+};
+
+// Bytes actually read by the shader from one ColorRange slot
+inline constexpr uint64 kColorRangeBindingSize = 16;
+
+// Greedy graph coloring of mesh elements (edges, faces) such that no two elements
+// of the same color share a node. Elements of one color can then scatter into
+// per-node / per-CSR-block storage with plain read-modify-write instead of CAS loops,
+// dispatched color by color. Results are deterministic for a given element order.
+class ElementColoring {
+public:
+    // element_nodes holds nodes_per_element node indices per element.
+    void Build(std::span<const uint32> element_nodes, uint32 nodes_per_element, uint32 node_count);
+
+    // Reorder an element array so each color occupies a contiguous range.
+    template<typename T>
+    [[nodiscard]] std::vector<T> Reorder(const std::vector<T>& elements) const {
+        std::vector<T> result;
+        result.reserve(order_.size());
+        for (uint32 e : order_) result.push_back(elements[e]);
+        return result;
+    }
+
+    [[nodiscard]] uint32 GetColorCount() const { return static_cast<uint32>(ranges_.size()); }
+    [[nodiscard]] const std::vector<ColorRange>& GetRanges() const { return ranges_; }
+    // order[i] = original index of the i-th element in color order
+    [[nodiscard]] const std::vector<uint32>& GetOrder() const { return order_; }
+
+private:
+    std::vector<uint32> order_;
+    std::vector<ColorRange> ranges_;
+};
+
+}  // namespace simulate
+}  // namespace mps
@@ -0,0 +1,193 @@
+#include "core_simulate/host_cg_solver.h"
+#include "core_util/thread_pool.h"
+#include <cmath>
+
+using namespace mps::util;
+
+namespace mps {
+namespace simulate {
+
+void HostCGSolver::Initialize(uint32 node_count) {
+    node_count_ = node_count;
+    x_.Assign(node_count);
+    r_.Assign(node_count);
+    p_.Assign(node_count);
+    ap_.Assign(node_count);
+    uint32 chunks = ThreadPool::GetChunkCount(node_count, kHostNodeGrain);
+    partials_.assign(chunks, 0.0);
+}
+
+float64 HostCGSolver::SumPartials() const {
+    // Fixed chunk order: independent of which thread ran which chunk
+    float64 sum = 0.0;
+    for (float64 partial : partials_) sum += partial;
+    return sum;
+}
+
+void HostCGSolver::InvertDiagonalBlocks(const HostBlockMatrix& matrix,
+                                        const std::vector<float32>& inv_mass) {
+    block_inv_.resize(uint64(node_count_) * 9);
+    z_.Assign(node_count_);
+
+    float32* out = block_inv_.data();
+    const float32* diag = matrix.diag;
+    ThreadPool::GetInstance().ParallelFor(node_count_, kHostNodeGrain, [&](uint32 begin, uint32 end) {
+        for (uint32 i = begin; i < end; ++i) {
+            float32* m = out + uint64(i) * 9;
+            const float32* a = diag + uint64(i) * 9;
+
+            // Pinned nodes get no preconditioned residual; singular blocks fall back to identity
+            bool pinned = inv_mass[i] <= 0.0f;
+            float32 c00 = a[4] * a[8] - a[5] * a[7];
+            float32 c01 = a[5] * a[6] - a[3] * a[8];
+            float32 c02 = a[3] * a[7] - a[4] * a[6];
+            float32 det = a[0] * c00 + a[1] * c01 + a[2] * c02;
+            if (pinned || std::abs(det) <= 1e-30f) {
+                float32 d = pinned ? 0.0f : 1.0f;
+                m[0] = d;    m[1] = 0.0f; m[2] = 0.0f;
+                m[3] = 0.0f; m[4] = d;    m[5] = 0.0f;
+                m[6] = 0.0f; m[7] = 0.0f; m[8] = d;
+                continue;
+            }
+
+            // Inverse = adjugate / det (rows of the adjugate are the cofactor columns)
+            float32 inv_det = 1.0f / det;
+            m[0] = c00 * inv_det;
+            m[1] = (a[2] * a[7] - a[1] * a[8]) * inv_det;
+            m[2] = (a[1] * a[5] - a[2] * a[4]) * inv_det;
+            m[3] = c01 * inv_det;
+            m[4] = (a[0] * a[8] - a[2] * a[6]) * inv_det;
+            m[5] = (a[2] * a[3] - a[0] * a[5]) * inv_det;
+            m[6] = c02 * inv_det;
+            m[7] = (a[1] * a[6] - a[0] * a[7]) * inv_det;
+            m[8] = (a[0] * a[4] - a[1] * a[3]) * inv_det;
+        }
+    });
+}
+
+float64 HostCGSolver::Multiply(const HostBlockMatrix& matrix) {
+    const float32* px = p_.x.data();
+    const float32* py = p_.y.data();
+    const float32* pz = p_.z.data();
+    float32* ax = ap_.x.data();
+    float32* ay = ap_.y.data();
+    float32* az = ap_.z.data();
+
+    // Row-parallel: each node gathers its own row, no write conflicts
+    ThreadPool::GetInstance().ParallelFor(node_count_, kHostNodeGrain, [&](uint32 begin, uint32 end) {
+        float64 pap = 0.0;
+        for (uint32 i = begin; i < end; ++i) {
+            const float32* d = matrix.diag + uint64(i) * 9;
+            float32 sx = d[0] * px[i] + d[1] * py[i] + d[2] * pz[i];
+            float32 sy = d[3] * px[i] + d[4] * py[i] + d[5] * pz[i];
+            float32 sz = d[6] * px[i] + d[7] * py[i] + d[8] * pz[i];
+            for (uint32 k = matrix.row_ptr[i]; k < matrix.row_ptr[i + 1]; ++k) {
+                const float32* b = matrix.csr_values + uint64(k) * 9;
+                uint32 j = matrix.col_idx[k];
+                sx += b[0] * px[j] + b[1] * py[j] + b[2] * pz[j];
+                sy += b[3] * px[j] + b[4] * py[j] + b[5] * pz[j];
+                sz += b[6] * px[j] + b[7] * py[j] + b[8] * pz[j];
+            }
+            ax[i] = sx;
+            ay[i] = sy;
+            az[i] = sz;
+            pap += float64(px[i]) * sx + float64(py[i]) * sy + float64(pz[i]) * sz;
+        }
+        partials_[begin / kHostNodeGrain] = pap;
+    });
+    return SumPartials();
+}
+
+uint32 HostCGSolver::Solve(const HostBlockMatrix& matrix, const HostVec3Array& rhs,
+                           const std::vector<float32>& inv_mass, uint32 max_iterations,
+                           float32 tolerance) {
+    auto& pool = ThreadPool::GetInstance();
+    const uint32 n = node_count_;
+    const bool precond = preconditioner_ == CGPreconditioner::BlockJacobi;
+    if (precond) {
+        InvertDiagonalBlocks(matrix, inv_mass);
+    }
+
+    // z = D^-1 r with BlockJacobi, otherwise z aliases r
+    HostVec3Array& z = precond ? z_ : r_;
+    const float32* bi = block_inv_.data();
+    auto apply_precond = [&](uint32 i) {
+        if (!precond) return;
+        const float32* m = bi + uint64(i) * 9;
+        float32 rx = r_.x[i], ry = r_.y[i], rz = r_.z[i];
+        z_.x[i] = m[0] * rx + m[1] * ry + m[2] * rz;
+        z_.y[i] = m[3] * rx + m[4] * ry + m[5] * rz;
+        z_.z[i] = m[6] * rx + m[7] * ry + m[8] * rz;
+    };
+
+    // x = 0, r = b, p = z; rz0 = r.z
+    pool.ParallelFor(n, kHostNodeGrain, [&](uint32 begin, uint32 end) {
+        float64 rz = 0.0;
+        for (uint32 i = begin; i < end; ++i) {
+            x_.x[i] = 0.0f;
+            x_.y[i] = 0.0f;
+            x_.z[i] = 0.0f;
+            r_.x[i] = rhs.x[i];
+            r_.y[i] = rhs.y[i];
+            r_.z[i] = rhs.z[i];
+            apply_precond(i);
+            p_.x[i] = z.x[i];
+            p_.y[i] = z.y[i];
+            p_.z[i] = z.z[i];
+            rz += float64(r_.x[i]) * z.x[i] + float64(r_.y[i]) * z.y[i] + float64(r_.z[i]) * z.z[i];
+        }
+        partials_[begin / kHostNodeGrain] = rz;
+    });
+    float64 rz = SumPartials();
+    const float64 rz0 = rz;
+    const float64 tol_sq = float64(tolerance) * float64(tolerance);
+
+    // Zero RHS: x = 0 is already the solution
+    if (convergence_check_ && rz0 <= 1e-30) {
+        return 0;
+    }
+
+    for (uint32 iter = 0; iter < max_iterations; ++iter) {
+        float64 pap = Multiply(matrix);
+        float32 alpha = pap > 1e-30 ? float32(rz / pap) : 0.0f;
+
+        // x += alpha p, r -= alpha Ap (MPCG: r = 0 on pinned nodes), z = D^-1 r; r.z
+        pool.ParallelFor(n, kHostNodeGrain, [&](uint32 begin, uint32 end) {
+            float64 rz_new = 0.0;
+            for (uint32 i = begin; i < end; ++i) {
+                x_.x[i] += alpha * p_.x[i];
+                x_.y[i] += alpha * p_.y[i];
+                x_.z[i] += alpha * p_.z[i];
+                bool free = inv_mass[i] > 0.0f;
+                r_.x[i] = free ? r_.x[i] - alpha * ap_.x[i] : 0.0f;
+                r_.y[i] = free ? r_.y[i] - alpha * ap_.y[i] : 0.0f;
+                r_.z[i] = free ? r_.z[i] - alpha * ap_.z[i] : 0.0f;
+                apply_precond(i);
+                rz_new += float64(r_.x[i]) * z.x[i] + float64(r_.y[i]) * z.y[i] +
+                          float64(r_.z[i]) * z.z[i];
+            }
+            partials_[begin / kHostNodeGrain] = rz_new;
+        });
+        float64 rz_new = SumPartials();
+        float32 beta = rz > 1e-30 ? float32(rz_new / rz) : 0.0f;
+        rz = rz_new;
+
+        if (convergence_check_ && rz_new <= tol_sq * rz0) {
+            return iter + 1;
+        }
+
+        // p = z + beta p (MPCG: p = 0 on pinned nodes)
+        pool.ParallelFor(n, kHostNodeGrain, [&](uint32 begin, uint32 end) {
+            for (uint32 i = begin; i < end; ++i) {
+                bool free = inv_mass[i] > 0.0f;
+                p_.x[i] = free ? z.x[i] + beta * p_.x[i] : 0.0f;
+                p_.y[i] = free ? z.y[i] + beta * p_.y[i] : 0.0f;
+                p_.z[i] = free ? z.z[i] + beta * p_.z[i] : 0.0f;
+            }
+        });
+    }
+    return max_iterations;
+}
+
+}  // namespace simulate
+}  // namespace mps
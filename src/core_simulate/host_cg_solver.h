@@ -0,0 +1,81 @@
+#pragma once
+
+#include "core_util/types.h"
+#include "core_simulate/solver_params.h"
+#include <vector>
+
+namespace mps {
+namespace simulate {
+
+// Node vector in structure-of-arrays layout (one contiguous array per axis).
+// The CPU backend keeps node data this way so per-node passes vectorize.
+struct HostVec3Array {
+    std::vector<float32> x;
+    std::vector<float32> y;
+    std::vector<float32> z;
+
+    // Resize to count nodes, every component set to value
+    void Assign(uint32 count, float32 value = 0.0f) {
+        x.assign(count, value);
+        y.assign(count, value);
+        z.assign(count, value);
+    }
+
+    [[nodiscard]] uint32 GetCount() const { return static_cast<uint32>(x.size()); }
+};
+
+// Block-sparse system matrix in the GPU layout: 3x3 row-major diagonal blocks
+// (9 f32 per node) plus off-diagonal CSR blocks (9 f32 per nonzero).
+struct HostBlockMatrix {
+    const uint32* row_ptr = nullptr;
+    const uint32* col_idx = nullptr;
+    const float32* csr_values = nullptr;
+    const float32* diag = nullptr;
+    uint32 node_count = 0;
+};
+
+// Nodes per ThreadPool chunk in host per-node passes
+inline constexpr uint32 kHostNodeGrain = 1024;
+
+// CPU counterpart of CGSolver: the same mass-filtered CG (optionally block-Jacobi
+// preconditioned) on HostVec3Array vectors. Per-node passes run on the ThreadPool;
+// the SpMV is row-parallel, and the update passes fuse the following dot products.
+// Dot products are reduced per fixed-size chunk in f64, so results do not depend
+// on the thread count.
+//
+// Iteration and termination match the classic GPU loop: x = 0, r = b, stop once
+// rr <= cg_tolerance^2 * rr0 when the convergence check is enabled.
+class HostCGSolver {
+public:
+    void Initialize(uint32 node_count);
+
+    void SetConvergenceCheck(bool enabled) { convergence_check_ = enabled; }
+    void SetPreconditioner(CGPreconditioner preconditioner) { preconditioner_ = preconditioner; }
+
+    // Solve A x = b. inv_mass (one per node, 0 = pinned) filters pinned nodes.
+    // Returns the number of iterations run.
+    uint32 Solve(const HostBlockMatrix& matrix, const HostVec3Array& rhs,
+                 const std::vector<float32>& inv_mass, uint32 max_iterations, float32 tolerance);
+
+    [[nodiscard]] const HostVec3Array& GetSolution() const { return x_; }
+
+private:
+    void InvertDiagonalBlocks(const HostBlockMatrix& matrix, const std::vector<float32>& inv_mass);
+    float64 Multiply(const HostBlockMatrix& matrix);   // ap = A * p, returns p.ap
+    float64 SumPartials() const;
+
+    uint32 node_count_ = 0;
+    bool convergence_check_ = true;
+    CGPreconditioner preconditioner_ = CGPreconditioner::None;
+
+    HostVec3Array x_;
+    HostVec3Array r_;
+    HostVec3Array p_;
+    HostVec3Array ap_;
+    HostVec3Array z_;                        // BlockJacobi only
+    std::vector<float32> block_inv_;         // BlockJacobi: 9 f32 per node
+    std::vector<float64> partials_;          // one dot product partial per ThreadPool chunk
+};
+
+}  // namespace simulate
+}  // namespace mps
@@ -0,0 +1,32 @@
+#include "core_simulate/node_incidence.h"
+#include <algorithm>
+
+namespace mps {
+namespace simulate {
+
+void NodeIncidence::Build(std::span<const uint32> element_nodes, uint32 nodes_per_element,
+                          uint32 node_count) {
+    uint32 element_count = nodes_per_element > 0
+        ? static_cast<uint32>(element_nodes.size() / nodes_per_element) : 0;
+
+    // Count per node, then prefix-sum into offsets
+    offsets_.assign(node_count + 1, 0);
+    for (uint32 node : element_nodes) ++offsets_[node + 1];
+    max_valence_ = 0;
+    for (uint32 i = 0; i < node_count; ++i) {
+        max_valence_ = std::max(max_valence_, offsets_[i + 1]);
+        offsets_[i + 1] += offsets_[i];
+    }
+
+    entries_.assign(offsets_[node_count], IncidenceEntry{});
+    std::vector<uint32> cursor(offsets_.begin(), offsets_.end() - 1);
+    for (uint32 e = 0; e < element_count; ++e) {
+        for (uint32 k = 0; k < nodes_per_element; ++k) {
+            uint32 node = element_nodes[uint64(e) * nodes_per_element + k];
+            entries_[cursor[node]++] = {e, k};
+        }
+    }
+}
+
+}  // namespace simulate
+}  // namespace mps
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "core_util/types.h"
+#include <span>
+#include <vector>
+
+namespace mps {
+namespace simulate {
+
+// One element incident to a node (8 bytes, GPU-compatible as vec2u)
+struct IncidenceEntry {
+    uint32 element = 0;  // element index
+    uint32 slot = 0;     // position of the node within the element (0..nodes_per_element-1)
+};
+
+// Node -> element incidence in CSR form, for gather-style assembly where one
+// thread owns a node (and its CSR row) and sums contributions from incident
+// elements. Entries of node i are [offsets[i], offsets[i+1]), in element order.
+class NodeIncidence {
+public:
+    // element_nodes holds nodes_per_element node indices per element.
+    void Build(std::span<const uint32> element_nodes, uint32 nodes_per_element, uint32 node_count);
+
+    [[nodiscard]] const std::vector<uint32>& GetOffsets() const { return offsets_; }
+    [[nodiscard]] const std::vector<IncidenceEntry>& GetEntries() const { return entries_; }
+    [[nodiscard]] uint32 GetMaxValence() const { return max_valence_; }
+
+private:
+    std::vector<uint32> offsets_;
+    std::vector<IncidenceEntry> entries_;
+    uint32 max_valence_ = 0;
+};
+
+// Upload span for a term's element or incidence array. Gather kernels dispatch even
+// for a term without elements (the first term may own the CSR row clear) and WebGPU
+// cannot bind an empty buffer, so an empty array uploads one zeroed element instead.
+template <typename T>
+[[nodiscard]] std::span<const T> NonEmptyUpload(const std::vector<T>& data) {
+    static const T kZero{};
+    return data.empty() ? std::span<const T>(&kZero, 1) : std::span<const T>(data);
+}
+
+}  // namespace simulate
+}  // namespace mps
@@ -8,16 +8,20 @@ struct WGPUCommandEncoderImpl;  typedef WGPUCommandEncoderImpl* WGPUCommandEncod
 struct WGPUBufferImpl;          typedef WGPUBufferImpl*          WGPUBuffer;
 
 namespace mps {
+namespace gpu { class ComputePassRecorder; }
 namespace simulate {
 
+// PD iterates rotate through this many q buffers (prev / curr / new) without copies
+inline constexpr uint32 kPDIterateBufferCount = 3;
+
 // Context passed to PD terms during Initialize for bind group caching
 struct PDAssemblyContext {
     WGPUBuffer physics_buffer;     // global physics params uniform (binding 0)
-    WGPUBuffer q_buffer;           // current iterate q (read)
+    WGPUBuffer q_buffers[kPDIterateBufferCount];  // rotating iterates q (read, one per slot)
     WGPUBuffer s_buffer;           // predicted positions s (read)
     WGPUBuffer mass_buffer;        // mass data (read)
-    WGPUBuffer rhs_buffer;         // RHS accumulation (atomic u32, read_write)
-    WGPUBuffer diag_buffer;        // LHS diagonal 3x3 blocks (atomic u32, read_write)
+    WGPUBuffer rhs_buffer;         // RHS accumulation (f32, read_write)
+    WGPUBuffer diag_buffer;        // LHS diagonal 3x3 blocks (atomic u32 during LHS assembly)
     WGPUBuffer csr_values_buffer;  // LHS off-diagonal CSR 3x3 blocks (read_write)
     WGPUBuffer params_buffer;      // solver params uniform (binding 1)
     uint32 node_count;
@@ -25,6 +29,17 @@ struct PDAssemblyContext {
     uint32 workgroup_size;
     uint64 physics_size;       // size of physics buffer in bytes
     uint64 params_size;        // size of solver params buffer in bytes
+    uint64 mass_offset = 0;    // byte offset of this system's node region in mass_buffer
+};
+
+// Host buffers handed to PD terms by the CPU backend (HostPDDynamics).
+// Node vectors are structure-of-arrays: [0] = x, [1] = y, [2] = z.
+struct PDHostAssemblyContext {
+    const float32* q[3];       // current iterate (read, ProjectRHSHost)
+    float32* rhs[3];           // RHS accumulation (ProjectRHSHost)
+    float32* diag;             // LHS diagonal 3x3 blocks (AssembleLHSHost)
+    float32* csr_values;       // LHS off-diagonal CSR blocks (AssembleLHSHost)
+    uint32 node_count;
 };
 
 // Interface for Projective Dynamics constraint terms.
@@ -44,11 +59,18 @@ public:
 
     // Phase 3a: Assemble constant LHS contribution (w * S^T * S)
     // Called once when dt changes or at init
-    virtual void AssembleLHS(WGPUCommandEncoder encoder) = 0;
+    virtual void AssembleLHS(gpu::ComputePassRecorder& recorder) = 0;
 
     // Phase 3b: Fused local projection + RHS assembly in a single dispatch.
-    // Computes p from current q and immediately scatters w * S^T * p to RHS.
-    virtual void ProjectRHS(WGPUCommandEncoder encoder) = 0;
+    // Computes p from current q (ctx.q_buffers[q_slot]) and immediately scatters
+    // w * S^T * p to RHS. Terms cache one bind group per slot.
+    virtual void ProjectRHS(gpu::ComputePassRecorder& recorder, uint32 q_slot) = 0;
+
+    // CPU backend (used instead of Initialize/AssembleLHS/ProjectRHS). Terms without
+    // a host path return false and are skipped by HostPDDynamics.
+    virtual bool InitializeHost(const SparsityBuilder& sparsity, uint32 node_count) { return false; }
+    virtual void AssembleLHSHost(const PDHostAssemblyContext& ctx) {}
+    virtual void ProjectRHSHost(const PDHostAssemblyContext& ctx) {}
 
     virtual void Shutdown() = 0;
 };
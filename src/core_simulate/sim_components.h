@@ -1,6 +1,8 @@
 #pragma once
 
 #include "core_util/types.h"
+#include "core_database/array_storage.h"
+#include <unordered_map>
 
 namespace mps {
 namespace simulate {
@@ -27,5 +29,32 @@ struct SimMass {
     float32 inv_mass = 1.0f;  // 0 = pinned
 };
 
+// Each entity's SimPosition/SimVelocity/SimMass region starts on a multiple of this
+// many nodes. 64 elements of any 4-byte-multiple type span a multiple of 256 bytes
+// (the largest allowed minStorageBufferOffsetAlignment), so scoped solvers can bind
+// a region of the global buffers in place. Gap nodes are zero and pinned.
+inline constexpr uint32 kNodeRegionAlignment = 64;
+
+// Start of the next node region at or after offset (host-side layout mirror).
+inline constexpr uint32 AlignNodeOffset(uint32 offset) {
+    return (offset + kNodeRegionAlignment - 1) / kNodeRegionAlignment * kNodeRegionAlignment;
+}
+
+// Node region start of every entity in the SimPosition storage (host-side mirror of the
+// DeviceDB layout: entities in storage order, each region at AlignNodeOffset). Used to
+// turn per-mesh node indices into global ones. Empty when positions is null.
+inline std::unordered_map<database::Entity, uint32> NodeRegionOffsets(
+    const database::IArrayStorage* positions) {
+    std::unordered_map<database::Entity, uint32> offsets;
+    if (!positions) return offsets;
+    uint32 offset = 0;
+    for (database::Entity e : positions->GetEntities()) {
+        offset = AlignNodeOffset(offset);
+        offsets[e] = offset;
+        offset += positions->GetArrayCount(e);
+    }
+    return offsets;
+}
+
 }  // namespace simulate
 }  // namespace mps
@@ -1,7 +1,6 @@
 #pragma once
 
 #include "core_gpu/gpu_core.h"
-#include "core_util/timer.h"
 #include "core_util/logger.h"
 #include <webgpu/webgpu.h>
 
@@ -9,7 +8,8 @@ namespace mps {
 namespace simulate {
 
 // Toggle simulation profiling at compile time.
-// When true, ISimulator::Update() implementations log GPU execution time via if constexpr.
+// When true, System enables gpu::GPUProfiler (timestamp queries, no CPU/GPU sync) and
+// periodically logs per-pipeline GPU time.
 // Only included by .cpp files — changing this value only rebuilds those .cpp files.
 inline constexpr bool kEnableSimulationProfiling = true;
 
@@ -17,6 +17,7 @@ inline constexpr bool kEnableSimulationProfiling = true;
 // Uses wgpuQueueOnSubmittedWorkDone + WaitAny (native) or ProcessEvents (WASM).
 inline void WaitForGPU() {
     auto& gpu = gpu::GPUCore::GetInstance();
+    if (!gpu.IsInitialized()) return;   // host-only: nothing was submitted
 
     struct Ctx { bool done = false; };
     Ctx ctx;
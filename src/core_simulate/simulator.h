@@ -15,6 +15,11 @@ public:
     virtual void Update() = 0;
     virtual void Shutdown() {}
     virtual void OnDatabaseChanged() {}
+    // Simulation reset (after the device buffers were restored from the host Database)
+    virtual void OnReset() {}
+    // False if the simulator can run without a GPU device (host-only System).
+    // Queried before Initialize, once the scene is in the Database.
+    [[nodiscard]] virtual bool RequiresGPU() const { return true; }
 };
 
 }  // namespace simulate
@@ -5,6 +5,18 @@
 namespace mps {
 namespace simulate {
 
+// CG preconditioner selection (SolverParams::cg_precond).
+enum class CGPreconditioner : uint32 {
+    None        = 0,  // plain mass-filtered CG
+    BlockJacobi = 1,  // z = D^-1 r with the assembled 3x3 diagonal blocks
+};
+
+// Where a system's solver runs (per-simulator config field `backend`).
+enum class SolverBackend : uint32 {
+    GPU = 0,  // WebGPU compute pipelines
+    CPU = 1,  // multithreaded host reference backend (HostNewtonDynamics / HostPDDynamics)
+};
+
 // Per-solver uniform buffer (binding 1).
 // Contains mesh topology counts and CG configuration.
 struct alignas(16) SolverParams {
@@ -13,7 +25,7 @@ struct alignas(16) SolverParams {
     uint32 face_count   = 0;
     uint32 cg_max_iter  = 30;
     float32 cg_tolerance = 1e-6f;
-    float32 _pad0       = 0.0f;
+    uint32 cg_precond   = 0;     // CGPreconditioner
     float32 _pad1       = 0.0f;
     float32 _pad2       = 0.0f;
 };
@@ -8,11 +8,18 @@
 #include "core_render/pass/render_pass_builder.h"
 #include "core_platform/window.h"
 #include "core_platform/input.h"
+#include "core_gpu/gpu_buffer_pool.h"
 #include "core_gpu/gpu_core.h"
+#include "core_gpu/gpu_profiler.h"
+#include "core_gpu/gpu_readback.h"
+#include "core_gpu/pipeline_registry.h"
+#include "core_gpu/staging_belt.h"
+#include "core_gpu/workgroup_tuner.h"
+#include "core_simulate/simulate_config.h"
 #include "core_util/logger.h"
+#include "core_util/memory_tracker.h"
 #include <webgpu/webgpu.h>
 #include <algorithm>
-#include <cstring>
 
 #ifdef __EMSCRIPTEN__
 #include <emscripten.h>
@@ -27,7 +34,18 @@ System::System()
     : device_db_(db_) {}
 
 System::~System() {
+    auto& memory = MemoryTracker::GetInstance();
+    for (uint32 handle : budget_handlers_) {
+        memory.RemoveBudgetHandler(handle);
+    }
+    memory.LogReport();
+
     ShutdownExtensions();
+    gpu::GPUProfiler::GetInstance().Shutdown();
+    gpu::GPUReadback::GetInstance().Shutdown();
+    gpu::StagingBelt::GetInstance().Shutdown();
+    gpu::GPUBufferPool::GetInstance().Shutdown();
+    gpu::PipelineRegistry::GetInstance().Shutdown();
     if (engine_) {
         engine_->Shutdown();
         engine_.reset();
@@ -47,9 +65,16 @@ System::~System() {
 // Lifecycle
 // ============================================================================
 
-bool System::Initialize() {
+bool System::Initialize(const SystemConfig& config) {
     LogInfo("MPS_DAWN starting...");
 
+    RegisterBudgetHandlers(config);
+
+    headless_ = config.headless;
+    if (headless_) {
+        return InitializeHeadless(config);
+    }
+
     // --- Create window ---
     window_ = platform::IWindow::Create();
     platform::WindowConfig win_config;
@@ -63,9 +88,11 @@ bool System::Initialize() {
 
     // --- Initialize GPU ---
     auto& gpu = gpu::GPUCore::GetInstance();
+    gpu::GPUConfig gpu_config;
+    gpu_config.single_pass_reductions = config.single_pass_reductions;
     WGPUSurface surface = gpu.CreateSurface(
         window_->GetNativeWindowHandle(), window_->GetNativeDisplayHandle());
-    if (!gpu.Initialize({}, surface)) {
+    if (!gpu.Initialize(gpu_config, surface)) {
         LogError("Failed to initialize GPU");
         return false;
     }
@@ -86,17 +113,72 @@ bool System::Initialize() {
     return true;
 }
 
+bool System::InitializeHeadless(const SystemConfig& config) {
+#ifdef __EMSCRIPTEN__
+    (void)config;
+    LogError("Headless mode is not supported on WASM");
+    return false;
+#else
+    // --- Initialize GPU (no window, no compatible surface) ---
+    auto& gpu = gpu::GPUCore::GetInstance();
+    gpu::GPUConfig gpu_config;
+    gpu_config.single_pass_reductions = config.single_pass_reductions;
+    if (!gpu.Initialize(gpu_config, nullptr)) {
+        // CI machines and servers without a GPU can still run the CPU backend
+        gpu.Shutdown();
+        host_only_ = true;
+        device_db_.SetHostOnly(true);
+        LogWarning("No usable GPU adapter: running host-only, only CPU-backend simulators will run");
+        return true;
+    }
+    while (!gpu.IsInitialized()) {
+        gpu.ProcessEvents();
+    }
+    FinishGPUInit();
+    LogInfo("Headless mode: compute only, drive with Step()");
+    return true;
+#endif
+}
+
+void System::RegisterBudgetHandlers(const SystemConfig& config) {
+    auto& memory = MemoryTracker::GetInstance();
+    memory.SetBudget(MemoryDomain::GPU, config.gpu_memory_budget);
+    memory.SetBudget(MemoryDomain::Host, config.host_memory_budget);
+
+    // Only caches are trimmed on the GPU side: DeviceDB and solver buffers are referenced
+    // by cached bind groups, so shrinking them here would leave those dangling.
+    budget_handlers_.push_back(memory.AddBudgetHandler(MemoryDomain::GPU, "buffer_pool",
+        [](uint64) { return gpu::GPUBufferPool::GetInstance().Trim(); }));
+    budget_handlers_.push_back(memory.AddBudgetHandler(MemoryDomain::GPU, "upload_staging",
+        [](uint64) { return gpu::StagingBelt::GetInstance().Trim(); }));
+    budget_handlers_.push_back(memory.AddBudgetHandler(MemoryDomain::Host, "undo_history",
+        [this](uint64 excess) { return db_.TrimUndoHistory(excess); }));
+}
+
 void System::FinishGPUInit() {
     auto& gpu = gpu::GPUCore::GetInstance();
     LogInfo("GPU initialized: ", gpu.GetAdapterName());
     LogInfo("Backend: ", gpu.GetBackendType());
 
-    // Create RenderEngine (needs device)
-    engine_ = std::make_unique<render::RenderEngine>();
-    render::RenderEngineConfig render_config;
-    render_config.clear_color = {0.1, 0.1, 0.15, 1.0};
-    engine_->Initialize(pending_surface_, window_->GetWidth(), window_->GetHeight(), render_config);
-    pending_surface_ = nullptr;
+    // Create RenderEngine (needs device and surface)
+    if (!headless_) {
+        MemoryScope memory_scope("render_engine");
+        engine_ = std::make_unique<render::RenderEngine>();
+        render::RenderEngineConfig render_config;
+        render_config.clear_color = {0.1, 0.1, 0.15, 1.0};
+        engine_->Initialize(pending_surface_, window_->GetWidth(), window_->GetHeight(), render_config);
+        pending_surface_ = nullptr;
+    }
+
+    // Per-pass GPU timings (requires TimestampQuery; silently off otherwise)
+    if constexpr (simulate::kEnableSimulationProfiling) {
+        if (gpu.SupportsTimestampQuery()) {
+            gpu::GPUProfiler::GetInstance().Initialize();
+        }
+    }
+
+    // Workgroup sizes tuned for this adapter by mps_bench --tune-workgroups
+    gpu::WorkgroupTuner::GetInstance().Load();
 
     // Sync any data transacted before GPU was ready
     device_db_.Sync();
@@ -105,6 +187,11 @@ void System::FinishGPUInit() {
 }
 
 void System::Run() {
+    if (headless_) {
+        LogError("System::Run is not available in headless mode, use Step()");
+        return;
+    }
+
 #ifndef __EMSCRIPTEN__
     // Native: synchronous extensions init + main loop
     InitializeExtensions();
@@ -121,6 +208,30 @@ void System::Run() {
 #endif
 }
 
+void System::Step(uint32 frame_count) {
+    if (!gpu_ready_ && !host_only_) {
+        LogError("System::Step called before GPU initialization");
+        return;
+    }
+    if (!extensions_initialized_) {
+        InitializeExtensions();
+    }
+
+    auto& gpu = gpu::GPUCore::GetInstance();
+    for (uint32 i = 0; i < frame_count; ++i) {
+        UpdateSimulators();
+        gpu.ProcessEvents();
+    }
+}
+
+bool System::IsHeadless() const {
+    return headless_;
+}
+
+bool System::IsHostOnly() const {
+    return host_only_;
+}
+
 #ifdef __EMSCRIPTEN__
 void System::EmscriptenMainLoop(void* arg) {
     auto* self = static_cast<System*>(arg);
@@ -197,6 +308,10 @@ void System::SetSimulationRunning(bool running) {
 
 void System::ResetSimulation() {
     device_db_.ForceSync();
+    for (auto& sim : simulators_) {
+        MemoryScope memory_scope(sim->GetName());
+        sim->OnReset();
+    }
     simulation_running_ = false;
     LogInfo("Simulation reset");
 }
@@ -209,12 +324,14 @@ void System::Transact(std::function<void(Database&)> fn) {
     db_.Transact([&] { fn(db_); });
     SyncToDevice();
     NotifyDatabaseChanged();
+    MemoryTracker::GetInstance().EnforceBudgets();
 }
 
 void System::Undo() {
     if (db_.Undo()) {
         SyncToDevice();
         NotifyDatabaseChanged();
+        MemoryTracker::GetInstance().EnforceBudgets();
     }
 }
 
@@ -222,6 +339,7 @@ void System::Redo() {
     if (db_.Redo()) {
         SyncToDevice();
         NotifyDatabaseChanged();
+        MemoryTracker::GetInstance().EnforceBudgets();
     }
 }
 
@@ -250,13 +368,15 @@ simulate::IDeviceArrayEntry* System::GetArrayEntryById(database::ComponentTypeId
 }
 
 void System::SyncToDevice() {
-    if (!gpu::GPUCore::GetInstance().IsInitialized()) return;
+    // Before the GPU is ready the dirty state is kept for FinishGPUInit's sync
+    if (!host_only_ && !gpu::GPUCore::GetInstance().IsInitialized()) return;
     device_db_.Sync();
 }
 
 void System::NotifyDatabaseChanged() {
     if (!extensions_initialized_) return;
     for (auto& sim : simulators_) {
+        MemoryScope memory_scope(sim->GetName());
         sim->OnDatabaseChanged();
     }
 }
@@ -277,6 +397,10 @@ void System::AddSimulator(std::unique_ptr<simulate::ISimulator> simulator) {
 }
 
 void System::AddRenderer(std::unique_ptr<render::IObjectRenderer> renderer) {
+    if (headless_) {
+        LogInfo("Renderer skipped (headless): ", renderer->GetName());
+        return;
+    }
     LogInfo("Renderer added: ", renderer->GetName());
     renderers_.push_back(std::move(renderer));
 }
@@ -339,9 +463,19 @@ void System::InitializeExtensions() {
         return;
     }
 
+    // Host-only: drop the simulators that need a device
+    if (host_only_) {
+        std::erase_if(simulators_, [](const auto& sim) {
+            if (!sim->RequiresGPU()) return false;
+            LogWarning("Simulator skipped (no GPU device): ", sim->GetName());
+            return true;
+        });
+    }
+
     // 1) Initialize simulators (GPU pipeline setup)
     for (auto& sim : simulators_) {
         LogInfo("Initializing simulator: ", sim->GetName());
+        MemoryScope memory_scope(sim->GetName());
         sim->Initialize();
     }
 
@@ -354,6 +488,7 @@ void System::InitializeExtensions() {
     // 3) Initialize renderers
     for (auto& renderer : renderers_) {
         LogInfo("Initializing renderer: ", renderer->GetName());
+        MemoryScope memory_scope(renderer->GetName());
         renderer->Initialize(*engine_);
     }
 
@@ -383,8 +518,23 @@ void System::ShutdownExtensions() {
 
 void System::UpdateSimulators() {
     for (auto& sim : simulators_) {
+        MemoryScope memory_scope(sim->GetName());
         sim->Update();
     }
+
+    // Submit this frame's readback copies after the simulators' work
+    gpu::GPUReadback::GetInstance().Flush();
+
+    auto& profiler = gpu::GPUProfiler::GetInstance();
+    if (profiler.IsEnabled()) {
+        profiler.EndFrame();
+        if (++profiled_frames_ % kProfileReportInterval == 0) {
+            profiler.LogReport();
+        }
+    }
+
+    // Frame boundary: nothing is mid-allocation, so the budget handlers may trim
+    MemoryTracker::GetInstance().EnforceBudgets();
 }
 
 void System::RenderFrame() {
@@ -416,55 +566,10 @@ void System::RenderFrame() {
 // ============================================================================
 
 std::vector<uint8> System::ReadbackBuffer(WGPUBuffer src, uint64 size) {
-    auto& gpu = gpu::GPUCore::GetInstance();
-
-    // Create staging buffer
-    WGPUBufferDescriptor staging_desc = WGPU_BUFFER_DESCRIPTOR_INIT;
-    staging_desc.usage = WGPUBufferUsage_MapRead | WGPUBufferUsage_CopyDst;
-    staging_desc.size = size;
-    WGPUBuffer staging = wgpuDeviceCreateBuffer(gpu.GetDevice(), &staging_desc);
-
-    // Copy src -> staging
-    WGPUCommandEncoderDescriptor enc_desc = WGPU_COMMAND_ENCODER_DESCRIPTOR_INIT;
-    WGPUCommandEncoder encoder = wgpuDeviceCreateCommandEncoder(gpu.GetDevice(), &enc_desc);
-    wgpuCommandEncoderCopyBufferToBuffer(encoder, src, 0, staging, 0, size);
-    WGPUCommandBuffer cmd = wgpuCommandEncoderFinish(encoder, nullptr);
-    wgpuQueueSubmit(gpu.GetQueue(), 1, &cmd);
-    wgpuCommandBufferRelease(cmd);
-    wgpuCommandEncoderRelease(encoder);
-
-    // Synchronous map
-    struct Ctx { bool done = false; bool ok = false; };
-    Ctx ctx;
-    WGPUBufferMapCallbackInfo cb = WGPU_BUFFER_MAP_CALLBACK_INFO_INIT;
-#ifdef __EMSCRIPTEN__
-    cb.mode = WGPUCallbackMode_AllowProcessEvents;
-#else
-    cb.mode = WGPUCallbackMode_WaitAnyOnly;
-#endif
-    cb.callback = [](WGPUMapAsyncStatus status, WGPUStringView, void* ud1, void*) {
-        auto* c = static_cast<Ctx*>(ud1);
-        c->done = true;
-        c->ok = (status == WGPUMapAsyncStatus_Success);
-    };
-    cb.userdata1 = &ctx;
-    WGPUFuture future = wgpuBufferMapAsync(staging, WGPUMapMode_Read, 0,
-                                            static_cast<size_t>(size), cb);
-#ifndef __EMSCRIPTEN__
-    WGPUFutureWaitInfo wait = WGPU_FUTURE_WAIT_INFO_INIT;
-    wait.future = future;
-    wgpuInstanceWaitAny(gpu.GetWGPUInstance(), 1, &wait, UINT64_MAX);
-#else
-    while (!ctx.done) gpu.ProcessEvents();
-#endif
-
-    std::vector<uint8> result;
-    if (ctx.ok) {
-        auto* mapped = wgpuBufferGetConstMappedRange(staging, 0, static_cast<size_t>(size));
-        result.resize(static_cast<size_t>(size));
-        std::memcpy(result.data(), mapped, result.size());
-        wgpuBufferUnmap(staging);
+    try {
+        return gpu::GPUReadback::GetInstance().Read(src, 0, size);
+    } catch (const gpu::GPUException& e) {
+        LogError("System: ", e.what());
+        return {};
     }
-    wgpuBufferRelease(staging);
-    return result;
 }
@@ -3,6 +3,7 @@
 #include "core_database/component_type.h"
 #include "core_database/database.h"
 #include "core_gpu/gpu_types.h"
+#include "core_gpu/gpu_readback.h"
 #include "core_simulate/device_db.h"
 #include <functional>
 #include <memory>
@@ -23,6 +24,25 @@ namespace system {
 
 class IExtension;
 
+struct SystemConfig {
+    // Headless: no window, no surface, no RenderEngine (renderers are dropped).
+    // The GPU adapter is requested without a compatible surface (compute only).
+    // Drive the simulation with Step() instead of Run(). Native only.
+    // Without a usable GPU adapter a headless System still initializes, host-only
+    // (see System::IsHostOnly): only simulators on SolverBackend::CPU run.
+    bool headless = false;
+
+    // Memory budgets in bytes (0 = none), checked after every frame and transaction.
+    // Over budget, System trims the GPU buffer pool and idle staging chunks (GPU) or
+    // drops the oldest undo history (host); see util::MemoryTracker.
+    uint64 gpu_memory_budget = 0;
+    uint64 host_memory_budget = 0;
+
+    // Single-dispatch GPU reductions (CG dots); see gpu::GPUConfig::single_pass_reductions.
+    // Turn off on adapters that do not make cross-workgroup atomics visible.
+    bool single_pass_reductions = true;
+};
+
 // Top-level system controller.
 // Owns the window, GPU lifecycle, render engine, host Database, DeviceDB,
 // extension system, and the main loop with simulation controls.
@@ -32,13 +52,26 @@ public:
     ~System();
 
     // --- Lifecycle ---
-    // Creates window, GPU, and RenderEngine. Call before AddExtension/Transact.
-    bool Initialize();
+    // Creates window, GPU, and RenderEngine (GPU only when headless).
+    // Call before AddExtension/Transact.
+    bool Initialize(const SystemConfig& config = {});
 
     // Initializes extensions, enters main loop. Call after scene setup.
-    // Cleanup happens in ~System().
+    // Cleanup happens in ~System(). Not available in headless mode.
     void Run();
 
+    // Advance all simulators by frame_count frames and return.
+    // Initializes extensions on first call. Ignores the running/paused state.
+    // Work is submitted, not awaited — Snapshot() synchronizes with the GPU.
+    void Step(uint32 frame_count = 1);
+
+    bool IsHeadless() const;
+
+    // Headless without a GPU device. DeviceDB keeps array layouts but holds no buffers,
+    // simulators that require a GPU are skipped, and CPU-backend simulators write their
+    // results back into the host Database (SimPosition / SimVelocity arrays).
+    bool IsHostOnly() const;
+
     // --- Simulation control ---
     bool IsSimulationRunning() const;
     void SetSimulationRunning(bool running);
@@ -59,6 +92,10 @@ public:
     void RegisterIndexedArray(gpu::BufferUsage extra_usage, const std::string& label,
                               simulate::IndexOffsetFn<T> offset_fn);
 
+    // Align each entity's region of a registered array (gaps filled with padding).
+    template<database::Component T>
+    void SetArrayRegionAlignment(uint32 alignment, const T& padding = T{});
+
     // --- Array queries ---
     template<database::Component T>
     uint32 GetArrayTotalCount() const;
@@ -83,9 +120,16 @@ public:
     uint32 GetComponentCount() const;
 
     // Explicit GPU -> Database readback (on-demand, no transaction).
+    // No-op when host-only: there is no device copy.
     template<database::Component T>
     void Snapshot();
 
+    // Non-blocking Snapshot(): the copy goes out with the frame's readback flush and
+    // the database is updated during a later ProcessEvents(), typically 1-2 frames on.
+    // Entities that lost the component in the meantime are skipped.
+    template<database::Component T>
+    void SnapshotAsync();
+
     // Access the host database.
     const database::Database& GetDatabase() const;
     database::Database& GetDatabase();
@@ -128,6 +172,8 @@ private:
     void SyncToDevice();
     void NotifyDatabaseChanged();
     void FinishGPUInit();
+    bool InitializeHeadless(const SystemConfig& config);
+    void RegisterBudgetHandlers(const SystemConfig& config);
     std::vector<uint8> ReadbackBuffer(WGPUBuffer src, uint64 size);
 
 #ifdef __EMSCRIPTEN__
@@ -149,6 +195,15 @@ private:
 
     // Simulation state
     bool simulation_running_ = false;
+    bool headless_ = false;
+    bool host_only_ = false;
+
+    // GPU profiler report cadence (simulated frames)
+    static constexpr uint64 kProfileReportInterval = 300;
+    uint64 profiled_frames_ = 0;
+
+    // util::MemoryTracker budget handlers registered by Initialize()
+    std::vector<uint32> budget_handlers_;
 
     // WASM async GPU initialization
     WGPUSurface pending_surface_ = nullptr;
@@ -183,6 +238,11 @@ void System::RegisterIndexedArray(gpu::BufferUsage extra_usage, const std::strin
     device_db_.RegisterIndexedArray<T, RefT>(extra_usage, label, std::move(offset_fn));
 }
 
+template<database::Component T>
+void System::SetArrayRegionAlignment(uint32 alignment, const T& padding) {
+    device_db_.SetArrayRegionAlignment<T>(alignment, padding);
+}
+
 template<database::Component T>
 WGPUBuffer System::GetDeviceBuffer() const {
     return device_db_.GetBufferHandle<T>();
@@ -223,5 +283,33 @@ void System::Snapshot() {
     }
 }
 
+template<database::Component T>
+void System::SnapshotAsync() {
+    WGPUBuffer gpu_buf = device_db_.GetBufferHandle<T>();
+    if (!gpu_buf) return;
+
+    auto* storage = db_.GetStorageById(database::GetComponentTypeId<T>());
+    if (!storage) return;
+
+    auto* typed = static_cast<database::ComponentStorage<T>*>(storage);
+    uint32 count = typed->GetDenseCount();
+    if (count == 0) return;
+
+    // Dense order at request time is what the GPU buffer holds for this frame
+    std::vector<database::Entity> entities(typed->GetEntities().begin(),
+                                           typed->GetEntities().begin() + count);
+    uint64 byte_size = uint64(count) * sizeof(T);
+    gpu::GPUReadback::GetInstance().Request(gpu_buf, 0, byte_size,
+        [this, entities = std::move(entities)](std::span<const uint8> data) {
+            if (data.size() < entities.size() * sizeof(T)) return;
+            auto* components = reinterpret_cast<const T*>(data.data());
+            for (size_t i = 0; i < entities.size(); ++i) {
+                if (db_.HasComponent<T>(entities[i])) {
+                    db_.DirectSetComponent<T>(entities[i], components[i]);
+                }
+            }
+        });
+}
+
 }  // namespace system
 }  // namespace mps
@@ -0,0 +1,118 @@
+#include "core_util/mapped_file.h"
+#include "core_util/logger.h"
+#include <utility>
+
+#if defined(__EMSCRIPTEN__)
+#include <fstream>
+#elif defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace mps {
+namespace util {
+
+MappedFile::MappedFile(const std::string& path) {
+#if defined(__EMSCRIPTEN__)
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) return;
+    buffer_.resize(static_cast<size_t>(file.tellg()));
+    file.seekg(0);
+    file.read(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+    data_ = buffer_.data();
+    size_ = buffer_.size();
+    open_ = true;
+#elif defined(_WIN32)
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return;
+    LARGE_INTEGER size{};
+    if (!GetFileSizeEx(file, &size)) {
+        CloseHandle(file);
+        return;
+    }
+    file_ = file;
+    open_ = true;
+    size_ = static_cast<uint64>(size.QuadPart);
+    if (size_ == 0) return;  // empty files cannot be mapped
+
+    mapping_ = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    void* view = mapping_ ? MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    if (!view) {
+        LogError("MappedFile: failed to map ", path);
+        Close();
+        return;
+    }
+    data_ = static_cast<const char*>(view);
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return;
+    struct stat st{};
+    if (::fstat(fd, &st) != 0) {
+        ::close(fd);
+        return;
+    }
+    open_ = true;
+    size_ = static_cast<uint64>(st.st_size);
+    if (size_ > 0) {
+        void* view = ::mmap(nullptr, static_cast<size_t>(size_), PROT_READ, MAP_PRIVATE, fd, 0);
+        if (view == MAP_FAILED) {
+            LogError("MappedFile: failed to map ", path);
+            open_ = false;
+            size_ = 0;
+        } else {
+            ::madvise(view, static_cast<size_t>(size_), MADV_SEQUENTIAL);
+            data_ = static_cast<const char*>(view);
+        }
+    }
+    ::close(fd);  // the mapping keeps its own reference
+#endif
+}
+
+MappedFile::~MappedFile() {
+    Close();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept {
+    *this = std::move(other);
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        Close();
+        data_ = std::exchange(other.data_, nullptr);
+        size_ = std::exchange(other.size_, 0);
+        open_ = std::exchange(other.open_, false);
+#ifdef _WIN32
+        file_ = std::exchange(other.file_, nullptr);
+        mapping_ = std::exchange(other.mapping_, nullptr);
+#endif
+        buffer_ = std::move(other.buffer_);
+    }
+    return *this;
+}
+
+void MappedFile::Close() {
+#if defined(__EMSCRIPTEN__)
+    buffer_.clear();
+#elif defined(_WIN32)
+    if (data_) UnmapViewOfFile(data_);
+    if (mapping_) CloseHandle(mapping_);
+    if (file_) CloseHandle(file_);
+    mapping_ = nullptr;
+    file_ = nullptr;
+#else
+    if (data_) ::munmap(const_cast<char*>(data_), static_cast<size_t>(size_));
+#endif
+    data_ = nullptr;
+    size_ = 0;
+    open_ = false;
+}
+
+}  // namespace util
+}  // namespace mps
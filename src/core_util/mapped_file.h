@@ -0,0 +1,46 @@
+#pragma once
+
+#include "core_util/types.h"
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace mps {
+namespace util {
+
+// Read-only view of a whole file. Maps the file into memory (mmap / MapViewOfFile);
+// under __EMSCRIPTEN__ the file is read into an owned buffer instead.
+class MappedFile {
+public:
+    MappedFile() = default;
+    explicit MappedFile(const std::string& path);
+    ~MappedFile();
+
+    // Move-only
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    // False if the file could not be opened (an empty file is open with size 0)
+    bool IsOpen() const { return open_; }
+
+    const char* GetData() const { return data_; }
+    uint64 GetSize() const { return size_; }
+    std::string_view GetView() const { return {data_, static_cast<size_t>(size_)}; }
+
+private:
+    void Close();
+
+    const char* data_ = nullptr;
+    uint64 size_ = 0;
+    bool open_ = false;
+#ifdef _WIN32
+    void* file_ = nullptr;       // HANDLE
+    void* mapping_ = nullptr;    // HANDLE
+#endif
+    std::vector<char> buffer_;   // __EMSCRIPTEN__ only
+};
+
+}  // namespace util
+}  // namespace mps
@@ -0,0 +1,280 @@
+#include "core_util/memory_tracker.h"
+#include "core_util/logger.h"
+#include <algorithm>
+#include <map>
+
+namespace mps {
+namespace util {
+
+static thread_local std::string t_current_owner;
+
+static float64 ToMiB(uint64 bytes) {
+    return static_cast<float64>(bytes) / (1024.0 * 1024.0);
+}
+
+const char* MemoryDomainName(MemoryDomain domain) {
+    return domain == MemoryDomain::GPU ? "GPU" : "host";
+}
+
+MemoryTracker& MemoryTracker::GetInstance() {
+    static MemoryTracker instance;
+    return instance;
+}
+
+// -- Accounting ---------------------------------------------------------------
+
+uint32 MemoryTracker::Register(MemoryDomain domain, std::string_view label, std::string_view owner) {
+    if (owner.empty()) owner = GetCurrentOwner();
+    if (label.empty()) label = "(unlabeled)";
+
+    std::lock_guard lock(mutex_);
+    for (uint32 i = 0; i < entries_.size(); ++i) {
+        const auto& entry = entries_[i];
+        if (entry.domain == domain && entry.owner == owner && entry.label == label) return i;
+    }
+    MemoryStats entry;
+    entry.domain = domain;
+    entry.owner = std::string(owner);
+    entry.label = std::string(label);
+    entries_.push_back(std::move(entry));
+    return static_cast<uint32>(entries_.size() - 1);
+}
+
+void MemoryTracker::Apply(uint32 entry, uint64 old_bytes, uint64 new_bytes, int32 allocation_delta) {
+    if (entry >= entries_.size()) return;
+    auto& stats = entries_[entry];
+    auto& domain = domains_[static_cast<uint32>(stats.domain)];
+
+    stats.live_bytes = stats.live_bytes - std::min(old_bytes, stats.live_bytes) + new_bytes;
+    stats.peak_bytes = std::max(stats.peak_bytes, stats.live_bytes);
+    stats.live_allocations = static_cast<uint32>(static_cast<int32>(stats.live_allocations) + allocation_delta);
+
+    domain.live = domain.live - std::min(old_bytes, domain.live) + new_bytes;
+    domain.peak = std::max(domain.peak, domain.live);
+    domain.high_water = std::max(domain.high_water, domain.live);
+}
+
+void MemoryTracker::Allocate(uint32 entry, uint64 bytes) {
+    std::lock_guard lock(mutex_);
+    Apply(entry, 0, bytes, 1);
+}
+
+void MemoryTracker::Free(uint32 entry, uint64 bytes) {
+    std::lock_guard lock(mutex_);
+    Apply(entry, bytes, 0, -1);
+}
+
+void MemoryTracker::Resize(uint32 entry, uint64 old_bytes, uint64 new_bytes) {
+    std::lock_guard lock(mutex_);
+    Apply(entry, old_bytes, new_bytes, 0);
+}
+
+// -- Budgets ------------------------------------------------------------------
+
+void MemoryTracker::SetBudget(MemoryDomain domain, uint64 bytes) {
+    std::lock_guard lock(mutex_);
+    domains_[static_cast<uint32>(domain)].budget = bytes;
+    domains_[static_cast<uint32>(domain)].warned = false;
+    if (bytes > 0) {
+        LogInfo("MemoryTracker: ", MemoryDomainName(domain), " budget ", ToMiB(bytes), " MiB");
+    }
+}
+
+uint64 MemoryTracker::GetBudget(MemoryDomain domain) const {
+    std::lock_guard lock(mutex_);
+    return domains_[static_cast<uint32>(domain)].budget;
+}
+
+bool MemoryTracker::IsOverBudget(MemoryDomain domain) const {
+    std::lock_guard lock(mutex_);
+    const auto& state = domains_[static_cast<uint32>(domain)];
+    return state.budget > 0 && state.live > state.budget;
+}
+
+uint32 MemoryTracker::AddBudgetHandler(MemoryDomain domain, std::string name, BudgetHandler handler) {
+    std::lock_guard lock(mutex_);
+    uint32 handle = next_handler_++;
+    handlers_.push_back({handle, domain, std::move(name), std::move(handler)});
+    return handle;
+}
+
+void MemoryTracker::RemoveBudgetHandler(uint32 handle) {
+    std::lock_guard lock(mutex_);
+    std::erase_if(handlers_, [handle](const Handler& h) { return h.handle == handle; });
+}
+
+void MemoryTracker::EnforceBudgets() {
+    if (enforcing_) return;
+    enforcing_ = true;
+
+    bool report = false;
+    for (uint32 d = 0; d < kMemoryDomainCount; ++d) {
+        auto domain = static_cast<MemoryDomain>(d);
+        uint64 live = 0;
+        uint64 budget = 0;
+        std::vector<Handler> handlers;
+        {
+            std::lock_guard lock(mutex_);
+            live = domains_[d].live;
+            budget = domains_[d].budget;
+            if (budget == 0 || live <= budget) {
+                domains_[d].warned = false;
+                continue;
+            }
+            for (const auto& handler : handlers_) {
+                if (handler.domain == domain) handlers.push_back(handler);
+            }
+        }
+
+        // Handlers run unlocked: they free (and may allocate) tracked memory
+        for (const auto& handler : handlers) {
+            uint64 excess = live - budget;
+            uint64 released = handler.fn(excess);
+            live = GetTotals(domain).live_bytes;
+            if (released > 0) {
+                LogInfo("MemoryTracker: ", MemoryDomainName(domain), " over budget by ", ToMiB(excess),
+                        " MiB, ", handler.name, " released ", ToMiB(released), " MiB");
+            }
+            if (live <= budget) break;
+        }
+
+        std::lock_guard lock(mutex_);
+        if (live > budget && !domains_[d].warned) {
+            domains_[d].warned = true;
+            report = true;
+            LogWarning("MemoryTracker: ", MemoryDomainName(domain), " memory ", ToMiB(live),
+                       " MiB exceeds the ", ToMiB(budget), " MiB budget");
+        } else if (live <= budget) {
+            domains_[d].warned = false;
+        }
+    }
+
+    // Once per excursion: show who holds the memory
+    if (report) LogReport();
+    enforcing_ = false;
+}
+
+// -- Statistics ---------------------------------------------------------------
+
+MemoryTotals MemoryTracker::GetTotals(MemoryDomain domain) const {
+    std::lock_guard lock(mutex_);
+    const auto& state = domains_[static_cast<uint32>(domain)];
+    return {state.live, state.peak, state.high_water, state.budget};
+}
+
+std::vector<MemoryStats> MemoryTracker::GetStats() const {
+    std::vector<MemoryStats> stats;
+    {
+        std::lock_guard lock(mutex_);
+        for (const auto& entry : entries_) {
+            if (entry.peak_bytes > 0) stats.push_back(entry);
+        }
+    }
+    std::stable_sort(stats.begin(), stats.end(), [](const MemoryStats& a, const MemoryStats& b) {
+        return a.live_bytes > b.live_bytes;
+    });
+    return stats;
+}
+
+std::vector<std::pair<std::string, uint64>> MemoryTracker::GetOwnerTotals(MemoryDomain domain) const {
+    std::map<std::string, uint64> owners;
+    {
+        std::lock_guard lock(mutex_);
+        for (const auto& entry : entries_) {
+            if (entry.domain == domain && entry.live_bytes > 0) owners[entry.owner] += entry.live_bytes;
+        }
+    }
+    std::vector<std::pair<std::string, uint64>> totals(owners.begin(), owners.end());
+    std::stable_sort(totals.begin(), totals.end(), [](const auto& a, const auto& b) {
+        return a.second > b.second;
+    });
+    return totals;
+}
+
+void MemoryTracker::ResetHighWater() {
+    std::lock_guard lock(mutex_);
+    for (auto& state : domains_) {
+        state.high_water = state.live;
+    }
+}
+
+void MemoryTracker::LogReport(uint32 max_entries) const {
+    for (uint32 d = 0; d < kMemoryDomainCount; ++d) {
+        auto domain = static_cast<MemoryDomain>(d);
+        MemoryTotals totals = GetTotals(domain);
+        LogInfo("Memory [", MemoryDomainName(domain), "]: live ", ToMiB(totals.live_bytes),
+                " MiB, peak ", ToMiB(totals.peak_bytes), " MiB, high-water ",
+                ToMiB(totals.high_water_bytes), " MiB",
+                totals.budget_bytes > 0 ? ", budget " : "",
+                totals.budget_bytes > 0 ? std::to_string(ToMiB(totals.budget_bytes)) + " MiB" : "");
+        for (const auto& [owner, bytes] : GetOwnerTotals(domain)) {
+            LogInfo("  ", owner.empty() ? "(no owner)" : owner, ": ", ToMiB(bytes), " MiB");
+        }
+    }
+
+    auto stats = GetStats();
+    uint32 count = std::min<uint32>(max_entries, static_cast<uint32>(stats.size()));
+    for (uint32 i = 0; i < count; ++i) {
+        const auto& entry = stats[i];
+        LogInfo("  [", MemoryDomainName(entry.domain), "] ", entry.owner.empty() ? "-" : entry.owner,
+                " / ", entry.label, ": ", ToMiB(entry.live_bytes), " MiB live (", entry.live_allocations,
+                " allocs), ", ToMiB(entry.peak_bytes), " MiB peak");
+    }
+}
+
+std::string_view MemoryTracker::GetCurrentOwner() {
+    return t_current_owner;
+}
+
+// -- MemoryAccount ------------------------------------------------------------
+
+MemoryAccount::MemoryAccount(MemoryDomain domain, std::string_view label, std::string_view owner)
+    : entry_(MemoryTracker::GetInstance().Register(domain, label, owner)) {}
+
+MemoryAccount::~MemoryAccount() {
+    Set(0);
+}
+
+MemoryAccount::MemoryAccount(MemoryAccount&& other) noexcept
+    : entry_(other.entry_), bytes_(other.bytes_) {
+    other.entry_ = kNoEntry;
+    other.bytes_ = 0;
+}
+
+MemoryAccount& MemoryAccount::operator=(MemoryAccount&& other) noexcept {
+    if (this != &other) {
+        Set(0);
+        entry_ = other.entry_;
+        bytes_ = other.bytes_;
+        other.entry_ = kNoEntry;
+        other.bytes_ = 0;
+    }
+    return *this;
+}
+
+void MemoryAccount::Set(uint64 bytes) {
+    if (entry_ == kNoEntry || bytes == bytes_) return;
+    auto& tracker = MemoryTracker::GetInstance();
+    if (bytes_ == 0) {
+        tracker.Allocate(entry_, bytes);
+    } else if (bytes == 0) {
+        tracker.Free(entry_, bytes_);
+    } else {
+        tracker.Resize(entry_, bytes_, bytes);
+    }
+    bytes_ = bytes;
+}
+
+// -- MemoryScope --------------------------------------------------------------
+
+MemoryScope::MemoryScope(std::string_view owner)
+    : previous_(t_current_owner) {
+    t_current_owner = owner;
+}
+
+MemoryScope::~MemoryScope() {
+    t_current_owner = std::move(previous_);
+}
+
+}  // namespace util
+}  // namespace mps
@@ -0,0 +1,159 @@
+#pragma once
+
+#include "core_util/types.h"
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace mps {
+namespace util {
+
+enum class MemoryDomain : uint8 { Host, GPU };
+inline constexpr uint32 kMemoryDomainCount = 2;
+
+const char* MemoryDomainName(MemoryDomain domain);
+
+// Bytes attributed to one (domain, owner, label) entry, e.g. (GPU, "NewtonSystemSimulator",
+// "newton_csr_values"). Allocations with the same key are summed.
+struct MemoryStats {
+    MemoryDomain domain = MemoryDomain::Host;
+    std::string owner;
+    std::string label;
+    uint64 live_bytes = 0;
+    uint64 peak_bytes = 0;          // largest live_bytes since the entry was registered
+    uint32 live_allocations = 0;
+};
+
+struct MemoryTotals {
+    uint64 live_bytes = 0;
+    uint64 peak_bytes = 0;          // since process start
+    uint64 high_water_bytes = 0;    // since the last ResetHighWater()
+    uint64 budget_bytes = 0;        // 0 = no budget
+};
+
+// Process-wide accounting of host and GPU memory by owner and label.
+//
+// Allocation sites hold a MemoryAccount and report their current size through it
+// (GPUBufferCore, GPUTexture, the GPU buffer pool and staging rings, Database storages
+// and the undo history). The owner is taken from the innermost MemoryScope on the
+// calling thread when the account is opened, so a buffer created while a simulator
+// initializes is charged to that simulator.
+//
+// A budget per domain is optional. EnforceBudgets(), called by System at frame and
+// transaction boundaries, runs the domain's budget handlers in registration order until
+// live bytes fit again; each handler frees what it safely can (trims pools, drops old
+// undo history) and returns the bytes it released. Handlers are never invoked from
+// inside an allocation, so they may allocate and free freely. Thread-safe.
+class MemoryTracker {
+public:
+    // Free memory toward `excess_bytes`; returns the bytes actually released
+    using BudgetHandler = std::function<uint64(uint64 excess_bytes)>;
+
+    static MemoryTracker& GetInstance();
+
+    // Entry for (domain, owner, label), created on first use. Empty owner = current scope.
+    uint32 Register(MemoryDomain domain, std::string_view label, std::string_view owner = {});
+    void Allocate(uint32 entry, uint64 bytes);
+    void Free(uint32 entry, uint64 bytes);
+    // An existing allocation changed size (grow, shrink-to-fit)
+    void Resize(uint32 entry, uint64 old_bytes, uint64 new_bytes);
+
+    // --- Budgets ---
+    void SetBudget(MemoryDomain domain, uint64 bytes);
+    uint64 GetBudget(MemoryDomain domain) const;
+    bool IsOverBudget(MemoryDomain domain) const;
+
+    uint32 AddBudgetHandler(MemoryDomain domain, std::string name, BudgetHandler handler);
+    void RemoveBudgetHandler(uint32 handle);
+
+    // Run budget handlers for every domain over its budget. If a domain is still over
+    // afterwards, warns and logs a report (once until it fits again). Main thread only.
+    void EnforceBudgets();
+
+    // --- Statistics ---
+    MemoryTotals GetTotals(MemoryDomain domain) const;
+    // Entries with live or peak bytes, largest live first
+    std::vector<MemoryStats> GetStats() const;
+    // Live bytes per owner within a domain, largest first
+    std::vector<std::pair<std::string, uint64>> GetOwnerTotals(MemoryDomain domain) const;
+    void ResetHighWater();
+    void LogReport(uint32 max_entries = 16) const;
+
+    // Owner of the innermost MemoryScope on this thread ("" outside any scope)
+    static std::string_view GetCurrentOwner();
+
+private:
+    MemoryTracker() = default;
+
+    MemoryTracker(const MemoryTracker&) = delete;
+    MemoryTracker& operator=(const MemoryTracker&) = delete;
+
+    // Apply a change to an entry and its domain totals; mutex_ must be held
+    void Apply(uint32 entry, uint64 old_bytes, uint64 new_bytes, int32 allocation_delta);
+
+    struct DomainState {
+        uint64 live = 0;
+        uint64 peak = 0;
+        uint64 high_water = 0;
+        uint64 budget = 0;
+        bool warned = false;    // over budget after the handlers ran; cleared once back under
+    };
+
+    struct Handler {
+        uint32 handle = 0;
+        MemoryDomain domain = MemoryDomain::Host;
+        std::string name;
+        BudgetHandler fn;
+    };
+
+    mutable std::mutex mutex_;
+    std::vector<MemoryStats> entries_;
+    DomainState domains_[kMemoryDomainCount];
+    std::vector<Handler> handlers_;
+    uint32 next_handler_ = 1;
+    bool enforcing_ = false;
+};
+
+// One allocation site's contribution to a MemoryTracker entry. Set() reports the
+// site's current size; the bytes are released when the account is destroyed.
+// Move-only (moving transfers the bytes with the owning object).
+class MemoryAccount {
+public:
+    MemoryAccount() = default;
+    MemoryAccount(MemoryDomain domain, std::string_view label, std::string_view owner = {});
+    ~MemoryAccount();
+
+    MemoryAccount(MemoryAccount&& other) noexcept;
+    MemoryAccount& operator=(MemoryAccount&& other) noexcept;
+    MemoryAccount(const MemoryAccount&) = delete;
+    MemoryAccount& operator=(const MemoryAccount&) = delete;
+
+    void Set(uint64 bytes);
+    uint64 Get() const { return bytes_; }
+    bool IsOpen() const { return entry_ != kNoEntry; }
+
+private:
+    static constexpr uint32 kNoEntry = UINT32_MAX;
+
+    uint32 entry_ = kNoEntry;
+    uint64 bytes_ = 0;
+};
+
+// Attributes accounts opened on this thread to `owner` until destroyed. Nests.
+class MemoryScope {
+public:
+    explicit MemoryScope(std::string_view owner);
+    ~MemoryScope();
+
+    MemoryScope(const MemoryScope&) = delete;
+    MemoryScope& operator=(const MemoryScope&) = delete;
+
+private:
+    std::string previous_;
+};
+
+}  // namespace util
+}  // namespace mps
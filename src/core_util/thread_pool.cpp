@@ -0,0 +1,132 @@
+#include "core_util/thread_pool.h"
+#include "core_util/logger.h"
+#include <algorithm>
+
+namespace mps {
+namespace util {
+
+// Set on pool workers and on a caller while it runs chunks: nested ParallelFor
+// calls execute inline instead of waiting on the busy pool.
+static thread_local bool t_in_job = false;
+
+ThreadPool& ThreadPool::GetInstance() {
+    static ThreadPool instance;
+    return instance;
+}
+
+ThreadPool::ThreadPool() {
+    Start(0);
+}
+
+ThreadPool::~ThreadPool() {
+    Shutdown();
+}
+
+void ThreadPool::Start(uint32 thread_count) {
+#ifndef __EMSCRIPTEN__
+    if (thread_count == 0) {
+        thread_count = std::max(std::thread::hardware_concurrency(), 1u);
+    }
+    workers_.reserve(thread_count - 1);
+    for (uint32 i = 1; i < thread_count; ++i) {
+        workers_.emplace_back([this] { WorkerLoop(); });
+    }
+#endif
+    LogInfo("ThreadPool: ", GetThreadCount(), " threads");
+}
+
+void ThreadPool::SetThreadCount(uint32 count) {
+    Shutdown();
+    Start(count);
+}
+
+void ThreadPool::Shutdown() {
+    {
+        std::lock_guard lock(mutex_);
+        stop_ = true;
+    }
+    wake_.notify_all();
+    for (auto& worker : workers_) {
+        worker.join();
+    }
+    workers_.clear();
+    stop_ = false;
+}
+
+uint32 ThreadPool::RunChunks(const RangeFn& fn, uint32 count, uint32 grain, uint32 chunks) {
+    uint32 processed = 0;
+    for (uint32 c = next_chunk_.fetch_add(1); c < chunks; c = next_chunk_.fetch_add(1)) {
+        uint32 begin = c * grain;
+        fn(begin, std::min(count, begin + grain));
+        ++processed;
+    }
+    return processed;
+}
+
+void ThreadPool::ParallelFor(uint32 count, uint32 grain, const RangeFn& fn) {
+    if (count == 0) return;
+    grain = std::max(grain, 1u);
+    uint32 chunks = GetChunkCount(count, grain);
+
+    if (workers_.empty() || chunks == 1 || t_in_job) {
+        for (uint32 begin = 0; begin < count; begin += grain) {
+            fn(begin, std::min(count, begin + grain));
+        }
+        return;
+    }
+
+    std::lock_guard submit(submit_mutex_);
+    {
+        std::lock_guard lock(mutex_);
+        job_ = &fn;
+        job_count_ = count;
+        job_grain_ = grain;
+        job_chunks_ = chunks;
+        finished_chunks_ = 0;
+        next_chunk_.store(0);
+        ++generation_;
+    }
+    wake_.notify_all();
+
+    t_in_job = true;
+    uint32 processed = RunChunks(fn, count, grain, chunks);
+    t_in_job = false;
+
+    // Wait for the remaining chunks and for every worker to leave the job, so none
+    // of them can pick up a chunk index of the next job with this job's fn.
+    std::unique_lock lock(mutex_);
+    finished_chunks_ += processed;
+    done_.wait(lock, [&] { return finished_chunks_ == chunks && active_workers_ == 0; });
+    job_ = nullptr;
+}
+
+void ThreadPool::WorkerLoop() {
+    t_in_job = true;
+    uint64 seen_generation = 0;
+
+    std::unique_lock lock(mutex_);
+    while (true) {
+        wake_.wait(lock, [&] { return stop_ || (job_ && generation_ != seen_generation); });
+        if (stop_) return;
+
+        seen_generation = generation_;
+        const RangeFn& fn = *job_;
+        uint32 count = job_count_;
+        uint32 grain = job_grain_;
+        uint32 chunks = job_chunks_;
+        ++active_workers_;
+        lock.unlock();
+
+        uint32 processed = RunChunks(fn, count, grain, chunks);
+
+        lock.lock();
+        finished_chunks_ += processed;
+        --active_workers_;
+        if (finished_chunks_ == job_chunks_ && active_workers_ == 0) {
+            done_.notify_all();
+        }
+    }
+}
+
+}  // namespace util
+}  // namespace mps
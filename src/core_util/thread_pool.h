@@ -0,0 +1,71 @@
+#pragma once
+
+#include "core_util/types.h"
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace mps {
+namespace util {
+
+// Process-wide worker pool for data-parallel host loops (CPU solver backend).
+//
+// ParallelFor splits [0, count) into chunks of `grain` items; chunk c always covers
+// [c * grain, min(count, (c + 1) * grain)), independent of the thread count, so
+// per-chunk partial sums reduce deterministically. The calling thread works on
+// chunks too and returns once every chunk is done. Calls made from inside a job
+// run inline. Under __EMSCRIPTEN__ no workers are started and loops run inline.
+class ThreadPool {
+public:
+    using RangeFn = std::function<void(uint32 begin, uint32 end)>;
+
+    static ThreadPool& GetInstance();
+
+    void ParallelFor(uint32 count, uint32 grain, const RangeFn& fn);
+
+    [[nodiscard]] static uint32 GetChunkCount(uint32 count, uint32 grain) {
+        return (count + grain - 1) / grain;
+    }
+
+    // Workers plus the calling thread
+    [[nodiscard]] uint32 GetThreadCount() const { return static_cast<uint32>(workers_.size()) + 1; }
+
+    // Restart with the given total thread count (0 = hardware concurrency).
+    // Must not be called while a ParallelFor is running.
+    void SetThreadCount(uint32 count);
+
+    void Shutdown();
+
+private:
+    ThreadPool();
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    void Start(uint32 thread_count);
+    void WorkerLoop();
+    uint32 RunChunks(const RangeFn& fn, uint32 count, uint32 grain, uint32 chunks);
+
+    std::vector<std::thread> workers_;
+    std::mutex submit_mutex_;               // one job at a time
+    std::mutex mutex_;                      // guards the job state below
+    std::condition_variable wake_;
+    std::condition_variable done_;
+
+    const RangeFn* job_ = nullptr;
+    uint32 job_count_ = 0;
+    uint32 job_grain_ = 1;
+    uint32 job_chunks_ = 0;
+    uint32 finished_chunks_ = 0;
+    uint32 active_workers_ = 0;             // workers still inside the current job
+    uint64 generation_ = 0;
+    bool stop_ = false;
+    std::atomic<uint32> next_chunk_{0};
+};
+
+}  // namespace util
+}  // namespace mps
@@ -10,16 +10,38 @@
 #include "ext_dynamics/global_physics_params.h"
 #include "core_simulate/sim_components.h"
 #include "core_util/types.h"
+#include <charconv>
 #include <memory>
+#include <string>
+#include <string_view>
 
 using namespace mps;
 using namespace mps::system;
 using namespace mps::database;
 using namespace mps::simulate;
 
-int main() {
+int main(int argc, char** argv) {
+    // --headless [frames]: no window, step the simulation and exit
+    SystemConfig config;
+    uint32 headless_frames = 600;
+    for (int i = 1; i < argc; ++i) {
+        if (std::string_view(argv[i]) == "--headless") {
+            config.headless = true;
+            // The frame count is optional: a following non-numeric argument is left alone
+            if (i + 1 < argc) {
+                std::string_view next(argv[i + 1]);
+                uint32 frames = 0;
+                auto [end, ec] = std::from_chars(next.data(), next.data() + next.size(), frames);
+                if (ec == std::errc() && end == next.data() + next.size()) {
+                    headless_frames = frames;
+                    ++i;
+                }
+            }
+        }
+    }
+
     System system;
-    if (!system.Initialize()) return 1;
+    if (!system.Initialize(config)) return 1;
 
     // Extensions: dynamics (data + GPU arrays), mesh (rendering), newton, pd
     system.AddExtension(std::make_unique<ext_dynamics::DynamicsExtension>(system));
@@ -70,6 +92,10 @@ int main() {
         db.AddComponent<ext_pd::PDSystemConfig>(pd_e, pd_cfg);
     });
 
-    system.Run();
+    if (config.headless) {
+        system.Step(headless_frames);
+    } else {
+        system.Run();
+    }
     return 0;
 }
@@ -0,0 +1,78 @@
+#include "core_database/array_storage.h"
+#include "test_check.h"
+#include <cstdint>
+#include <vector>
+
+using namespace mps;
+using namespace mps::database;
+
+static std::vector<uint32> Sequence(uint32 count, uint32 first) {
+    std::vector<uint32> values(count);
+    for (uint32 i = 0; i < count; ++i) values[i] = first + i;
+    return values;
+}
+
+// Pack keeps every array's contents, aligns each region and fills the gaps
+static void TestPackPreservesContents() {
+    constexpr uint32 kAlignment = 64;
+    constexpr uint32 kPadding = 0xFFFFFFFFu;
+
+    ArrayStorage<uint32> storage;
+    storage.SetArray(7, Sequence(100, 7000));
+    storage.SetArray(2, Sequence(3, 2000));
+    storage.SetArray(5, Sequence(0, 0));
+    storage.SetArray(9, Sequence(65, 9000));
+    storage.SetArray(2, Sequence(40, 2000));   // outgrows its range: moves, leaving a hole
+    storage.Remove(9);
+    storage.SetArray(4, Sequence(10, 4000));
+
+    storage.Pack(kAlignment, &kPadding);
+    MPS_CHECK(storage.IsPacked(kAlignment));
+    MPS_CHECK(!storage.IsPacked(16));
+
+    const auto* arena = static_cast<const uint32*>(storage.GetArenaData());
+    const std::pair<Entity, std::vector<uint32>> expected[] = {
+        {2, Sequence(40, 2000)}, {4, Sequence(10, 4000)}, {5, {}}, {7, Sequence(100, 7000)}};
+
+    uint32 used = 0;
+    std::vector<uint8> owned(storage.GetArenaCount(), 0);
+    for (const auto& [entity, values] : expected) {
+        auto array = storage.GetArray(entity);
+        MPS_CHECK(array.has_value());
+        if (!array) continue;
+        MPS_CHECK(std::vector<uint32>(array->begin(), array->end()) == values);
+        used += static_cast<uint32>(values.size());
+        if (values.empty()) continue;
+
+        auto offset = static_cast<uint32>(static_cast<const uint32*>(storage.GetArrayData(entity)) - arena);
+        MPS_CHECK(offset % kAlignment == 0);
+        for (uint32 i = 0; i < values.size(); ++i) owned[offset + i] = 1;
+    }
+    MPS_CHECK(!storage.Has(9));
+
+    // Regions in entity order with aligned starts: 2 @ 0, 4 @ 64, 7 @ 128
+    MPS_CHECK(storage.GetArenaCount() == 128 + 100);
+    for (uint32 i = 0; i < storage.GetArenaCount(); ++i) {
+        if (!owned[i]) MPS_CHECK(arena[i] == kPadding);
+    }
+    MPS_CHECK(used < storage.GetArenaCount());
+
+    // Same-length rewrites stay in place and keep the packed layout
+    storage.SetArray(4, Sequence(10, 4100));
+    MPS_CHECK(storage.IsPacked(kAlignment));
+    MPS_CHECK(storage.GetArray(4)->front() == 4100);
+
+    // A length change invalidates it; packing again restores the contents
+    storage.SetArray(4, Sequence(70, 4200));
+    MPS_CHECK(!storage.IsPacked(kAlignment));
+    storage.Pack(kAlignment, &kPadding);
+    MPS_CHECK(std::vector<uint32>(storage.GetArray(4)->begin(), storage.GetArray(4)->end()) ==
+              Sequence(70, 4200));
+    MPS_CHECK(std::vector<uint32>(storage.GetArray(7)->begin(), storage.GetArray(7)->end()) ==
+              Sequence(100, 7000));
+}
+
+int main() {
+    TestPackPreservesContents();
+    return MPS_TEST_RESULT();
+}
@@ -0,0 +1,63 @@
+#include "core_simulate/element_coloring.h"
+#include "test_check.h"
+#include "test_mesh.h"
+#include <algorithm>
+
+using namespace mps;
+using namespace mps::simulate;
+
+// No two elements of one color share a node, and the ranges partition the reordered elements
+static void CheckColoring(const std::vector<uint32>& element_nodes, uint32 nodes_per_element,
+                          uint32 node_count) {
+    ElementColoring coloring;
+    coloring.Build(element_nodes, nodes_per_element, node_count);
+
+    uint32 element_count = static_cast<uint32>(element_nodes.size() / nodes_per_element);
+    const auto& order = coloring.GetOrder();
+    const auto& ranges = coloring.GetRanges();
+    MPS_CHECK(order.size() == element_count);
+    MPS_CHECK(coloring.GetColorCount() == ranges.size());
+
+    // order is a permutation of the elements
+    std::vector<uint32> sorted = order;
+    std::sort(sorted.begin(), sorted.end());
+    for (uint32 e = 0; e < element_count; ++e) MPS_CHECK(sorted[e] == e);
+
+    uint32 offset = 0;
+    for (const auto& range : ranges) {
+        MPS_CHECK(range.offset == offset);
+        MPS_CHECK(range.count > 0);
+        offset += range.count;
+
+        std::vector<uint8> touched(node_count, 0);
+        for (uint32 i = range.offset; i < range.offset + range.count; ++i) {
+            const uint32* nodes = element_nodes.data() + uint64(order[i]) * nodes_per_element;
+            for (uint32 k = 0; k < nodes_per_element; ++k) {
+                MPS_CHECK(!touched[nodes[k]]);
+                touched[nodes[k]] = 1;
+            }
+        }
+    }
+    MPS_CHECK(offset == element_count);
+
+    // Reorder follows the same order
+    std::vector<uint32> ids(element_count);
+    for (uint32 e = 0; e < element_count; ++e) ids[e] = e;
+    MPS_CHECK(coloring.Reorder(ids) == order);
+}
+
+int main() {
+    constexpr uint32 n = 12;
+    CheckColoring(mps_test::GridEdges(n), 2, n * n);
+    CheckColoring(mps_test::GridTriangles(n), 3, n * n);
+
+    // A star: every edge shares the center, so each needs its own color
+    std::vector<uint32> star;
+    for (uint32 v = 1; v <= 70; ++v) star.insert(star.end(), {0, v});
+    CheckColoring(star, 2, 71);
+    ElementColoring coloring;
+    coloring.Build(star, 2, 71);
+    MPS_CHECK(coloring.GetColorCount() == 70);   // past one 64-color bitset word
+
+    return MPS_TEST_RESULT();
+}
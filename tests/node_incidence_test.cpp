@@ -0,0 +1,68 @@
+#include "core_simulate/node_incidence.h"
+#include "test_check.h"
+#include "test_mesh.h"
+#include <algorithm>
+
+using namespace mps;
+using namespace mps::simulate;
+
+// Every (element, slot) appears exactly once, under the node it names, in element order
+static void CheckIncidence(const std::vector<uint32>& element_nodes, uint32 nodes_per_element,
+                           uint32 node_count) {
+    NodeIncidence incidence;
+    incidence.Build(element_nodes, nodes_per_element, node_count);
+
+    const auto& offsets = incidence.GetOffsets();
+    const auto& entries = incidence.GetEntries();
+    MPS_CHECK(offsets.size() == node_count + 1);
+    MPS_CHECK(offsets.front() == 0);
+    MPS_CHECK(offsets.back() == element_nodes.size());
+    MPS_CHECK(entries.size() == element_nodes.size());
+
+    uint32 max_valence = 0;
+    std::vector<uint8> seen(element_nodes.size(), 0);
+    for (uint32 node = 0; node < node_count; ++node) {
+        MPS_CHECK(offsets[node] <= offsets[node + 1]);
+        max_valence = std::max(max_valence, offsets[node + 1] - offsets[node]);
+        for (uint32 i = offsets[node]; i < offsets[node + 1]; ++i) {
+            const IncidenceEntry& entry = entries[i];
+            MPS_CHECK(entry.slot < nodes_per_element);
+            uint64 corner = uint64(entry.element) * nodes_per_element + entry.slot;
+            MPS_CHECK(corner < element_nodes.size());
+            if (corner >= element_nodes.size()) continue;
+            MPS_CHECK(element_nodes[corner] == node);
+            MPS_CHECK(!seen[corner]);
+            seen[corner] = 1;
+            if (i > offsets[node]) MPS_CHECK(entries[i - 1].element < entry.element);
+        }
+    }
+    MPS_CHECK(std::all_of(seen.begin(), seen.end(), [](uint8 s) { return s != 0; }));
+    MPS_CHECK(incidence.GetMaxValence() == max_valence);
+}
+
+int main() {
+    constexpr uint32 n = 10;
+    CheckIncidence(mps_test::GridEdges(n), 2, n * n);
+    CheckIncidence(mps_test::GridTriangles(n), 3, n * n);
+
+    // Interior grid vertices touch six triangles
+    NodeIncidence incidence;
+    incidence.Build(mps_test::GridTriangles(n), 3, n * n);
+    MPS_CHECK(incidence.GetMaxValence() == 6);
+
+    // Isolated nodes get empty ranges
+    std::vector<uint32> one_edge = {1, 3};
+    CheckIncidence(one_edge, 2, 5);
+
+    // No elements: every range is empty, and the upload is one zeroed entry
+    NodeIncidence empty;
+    empty.Build({}, 2, 4);
+    MPS_CHECK(empty.GetOffsets() == std::vector<uint32>(5, 0));
+    MPS_CHECK(empty.GetEntries().empty());
+    auto upload = NonEmptyUpload(empty.GetEntries());
+    MPS_CHECK(upload.size() == 1);
+    MPS_CHECK(upload[0].element == 0 && upload[0].slot == 0);
+    MPS_CHECK(NonEmptyUpload(one_edge).size() == one_edge.size());
+
+    return MPS_TEST_RESULT();
+}
@@ -0,0 +1,82 @@
+#include "ext_mesh/obj_parser.h"
+#include "test_check.h"
+#include <string>
+
+using namespace mps;
+using namespace ext_mesh;
+
+static bool SameFace(const MeshFace& face, uint32 n0, uint32 n1, uint32 n2) {
+    return face.n0 == n0 && face.n1 == n1 && face.n2 == n2;
+}
+
+// Corner formats, fan triangulation, negative indices, scale and offset
+static void TestRecords() {
+    const char* text =
+        "# comment\n"
+        "o quad\n"
+        "v 0 0 0\n"
+        "v 1 0 0\r\n"
+        "v 1 1 0\n"
+        "v 0 1 0\n"
+        "vt 0 0\n"
+        "vn 0 0 1\n"
+        "f 1/1/1 2/2/1 3/3/1 4/4/1\n"
+        "f -4//1 -3//1 -1//1\n";
+
+    OBJMesh mesh;
+    MPS_CHECK(ParseOBJ(text, 2.0f, util::vec3(1.0f, 2.0f, 3.0f), mesh));
+    MPS_CHECK(mesh.positions.size() == 4);
+    MPS_CHECK(mesh.faces.size() == 3);
+    if (mesh.positions.size() != 4 || mesh.faces.size() != 3) return;
+
+    MPS_CHECK(mesh.positions[2].x == 3.0f);
+    MPS_CHECK(mesh.positions[2].y == 4.0f);
+    MPS_CHECK(mesh.positions[2].z == 3.0f);
+    MPS_CHECK(SameFace(mesh.faces[0], 0, 1, 2));
+    MPS_CHECK(SameFace(mesh.faces[1], 0, 2, 3));
+    MPS_CHECK(SameFace(mesh.faces[2], 0, 1, 3));
+}
+
+static void TestOutOfRange() {
+    OBJMesh mesh;
+    MPS_CHECK(!ParseOBJ("v 0 0 0\nv 1 0 0\nf 1 2 3\n", 1.0f, util::vec3(0.0f), mesh));
+    MPS_CHECK(mesh.positions.empty());
+    MPS_CHECK(mesh.faces.empty());
+}
+
+// Text larger than one parse chunk merges back in file order, including negative
+// indices that refer to vertices of the previous chunk
+static void TestChunkedMatchesFileOrder() {
+    constexpr uint32 kTriangles = 60000;   // ~2 MiB of text
+    std::string text;
+    for (uint32 t = 0; t < kTriangles; ++t) {
+        for (uint32 k = 0; k < 3; ++k) {
+            text += "v " + std::to_string(3 * t + k) + " 0 0\n";
+        }
+        text += "f -3 -2 -1\n";
+    }
+
+    OBJMesh mesh;
+    MPS_CHECK(ParseOBJ(text, 1.0f, util::vec3(0.0f), mesh));
+    MPS_CHECK(mesh.positions.size() == 3 * kTriangles);
+    MPS_CHECK(mesh.faces.size() == kTriangles);
+    if (mesh.positions.size() != 3 * kTriangles || mesh.faces.size() != kTriangles) return;
+
+    uint32 bad_positions = 0;
+    for (uint32 v = 0; v < 3 * kTriangles; ++v) {
+        if (mesh.positions[v].x != static_cast<float32>(v)) ++bad_positions;
+    }
+    uint32 bad_faces = 0;
+    for (uint32 t = 0; t < kTriangles; ++t) {
+        if (!SameFace(mesh.faces[t], 3 * t, 3 * t + 1, 3 * t + 2)) ++bad_faces;
+    }
+    MPS_CHECK(bad_positions == 0);
+    MPS_CHECK(bad_faces == 0);
+}
+
+int main() {
+    TestRecords();
+    TestOutOfRange();
+    TestChunkedMatchesFileOrder();
+    return MPS_TEST_RESULT();
+}
@@ -0,0 +1,74 @@
+#include "core_simulate/dynamics_term.h"
+#include "test_check.h"
+#include "test_mesh.h"
+#include <set>
+#include <utility>
+
+using namespace mps;
+using namespace mps::simulate;
+
+// Rows are sorted and duplicate-free, and every declared entry is found in both directions
+static void TestGridSparsity() {
+    constexpr uint32 n = 9;
+    auto edges = mps_test::GridEdges(n);
+
+    SparsityBuilder builder(n * n);
+    std::set<std::pair<uint32, uint32>> expected;
+    for (size_t i = 0; i < edges.size(); i += 2) {
+        // Terms sharing an edge declare it again, in either order
+        builder.AddEdge(edges[i], edges[i + 1]);
+        builder.AddEdge(edges[i + 1], edges[i]);
+        expected.insert({edges[i], edges[i + 1]});
+        expected.insert({edges[i + 1], edges[i]});
+    }
+    for (uint32 v = 0; v < n * n; ++v) {
+        builder.AddEdge(v, v);   // diagonal block
+        expected.insert({v, v});
+    }
+    builder.Build();
+
+    const auto& row_ptr = builder.GetRowPtr();
+    const auto& col_idx = builder.GetColIdx();
+    MPS_CHECK(row_ptr.size() == n * n + 1);
+    MPS_CHECK(row_ptr.front() == 0);
+    MPS_CHECK(row_ptr.back() == builder.GetNNZ());
+    MPS_CHECK(builder.GetNNZ() == expected.size());
+
+    for (uint32 row = 0; row < n * n; ++row) {
+        MPS_CHECK(row_ptr[row] <= row_ptr[row + 1]);
+        for (uint32 k = row_ptr[row] + 1; k < row_ptr[row + 1]; ++k) {
+            MPS_CHECK(col_idx[k - 1] < col_idx[k]);   // strictly ascending: sorted and unique
+        }
+        for (uint32 k = row_ptr[row]; k < row_ptr[row + 1]; ++k) {
+            MPS_CHECK(expected.contains({row, col_idx[k]}));
+        }
+    }
+
+    for (const auto& [row, col] : expected) {
+        uint32 index = builder.GetCSRIndex(row, col);
+        MPS_CHECK(index != UINT32_MAX);
+        if (index == UINT32_MAX) continue;
+        MPS_CHECK(index >= row_ptr[row] && index < row_ptr[row + 1]);
+        MPS_CHECK(col_idx[index] == col);
+    }
+}
+
+static void TestMissingEntries() {
+    SparsityBuilder builder(4);
+    builder.AddEdge(0, 1);
+    builder.AddEdge(2, 3);
+    builder.Build();
+
+    MPS_CHECK(builder.GetNNZ() == 4);
+    MPS_CHECK(builder.GetCSRIndex(0, 1) != UINT32_MAX);
+    MPS_CHECK(builder.GetCSRIndex(3, 2) != UINT32_MAX);
+    MPS_CHECK(builder.GetCSRIndex(0, 0) == UINT32_MAX);   // diagonal not declared
+    MPS_CHECK(builder.GetCSRIndex(1, 2) == UINT32_MAX);
+    MPS_CHECK(builder.GetCSRIndex(4, 0) == UINT32_MAX);   // row out of range
+}
+
+int main() {
+    TestGridSparsity();
+    TestMissingEntries();
+    return MPS_TEST_RESULT();
+}
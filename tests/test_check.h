@@ -0,0 +1,19 @@
+#pragma once
+
+#include <cstdio>
+
+// Minimal checks for the host-only tests. A failed check is reported with its
+// location and the test keeps going; main() returns MPS_TEST_RESULT().
+namespace mps_test {
+inline int failures = 0;
+}  // namespace mps_test
+
+#define MPS_CHECK(cond)                                                                  \
+    do {                                                                                 \
+        if (!(cond)) {                                                                   \
+            std::fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+            ++mps_test::failures;                                                        \
+        }                                                                                \
+    } while (0)
+
+#define MPS_TEST_RESULT() (mps_test::failures == 0 ? 0 : 1)
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "core_util/types.h"
+#include <vector>
+
+namespace mps_test {
+
+// Triangulated (n x n)-vertex grid: 3 node indices per triangle, two triangles per cell
+inline std::vector<mps::uint32> GridTriangles(mps::uint32 n) {
+    std::vector<mps::uint32> nodes;
+    for (mps::uint32 y = 0; y + 1 < n; ++y) {
+        for (mps::uint32 x = 0; x + 1 < n; ++x) {
+            mps::uint32 v = y * n + x;
+            nodes.insert(nodes.end(), {v, v + 1, v + n});
+            nodes.insert(nodes.end(), {v + 1, v + n + 1, v + n});
+        }
+    }
+    return nodes;
+}
+
+// Edges of GridTriangles(n), each once: 2 node indices per edge
+inline std::vector<mps::uint32> GridEdges(mps::uint32 n) {
+    std::vector<mps::uint32> nodes;
+    for (mps::uint32 y = 0; y < n; ++y) {
+        for (mps::uint32 x = 0; x < n; ++x) {
+            mps::uint32 v = y * n + x;
+            if (x + 1 < n) nodes.insert(nodes.end(), {v, v + 1});
+            if (y + 1 < n) nodes.insert(nodes.end(), {v, v + n});
+            if (x + 1 < n && y + 1 < n) nodes.insert(nodes.end(), {v + 1, v + n});
+        }
+    }
+    return nodes;
+}
+
+}  // namespace mps_test